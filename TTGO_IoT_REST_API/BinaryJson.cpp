@@ -0,0 +1,230 @@
+#include "BinaryJson.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// ========================================
+// NÉGOCIATION
+// ========================================
+struct MediaType {
+    const char* type;
+    ResponseFormat format;
+};
+
+static const MediaType MEDIA_TYPES[] = {
+    { "application/json",        FORMAT_JSON },
+    { "application/cbor",        FORMAT_CBOR },
+    { "application/msgpack",     FORMAT_MSGPACK },
+    { "application/x-msgpack",   FORMAT_MSGPACK },
+    { "application/vnd.msgpack", FORMAT_MSGPACK },
+    { "application/*",           FORMAT_JSON },
+    { "*/*",                     FORMAT_JSON },
+};
+
+ResponseFormat negotiateFormat(const char* accept) {
+    ResponseFormat best = FORMAT_JSON;
+    float bestQ = 0;
+    const char* p = accept;
+    while (p && *p) {
+        while (*p == ' ' || *p == ',') p++;
+        const char* type = p;
+        while (*p && *p != ';' && *p != ',' && *p != ' ') p++;
+        size_t typeLen = p - type;
+
+        // Paramètres jusqu'à la virgule suivante, seul q= compte
+        float q = 1.0f;
+        while (*p && *p != ',') {
+            if (*p++ != ';') continue;
+            while (*p == ' ') p++;
+            if ((*p == 'q' || *p == 'Q') && p[1] == '=') q = strtof(p + 2, NULL);
+        }
+
+        for (size_t i = 0; i < sizeof(MEDIA_TYPES) / sizeof(MEDIA_TYPES[0]); i++) {
+            if (strlen(MEDIA_TYPES[i].type) != typeLen ||
+                strncasecmp(MEDIA_TYPES[i].type, type, typeLen) != 0) continue;
+            if (q > bestQ) {
+                best = MEDIA_TYPES[i].format;
+                bestQ = q;
+            }
+            break;
+        }
+    }
+    return best;
+}
+
+const char* formatContentType(ResponseFormat format) {
+    switch (format) {
+        case FORMAT_CBOR:    return "application/cbor";
+        case FORMAT_MSGPACK: return "application/msgpack";
+        default:             return "application/json";
+    }
+}
+
+// ========================================
+// ÉCRITURE
+// ========================================
+struct BinaryWriter {
+    uint8_t* out;
+    size_t size;
+    size_t len;
+    bool overflowed;
+
+    void byte(uint8_t b) {
+        if (len < size) out[len++] = b;
+        else overflowed = true;
+    }
+    // Entier big-endian sur bytes octets (ordre réseau des deux formats)
+    void bigEndian(uint64_t value, int bytes) {
+        for (int i = bytes - 1; i >= 0; i--) byte((uint8_t)(value >> (8 * i)));
+    }
+    void raw(const char* data, size_t n) {
+        if (size - len < n) {
+            overflowed = true;
+            return;
+        }
+        memcpy(out + len, data, n);
+        len += n;
+    }
+};
+
+// Types majeurs CBOR
+enum CborMajor {
+    CBOR_UNSIGNED = 0,
+    CBOR_NEGATIVE = 1,
+    CBOR_TEXT = 3,
+    CBOR_ARRAY = 4,
+    CBOR_MAP = 5
+};
+
+// Tête CBOR : type majeur et argument sur 0, 1, 2, 4 ou 8 octets
+static void cborHead(BinaryWriter& w, uint8_t major, uint64_t value) {
+    major <<= 5;
+    if (value < 24) {
+        w.byte(major | (uint8_t)value);
+    } else if (value <= 0xFF) {
+        w.byte(major | 24);
+        w.bigEndian(value, 1);
+    } else if (value <= 0xFFFF) {
+        w.byte(major | 25);
+        w.bigEndian(value, 2);
+    } else if (value <= 0xFFFFFFFFULL) {
+        w.byte(major | 26);
+        w.bigEndian(value, 4);
+    } else {
+        w.byte(major | 27);
+        w.bigEndian(value, 8);
+    }
+}
+
+// Tête MessagePack : forme courte (fix*) si elle existe, sinon préfixe
+// de la plus petite largeur ; prefixes[] donne les préfixes 8/16/32 bits
+static void msgpackHead(BinaryWriter& w, uint8_t fixPrefix, uint32_t fixLimit,
+                        const uint8_t prefixes[3], uint32_t value) {
+    if (value < fixLimit) {
+        w.byte(fixPrefix | (uint8_t)value);
+    } else if (value <= 0xFF && prefixes[0]) {
+        w.byte(prefixes[0]);
+        w.bigEndian(value, 1);
+    } else if (value <= 0xFFFF) {
+        w.byte(prefixes[1]);
+        w.bigEndian(value, 2);
+    } else {
+        w.byte(prefixes[2]);
+        w.bigEndian(value, 4);
+    }
+}
+
+static const uint8_t MSGPACK_STR[3] = { 0xD9, 0xDA, 0xDB };
+static const uint8_t MSGPACK_ARRAY[3] = { 0, 0xDC, 0xDD };
+static const uint8_t MSGPACK_MAP[3] = { 0, 0xDE, 0xDF };
+
+static void writeString(BinaryWriter& w, ResponseFormat format, const char* s) {
+    size_t n = strlen(s);
+    if (format == FORMAT_CBOR) cborHead(w, CBOR_TEXT, n);
+    else msgpackHead(w, 0xA0, 32, MSGPACK_STR, n);
+    w.raw(s, n);
+}
+
+static void writeInteger(BinaryWriter& w, ResponseFormat format, long long value) {
+    if (format == FORMAT_CBOR) {
+        if (value >= 0) cborHead(w, CBOR_UNSIGNED, (uint64_t)value);
+        else cborHead(w, CBOR_NEGATIVE, (uint64_t)(-1 - value));
+        return;
+    }
+    if (value >= 0) {
+        if (value < 128) {
+            w.byte((uint8_t)value);
+        } else if (value <= 0xFF) {
+            w.byte(0xCC);
+            w.bigEndian(value, 1);
+        } else if (value <= 0xFFFF) {
+            w.byte(0xCD);
+            w.bigEndian(value, 2);
+        } else if (value <= 0xFFFFFFFFLL) {
+            w.byte(0xCE);
+            w.bigEndian(value, 4);
+        } else {
+            w.byte(0xCF);
+            w.bigEndian(value, 8);
+        }
+    } else if (value >= -32) {
+        w.byte((uint8_t)value);
+    } else if (value >= -128) {
+        w.byte(0xD0);
+        w.bigEndian((uint64_t)value, 1);
+    } else if (value >= -32768) {
+        w.byte(0xD1);
+        w.bigEndian((uint64_t)value, 2);
+    } else if (value >= -2147483648LL) {
+        w.byte(0xD2);
+        w.bigEndian((uint64_t)value, 4);
+    } else {
+        w.byte(0xD3);
+        w.bigEndian((uint64_t)value, 8);
+    }
+}
+
+// Mesures en float32 : précision du capteur, 5 octets au lieu de 9
+static void writeReal(BinaryWriter& w, ResponseFormat format, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    w.byte(format == FORMAT_CBOR ? 0xFA : 0xCA);
+    w.bigEndian(bits, 4);
+}
+
+static void writeValue(BinaryWriter& w, ResponseFormat format, JsonVariant value) {
+    bool cbor = format == FORMAT_CBOR;
+    if (value.is<JsonObject>()) {
+        JsonObject object = value.as<JsonObject>();
+        if (cbor) cborHead(w, CBOR_MAP, object.size());
+        else msgpackHead(w, 0x80, 16, MSGPACK_MAP, object.size());
+        for (JsonPair member : object) {
+            writeString(w, format, member.key().c_str());
+            writeValue(w, format, member.value());
+        }
+    } else if (value.is<JsonArray>()) {
+        JsonArray array = value.as<JsonArray>();
+        if (cbor) cborHead(w, CBOR_ARRAY, array.size());
+        else msgpackHead(w, 0x90, 16, MSGPACK_ARRAY, array.size());
+        for (JsonVariant element : array) writeValue(w, format, element);
+    } else if (value.is<const char*>()) {
+        writeString(w, format, value.as<const char*>());
+    } else if (value.is<bool>()) {
+        bool b = value.as<bool>();
+        w.byte(cbor ? (b ? 0xF5 : 0xF4) : (b ? 0xC3 : 0xC2));
+    } else if (value.is<long>()) {
+        writeInteger(w, format, value.as<long>());
+    } else if (value.is<unsigned long>()) {
+        writeInteger(w, format, (long long)value.as<unsigned long>());
+    } else if (value.is<float>()) {
+        writeReal(w, format, value.as<float>());
+    } else {
+        w.byte(cbor ? 0xF6 : 0xC0);
+    }
+}
+
+size_t serializeBinary(JsonVariant value, ResponseFormat format, uint8_t* out, size_t size) {
+    BinaryWriter w = { out, size, 0, false };
+    writeValue(w, format, value);
+    return w.overflowed ? 0 : w.len;
+}
@@ -0,0 +1,27 @@
+#ifndef BINARY_JSON_H
+#define BINARY_JSON_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// ========================================
+// FORMATS DE RÉPONSE
+// ========================================
+// Négociés par l'en-tête Accept ; JSON par défaut
+enum ResponseFormat {
+    FORMAT_JSON,
+    FORMAT_CBOR,
+    FORMAT_MSGPACK
+};
+
+// Format le mieux noté (q=) parmi ceux de l'en-tête Accept, le premier cité
+// à égalité ; JSON si aucun n'est reconnu
+ResponseFormat negotiateFormat(const char* accept);
+const char* formatContentType(ResponseFormat format);
+
+// Encode un document en CBOR (RFC 8949) ou MessagePack : mêmes clés, même
+// structure que le JSON ; entiers sur le moins d'octets possible, réels en
+// float32. Retourne la taille écrite, 0 si out est trop petit.
+size_t serializeBinary(JsonVariant value, ResponseFormat format, uint8_t* out, size_t size);
+
+#endif
@@ -1,113 +1,290 @@
 #include "DisplayControl.h"
 
-DisplayControl::DisplayControl(TFT_eSPI* tft) {
+static void initWidget(StatusWidget& widget, int16_t x, int16_t y, int16_t w, int16_t h) {
+    widget.x = x;
+    widget.y = y;
+    widget.w = w;
+    widget.h = h;
+    widget.value = 0;
+    widget.valid = false;
+}
+
+DisplayControl::DisplayControl(TFT_eSPI* tft)
+#if DISPLAY_SPRITE_DEPTH
+    : _sprite(tft)
+#endif
+{
     _tft = tft;
+    _gfx = tft;
+#if DISPLAY_SPRITE_DEPTH
+    _dma = false;
+#endif
+    _dirtyTop = 0;
+    _dirtyBottom = 0;
+    _layoutDrawn = false;
+    _modeText[0] = '\0';
+
+    // Rectangles englobant tout ce que chaque zone peut dessiner
+    initWidget(_tempWidget, 70, 28, 96, 16);     // "-10.0C" en taille 2
+    initWidget(_lightWidget, 70, 50, 48, 16);    // "100%" en taille 2
+    initWidget(_barWidget, 10, 72, 220, 8);
+    initWidget(_modeWidget, 46, 85, 90, 8);      // 15 caractères après "Mode: "
+    initWidget(_ledWidget, 187, 108, 18, 8);     // ON/OFF ; la pastille se repeint entière
+    initWidget(_linkWidget, 10, 118, 60, 8);     // "Hors ligne"
 }
 
 void DisplayControl::begin() {
     _tft->init();
     _tft->setRotation(1);
     _tft->fillScreen(TFT_BLACK);
+
+#if DISPLAY_SPRITE_DEPTH
+    // Sans RAM suffisante on reste en dessin direct
+    _sprite.setColorDepth(DISPLAY_SPRITE_DEPTH);
+    if (_sprite.createSprite(_tft->width(), _tft->height())) {
+        _gfx = &_sprite;
+        _gfx->fillScreen(TFT_BLACK);
+#if DISPLAY_SPRITE_DEPTH == 16
+        // Le bus reste réservé à l'écran : chaque push part en DMA
+        _dma = _tft->initDMA();
+        if (_dma) _tft->startWrite();
+#endif
+    }
+#endif
+    invalidate();
 }
 
 void DisplayControl::clear() {
-    _tft->fillScreen(TFT_BLACK);
+    if (isBusy()) _tft->dmaWait();
+    _gfx->fillScreen(TFT_BLACK);
+    markDirty(0, _gfx->height());
+    pushFrame();
+    invalidate();
+}
+
+// Transfert DMA en cours : l'image ne doit pas être modifiée
+bool DisplayControl::isBusy() {
+#if DISPLAY_SPRITE_DEPTH
+    return _dma && _tft->dmaBusy();
+#else
+    return false;
+#endif
 }
 
 void DisplayControl::showMessage(String title, String msg, uint16_t color) {
-    _tft->fillScreen(TFT_BLACK);
-    _tft->setTextColor(color);
-    _tft->setTextSize(2);
-    _tft->setCursor(50, 30);
-    _tft->println(title);
-    _tft->setTextSize(1);
-    _tft->setCursor(50, 60);
-    _tft->println(msg);
+    if (isBusy()) _tft->dmaWait();
+    _gfx->fillScreen(TFT_BLACK);
+    _gfx->setTextColor(color);
+    _gfx->setTextSize(2);
+    _gfx->setCursor(50, 30);
+    _gfx->println(title);
+    _gfx->setTextSize(1);
+    _gfx->setCursor(50, 60);
+    _gfx->println(msg);
+    markDirty(0, _gfx->height());
+    pushFrame();
+    invalidate();
 }
 
+// ========================================
+// ÉCRAN DE STATUT
+// ========================================
+// Appelé toutes les 500 ms : seules les zones dont la valeur a changé
+// sont effacées et redessinées, le reste de l'écran n'est pas retransmis.
 void DisplayControl::showStatus(float temperature, int lightPercent, bool ledState, 
                                 bool wifiConnected, bool firebaseReady, String mode) {
-    _tft->fillScreen(TFT_BLACK);
-    
+    // Image précédente encore en cours d'envoi : on sautera cette mise à jour
+    if (isBusy()) return;
+
+    if (!_layoutDrawn) drawLayout();
+
+    drawTemperature(temperature);
+    drawLight(lightPercent);
+    drawLightBar(lightPercent);
+    drawMode(mode);
+    drawLed(ledState);
+    drawLink(wifiConnected, firebaseReady);
+
+    pushFrame();
+}
+
+void DisplayControl::invalidate() {
+    _layoutDrawn = false;
+    _tempWidget.valid = false;
+    _lightWidget.valid = false;
+    _barWidget.valid = false;
+    _modeWidget.valid = false;
+    _ledWidget.valid = false;
+    _linkWidget.valid = false;
+}
+
+bool DisplayControl::changed(StatusWidget& widget, int32_t value) {
+    if (widget.valid && widget.value == value) return false;
+    widget.value = value;
+    widget.valid = true;
+    return true;
+}
+
+void DisplayControl::clearWidget(const StatusWidget& widget) {
+    _gfx->fillRect(widget.x, widget.y, widget.w, widget.h, TFT_BLACK);
+    markDirty(widget.y, widget.h);
+}
+
+void DisplayControl::markDirty(int16_t y, int16_t h) {
+    if (_dirtyTop >= _dirtyBottom) {
+        _dirtyTop = y;
+        _dirtyBottom = y + h;
+        return;
+    }
+    if (y < _dirtyTop) _dirtyTop = y;
+    if (y + h > _dirtyBottom) _dirtyBottom = y + h;
+}
+
+// Envoie la bande de lignes modifiées. Lignes entières : dans le sprite elles
+// sont contiguës, donc un seul transfert sans copie.
+void DisplayControl::pushFrame() {
+    int16_t top = _dirtyTop < 0 ? 0 : _dirtyTop;
+    int16_t bottom = _dirtyBottom > _gfx->height() ? _gfx->height() : _dirtyBottom;
+    _dirtyTop = 0;
+    _dirtyBottom = 0;
+    if (top >= bottom) return;
+
+#if DISPLAY_SPRITE_DEPTH
+    if (_gfx != &_sprite) return;
+    int16_t width = _sprite.width();
+    if (_dma) {
+        uint16_t* pixels = (uint16_t*)_sprite.getPointer() + (size_t)top * width;
+        _tft->pushImageDMA(0, top, width, bottom - top, pixels);
+    } else {
+        _sprite.pushSprite(0, top, 0, top, width, bottom - top);
+    }
+#endif
+}
+
+// Titre, séparateur et libellés : identiques d'une mise à jour à l'autre
+void DisplayControl::drawLayout() {
+    _gfx->fillScreen(TFT_BLACK);
+
     // Titre
-    _tft->setTextSize(2);
-    _tft->setTextColor(TFT_CYAN);
-    _tft->setCursor(40, 5);
-    _tft->print("TTGO IoT");
-    _tft->drawLine(0, 25, 240, 25, TFT_WHITE);
-    
-    // Température
-    _tft->setTextSize(1);
-    _tft->setTextColor(TFT_YELLOW);
-    _tft->setCursor(10, 30);
-    _tft->print("Temp:");
-    
-    _tft->setTextSize(2);
-    if(temperature < 30.0) _tft->setTextColor(TFT_GREEN);
-    else if(temperature < 35.0) _tft->setTextColor(TFT_CYAN);
-    else if(temperature < 40.0) _tft->setTextColor(TFT_ORANGE);
-    else _tft->setTextColor(TFT_RED);
-    
-    _tft->setCursor(70, 28);
-    _tft->print(temperature, 1);
-    _tft->print("C");
-    
-    // Lumière
-    _tft->setTextSize(1);
-    _tft->setTextColor(TFT_YELLOW);
-    _tft->setCursor(10, 52);
-    _tft->print("Lum:");
-    
-    _tft->setTextSize(2);
-    if(lightPercent < 30) _tft->setTextColor(TFT_BLUE);
-    else if(lightPercent < 70) _tft->setTextColor(TFT_YELLOW);
-    else _tft->setTextColor(TFT_ORANGE);
-    
-    _tft->setCursor(70, 50);
-    _tft->print(lightPercent);
-    _tft->print("%");
-    
-    // Barre lumière
+    _gfx->setTextSize(2);
+    _gfx->setTextColor(TFT_CYAN);
+    _gfx->setCursor(40, 5);
+    _gfx->print("TTGO IoT");
+    _gfx->drawLine(0, 25, 240, 25, TFT_WHITE);
+
+    // Libellés
+    _gfx->setTextSize(1);
+    _gfx->setTextColor(TFT_YELLOW);
+    _gfx->setCursor(10, 30);
+    _gfx->print("Temp:");
+    _gfx->setCursor(10, 52);
+    _gfx->print("Lum:");
+
+    _gfx->setCursor(10, 85);
+    _gfx->setTextColor(TFT_MAGENTA);
+    _gfx->print("Mode: ");
+
+    markDirty(0, _gfx->height());
+    _layoutDrawn = true;
+}
+
+void DisplayControl::drawTemperature(float temperature) {
+    // Affichage au dixième : la clé de cache aussi
+    int32_t tenths = isnan(temperature) ? INT32_MIN : (int32_t)lroundf(temperature * 10);
+    if (!changed(_tempWidget, tenths)) return;
+    clearWidget(_tempWidget);
+
+    _gfx->setTextSize(2);
+    if(temperature < 30.0) _gfx->setTextColor(TFT_GREEN);
+    else if(temperature < 35.0) _gfx->setTextColor(TFT_CYAN);
+    else if(temperature < 40.0) _gfx->setTextColor(TFT_ORANGE);
+    else _gfx->setTextColor(TFT_RED);
+
+    _gfx->setCursor(70, 28);
+    _gfx->print(temperature, 1);
+    _gfx->print("C");
+}
+
+void DisplayControl::drawLight(int lightPercent) {
+    if (!changed(_lightWidget, lightPercent)) return;
+    clearWidget(_lightWidget);
+
+    _gfx->setTextSize(2);
+    if(lightPercent < 30) _gfx->setTextColor(TFT_BLUE);
+    else if(lightPercent < 70) _gfx->setTextColor(TFT_YELLOW);
+    else _gfx->setTextColor(TFT_ORANGE);
+
+    _gfx->setCursor(70, 50);
+    _gfx->print(lightPercent);
+    _gfx->print("%");
+}
+
+void DisplayControl::drawLightBar(int lightPercent) {
     int barWidth = map(lightPercent, 0, 100, 0, 220);
     uint16_t barColor = TFT_YELLOW;
     if(lightPercent < 30) barColor = TFT_BLUE;
     if(lightPercent > 70) barColor = TFT_ORANGE;
-    _tft->fillRect(10, 72, barWidth, 8, barColor);
-    _tft->drawRect(10, 72, 220, 8, TFT_WHITE);
-    
-    // Mode
-    _tft->setTextSize(1);
-    _tft->setCursor(10, 85);
-    _tft->setTextColor(TFT_MAGENTA);
-    _tft->print("Mode: ");
-    _tft->print(mode);
-    
-    // LED
+
+    // Plusieurs pourcentages donnent la même barre : clé = largeur + couleur
+    if (!changed(_barWidget, ((int32_t)barWidth << 16) | barColor)) return;
+
+    _gfx->fillRect(10, 72, barWidth, 8, barColor);
+    _gfx->fillRect(10 + barWidth, 72, 220 - barWidth, 8, TFT_BLACK);
+    _gfx->drawRect(10, 72, 220, 8, TFT_WHITE);
+    markDirty(72, 8);
+
+    // Le haut de la pastille LED recouvre la barre : elle doit être repeinte
+    _ledWidget.valid = false;
+}
+
+void DisplayControl::drawMode(const String& mode) {
+    if (_modeWidget.valid && strncmp(_modeText, mode.c_str(), sizeof(_modeText)) == 0) return;
+    strncpy(_modeText, mode.c_str(), sizeof(_modeText) - 1);
+    _modeText[sizeof(_modeText) - 1] = '\0';
+    _modeWidget.valid = true;
+    clearWidget(_modeWidget);
+
+    _gfx->setTextSize(1);
+    _gfx->setCursor(46, 85);
+    _gfx->setTextColor(TFT_MAGENTA);
+    _gfx->print(mode);
+}
+
+void DisplayControl::drawLed(bool ledState) {
+    if (!changed(_ledWidget, ledState)) return;
+    clearWidget(_ledWidget);
+
+    markDirty(78, 25);   // pastille
     if (ledState) {
-        _tft->fillCircle(200, 90, 12, TFT_GREEN);
-        _tft->setTextColor(TFT_GREEN);
-        _tft->setTextSize(1);
-        _tft->setCursor(190, 108);
-        _tft->print("ON");
+        _gfx->fillCircle(200, 90, 12, TFT_GREEN);
+        _gfx->setTextColor(TFT_GREEN);
+        _gfx->setTextSize(1);
+        _gfx->setCursor(190, 108);
+        _gfx->print("ON");
     } else {
-        _tft->fillCircle(200, 90, 12, TFT_RED);
-        _tft->setTextColor(TFT_RED);
-        _tft->setTextSize(1);
-        _tft->setCursor(187, 108);
-        _tft->print("OFF");
+        _gfx->fillCircle(200, 90, 12, TFT_RED);
+        _gfx->setTextColor(TFT_RED);
+        _gfx->setTextSize(1);
+        _gfx->setCursor(187, 108);
+        _gfx->print("OFF");
     }
-    
-    // Status
-    _tft->setTextSize(1);
-    _tft->setCursor(10, 118);
-    if (wifiConnected && firebaseReady) {
-        _tft->setTextColor(TFT_GREEN);
-        _tft->print("WiFi+FB OK");
-    } else if (wifiConnected) {
-        _tft->setTextColor(TFT_ORANGE);
-        _tft->print("WiFi OK");
+}
+
+void DisplayControl::drawLink(bool wifiConnected, bool firebaseReady) {
+    int32_t state = wifiConnected ? (firebaseReady ? 2 : 1) : 0;
+    if (!changed(_linkWidget, state)) return;
+    clearWidget(_linkWidget);
+
+    _gfx->setTextSize(1);
+    _gfx->setCursor(10, 118);
+    if (state == 2) {
+        _gfx->setTextColor(TFT_GREEN);
+        _gfx->print("WiFi+FB OK");
+    } else if (state == 1) {
+        _gfx->setTextColor(TFT_ORANGE);
+        _gfx->print("WiFi OK");
     } else {
-        _tft->setTextColor(TFT_RED);
-        _tft->print("Hors ligne");
+        _gfx->setTextColor(TFT_RED);
+        _gfx->print("Hors ligne");
     }
 }
@@ -3,11 +3,55 @@
 
 #include <TFT_eSPI.h>
 #include <Arduino.h>
+#include "config.h"
+
+// Zone de l'écran de statut : redessinée seulement quand sa valeur change
+struct StatusWidget {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+    int32_t value;   // dernière valeur rendue
+    bool valid;      // false = à redessiner quelle que soit la valeur
+};
 
 class DisplayControl {
 private:
     TFT_eSPI* _tft;
-    
+    TFT_eSPI* _gfx;      // cible des dessins : l'écran, ou le sprite s'il existe
+
+#if DISPLAY_SPRITE_DEPTH
+    // Image hors écran : composée en RAM puis envoyée par bandes modifiées
+    TFT_eSprite _sprite;
+    bool _dma;
+#endif
+    int16_t _dirtyTop;      // bande de lignes à pousser (vide si top >= bottom)
+    int16_t _dirtyBottom;
+
+    // Écran de statut : fond et libellés fixes dessinés une seule fois
+    bool _layoutDrawn;
+    StatusWidget _tempWidget;
+    StatusWidget _lightWidget;
+    StatusWidget _barWidget;
+    StatusWidget _modeWidget;
+    StatusWidget _ledWidget;
+    StatusWidget _linkWidget;
+    char _modeText[16];
+
+    void drawLayout();
+    void invalidate();
+    bool changed(StatusWidget& widget, int32_t value);
+    void clearWidget(const StatusWidget& widget);
+    void markDirty(int16_t y, int16_t h);
+    void pushFrame();
+
+    void drawTemperature(float temperature);
+    void drawLight(int lightPercent);
+    void drawLightBar(int lightPercent);
+    void drawMode(const String& mode);
+    void drawLed(bool ledState);
+    void drawLink(bool wifiConnected, bool firebaseReady);
+
 public:
     DisplayControl(TFT_eSPI* tft);
     void begin();
@@ -15,6 +59,7 @@ public:
     void showStatus(float temperature, int lightPercent, bool ledState, 
                    bool wifiConnected, bool firebaseReady, String mode);
     void clear();
+    bool isBusy();
 };
 
 #endif
@@ -0,0 +1,185 @@
+#include "FirebaseOutbox.h"
+#include "Logger.h"
+#include "SensorHistory.h"
+
+FirebaseOutbox::FirebaseOutbox(FlashLog* log, FS* fs) {
+    _log = log;
+    _fs = fs;
+    _cursor = 0;
+    _depth = 0;
+    _lastDrain = 0;
+    _savedAt = 0;
+    _backlog = false;
+    _delivered = 0;
+    _batches = 0;
+    _failed = 0;
+    _windowStart = 0;
+    _windowCount = 0;
+    _drainRate = 0;
+    _body[0] = '\0';
+#ifdef ARDUINO_ARCH_ESP32
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void FirebaseOutbox::lock() { portENTER_CRITICAL(&_mux); }
+void FirebaseOutbox::unlock() { portEXIT_CRITICAL(&_mux); }
+#else
+void FirebaseOutbox::lock() { _mutex.lock(); }
+void FirebaseOutbox::unlock() { _mutex.unlock(); }
+#endif
+
+// ========================================
+// CURSEUR PERSISTANT
+// ========================================
+// Fichier temporaire puis rename (atomique sous LittleFS) : une coupure
+// laisse l'ancien curseur ou le nouveau, jamais un fichier partiel
+void FirebaseOutbox::saveCursor() {
+    File file = _fs->open(OUTBOX_CURSOR_FILE ".tmp", FILE_WRITE);
+    uint8_t bytes[4] = { (uint8_t)_cursor, (uint8_t)(_cursor >> 8),
+                         (uint8_t)(_cursor >> 16), (uint8_t)(_cursor >> 24) };
+    bool ok = file && file.write(bytes, sizeof(bytes)) == sizeof(bytes);
+    file.close();
+    if (ok) {
+        _fs->remove(OUTBOX_CURSOR_FILE);
+        ok = _fs->rename(OUTBOX_CURSOR_FILE ".tmp", OUTBOX_CURSOR_FILE);
+    }
+    if (ok) {
+        _savedAt = millis();
+    } else {
+        LOG_EVERY(LOG_LEVEL_WARN, 60000, "Outbox: curseur non sauvegarde");
+    }
+}
+
+bool FirebaseOutbox::begin() {
+    File file = _fs->open(OUTBOX_CURSOR_FILE, FILE_READ);
+    uint8_t bytes[4];
+    if (file && file.read(bytes, sizeof(bytes)) == sizeof(bytes)) {
+        _cursor = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    }
+    file.close();
+
+    // Arriéré : un seul parcours du journal au démarrage, compteur ensuite
+    uint32_t depth = _log->query(_cursor + 1, 0xFFFFFFFF, 0xFFFFFFFF, [](const LogSample&) {});
+
+    lock();
+    _depth = depth;
+    // Premier lot autorisé tout de suite
+    _lastDrain = millis() - OUTBOX_MAX_DELAY;
+    _savedAt = millis();
+    _windowStart = millis();
+    unlock();
+
+    LOG_INFO("Outbox: %lu echantillons a livrer apres %lu", (unsigned long)depth, (unsigned long)_cursor);
+    return true;
+}
+
+void FirebaseOutbox::recorded() {
+    lock();
+    _depth++;
+    unlock();
+}
+
+// ========================================
+// VIDAGE PAR LOTS
+// ========================================
+bool FirebaseOutbox::drain(FirebaseData* fbdo) {
+    unsigned long now = millis();
+
+    lock();
+    uint32_t depth = _depth;
+    unsigned long since = now - _lastDrain;
+    unlock();
+
+    // Arriéré : un lot par OUTBOX_DRAIN_INTERVAL jusqu'au bout. Régime
+    // établi : on laisse un lot se remplir, OUTBOX_MAX_DELAY au plus.
+    if (depth == 0 || since < OUTBOX_DRAIN_INTERVAL) return false;
+    if (depth < OUTBOX_BATCH && !_backlog && since < OUTBOX_MAX_DELAY) return false;
+    if (!Firebase.ready()) return false;
+
+    // Un seul objet multi-clés : OUTBOX_PATH/<epoch> pour chaque échantillon
+    size_t len = 0;
+    uint32_t last = _cursor;
+    _body[len++] = '{';
+    size_t count = _log->query(_cursor + 1, 0xFFFFFFFF, OUTBOX_BATCH, [&](const LogSample& sample) {
+        char* out = _body + len;
+        size_t space = sizeof(_body) - len;
+        int n = snprintf(out, space, "%s\"%lu\":{\"temp\":", len > 1 ? "," : "", (unsigned long)sample.time);
+        n += SensorHistory::formatCenti(out + n, space - n, sample.temp);
+        n += snprintf(out + n, space - n, ",\"light\":");
+        n += SensorHistory::formatCenti(out + n, space - n, sample.light);
+        n += snprintf(out + n, space - n, ",\"led\":%s}", sample.led ? "true" : "false");
+        len += n;
+        last = sample.time;
+    });
+    _body[len++] = '}';
+    _body[len] = '\0';
+
+    lock();
+    _lastDrain = now;
+    unlock();
+
+    if (count == 0) {
+        // Arriéré surestimé (segments supprimés par la rotation) : recalé
+        lock();
+        _depth -= depth;
+        unlock();
+        return false;
+    }
+
+    FirebaseJson json;
+    json.setJsonData(_body);
+    if (!Firebase.RTDB.updateNodeSilent(fbdo, OUTBOX_PATH, &json)) {
+        lock();
+        _failed++;
+        unlock();
+        LOG_EVERY(LOG_LEVEL_WARN, 10000, "Outbox: lot refuse (%s), %lu en attente",
+                  fbdo->errorReason().c_str(), (unsigned long)depth);
+        return true;
+    }
+
+    _cursor = last;
+    _backlog = count == OUTBOX_BATCH;
+
+    lock();
+    // Lot incomplet : journal épuisé, seuls restent les ajouts pendant l'envoi
+    _depth -= count < OUTBOX_BATCH ? depth : (count < _depth ? count : _depth);
+    bool caughtUp = _depth == 0;
+    _delivered += count;
+    _batches++;
+    _windowCount += count;
+    if (now - _windowStart >= OUTBOX_RATE_WINDOW) {
+        _drainRate = _windowCount * 1000.0f / (now - _windowStart);
+        _windowStart = now;
+        _windowCount = 0;
+    }
+    unlock();
+
+    // Usure : curseur réécrit une fois l'arriéré vidé ou au plus 1 fois/min
+    if (caughtUp || now - _savedAt >= OUTBOX_SAVE_INTERVAL) {
+        saveCursor();
+    }
+    return true;
+}
+
+// ========================================
+// STATISTIQUES
+// ========================================
+OutboxStats FirebaseOutbox::getStats() {
+    unsigned long now = millis();
+    OutboxStats stats;
+    lock();
+    stats.depth = _depth;
+    // Plus aucun lot depuis deux fenêtres : débit nul
+    stats.drainRate = now - _lastDrain > 2 * OUTBOX_RATE_WINDOW ? 0.0f : _drainRate;
+    stats.delivered = _delivered;
+    stats.batches = _batches;
+    stats.failed = _failed;
+    unlock();
+    return stats;
+}
+
+uint32_t FirebaseOutbox::cursor() {
+    return _cursor;
+}
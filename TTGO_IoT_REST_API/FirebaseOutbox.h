@@ -0,0 +1,76 @@
+#ifndef FIREBASE_OUTBOX_H
+#define FIREBASE_OUTBOX_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <Firebase_ESP_Client.h>
+#ifndef ARDUINO_ARCH_ESP32
+#include <mutex>
+#endif
+#include "config.h"
+#include "FlashLog.h"
+
+// Corps d'un lot : OUTBOX_BATCH entrées "epoch":{temp,light,led}
+#define OUTBOX_BODY_SIZE 3072
+
+struct OutboxStats {
+    uint32_t depth;          // échantillons journalisés non livrés
+    float drainRate;         // échantillons/s sur la dernière fenêtre
+    unsigned long delivered;
+    unsigned long batches;
+    unsigned long failed;
+};
+
+// ========================================
+// FILE D'ENVOI PERSISTANTE
+// ========================================
+// Pas de copie des données : la file est la fin du journal flash, après
+// le curseur de livraison. drain() est appelé par la tâche uploader (même
+// FirebaseData, même cœur) ; recorded() par la tâche qui journalise.
+// Livraison au moins une fois : après une coupure, au plus
+// OUTBOX_SAVE_INTERVAL d'échantillons sont renvoyés, sous la même clé.
+class FirebaseOutbox {
+private:
+    FlashLog* _log;
+    FS* _fs;
+    uint32_t _cursor;          // horodatage du dernier échantillon livré
+    uint32_t _depth;
+    unsigned long _lastDrain;  // millis() du dernier lot tenté
+    unsigned long _savedAt;
+    bool _backlog;             // dernier lot plein : la suite part sans attendre
+
+    unsigned long _delivered;
+    unsigned long _batches;
+    unsigned long _failed;
+    unsigned long _windowStart;
+    unsigned long _windowCount;
+    float _drainRate;
+
+    char _body[OUTBOX_BODY_SIZE];
+
+#ifdef ARDUINO_ARCH_ESP32
+    portMUX_TYPE _mux;
+#else
+    std::mutex _mutex;
+#endif
+    void lock();
+    void unlock();
+
+    void saveCursor();
+
+public:
+    FirebaseOutbox(FlashLog* log, FS* fs);
+
+    // Après FlashLog::begin() : relit le curseur et compte l'arriéré
+    bool begin();
+    void recorded();
+
+    // Envoie le lot suivant si le rythme et le lien le permettent ;
+    // retourne true si un envoi a été tenté
+    bool drain(FirebaseData* fbdo);
+
+    OutboxStats getStats();
+    uint32_t cursor();
+};
+
+#endif
@@ -0,0 +1,201 @@
+#include "FirebaseUploader.h"
+#include <ArduinoJson.h>
+#include "Logger.h"
+
+FirebaseUploader::FirebaseUploader(FirebaseData* fbdo)
+    : _running(false), _ready(false), _sent(0), _failed(0), _coalesced(0), _rejected(0), _lastLatency(0) {
+    _fbdo = fbdo;
+    _head = 0;
+    _count = 0;
+    _body[0] = '\0';
+    _monitor = NULL;
+    _outbox = NULL;
+    _policy = NULL;
+
+#ifdef ARDUINO_ARCH_ESP32
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+    _task = NULL;
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void FirebaseUploader::lock() { portENTER_CRITICAL(&_mux); }
+void FirebaseUploader::unlock() { portEXIT_CRITICAL(&_mux); }
+#else
+void FirebaseUploader::lock() { _mutex.lock(); }
+void FirebaseUploader::unlock() { _mutex.unlock(); }
+#endif
+
+// ========================================
+// DÉMARRAGE / ARRÊT DE LA TÂCHE
+// ========================================
+void FirebaseUploader::begin() {
+    if (_running) return;
+    _running = true;
+
+#ifdef ARDUINO_ARCH_ESP32
+    // Pile large : la session TLS du client Firebase vit dans cette tâche
+    xTaskCreatePinnedToCore(taskEntry, "uploader", 8192, this, 1, &_task, CORE_NETWORK);
+#else
+    _thread = std::thread([this]() { run(); });
+#endif
+}
+
+// À appeler avant begin() : la tâche s'enregistre au démarrage
+void FirebaseUploader::setMonitor(TaskMonitor* monitor) {
+    _monitor = monitor;
+}
+
+// Même tâche, même FirebaseData : aucun appel RTDB concurrent
+void FirebaseUploader::setOutbox(FirebaseOutbox* outbox) {
+    _outbox = outbox;
+}
+
+// Sans politique : les sept chemins à chaque envoi
+void FirebaseUploader::setPolicy(TelemetryPolicy* policy) {
+    _policy = policy;
+}
+
+void FirebaseUploader::stop() {
+    if (!_running) return;
+    _running = false;
+
+#ifdef ARDUINO_ARCH_ESP32
+    // La tâche se termine d'elle-même après l'envoi en cours
+    _task = NULL;
+#else
+    if (_thread.joinable()) _thread.join();
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void FirebaseUploader::taskEntry(void* arg) {
+    static_cast<FirebaseUploader*>(arg)->run();
+    vTaskDelete(NULL);
+}
+#endif
+
+void FirebaseUploader::run() {
+    int monitorId = _monitor ? _monitor->registerCurrentTask("uploader", CORE_NETWORK) : -1;
+    while (_running) {
+        unsigned long start = micros();
+        refreshReady();
+        bool sent = uploadPending();
+        if (_outbox && _outbox->drain(_fbdo)) sent = true;
+        if (_monitor) _monitor->addBusy(monitorId, micros() - start);
+        if (!sent) {
+            delay(UPLOAD_POLL_INTERVAL);
+        }
+    }
+    if (_monitor) _monitor->detach(monitorId);
+}
+
+// ========================================
+// ÉTAT DU LIEN
+// ========================================
+// Firebase.ready() relu à chaque tour de la tâche, même sans envoi
+bool FirebaseUploader::refreshReady() {
+    bool ready = Firebase.ready();
+    _ready = ready;
+    return ready;
+}
+
+// Dernier état vu par la tâche : aucun appel Firebase hors de celle-ci
+bool FirebaseUploader::isReady() {
+    return _ready;
+}
+
+// ========================================
+// FILE BORNÉE
+// ========================================
+bool FirebaseUploader::submit(const TelemetryRecord& record) {
+    lock();
+    if (_count >= UPLOAD_QUEUE_SIZE) {
+        unlock();
+        _rejected++;
+        return false;
+    }
+    _queue[(_head + _count) % UPLOAD_QUEUE_SIZE] = record;
+    _count++;
+    unlock();
+    return true;
+}
+
+size_t FirebaseUploader::pending() {
+    lock();
+    size_t count = _count;
+    unlock();
+    return count;
+}
+
+// ========================================
+// ENVOI
+// ========================================
+// Fusionne la file en un seul enregistrement et l'envoie. Retourne false
+// s'il n'y avait rien à envoyer.
+bool FirebaseUploader::uploadPending() {
+    TelemetryRecord latest;
+
+    lock();
+    size_t count = _count;
+    if (count > 0) {
+        latest = _queue[(_head + count - 1) % UPLOAD_QUEUE_SIZE];
+        _head = (_head + count) % UPLOAD_QUEUE_SIZE;
+        _count = 0;
+    }
+    unlock();
+
+    if (count == 0) return false;
+    _coalesced += count - 1;
+
+    // Comparé à ce que Firebase a acquitté, pas au dernier enregistrement
+    unsigned long now = millis();
+    unsigned int fields = _policy ? _policy->select(latest, now) : TELEMETRY_ALL_FIELDS;
+    if (fields == 0) return false;
+
+    if (!refreshReady()) {
+        _failed++;
+        return true;
+    }
+
+    buildBody(latest, fields);
+    FirebaseJson json;
+    json.setJsonData(_body);
+
+    unsigned long start = millis();
+    bool ok = Firebase.RTDB.updateNodeSilent(_fbdo, "/", &json);
+    _lastLatency = millis() - start;
+
+    if (ok) {
+        _sent++;
+        if (_policy) _policy->commit(latest, fields, now);
+    } else {
+        _failed++;
+        LOG_EVERY(LOG_LEVEL_WARN, 10000, "Firebase: %s", _fbdo->errorReason().c_str());
+    }
+    return true;
+}
+
+size_t FirebaseUploader::buildBody(const TelemetryRecord& record, unsigned int fields) {
+    StaticJsonDocument<256> doc;
+
+    if (fields & TELEMETRY_BIT(TELEMETRY_TEMPERATURE)) doc["sensors/temperature"] = record.temperature;
+    if (fields & TELEMETRY_BIT(TELEMETRY_LIGHT_RAW)) doc["sensors/lightRaw"] = record.lightRaw;
+    if (fields & TELEMETRY_BIT(TELEMETRY_LIGHT_PERCENT)) doc["sensors/lightPercent"] = record.lightPercent;
+    if (fields & TELEMETRY_BIT(TELEMETRY_LED)) doc["actuators/led"] = record.led;
+    if (fields & TELEMETRY_BIT(TELEMETRY_MODE)) doc["settings/mode"] = (const char*)record.mode;
+    if (fields & TELEMETRY_BIT(TELEMETRY_AUTO_MODE)) doc["settings/autoMode"] = record.autoMode;
+    // Horodatage serveur, comme setTimestamp() : date du dernier rapport
+    doc["sensors/lastUpdate"][".sv"] = "timestamp";
+
+    return serializeJson(doc, _body, sizeof(_body));
+}
+
+// ========================================
+// STATISTIQUES
+// ========================================
+unsigned long FirebaseUploader::getSent() { return _sent; }
+unsigned long FirebaseUploader::getFailed() { return _failed; }
+unsigned long FirebaseUploader::getCoalesced() { return _coalesced; }
+unsigned long FirebaseUploader::getRejected() { return _rejected; }
+unsigned long FirebaseUploader::getLastLatency() { return _lastLatency; }
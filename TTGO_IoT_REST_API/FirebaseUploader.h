@@ -0,0 +1,90 @@
+#ifndef FIREBASE_UPLOADER_H
+#define FIREBASE_UPLOADER_H
+
+#include <Arduino.h>
+#include <Firebase_ESP_Client.h>
+#include <atomic>
+#ifndef ARDUINO_ARCH_ESP32
+#include <mutex>
+#include <thread>
+#endif
+#include "config.h"
+#include "TaskMonitor.h"
+#include "FirebaseOutbox.h"
+#include "TelemetryPolicy.h"
+
+// Corps JSON d'une mise à jour multi-chemins (7 champs)
+#define UPLOAD_BODY_SIZE 256
+
+// ========================================
+// ENVOI FIREBASE EN TÂCHE DE FOND
+// ========================================
+// loop() dépose un enregistrement dans une file bornée et repart aussitôt.
+// La tâche d'envoi vide la file, fusionne les enregistrements en attente
+// (seul le plus récent compte pour un miroir d'état) et les envoie en un
+// seul updateNode multi-chemins : un aller-retour HTTP au lieu de sept.
+// Avec une politique (setPolicy), seuls les champs qui ont bougé partent ;
+// aucun envoi si rien n'a changé.
+// File pleine = lien trop lent : submit() refuse, l'appelant est prévenu.
+// La série temporelle passe par la file persistante (setOutbox), vidée
+// par la même tâche entre deux miroirs d'état.
+// Tous les appels Firebase.* (ready() compris, qui rafraîchit le jeton) se
+// font dans cette tâche ; les autres lisent l'état du lien via isReady().
+class FirebaseUploader {
+private:
+    FirebaseData* _fbdo;
+
+    TelemetryRecord _queue[UPLOAD_QUEUE_SIZE];
+    size_t _head;     // plus ancien enregistrement
+    size_t _count;
+
+    char _body[UPLOAD_BODY_SIZE];
+
+    std::atomic<bool> _running;
+    std::atomic<bool> _ready;
+    TaskMonitor* _monitor;
+    FirebaseOutbox* _outbox;
+    TelemetryPolicy* _policy;
+    std::atomic<unsigned long> _sent;
+    std::atomic<unsigned long> _failed;
+    std::atomic<unsigned long> _coalesced;
+    std::atomic<unsigned long> _rejected;
+    std::atomic<unsigned long> _lastLatency;
+
+    size_t buildBody(const TelemetryRecord& record, unsigned int fields);
+    bool refreshReady();
+    void run();
+
+#ifdef ARDUINO_ARCH_ESP32
+    portMUX_TYPE _mux;
+    TaskHandle_t _task;
+    static void taskEntry(void* arg);
+#else
+    std::mutex _mutex;
+    std::thread _thread;
+#endif
+
+    void lock();
+    void unlock();
+
+public:
+    FirebaseUploader(FirebaseData* fbdo);
+
+    void setMonitor(TaskMonitor* monitor);
+    void setOutbox(FirebaseOutbox* outbox);
+    void setPolicy(TelemetryPolicy* policy);
+    void begin();
+    void stop();
+    bool submit(const TelemetryRecord& record);
+    bool uploadPending();
+
+    bool isReady();
+    size_t pending();
+    unsigned long getSent();
+    unsigned long getFailed();
+    unsigned long getCoalesced();
+    unsigned long getRejected();
+    unsigned long getLastLatency();
+};
+
+#endif
@@ -0,0 +1,379 @@
+#include "FlashLog.h"
+#include "SensorHistory.h"
+#include "Logger.h"
+
+#define FLASHLOG_MAGIC 0xA5
+#define FLASHLOG_PAYLOAD_MAX (FLASHLOG_PAGE_SIZE - FLASHLOG_HEADER_SIZE)
+// Écart max entre deux échantillons d'un même enregistrement (s)
+#define FLASHLOG_MAX_GAP 0xFFFF
+
+FlashLog::FlashLog(FS* fs) {
+    _fs = fs;
+    _first = 1;
+    _last = 1;
+    _segmentSize = 0;
+    memset(&_stats, 0, sizeof(_stats));
+    _pageLen = FLASHLOG_HEADER_SIZE;
+    _pageCount = 0;
+    _lastTime = 0;
+    _lastTemp = 0;
+    _lastLight = 0;
+#ifdef ARDUINO_ARCH_ESP32
+    _mutex = xSemaphoreCreateMutex();
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void FlashLog::lock() { xSemaphoreTake(_mutex, portMAX_DELAY); }
+void FlashLog::unlock() { xSemaphoreGive(_mutex); }
+#else
+void FlashLog::lock() { _mutex.lock(); }
+void FlashLog::unlock() { _mutex.unlock(); }
+#endif
+
+// ========================================
+// ENCODAGE
+// ========================================
+static size_t putVarint(uint8_t* out, uint32_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+// Retourne 0 si la varint dépasse la fin du tampon
+static size_t getVarint(const uint8_t* in, size_t len, uint32_t* value) {
+    uint32_t result = 0;
+    for (size_t n = 0; n < len && n < 5; n++) {
+        result |= (uint32_t)(in[n] & 0x7F) << (7 * n);
+        if (!(in[n] & 0x80)) {
+            *value = result;
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+static uint32_t zigzag(int32_t value) { return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31); }
+static int32_t unzigzag(uint32_t value) { return (int32_t)(value >> 1) ^ -(int32_t)(value & 1); }
+
+static void put32(uint8_t* out, uint32_t value) {
+    out[0] = value; out[1] = value >> 8; out[2] = value >> 16; out[3] = value >> 24;
+}
+
+static uint32_t get32(const uint8_t* in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// CRC32 IEEE, table de 16 entrées (64 octets de flash au lieu de 1 Ko)
+uint32_t FlashLog::crc32(const uint8_t* data, size_t len, uint32_t crc) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+// CRC de l'en-tête (hors champ CRC) et des données
+static bool checkRecord(const uint8_t* header, const uint8_t* payload) {
+    size_t len = header[2] | (header[3] << 8);
+    uint32_t crc = FlashLog::crc32(header, 8);
+    return FlashLog::crc32(payload, len, crc) == get32(header + 8);
+}
+
+static bool readHeader(File& file, uint8_t* header) {
+    if (file.read(header, FLASHLOG_HEADER_SIZE) != FLASHLOG_HEADER_SIZE) return false;
+    size_t len = header[2] | (header[3] << 8);
+    return header[0] == FLASHLOG_MAGIC && header[1] > 0 && len <= FLASHLOG_PAYLOAD_MAX;
+}
+
+// ========================================
+// SEGMENTS
+// ========================================
+void FlashLog::segmentPath(uint32_t id, char* path, size_t size) {
+    snprintf(path, size, FLASHLOG_DIR "/%08lx.log", (unsigned long)id);
+}
+
+// Nouveau segment courant ; les plus anciens au-delà du quota sont supprimés
+void FlashLog::openSegment(uint32_t id) {
+    char path[32];
+    _last = id;
+    _segmentSize = 0;
+    while (_last - _first + 1 > FLASHLOG_MAX_SEGMENTS) {
+        segmentPath(_first, path, sizeof(path));
+        File old = _fs->open(path, FILE_READ);
+        if (old) {
+            _stats.bytes -= old.size();
+            old.close();
+            _fs->remove(path);
+        }
+        _first++;
+    }
+}
+
+// Nombre d'enregistrements valides en tête du segment
+uint32_t FlashLog::scanSegment(uint32_t id, size_t* validBytes) {
+    char path[32];
+    segmentPath(id, path, sizeof(path));
+    *validBytes = 0;
+    File file = _fs->open(path, FILE_READ);
+    if (!file) return 0;
+
+    uint8_t header[FLASHLOG_HEADER_SIZE];
+    uint8_t payload[FLASHLOG_PAYLOAD_MAX];
+    uint32_t records = 0;
+    while (readHeader(file, header)) {
+        size_t len = header[2] | (header[3] << 8);
+        if (file.read(payload, len) != len || !checkRecord(header, payload)) break;
+        *validBytes += FLASHLOG_HEADER_SIZE + len;
+        records++;
+    }
+    file.close();
+    return records;
+}
+
+bool FlashLog::firstTime(uint32_t id, uint32_t* time) {
+    char path[32];
+    segmentPath(id, path, sizeof(path));
+    File file = _fs->open(path, FILE_READ);
+    uint8_t header[FLASHLOG_HEADER_SIZE];
+    if (!file || !readHeader(file, header)) return false;
+    *time = get32(header + 4);
+    return true;
+}
+
+bool FlashLog::begin() {
+    if (!_fs->exists(FLASHLOG_DIR) && !_fs->mkdir(FLASHLOG_DIR)) {
+        LOG_ERROR("FlashLog: impossible de creer " FLASHLOG_DIR);
+        return false;
+    }
+    File dir = _fs->open(FLASHLOG_DIR, FILE_READ);
+    if (!dir || !dir.isDirectory()) return false;
+
+    lock();
+    bool found = false;
+    _stats.bytes = 0;
+    File entry;
+    while ((entry = dir.openNextFile())) {
+        // name() : nom seul (cœur 2.x) ou chemin complet (cœur 1.x)
+        const char* name = strrchr(entry.name(), '/');
+        name = name ? name + 1 : entry.name();
+        char* end;
+        unsigned long id = strtoul(name, &end, 16);
+        if (end != name + 8 || strcmp(end, ".log") != 0 || id == 0) continue;
+        if (!found || id < _first) _first = id;
+        if (!found || id > _last) _last = id;
+        found = true;
+        _stats.bytes += entry.size();
+    }
+    dir.close();
+
+    if (found) {
+        size_t valid;
+        uint32_t records = scanSegment(_last, &valid);
+        char path[32];
+        segmentPath(_last, path, sizeof(path));
+        File current = _fs->open(path, FILE_READ);
+        _segmentSize = current ? current.size() : 0;
+        current.close();
+
+        // Queue tronquée par une coupure : segment figé, la suite ailleurs
+        if (valid < _segmentSize) {
+            _stats.corrupt++;
+            LOG_WARN("FlashLog: %u octets invalides en fin de segment %lu, ecartes",
+                     (unsigned)(_segmentSize - valid), (unsigned long)_last);
+            openSegment(_last + 1);
+        }
+        LOG_INFO("FlashLog: segments %lu..%lu, %lu octets, %lu enregistrements dans le courant",
+                 (unsigned long)_first, (unsigned long)_last, (unsigned long)_stats.bytes,
+                 (unsigned long)records);
+    }
+    unlock();
+    return true;
+}
+
+// ========================================
+// ÉCRITURE
+// ========================================
+// Une page = un enregistrement, écrit d'un seul appel
+void FlashLog::flushLocked() {
+    if (_pageCount == 0) return;
+
+    size_t len = _pageLen - FLASHLOG_HEADER_SIZE;
+    _page[0] = FLASHLOG_MAGIC;
+    _page[1] = _pageCount;
+    _page[2] = len;
+    _page[3] = len >> 8;
+    // _page[4..7] : horodatage de base, posé au premier échantillon
+    put32(_page + 8, crc32(_page + FLASHLOG_HEADER_SIZE, len, crc32(_page, 8)));
+
+    if (_segmentSize > 0 && _segmentSize + _pageLen > FLASHLOG_SEGMENT_SIZE) {
+        openSegment(_last + 1);
+    }
+
+    char path[32];
+    segmentPath(_last, path, sizeof(path));
+    File file = _fs->open(path, FILE_APPEND, true);
+    size_t written = file ? file.write(_page, _pageLen) : 0;
+    file.close();
+
+    if (written != _pageLen) {
+        LOG_ERROR("FlashLog: ecriture %s echouee (%u/%u octets)", path,
+                  (unsigned)written, (unsigned)_pageLen);
+        // Enregistrement partiel : invalide par CRC, on repart sur un segment neuf
+        if (written > 0) openSegment(_last + 1);
+    } else {
+        _segmentSize += written;
+        _stats.bytes += written;
+        _stats.flushes++;
+    }
+    _stats.bytesWritten += written;
+
+    _pageLen = FLASHLOG_HEADER_SIZE;
+    _pageCount = 0;
+}
+
+void FlashLog::record(float temperature, int lightRaw, bool led, uint32_t time) {
+    int16_t temp = SensorHistory::centiTemp(temperature);
+    uint16_t light = SensorHistory::centiLight(lightRaw);
+
+    lock();
+    // Horloge reculée ou long trou : nouvel enregistrement (deltas positifs et courts)
+    if (_pageCount > 0 && (time < _lastTime || time - _lastTime > FLASHLOG_MAX_GAP)) {
+        flushLocked();
+    }
+    if (_pageCount == 0) {
+        put32(_page + 4, time);
+        _lastTime = time;
+        _lastTemp = 0;
+        _lastLight = 0;
+    }
+
+    uint8_t* out = _page + _pageLen;
+    size_t n = putVarint(out, ((time - _lastTime) << 1) | (led ? 1 : 0));
+    n += putVarint(out + n, zigzag((int32_t)temp - _lastTemp));
+    n += putVarint(out + n, zigzag((int32_t)light - _lastLight));
+    _pageLen += n;
+    _pageCount++;
+    _lastTime = time;
+    _lastTemp = temp;
+    _lastLight = light;
+
+    // Page pleine : écrite tout de suite plutôt qu'au prochain échantillon
+    if (_pageLen + FLASHLOG_MAX_SAMPLE > FLASHLOG_PAGE_SIZE || _pageCount == 255) {
+        flushLocked();
+    }
+    unlock();
+}
+
+void FlashLog::flush() {
+    lock();
+    flushLocked();
+    unlock();
+}
+
+// ========================================
+// LECTURE
+// ========================================
+size_t FlashLog::decode(const uint8_t* page, size_t len, uint8_t count, uint32_t base,
+                        uint32_t from, uint32_t to, size_t limit,
+                        std::function<void(const LogSample&)>& emit) {
+    LogSample sample;
+    sample.time = base;
+    int32_t temp = 0;
+    int32_t light = 0;
+    size_t pos = 0;
+    size_t emitted = 0;
+
+    for (uint8_t i = 0; i < count && emitted < limit; i++) {
+        uint32_t head, dtemp, dlight;
+        size_t n = getVarint(page + pos, len - pos, &head);
+        if (!n) break;
+        pos += n;
+        if (!(n = getVarint(page + pos, len - pos, &dtemp))) break;
+        pos += n;
+        if (!(n = getVarint(page + pos, len - pos, &dlight))) break;
+        pos += n;
+
+        sample.time += head >> 1;
+        sample.led = head & 1;
+        temp += unzigzag(dtemp);
+        light += unzigzag(dlight);
+        if (sample.time > to) break;
+        if (sample.time < from) continue;
+        sample.temp = (int16_t)temp;
+        sample.light = (uint16_t)light;
+        emit(sample);
+        emitted++;
+    }
+    return emitted;
+}
+
+size_t FlashLog::query(uint32_t from, uint32_t to, size_t limit,
+                       std::function<void(const LogSample&)> emit) {
+    // Instantané : segments, taille lue du courant (les ajouts suivants sont
+    // dans la copie de la page ou ignorés) et page en attente
+    uint8_t pending[FLASHLOG_PAGE_SIZE];
+    lock();
+    uint32_t first = _first;
+    uint32_t last = _last;
+    size_t lastBytes = _segmentSize;
+    size_t pendingLen = _pageLen;
+    uint8_t pendingCount = _pageCount;
+    memcpy(pending, _page, _pageLen);
+    unlock();
+
+    size_t emitted = 0;
+    bool done = false;
+    uint8_t header[FLASHLOG_HEADER_SIZE];
+    uint8_t payload[FLASHLOG_PAYLOAD_MAX];
+
+    for (uint32_t id = first; id <= last && !done && emitted < limit; id++) {
+        // Segment entièrement antérieur à from : le suivant commence avant
+        uint32_t nextStart;
+        if (id < last && firstTime(id + 1, &nextStart) && nextStart < from) continue;
+
+        char path[32];
+        segmentPath(id, path, sizeof(path));
+        File file = _fs->open(path, FILE_READ);
+        if (!file) continue;   // supprimé par une rotation entre-temps
+
+        size_t offset = 0;
+        while (emitted < limit && (id < last || offset < lastBytes) && readHeader(file, header)) {
+            size_t len = header[2] | (header[3] << 8);
+            if (file.read(payload, len) != len || !checkRecord(header, payload)) break;
+            offset += FLASHLOG_HEADER_SIZE + len;
+
+            uint32_t base = get32(header + 4);
+            if (base > to) {
+                done = true;
+                break;
+            }
+            emitted += decode(payload, len, header[1], base, from, to, limit - emitted, emit);
+        }
+        file.close();
+    }
+
+    if (!done && emitted < limit && pendingCount > 0) {
+        emitted += decode(pending + FLASHLOG_HEADER_SIZE, pendingLen - FLASHLOG_HEADER_SIZE,
+                          pendingCount, get32(pending + 4), from, to, limit - emitted, emit);
+    }
+    return emitted;
+}
+
+FlashLogStats FlashLog::getStats() {
+    lock();
+    FlashLogStats stats = _stats;
+    stats.segments = _last - _first + 1;
+    stats.pending = _pageCount;
+    unlock();
+    return stats;
+}
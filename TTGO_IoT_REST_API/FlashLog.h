@@ -0,0 +1,95 @@
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <functional>
+#ifndef ARDUINO_ARCH_ESP32
+#include <mutex>
+#endif
+#include "config.h"
+
+// En-tête d'enregistrement : magic, nombre d'échantillons, longueur utile,
+// horodatage de base, CRC32 (en-tête + données)
+#define FLASHLOG_HEADER_SIZE 12
+// Pire cas encodé d'un échantillon : 3 varints de 3 octets
+#define FLASHLOG_MAX_SAMPLE 9
+
+struct LogSample {
+    uint32_t time;     // secondes epoch
+    int16_t temp;      // centièmes de °C
+    uint16_t light;    // centièmes de %
+    bool led;
+};
+
+struct FlashLogStats {
+    uint32_t segments;
+    uint32_t bytes;          // occupés par les segments
+    uint32_t flushes;        // enregistrements écrits depuis le démarrage
+    uint32_t bytesWritten;   // octets écrits depuis le démarrage
+    uint32_t pending;        // échantillons en attente dans la page RAM
+    uint32_t corrupt;        // queues de segment invalides écartées
+};
+
+// ========================================
+// JOURNAL PERSISTANT DES MESURES
+// ========================================
+// Ajout seul, segments FLASHLOG_DIR/xxxxxxxx.log d'au plus
+// FLASHLOG_SEGMENT_SIZE octets, le plus ancien supprimé au-delà de
+// FLASHLOG_MAX_SEGMENTS. Les échantillons sont encodés en deltas varint
+// dans une page RAM ; la page pleine devient un enregistrement protégé par
+// CRC, écrit en une fois (une programmation au lieu d'une par échantillon).
+// Une coupure en cours d'écriture laisse une queue invalide : begin() la
+// détecte et ouvre un nouveau segment.
+class FlashLog {
+private:
+    FS* _fs;
+    uint32_t _first;          // numéros du plus ancien et du courant
+    uint32_t _last;
+    uint32_t _segmentSize;    // octets du segment courant
+    FlashLogStats _stats;
+
+    // Page en cours d'encodage
+    uint8_t _page[FLASHLOG_PAGE_SIZE];
+    size_t _pageLen;
+    uint8_t _pageCount;
+    uint32_t _lastTime;
+    int16_t _lastTemp;
+    uint16_t _lastLight;
+
+    // Verrou bloquant : record() peut écrire en flash
+#ifdef ARDUINO_ARCH_ESP32
+    SemaphoreHandle_t _mutex;
+#else
+    std::mutex _mutex;
+#endif
+    void lock();
+    void unlock();
+
+    void segmentPath(uint32_t id, char* path, size_t size);
+    void flushLocked();
+    void openSegment(uint32_t id);
+    uint32_t scanSegment(uint32_t id, size_t* validBytes);
+    bool firstTime(uint32_t id, uint32_t* time);
+    size_t decode(const uint8_t* page, size_t len, uint8_t count, uint32_t base,
+                  uint32_t from, uint32_t to, size_t limit,
+                  std::function<void(const LogSample&)>& emit);
+
+public:
+    FlashLog(FS* fs);
+
+    // Après LittleFS.begin() : retrouve les segments, écarte une queue corrompue
+    bool begin();
+    void record(float temperature, int lightRaw, bool led, uint32_t time);
+    void flush();
+
+    // Échantillons de [from, to] dans l'ordre, page RAM comprise, au plus
+    // limit ; la lecture des segments se fait hors verrou
+    size_t query(uint32_t from, uint32_t to, size_t limit,
+                 std::function<void(const LogSample&)> emit);
+
+    FlashLogStats getStats();
+    static uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0);
+};
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include <Arduino.h>
+#include <WebServer.h>   // HTTPMethod, CONTENT_LENGTH_UNKNOWN
+#include <functional>
+
+#define HTTP_CONTENT_CHUNK 512   // place minimale offerte à un producteur de corps
+
+// ========================================
+// INTERFACE SERVEUR HTTP
+// ========================================
+// Ce dont RestAPI a besoin, indépendamment du moteur : routes, lecture de
+// la requête en cours, écriture de la réponse. Les accesseurs de requête
+// ne sont valides que pendant l'appel du handler.
+class HttpServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    virtual ~HttpServer() {}
+
+    virtual void begin() = 0;
+    virtual void handleClient() = 0;
+
+    // uri doit rester valide (littéral) : seul le pointeur est conservé
+    virtual void on(const char* uri, HTTPMethod method, THandlerFunction handler) = 0;
+    virtual void onNotFound(THandlerFunction handler) = 0;
+    virtual void collectHeaders(const char* headerKeys[], size_t headerKeysCount) = 0;
+
+    // Requête en cours
+    virtual String uri() = 0;
+    // Chemin sans copie, valide pendant le handler
+    virtual const char* path() = 0;
+    virtual HTTPMethod method() = 0;
+    virtual bool hasArg(const String& name) = 0;
+    virtual String arg(const String& name) = 0;
+    virtual String header(const String& name) = 0;
+
+    // Réponse
+    virtual void sendHeader(const char* name, const char* value) = 0;
+    // Bloc d'en-têtes déjà formaté ("Nom: valeur\r\n"...), en flash. Par
+    // défaut découpé en sendHeader() ; SocketHttpServer le copie d'un bloc.
+    virtual void sendHeaders_P(PGM_P headers) {
+        while (*headers) {
+            const char* colon = strchr(headers, ':');
+            const char* end = strstr(headers, "\r\n");
+            if (!colon || !end || colon > end) return;
+            char name[48];
+            char value[96];
+            size_t nameLen = colon - headers;
+            size_t valueLen = end - colon - 2;
+            if (nameLen >= sizeof(name) || valueLen >= sizeof(value)) return;
+            memcpy(name, headers, nameLen);
+            name[nameLen] = '\0';
+            memcpy(value, colon + 2, valueLen);
+            value[valueLen] = '\0';
+            sendHeader(name, value);
+            headers = end + 2;
+        }
+    }
+    virtual void setContentLength(size_t contentLength) = 0;
+    virtual void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) = 0;
+    virtual void sendContent_P(PGM_P content, size_t contentLength) = 0;
+
+    void send(int code, const char* contentType = NULL, const char* content = "") {
+        send_P(code, contentType, content, strlen(content));
+    }
+    void sendContent(const char* content, size_t contentLength) {
+        sendContent_P(content, contentLength);
+    }
+    void sendContent(const char* content) {
+        sendContent_P(content, strlen(content));
+    }
+
+    // Corps produit au fil de l'envoi, après send() : producer remplit
+    // buffer (size >= HTTP_CONTENT_CHUNK) et retourne la longueur écrite,
+    // 0 en fin de corps ; son état (curseur, offset) vit dans la fonction.
+    // SocketHttpServer le rappelle quand la connexion peut prendre la suite,
+    // hors de toute requête : il n'appelle pas le serveur. Par défaut, appelé
+    // en boucle comme le reste du moteur synchrone.
+    typedef std::function<size_t(char* buffer, size_t size)> TContentProducer;
+    virtual void sendContentFrom(TContentProducer producer) {
+        char buffer[HTTP_CONTENT_CHUNK];
+        size_t n;
+        while ((n = producer(buffer, sizeof(buffer))) > 0) sendContent_P(buffer, n);
+        sendContent_P("", 0);
+    }
+
+    // Flux longue durée (SSE) : appelé par le handler, envoie l'en-tête
+    // sans longueur et sort la connexion du cycle requête/réponse. Le corps
+    // suit par sendContent() puis broadcast(). false si le moteur ne sait pas.
+    virtual bool beginStream(PGM_P contentType) { return false; }
+    // Mêmes octets vers tous les flux SSE, sans jamais attendre : un flux
+    // dont le tampon d'émission ne peut pas les prendre est fermé. Retourne
+    // le nombre de flux servis.
+    virtual int broadcast(const char* data, size_t len) { return 0; }
+    // Flux SSE et WebSocket ouverts
+    virtual int streamCount() { return 0; }
+
+    // WebSocket (RFC 6455) : le handler accepte la mise à niveau de la
+    // connexion courante et reçoit son numéro (-1 : refusée). Les messages
+    // arrivent ensuite par le handler onWebSocket(), hors de toute requête.
+    typedef std::function<void(int client, bool binary, const uint8_t* data, size_t len)> TWebSocketHandler;
+    virtual int beginWebSocket() { return -1; }
+    virtual void onWebSocket(TWebSocketHandler handler) {}
+    // Même règle que broadcast() : jamais d'attente, client lent fermé
+    virtual bool sendWebSocket(int client, bool binary, const uint8_t* data, size_t len) { return false; }
+    virtual int broadcastWebSocket(bool binary, const uint8_t* data, size_t len) { return 0; }
+
+    // Réponse différée (long-poll) : le handler garde la connexion courante
+    // ouverte sans répondre et reçoit son numéro (-1 : moteur incapable).
+    // La réponse s'écrit plus tard, hors requête, entre resumeResponse()
+    // (false si le client est parti) et endResponse().
+    virtual int deferResponse() { return -1; }
+    virtual bool resumeResponse(int client) { return false; }
+    virtual void endResponse() {}
+};
+
+// ========================================
+// MOTEUR WebServer (REPLI)
+// ========================================
+// Bibliothèque synchrone du core ESP32 : une connexion à la fois, une
+// requête par handleClient(), ni flux ni WebSocket
+class WebServerBackend : public HttpServer {
+private:
+    WebServer* _server;
+    String _path;   // uri() du core rend une copie : gardée pour path()
+
+public:
+    WebServerBackend(WebServer* server) : _server(server) {}
+
+    WebServer* server() { return _server; }
+
+    void begin() { _server->begin(); }
+    void handleClient() { _server->handleClient(); }
+
+    void on(const char* uri, HTTPMethod method, THandlerFunction handler) {
+        _server->on(uri, method, handler);
+    }
+    void onNotFound(THandlerFunction handler) { _server->onNotFound(handler); }
+    void collectHeaders(const char* headerKeys[], size_t headerKeysCount) {
+        _server->collectHeaders(headerKeys, headerKeysCount);
+    }
+
+    String uri() { return _server->uri(); }
+    const char* path() {
+        _path = _server->uri();
+        return _path.c_str();
+    }
+    HTTPMethod method() { return _server->method(); }
+    bool hasArg(const String& name) { return _server->hasArg(name); }
+    String arg(const String& name) { return _server->arg(name); }
+    String header(const String& name) { return _server->header(name); }
+
+    void sendHeader(const char* name, const char* value) { _server->sendHeader(name, value); }
+    void setContentLength(size_t contentLength) { _server->setContentLength(contentLength); }
+
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) {
+        // Corps vide : send() respecte setContentLength() (chunked) et un type NULL
+        if (contentLength == 0) {
+            _server->send(code, contentType, String(""));
+        } else {
+            _server->send_P(code, contentType, content, contentLength);
+        }
+    }
+    void sendContent_P(PGM_P content, size_t contentLength) {
+        _server->sendContent_P(content, contentLength);
+    }
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include "Logger.h"
+#include <stdarg.h>
+#include <string.h>
+
+#ifndef ARDUINO_ARCH_ESP32
+#include <mutex>
+#endif
+
+// ========================================
+// TAMPON CIRCULAIRE
+// ========================================
+#if LOG_BACKEND_RING
+static char ring[LOG_RING_SIZE];
+static size_t ringHead = 0;   // prochaine écriture
+static size_t ringTail = 0;   // prochaine lecture
+static unsigned long ringDropped = 0;
+
+// Plusieurs tâches peuvent loguer (sampler, loop)
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+#define RING_LOCK() portENTER_CRITICAL(&ringMux)
+#define RING_UNLOCK() portEXIT_CRITICAL(&ringMux)
+#else
+static std::mutex ringMutex;
+#define RING_LOCK() ringMutex.lock()
+#define RING_UNLOCK() ringMutex.unlock()
+#endif
+
+static void ringPush(const char* data, size_t len) {
+    RING_LOCK();
+    size_t used = (ringHead + LOG_RING_SIZE - ringTail) % LOG_RING_SIZE;
+    size_t space = LOG_RING_SIZE - 1 - used;
+    if (len > space) {
+        // Message entier ou rien : jamais de ligne tronquée
+        ringDropped++;
+        RING_UNLOCK();
+        return;
+    }
+    for (size_t i = 0; i < len; i++) {
+        ring[ringHead] = data[i];
+        ringHead = (ringHead + 1) % LOG_RING_SIZE;
+    }
+    RING_UNLOCK();
+}
+#endif
+
+// ========================================
+// API
+// ========================================
+void Logger::write(uint8_t level, const char* fmt, ...) {
+    char line[160];
+    size_t len = 0;
+
+    if (level == LOG_LEVEL_ERROR) len = strlen(strcpy(line, "[ERR] "));
+    else if (level == LOG_LEVEL_WARN) len = strlen(strcpy(line, "[WARN] "));
+    else if (level == LOG_LEVEL_DEBUG) len = strlen(strcpy(line, "[DBG] "));
+
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(line + len, sizeof(line) - len - 1, fmt, args);
+    va_end(args);
+    if (n < 0) return;
+
+    len += (size_t)n;
+    if (len > sizeof(line) - 2) len = sizeof(line) - 2;
+    line[len++] = '\n';
+    line[len] = '\0';
+
+#if LOG_BACKEND_RING
+    ringPush(line, len);
+#else
+    Serial.print(line);
+#endif
+}
+
+// Vide le tampon sans bloquer : seulement ce que l'UART accepte maintenant
+void Logger::flush() {
+#if LOG_BACKEND_RING
+    char chunk[64];
+    while (true) {
+        size_t room = Serial.availableForWrite();
+        if (room == 0) return;
+        if (room > sizeof(chunk)) room = sizeof(chunk);
+
+        size_t n = 0;
+        RING_LOCK();
+        while (n < room && ringTail != ringHead) {
+            chunk[n++] = ring[ringTail];
+            ringTail = (ringTail + 1) % LOG_RING_SIZE;
+        }
+        RING_UNLOCK();
+
+        if (n == 0) return;
+        Serial.write((const uint8_t*)chunk, n);
+    }
+#endif
+}
+
+bool Logger::every(unsigned long* last, unsigned long intervalMs) {
+    unsigned long now = millis();
+    if (*last != 0 && (long)(now - *last) < (long)intervalMs) return false;
+    *last = now ? now : 1;
+    return true;
+}
+
+unsigned long Logger::dropped() {
+#if LOG_BACKEND_RING
+    return ringDropped;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,78 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ========================================
+// NIVEAUX DE LOG
+// ========================================
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+// Niveau de compilation : tout appel au-dessus disparaît du binaire
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// 1 = messages mis en file dans un tampon circulaire, vidé par Logger::flush()
+// sans jamais attendre l'UART ; 0 = écriture directe sur Serial
+#ifndef LOG_BACKEND_RING
+#define LOG_BACKEND_RING 1
+#endif
+
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 1024
+#endif
+
+class Logger {
+public:
+    static void write(uint8_t level, const char* fmt, ...)
+        __attribute__((format(printf, 2, 3)));
+    static void flush();
+    static bool every(unsigned long* last, unsigned long intervalMs);
+    static unsigned long dropped();
+};
+
+#define LOG_NOOP() do {} while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Logger::write(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) LOG_NOOP()
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) Logger::write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) LOG_NOOP()
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) LOG_NOOP()
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) LOG_NOOP()
+#endif
+
+// Limitation de débit : au plus un message toutes les intervalMs par site d'appel.
+// Le test de niveau est constant, le bloc entier disparaît sous LOG_LEVEL.
+#define LOG_EVERY(level, intervalMs, ...)                          \
+    do {                                                           \
+        if ((level) <= LOG_LEVEL) {                                \
+            static unsigned long _logLast = 0;                     \
+            if (Logger::every(&_logLast, (intervalMs))) {          \
+                Logger::write((level), __VA_ARGS__);               \
+            }                                                      \
+        }                                                          \
+    } while (0)
+
+#endif
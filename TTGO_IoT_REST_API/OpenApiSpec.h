@@ -0,0 +1,277 @@
+// Généré par api-docs/gen_openapi.py depuis api-docs/openapi.json
+// Ne pas éditer : modifier openapi.json puis relancer le script.
+#ifndef OPENAPI_SPEC_H
+#define OPENAPI_SPEC_H
+
+#include <Arduino.h>
+
+#define OPENAPI_SPEC_HASH "37dce096"
+#define OPENAPI_HEAD_LEN 313
+#define OPENAPI_TAIL_LEN 8030
+#define OPENAPI_GZ_LEN 2653
+
+// Spécification jusqu'à l'URL du serveur
+static const char OPENAPI_HEAD[] PROGMEM =
+    "{\"openapi\":\"3.0.0\",\"info\":{\"title\":\"TTGO IoT REST API\",\"version\":\"1.0.0\",\"description\":\"API REST"
+    " pour controle ESP32 TTGO avec capteurs temperature et lumiere. Les reponses JSON existent aussi"
+    " en CBOR ou MessagePack : en-tete Accept: application/cbor ou application/msgpack (JSON par defa"
+    "ut)\"},\"servers\":[{\"url\":\"";
+
+// Suite de la spécification après l'URL du serveur
+static const char OPENAPI_TAIL[] PROGMEM =
+    "\",\"description\":\"Serveur ESP32 local\"}],\"paths\":{\"/sensors\":{\"get\":{\"summary\":\"Liste tous les ca"
+    "pteurs\",\"responses\":{\"200\":{\"description\":\"Liste des capteurs disponibles\"}}}},\"/sensors/tempera"
+    "ture\":{\"get\":{\"summary\":\"Lecture temperature\",\"responses\":{\"200\":{\"description\":\"Temperature en "
+    "Celsius\"}}}},\"/sensors/light\":{\"get\":{\"summary\":\"Lecture lumiere\",\"responses\":{\"200\":{\"descripti"
+    "on\":\"Niveau de lumiere (raw et pourcentage)\"}}}},\"/led/on\":{\"post\":{\"summary\":\"Allumer la LED\",\""
+    "responses\":{\"200\":{\"description\":\"LED allumee\"}}}},\"/led/off\":{\"post\":{\"summary\":\"Eteindre la LE"
+    "D\",\"responses\":{\"200\":{\"description\":\"LED eteinte\"}}}},\"/led/toggle\":{\"post\":{\"summary\":\"Bascule"
+    "r l'etat de la LED\",\"responses\":{\"200\":{\"description\":\"LED basculee\"}}}},\"/threshold/set\":{\"post"
+    "\":{\"summary\":\"Definir les seuils\",\"parameters\":[{\"name\":\"temp\",\"in\":\"query\",\"required\":true,\"sch"
+    "ema\":{\"type\":\"number\"},\"description\":\"Seuil de temperature en Celsius\"},{\"name\":\"light\",\"in\":\"qu"
+    "ery\",\"required\":true,\"schema\":{\"type\":\"integer\"},\"description\":\"Seuil de lumiere en pourcentage\""
+    "}],\"responses\":{\"200\":{\"description\":\"Seuils definis\"},\"400\":{\"description\":\"Parametres manquant"
+    "s\"}}}},\"/threshold\":{\"get\":{\"summary\":\"Obtenir les seuils actuels\",\"parameters\":[{\"name\":\"wait_f"
+    "or_change\",\"in\":\"query\",\"required\":false,\"schema\":{\"type\":\"integer\",\"minimum\":0,\"maximum\":30000}"
+    ",\"description\":\"Long-poll : reponse retenue jusqu'au prochain changement de version ou au delai "
+    "(ms, plafond 30000)\"},{\"name\":\"If-None-Match\",\"in\":\"header\",\"required\":false,\"schema\":{\"type\":\"s"
+    "tring\"},\"description\":\"ETag d'une reponse precedente : 304 si la version n'a pas bouge\"}],\"respo"
+    "nses\":{\"200\":{\"description\":\"Seuils et mode actuel\"},\"304\":{\"description\":\"Version inchangee (If"
+    "-None-Match) : pas de corps\"},\"400\":{\"description\":\"wait_for_change invalide\"}}}},\"/mode/set\":{\""
+    "post\":{\"summary\":\"Definir le mode de fonctionnement\",\"parameters\":[{\"name\":\"mode\",\"in\":\"query\",\""
+    "required\":true,\"schema\":{\"type\":\"string\",\"enum\":[\"MANUEL\",\"AUTO-TEMP\",\"AUTO-LIGHT\"]},\"descriptio"
+    "n\":\"Mode: MANUEL, AUTO-TEMP ou AUTO-LIGHT\"}],\"responses\":{\"200\":{\"description\":\"Mode defini\"},\"4"
+    "00\":{\"description\":\"Mode invalide\"}}}},\"/batch\":{\"post\":{\"summary\":\"Appliquer plusieurs operatio"
+    "ns d'un bloc : toutes validees puis appliquees ensemble, aucune si une seule est invalide\",\"requ"
+    "estBody\":{\"required\":true,\"content\":{\"application/json\":{\"schema\":{\"type\":\"array\",\"minItems\":1,\""
+    "maxItems\":8,\"items\":{\"type\":\"object\",\"description\":\"Meme format que les commandes texte /ws, san"
+    "s seq : {cmd: led, state: on|off|toggle}, {cmd: mode, mode: MANUEL|AUTO-TEMP|AUTO-LIGHT}, {cmd: "
+    "threshold, temp, light (0-100)}, {cmd: state}\"}},\"example\":[{\"cmd\":\"threshold\",\"temp\":28,\"light\""
+    ":40},{\"cmd\":\"mode\",\"mode\":\"AUTO-TEMP\"},{\"cmd\":\"led\",\"state\":\"on\"}]}}},\"responses\":{\"200\":{\"descr"
+    "iption\":\"Operations appliquees ; etat complet (applied, led_state, mode, auto_mode, temp_thresho"
+    "ld, light_threshold)\"},\"400\":{\"description\":\"Corps invalide, 0 ou plus de 8 operations, ou opera"
+    "tion invalide (index, message) : rien n'est applique\"}}}},\"/status\":{\"get\":{\"summary\":\"Status co"
+    "mplet du systeme\",\"parameters\":[{\"name\":\"wait_for_change\",\"in\":\"query\",\"required\":false,\"schema\""
+    ":{\"type\":\"integer\",\"minimum\":0,\"maximum\":30000},\"description\":\"Long-poll : reponse retenue jusqu"
+    "'au prochain changement de version ou au delai (ms, plafond 30000)\"},{\"name\":\"If-None-Match\",\"in"
+    "\":\"header\",\"required\":false,\"schema\":{\"type\":\"string\"},\"description\":\"ETag d'une reponse precede"
+    "nte : 304 si la version n'a pas bouge\"}],\"responses\":{\"200\":{\"description\":\"Capteurs, actuateurs"
+    " et parametres ; objet outbox (depth, drain_rate, delivered, failed) si l'envoi differe est acti"
+    "f\"},\"304\":{\"description\":\"Version inchangee (If-None-Match) : pas de corps\"},\"400\":{\"description"
+    "\":\"wait_for_change invalide\"}}}},\"/system\":{\"get\":{\"summary\":\"Taches FreeRTOS : coeur, pile libr"
+    "e minimale (octets), part de CPU\",\"responses\":{\"200\":{\"description\":\"Liste des taches (stack_fre"
+    "e null si non mesurable)\"}}}},\"/history\":{\"get\":{\"summary\":\"Historique en RAM agrege par tranche"
+    "s (min/max/moyenne), envoye en chunked\",\"parameters\":[{\"name\":\"since\",\"in\":\"query\",\"required\":fa"
+    "lse,\"schema\":{\"type\":\"integer\",\"minimum\":0},\"description\":\"millis() de reference : seuls les ech"
+    "antillons posterieurs sont agreges (defaut 0)\"},{\"name\":\"step\",\"in\":\"query\",\"required\":false,\"sc"
+    "hema\":{\"type\":\"integer\",\"minimum\":1},\"description\":\"Largeur d'une tranche en ms (defaut : interv"
+    "alle d'enregistrement)\"}],\"responses\":{\"200\":{\"description\":\"data : lignes [t, n, temp_min, temp"
+    "_max, temp_avg, light_min, light_max, light_avg, led_on_percent]\"},\"400\":{\"description\":\"since o"
+    "u step invalide\"},\"503\":{\"description\":\"Historique non active\"}}}},\"/history/flash\":{\"get\":{\"sum"
+    "mary\":\"Journal persistant en flash (LittleFS) : echantillons bruts sur un intervalle, envoyes en"
+    " chunked\",\"parameters\":[{\"name\":\"from\",\"in\":\"query\",\"required\":false,\"schema\":{\"type\":\"integer\","
+    "\"minimum\":0},\"description\":\"Debut inclus, secondes epoch (defaut 0)\"},{\"name\":\"to\",\"in\":\"query\","
+    "\"required\":false,\"schema\":{\"type\":\"integer\",\"minimum\":0},\"description\":\"Fin incluse, secondes ep"
+    "och (defaut : tout)\"},{\"name\":\"limit\",\"in\":\"query\",\"required\":false,\"schema\":{\"type\":\"integer\",\""
+    "minimum\":1,\"maximum\":2000},\"description\":\"Nombre max de lignes (plafonne a 2000)\"}],\"responses\":"
+    "{\"200\":{\"description\":\"data : lignes [t, temp, light, led] ; truncated si limit atteint\"},\"400\":"
+    "{\"description\":\"from, to ou limit invalide\"},\"503\":{\"description\":\"LittleFS indisponible\"}}}},\"/"
+    "events\":{\"get\":{\"summary\":\"Flux Server-Sent Events : etat courant a l'abonnement puis un eveneme"
+    "nt par changement (mesures, LED, mode), 4 par seconde au plus\",\"responses\":{\"200\":{\"description\""
+    ":\"text/event-stream ; data : {id, temperature, light_raw, light_percent, led, auto_mode, mode}, "
+    "commentaire ': ping' toutes les 15 s sans changement\"},\"503\":{\"description\":\"Trop de flux (4 au "
+    "plus, /events et /ws confondus) ou serveur sans flux\"}}}},\"/ws\":{\"get\":{\"summary\":\"Canal de comm"
+    "ande WebSocket : etat courant a l'ouverture puis le meme JSON que /events a chaque changement. C"
+    "ommandes texte {\\\"seq\\\":N,\\\"cmd\\\":\\\"led|mode|threshold|state\\\",...} acquittees par {\\\"ack\\\":N,\\\""
+    "ok\\\":true|false}, ou binaires [commande u8][seq u16 LE][arguments] acquittees par [0x80|commande"
+    "][seq][statut]\",\"responses\":{\"101\":{\"description\":\"Mise a niveau WebSocket acceptee\"},\"400\":{\"de"
+    "scription\":\"Requete sans Sec-WebSocket-Key ou serveur sans WebSocket\"},\"503\":{\"description\":\"Tro"
+    "p de flux (4 au plus, /events et /ws confondus)\"}}}},\"/telemetry\":{\"get\":{\"summary\":\"Telemetrie "
+    "Firebase par exception : bande morte et heartbeat par champ, ecritures evitees\",\"responses\":{\"20"
+    "0\":{\"description\":\"fields.<champ> : deadband (analogiques), heartbeat_ms ; evaluations, updates,"
+    " fields_sent, fields_suppressed\"},\"503\":{\"description\":\"Politique non configuree\"}}}},\"/telemetr"
+    "y/set\":{\"post\":{\"summary\":\"Regler la bande morte et/ou le heartbeat d'un champ du miroir Firebas"
+    "e\",\"parameters\":[{\"name\":\"field\",\"in\":\"query\",\"required\":true,\"schema\":{\"type\":\"string\",\"enum\":["
+    "\"temperature\",\"lightRaw\",\"lightPercent\",\"led\",\"mode\",\"autoMode\"]},\"description\":\"Champ du miroir"
+    " (feuille Firebase)\"},{\"name\":\"deadband\",\"in\":\"query\",\"required\":false,\"schema\":{\"type\":\"number\""
+    ",\"minimum\":0},\"description\":\"Ecart minimal avant ecriture (temperature en C, lightRaw en points "
+    "ADC, lightPercent en %)\"},{\"name\":\"heartbeat\",\"in\":\"query\",\"required\":false,\"schema\":{\"type\":\"in"
+    "teger\",\"minimum\":0},\"description\":\"Silence max en ms (0 = a chaque evaluation)\"}],\"responses\":{\""
+    "200\":{\"description\":\"Reglage applique\"},\"400\":{\"description\":\"Champ inconnu, aucun reglage, ou b"
+    "ande morte sur un champ discret\"},\"503\":{\"description\":\"Politique non configuree\"}}}},\"/api-docs"
+    "\":{\"get\":{\"summary\":\"Specification OpenAPI de cette API\",\"parameters\":[{\"name\":\"If-None-Match\",\""
+    "in\":\"header\",\"required\":false,\"schema\":{\"type\":\"string\"},\"description\":\"ETag d'une copie deja re"
+    "cue\"}],\"responses\":{\"200\":{\"description\":\"Specification OpenAPI 3.0 (gzip si Accept-Encoding le "
+    "permet)\"},\"304\":{\"description\":\"Specification inchangee\"}}}}}}";
+
+// Spécification complète gzip, URL de serveur relative "/"
+static const uint8_t OPENAPI_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x59, 0xfb, 0x6f, 0xdb, 0xba,
+    0x15, 0xfe, 0x57, 0x08, 0x01, 0x43, 0x6c, 0x40, 0x4e, 0x9c, 0xa6, 0x77, 0x28, 0x7c, 0xb7, 0x01,
+    0xb9, 0x49, 0x7a, 0x6f, 0xef, 0xf2, 0x42, 0xe2, 0x6e, 0x3f, 0xa4, 0x41, 0x40, 0x4b, 0xc7, 0x36,
+    0x5b, 0x49, 0x54, 0x49, 0x2a, 0x8f, 0x25, 0xf9, 0xdf, 0xf7, 0x1d, 0x52, 0x92, 0xed, 0xd8, 0x4e,
+    0x93, 0xad, 0xdd, 0x30, 0x60, 0x45, 0x11, 0xeb, 0x41, 0xf2, 0xbc, 0xbe, 0xf3, 0xd4, 0x7d, 0xa4,
+    0x4b, 0x2a, 0x64, 0xa9, 0xa2, 0x41, 0xb4, 0xb3, 0xd9, 0xdf, 0xec, 0x47, 0x71, 0xa4, 0x8a, 0xb1,
+    0x8e, 0x06, 0xf7, 0x91, 0x53, 0x2e, 0x23, 0x3c, 0x1f, 0x0e, 0x7f, 0x3d, 0x11, 0x1f, 0xf4, 0x50,
+    0x9c, 0x1d, 0x9c, 0x0f, 0xc5, 0xee, 0xe9, 0x07, 0xac, 0xb9, 0x26, 0x63, 0x95, 0x2e, 0xf0, 0x76,
+    0xbb, 0xde, 0x95, 0x92, 0x4d, 0x8c, 0x2a, 0x5d, 0x78, 0x8a, 0x55, 0x61, 0x79, 0xa9, 0x2b, 0x23,
+    0x12, 0x5d, 0x38, 0xa3, 0x33, 0x12, 0x07, 0xe7, 0xa7, 0x3b, 0x6f, 0x84, 0x3f, 0x50, 0x5e, 0x53,
+    0x22, 0x12, 0x59, 0x3a, 0xaa, 0x8c, 0x15, 0x8e, 0xf2, 0x92, 0x8c, 0x74, 0x95, 0x21, 0x41, 0x4e,
+    0x64, 0x55, 0xae, 0xc8, 0xd0, 0xa6, 0x38, 0x24, 0x2b, 0x0c, 0x95, 0xba, 0xb0, 0xb8, 0xf8, 0xfd,
+    0xfc, 0xe4, 0x58, 0xd0, 0xad, 0xb2, 0x8e, 0x0a, 0x27, 0x64, 0x65, 0xad, 0x12, 0x54, 0x88, 0xbd,
+    0x5f, 0x4e, 0xce, 0x84, 0xae, 0xc4, 0x11, 0x59, 0x2b, 0x27, 0x74, 0x2a, 0x93, 0x2f, 0x62, 0x80,
+    0x17, 0x3d, 0x47, 0x8e, 0xc4, 0x6e, 0x92, 0x50, 0xe9, 0x06, 0x42, 0x96, 0x65, 0xa6, 0x12, 0xc9,
+    0xfc, 0x6d, 0x25, 0x23, 0x6d, 0x78, 0xc7, 0xfc, 0xb3, 0xdc, 0x4e, 0x4a, 0xde, 0xd9, 0xf1, 0x54,
+    0x4a, 0x69, 0x44, 0x4a, 0x63, 0x59, 0xb9, 0x6e, 0xf4, 0x18, 0x47, 0x96, 0x0c, 0x4b, 0x1c, 0x0d,
+    0x2e, 0xee, 0xa3, 0xca, 0x64, 0x10, 0x70, 0x6b, 0x49, 0xe4, 0x73, 0x5e, 0x03, 0x61, 0x83, 0x8c,
+    0x99, 0x4e, 0x64, 0x16, 0x3d, 0x5e, 0xc6, 0x51, 0x29, 0xdd, 0xd4, 0xb2, 0x3e, 0xb7, 0x2c, 0x15,
+    0x56, 0x1b, 0x7f, 0x3d, 0x21, 0xc7, 0x3f, 0xb6, 0xca, 0x73, 0x69, 0xee, 0xb0, 0xfb, 0x90, 0xa5,
+    0x12, 0x4e, 0x57, 0x56, 0x64, 0x10, 0xb5, 0x51, 0x0c, 0xa8, 0x18, 0xb2, 0x41, 0x7e, 0xde, 0xf0,
+    0xa6, 0xdf, 0xe7, 0x9f, 0x45, 0xca, 0x61, 0x6f, 0x3a, 0xb7, 0x4d, 0xa4, 0x8a, 0x37, 0xa9, 0x11,
+    0xce, 0x8a, 0x1e, 0xf1, 0x2f, 0x6e, 0xa9, 0x6f, 0xcd, 0xa9, 0x7a, 0x35, 0x27, 0x94, 0x78, 0x33,
+    0xcc, 0xaf, 0x7b, 0x09, 0x17, 0xc3, 0x79, 0x13, 0xc2, 0x2a, 0x94, 0x59, 0x55, 0x2d, 0x51, 0xcf,
+    0xd4, 0x64, 0xea, 0x9e, 0xa5, 0x5b, 0xdb, 0xfe, 0x45, 0x34, 0x8f, 0xd5, 0x35, 0xc9, 0x0a, 0xa2,
+    0x37, 0xbb, 0x44, 0xc7, 0xc8, 0x1b, 0x46, 0x10, 0xe3, 0x2e, 0x01, 0x4c, 0x00, 0x88, 0x6e, 0xc3,
+    0x43, 0x46, 0xe9, 0x16, 0x6f, 0xbb, 0x8f, 0x4a, 0x6d, 0x9f, 0x50, 0xdf, 0xcd, 0x70, 0x02, 0x19,
+    0x91, 0x49, 0x71, 0x78, 0xb0, 0xff, 0x32, 0xb5, 0x1f, 0xec, 0x0b, 0xe9, 0xb7, 0xd1, 0x02, 0x85,
+    0xf1, 0x78, 0x35, 0x89, 0x03, 0x47, 0xaa, 0x48, 0x59, 0xc2, 0xd7, 0xd1, 0x20, 0xde, 0xe7, 0x16,
+    0x68, 0x38, 0x3d, 0x99, 0x64, 0xb4, 0x9a, 0xcc, 0x2f, 0xd2, 0x26, 0x55, 0xc6, 0xa2, 0x6c, 0x90,
+    0x93, 0xce, 0x2b, 0xe7, 0x75, 0x04, 0x47, 0xe1, 0x84, 0x96, 0xa2, 0x9b, 0x62, 0xdf, 0x54, 0x67,
+    0x29, 0xac, 0xe8, 0x56, 0x13, 0xdd, 0xa7, 0xb1, 0x2a, 0x94, 0xf1, 0xd8, 0xb5, 0x54, 0xa9, 0x8c,
+    0x91, 0x0b, 0x27, 0x92, 0x39, 0xb8, 0xaf, 0x1d, 0xa7, 0xc0, 0x0d, 0x96, 0x32, 0xae, 0x7c, 0x94,
+    0xc1, 0xf5, 0xd7, 0x8a, 0xb0, 0x9d, 0xf9, 0xfa, 0x5a, 0x29, 0x43, 0x69, 0x34, 0x70, 0xa6, 0x22,
+    0xf8, 0x5b, 0x32, 0xa5, 0x5c, 0xfa, 0x20, 0x74, 0x57, 0xf2, 0xa6, 0xa2, 0xca, 0x47, 0x64, 0xd8,
+    0x15, 0x9f, 0x3a, 0x1d, 0x68, 0xb1, 0x88, 0x6e, 0x0d, 0xfa, 0xe2, 0x96, 0x6e, 0x40, 0xde, 0x6b,
+    0x09, 0xb3, 0xe6, 0x27, 0xcf, 0x52, 0x6e, 0x90, 0x07, 0xaa, 0x73, 0xa0, 0xf3, 0xae, 0xff, 0x6d,
+    0x75, 0xfb, 0x53, 0x2c, 0x87, 0x1a, 0xa8, 0x8f, 0xd9, 0x8d, 0xde, 0xae, 0x5a, 0x76, 0x1a, 0x34,
+    0x89, 0xf3, 0x44, 0x2e, 0x8b, 0xaf, 0x95, 0x2c, 0x9c, 0x5d, 0xb2, 0xce, 0x4a, 0xaf, 0x3a, 0x19,
+    0x21, 0x58, 0x2e, 0x18, 0x46, 0x48, 0xf8, 0x19, 0x3d, 0x63, 0xa0, 0x1b, 0xa9, 0xdc, 0xd5, 0x58,
+    0x9b, 0xab, 0x64, 0x2a, 0x8b, 0x09, 0xad, 0x57, 0xd9, 0x58, 0x66, 0xf6, 0x39, 0x9d, 0xc5, 0x51,
+    0x0e, 0xa9, 0xf2, 0x2a, 0x8f, 0x06, 0x7d, 0x5c, 0xcb, 0xdb, 0x70, 0xbd, 0xd3, 0xc7, 0xbf, 0x25,
+    0x7d, 0x1e, 0xea, 0x62, 0xd2, 0x2b, 0x75, 0x96, 0x21, 0x76, 0xd7, 0x11, 0x1f, 0xbf, 0x60, 0xbe,
+    0x22, 0xf1, 0xb9, 0xb2, 0x5f, 0xab, 0x0d, 0x38, 0x7a, 0x69, 0x34, 0x98, 0x52, 0x85, 0x08, 0xac,
+    0xe5, 0x9c, 0x07, 0x60, 0x82, 0x3a, 0x1b, 0xf9, 0x90, 0xce, 0xd1, 0x20, 0x93, 0x4a, 0x74, 0x72,
+    0x1b, 0x8b, 0x32, 0x93, 0x63, 0x5d, 0xa4, 0xc2, 0x93, 0xec, 0xce, 0xa3, 0xe1, 0xc3, 0xb8, 0x77,
+    0xac, 0x0b, 0xea, 0x1d, 0x49, 0x97, 0x4c, 0x1b, 0x11, 0xa7, 0x24, 0x53, 0xcf, 0xf7, 0xb7, 0x65,
+    0xb4, 0xce, 0xa8, 0x62, 0xb2, 0x0c, 0x8b, 0x83, 0xa1, 0x9c, 0x88, 0x74, 0xa3, 0x2a, 0xa8, 0x95,
+    0xa2, 0x34, 0x94, 0x50, 0x0a, 0x56, 0x09, 0xa2, 0xed, 0xf4, 0xdf, 0x0a, 0xa4, 0x2d, 0x78, 0x64,
+    0xc3, 0x74, 0xb1, 0x21, 0x91, 0x6e, 0xac, 0x18, 0xe9, 0xea, 0xb5, 0xb0, 0x41, 0x9c, 0xcb, 0x35,
+    0xe4, 0x0f, 0x16, 0x65, 0x66, 0x70, 0xfc, 0xf2, 0xea, 0xbf, 0xd5, 0x94, 0x54, 0x11, 0xd4, 0x86,
+    0x28, 0xb9, 0x20, 0x7e, 0x17, 0x7c, 0x31, 0x07, 0x38, 0x29, 0xd1, 0xa6, 0x5c, 0x0f, 0xc3, 0x27,
+    0xc8, 0xc0, 0x81, 0xd7, 0x32, 0x53, 0x69, 0x1b, 0x28, 0x98, 0x99, 0x97, 0xc4, 0x88, 0xc0, 0x35,
+    0xfe, 0xc3, 0x38, 0x09, 0x9f, 0x5d, 0x78, 0x53, 0xae, 0x45, 0x24, 0x2f, 0x7f, 0xb5, 0xe7, 0xd6,
+    0x16, 0x8a, 0x23, 0x40, 0x08, 0xa8, 0xbb, 0x88, 0x8e, 0x76, 0x8f, 0x3f, 0x1e, 0x1c, 0xe2, 0xc1,
+    0xee, 0xc7, 0xe1, 0x49, 0x6f, 0x78, 0x70, 0x74, 0xda, 0x5c, 0x1f, 0x7e, 0xf8, 0xf5, 0xb7, 0x61,
+    0x74, 0xb9, 0x64, 0xcc, 0x23, 0xd0, 0x1d, 0x88, 0xb0, 0x2f, 0x16, 0xed, 0x36, 0xc6, 0xd9, 0xdc,
+    0xbe, 0x97, 0x99, 0xec, 0x28, 0x88, 0xcc, 0x2a, 0x58, 0xab, 0x5f, 0xbf, 0xe6, 0xa9, 0x52, 0x47,
+    0x1e, 0xa1, 0xab, 0x93, 0x16, 0xd7, 0x2f, 0xac, 0x10, 0x00, 0xbd, 0xb2, 0xca, 0x67, 0x7e, 0xed,
+    0xc3, 0x20, 0xce, 0xb3, 0x1e, 0x86, 0x62, 0x84, 0x4a, 0x04, 0xf6, 0x45, 0x65, 0xe1, 0x10, 0x02,
+    0xc2, 0xd1, 0xb8, 0x28, 0x2b, 0x65, 0x43, 0xfd, 0x83, 0xfd, 0xb8, 0x47, 0x7a, 0xa6, 0x1c, 0xe5,
+    0x42, 0x0c, 0x0f, 0x4a, 0x18, 0xbd, 0x00, 0xa9, 0xff, 0x21, 0x64, 0x02, 0x41, 0xd6, 0xcd, 0xf8,
+    0x0a, 0xba, 0xc7, 0xa3, 0x5f, 0x74, 0x7a, 0xc7, 0x0c, 0x3d, 0x35, 0x05, 0x97, 0x7b, 0x6c, 0x4e,
+    0xbc, 0x9a, 0xaf, 0xb0, 0x3e, 0xdb, 0x90, 0x7c, 0x97, 0x2c, 0x25, 0x8d, 0x91, 0x77, 0x21, 0x5a,
+    0x7c, 0x40, 0x1c, 0x87, 0x0e, 0xb7, 0x7d, 0xb8, 0xa8, 0x6f, 0xde, 0xc1, 0xf2, 0xe1, 0xaa, 0xdd,
+    0xa1, 0x47, 0x9f, 0x51, 0x2d, 0x2c, 0x95, 0x60, 0x47, 0x80, 0x11, 0x30, 0x65, 0x72, 0xa4, 0x3d,
+    0x70, 0x18, 0x2a, 0x29, 0x0d, 0x6d, 0x15, 0x5c, 0x1c, 0x39, 0xba, 0x85, 0x0b, 0x6e, 0xdd, 0x20,
+    0x2e, 0x58, 0x59, 0x70, 0x38, 0xfc, 0x0a, 0xc5, 0xdc, 0x27, 0x79, 0x3a, 0xc0, 0xca, 0x14, 0x4f,
+    0x91, 0x2e, 0x61, 0x6f, 0x5d, 0x3c, 0x20, 0x87, 0x3f, 0x84, 0x1c, 0xfb, 0x18, 0xd7, 0x2b, 0x18,
+    0x83, 0xb1, 0xff, 0xdb, 0x20, 0xe2, 0xa1, 0x05, 0xc4, 0xc3, 0x0c, 0x0d, 0xed, 0xfa, 0x36, 0x2c,
+    0xc7, 0x3e, 0x37, 0xc5, 0xc2, 0xe7, 0x1f, 0xd1, 0xe9, 0xf7, 0xb6, 0x11, 0x8a, 0xda, 0x65, 0x9e,
+    0xe6, 0x63, 0xc4, 0x96, 0xa6, 0x5b, 0x99, 0x97, 0x9c, 0xd5, 0x01, 0x7c, 0xbc, 0xe3, 0x54, 0xd9,
+    0x86, 0xf6, 0x38, 0xa4, 0xcd, 0xc1, 0x1b, 0x28, 0xa3, 0x2e, 0xa1, 0xde, 0xf6, 0x39, 0x9c, 0x85,
+    0x85, 0xb5, 0x83, 0xf8, 0x9f, 0xc1, 0x1c, 0xbe, 0x67, 0x2b, 0x20, 0x20, 0x16, 0x78, 0x6a, 0xac,
+    0xbf, 0x02, 0xa8, 0xf5, 0xf0, 0xfa, 0x36, 0x70, 0x4f, 0x66, 0x80, 0x9a, 0xc3, 0xcb, 0xcf, 0xc2,
+    0x17, 0x17, 0xd0, 0x2e, 0x58, 0x86, 0x58, 0xfe, 0x15, 0x2b, 0x11, 0x84, 0xae, 0x3c, 0x99, 0xb8,
+    0x56, 0x19, 0x6a, 0x68, 0x7d, 0x15, 0x2e, 0x59, 0x86, 0xab, 0x39, 0xc5, 0x78, 0x49, 0x66, 0x0f,
+    0xba, 0x6b, 0x1d, 0x63, 0x8f, 0xc3, 0x52, 0x8b, 0xc0, 0x58, 0xf4, 0xd9, 0x05, 0x19, 0xf3, 0x1c,
+    0x44, 0xde, 0xcd, 0x61, 0x3e, 0xe6, 0x17, 0xed, 0x6d, 0xbb, 0x43, 0x74, 0x50, 0x79, 0xd1, 0x2d,
+    0x58, 0x0a, 0x3d, 0x02, 0x47, 0x3c, 0xa3, 0x88, 0x83, 0x2f, 0x43, 0xbb, 0x91, 0xab, 0x2d, 0x56,
+    0xc1, 0x7f, 0xb5, 0xba, 0x4e, 0x3f, 0xf7, 0xaf, 0x5a, 0xb9, 0xd3, 0x4a, 0xd8, 0x3b, 0x54, 0xdf,
+    0x39, 0xfd, 0x3f, 0x9d, 0xfe, 0xef, 0xa6, 0xd3, 0xbd, 0xba, 0x6d, 0x8a, 0x7d, 0x26, 0x95, 0xa1,
+    0x85, 0xe2, 0x26, 0x62, 0x56, 0x76, 0xfd, 0x2c, 0x38, 0xe6, 0x38, 0xe8, 0xc4, 0x8d, 0xf4, 0xad,
+    0xe8, 0xa4, 0x68, 0x2a, 0xa7, 0xb1, 0x48, 0x0d, 0xd4, 0x77, 0x65, 0x3c, 0xdc, 0xa1, 0x28, 0xb4,
+    0x23, 0x86, 0x9d, 0x60, 0x2c, 0x15, 0xfc, 0xa0, 0xeb, 0x59, 0xdb, 0xa0, 0xe2, 0x5a, 0x2b, 0x74,
+    0x64, 0xe3, 0xb1, 0x2f, 0x13, 0x19, 0x6f, 0x48, 0x7a, 0xe3, 0xff, 0x7e, 0xba, 0x0e, 0xc8, 0x5d,
+    0x09, 0xf3, 0xa1, 0x84, 0x85, 0xac, 0x78, 0x6f, 0x88, 0xce, 0x86, 0x27, 0xe7, 0xa0, 0x98, 0x68,
+    0x68, 0x05, 0x10, 0x80, 0x60, 0xf0, 0xdb, 0x11, 0x24, 0xf1, 0x68, 0x94, 0xb8, 0xed, 0xe8, 0x04,
+    0xad, 0xb6, 0xed, 0xc6, 0xac, 0x30, 0x8f, 0xa0, 0xbd, 0xd3, 0x8f, 0xaf, 0xec, 0x5c, 0x5d, 0x20,
+    0xd8, 0x81, 0xeb, 0x25, 0x5f, 0xae, 0xc6, 0xa0, 0x2b, 0x8a, 0x0a, 0xe8, 0x85, 0x06, 0x0b, 0xe8,
+    0x02, 0x7e, 0x5b, 0x19, 0x89, 0xfc, 0xd4, 0x36, 0x73, 0x53, 0x6c, 0xd5, 0xe6, 0x6e, 0x25, 0xf7,
+    0xbf, 0xf9, 0x77, 0xec, 0xd1, 0x5c, 0x95, 0x9f, 0xed, 0x1e, 0x09, 0x39, 0x31, 0xf0, 0x21, 0xdf,
+    0xd6, 0x3b, 0x23, 0x8b, 0x40, 0x0b, 0x02, 0x6c, 0xc1, 0x8d, 0x50, 0xb6, 0xdc, 0x11, 0x4a, 0x10,
+    0xf0, 0xcf, 0xa6, 0xba, 0xf3, 0x9b, 0x92, 0x69, 0x55, 0x7c, 0xf1, 0x31, 0x73, 0xb5, 0x57, 0x5b,
+    0x58, 0xe7, 0x3b, 0xf9, 0xf2, 0x12, 0xe8, 0x73, 0x95, 0x65, 0xca, 0x76, 0xba, 0xac, 0x49, 0x43,
+    0x8c, 0x1a, 0xd0, 0x82, 0x09, 0x38, 0x17, 0x87, 0xf1, 0x00, 0xb1, 0x45, 0x1d, 0x96, 0x71, 0x54,
+    0xe6, 0xba, 0x80, 0x4c, 0xc8, 0xfe, 0x48, 0xb1, 0xae, 0x16, 0xd6, 0x32, 0x48, 0x79, 0x82, 0x21,
+    0x16, 0x5d, 0x15, 0x8b, 0xcb, 0xef, 0xc2, 0xf8, 0xf6, 0x72, 0xd0, 0x91, 0x66, 0xc2, 0x23, 0x90,
+    0xe0, 0xb0, 0xb5, 0xa2, 0x59, 0x9b, 0xf9, 0x8c, 0x99, 0x81, 0xe0, 0xa3, 0x0c, 0x90, 0x08, 0xe4,
+    0xa4, 0x70, 0x0e, 0xf0, 0x0a, 0x73, 0x19, 0x1f, 0x7d, 0xba, 0x2f, 0x74, 0xd8, 0x54, 0x3a, 0x89,
+    0x93, 0x90, 0x3f, 0x0a, 0xc8, 0x79, 0xe1, 0x62, 0x51, 0xd4, 0xd9, 0x05, 0xdc, 0x35, 0x57, 0xf2,
+    0xb6, 0xbe, 0x92, 0xd7, 0x93, 0x26, 0xd7, 0xf8, 0xd7, 0xf5, 0x25, 0xbf, 0x0f, 0x97, 0x61, 0x01,
+    0x12, 0x97, 0x2e, 0xae, 0x90, 0x3b, 0xb8, 0x85, 0xbb, 0x5c, 0xeb, 0x55, 0xde, 0xf2, 0x1c, 0x1b,
+    0x59, 0x91, 0x73, 0x3e, 0x15, 0x47, 0x3f, 0xf5, 0x77, 0x96, 0x97, 0xcf, 0x61, 0x91, 0x81, 0xcc,
+    0xae, 0x7f, 0x4d, 0x4f, 0x40, 0xbc, 0x35, 0xce, 0xa4, 0x9d, 0xae, 0x84, 0xf2, 0xef, 0x68, 0x29,
+    0x0b, 0x99, 0x89, 0x92, 0x83, 0x02, 0x9c, 0x03, 0xe6, 0x85, 0x3e, 0xfd, 0x7a, 0xd1, 0x39, 0x54,
+    0xce, 0x65, 0xf4, 0xfe, 0x9c, 0x23, 0xc2, 0x02, 0x24, 0x46, 0xa6, 0x72, 0x00, 0x03, 0x4c, 0x51,
+    0x15, 0x73, 0xfa, 0x6e, 0x00, 0x6e, 0x5f, 0x82, 0xf0, 0xb1, 0xd1, 0xf9, 0x0f, 0x02, 0xf8, 0x3e,
+    0x8d, 0x2a, 0x2e, 0x28, 0x13, 0x64, 0x70, 0x94, 0x5d, 0x84, 0x82, 0x91, 0x63, 0x00, 0x02, 0x7c,
+    0x32, 0x5d, 0x83, 0x5a, 0xa7, 0x7f, 0x10, 0x2f, 0xef, 0x55, 0x51, 0x73, 0x42, 0x6b, 0x59, 0x09,
+    0xe5, 0x73, 0x77, 0x71, 0x9a, 0x90, 0x2b, 0xf7, 0x7d, 0xdc, 0x68, 0x2e, 0x97, 0xbf, 0x59, 0x95,
+    0xca, 0x8f, 0x75, 0xee, 0xc3, 0xad, 0xbc, 0xf5, 0xe3, 0x86, 0x80, 0xf9, 0x4e, 0xc8, 0xc5, 0x70,
+    0x33, 0x29, 0xde, 0x84, 0x6c, 0xfc, 0x2f, 0x7a, 0xce, 0x5c, 0x75, 0xea, 0x9d, 0xe0, 0x12, 0xb9,
+    0x0e, 0x75, 0x7c, 0x81, 0xaa, 0x9d, 0x52, 0x9f, 0xc1, 0x58, 0x54, 0x21, 0x9d, 0x1f, 0x43, 0xad,
+    0x75, 0x0b, 0x86, 0x0b, 0x0e, 0xd3, 0xec, 0x19, 0x61, 0xc7, 0x37, 0x5d, 0xa3, 0x81, 0x2f, 0x56,
+    0xce, 0xe6, 0x95, 0x8d, 0x6b, 0xd0, 0x35, 0xf1, 0x90, 0x63, 0x95, 0x4f, 0xbc, 0xcf, 0xaa, 0x5b,
+    0xe1, 0xc7, 0xad, 0xa6, 0x77, 0xce, 0x35, 0xcb, 0x81, 0x5f, 0xcb, 0x4e, 0x10, 0x6a, 0x52, 0xa4,
+    0x0a, 0x0e, 0x83, 0xc8, 0xbd, 0x72, 0xd4, 0x34, 0x97, 0xa1, 0xe3, 0x81, 0x3b, 0xf0, 0xc1, 0xf5,
+    0x13, 0x64, 0x83, 0xb9, 0xca, 0xa7, 0xe3, 0x93, 0x0c, 0x01, 0x91, 0x87, 0x07, 0xfb, 0xa1, 0x7a,
+    0x45, 0x4a, 0x78, 0xeb, 0x97, 0xd5, 0xc0, 0xe0, 0x7a, 0x88, 0xcb, 0xce, 0x17, 0x25, 0x37, 0xee,
+    0x37, 0x82, 0x18, 0x3d, 0x8e, 0x6f, 0x32, 0x87, 0x62, 0x6b, 0xf5, 0xdf, 0xab, 0xba, 0x2d, 0xa8,
+    0x47, 0x56, 0x4d, 0x20, 0x32, 0xf2, 0xa6, 0xb9, 0xac, 0xe3, 0x50, 0x1c, 0x5a, 0x93, 0xb9, 0x22,
+    0x9a, 0xff, 0xa2, 0x7d, 0xe0, 0xbe, 0x86, 0x47, 0x4d, 0xc0, 0x9b, 0xd8, 0x40, 0x41, 0x80, 0xf2,
+    0x69, 0xa3, 0xe9, 0xf2, 0x38, 0x45, 0x6c, 0xff, 0x24, 0x6c, 0xe8, 0x73, 0x66, 0x22, 0xae, 0xb5,
+    0xc4, 0xd0, 0xe8, 0xd2, 0xf7, 0xe3, 0xac, 0xd9, 0xce, 0xdb, 0x46, 0xcc, 0x58, 0xd4, 0x66, 0xe0,
+    0x62, 0x08, 0x8d, 0x13, 0x0f, 0xf2, 0xb9, 0x00, 0xac, 0x6c, 0xd7, 0x07, 0xc0, 0x7a, 0xe2, 0xed,
+    0xa9, 0xf0, 0xd6, 0xc6, 0x76, 0x37, 0xab, 0xed, 0xb6, 0x27, 0x39, 0x92, 0xf9, 0xb2, 0x25, 0xf4,
+    0x64, 0xe2, 0xef, 0x34, 0x3a, 0xd7, 0xc9, 0x17, 0x72, 0xab, 0x6c, 0xa7, 0x2b, 0x18, 0xd8, 0x0f,
+    0xf4, 0xbc, 0xe9, 0x78, 0x6c, 0xc0, 0xfd, 0x9d, 0x9f, 0xcf, 0x73, 0x38, 0x6d, 0x78, 0x93, 0x2c,
+    0x21, 0x3f, 0x98, 0x09, 0xba, 0x29, 0xf6, 0x9e, 0xb4, 0x7d, 0xf7, 0x9f, 0x22, 0xf4, 0x7b, 0x9f,
+    0xa2, 0xc1, 0x71, 0xfc, 0x89, 0x5b, 0x22, 0x5c, 0x7d, 0xe2, 0xa6, 0xe8, 0x81, 0xd5, 0xf9, 0xd0,
+    0xb6, 0x20, 0x0f, 0xbe, 0x75, 0xf9, 0x14, 0xc5, 0x9b, 0x9b, 0x9b, 0x8f, 0x08, 0xd6, 0xf0, 0x67,
+    0xe0, 0x9e, 0xfb, 0x65, 0x80, 0x00, 0x67, 0xa0, 0x38, 0xa9, 0xcf, 0xd0, 0x7c, 0xc1, 0xfd, 0xee,
+    0x83, 0xf7, 0xf5, 0x47, 0xdf, 0x79, 0x8c, 0x54, 0xc1, 0x06, 0x81, 0x63, 0xb5, 0x22, 0x56, 0xef,
+    0x2e, 0x2f, 0xb8, 0xd3, 0xac, 0xb6, 0xff, 0x08, 0x5c, 0x5d, 0x5e, 0x20, 0x45, 0x56, 0xcc, 0xa2,
+    0xbd, 0x7c, 0x7a, 0xfc, 0x45, 0xff, 0xf6, 0x5d, 0xff, 0xa1, 0xd9, 0xe8, 0x77, 0xe1, 0x0f, 0xf7,
+    0x1b, 0xc8, 0x46, 0x4f, 0x00, 0xb7, 0xdd, 0xdf, 0x5e, 0x31, 0x3e, 0x50, 0x96, 0xc3, 0x41, 0x11,
+    0x86, 0xe2, 0x33, 0xdd, 0x4a, 0xff, 0x09, 0x84, 0x68, 0xad, 0xef, 0x9e, 0x71, 0x3f, 0x0f, 0x25,
+    0x79, 0x43, 0x9e, 0x53, 0xd2, 0x6b, 0xf7, 0xf6, 0xfe, 0x4a, 0x77, 0x4b, 0xa6, 0x6e, 0xdf, 0x7e,
+    0x47, 0x3c, 0xb5, 0xd3, 0x4c, 0xca, 0x88, 0x4b, 0xee, 0xd5, 0x85, 0xdd, 0xb0, 0x7e, 0xab, 0x48,
+    0xbc, 0x87, 0x9e, 0x47, 0xd2, 0x86, 0x9a, 0x8e, 0x6e, 0x59, 0x42, 0x2e, 0x9a, 0x07, 0x62, 0xe4,
+    0xd5, 0x9e, 0x6b, 0xe3, 0xfc, 0xa7, 0x24, 0x34, 0x21, 0xc6, 0x8d, 0x48, 0xb6, 0xee, 0xce, 0xd1,
+    0x8e, 0xc0, 0x2b, 0x23, 0x0b, 0x8c, 0x5c, 0x2b, 0x36, 0xc0, 0x8b, 0x1c, 0x7a, 0xac, 0x28, 0x4b,
+    0xed, 0xe6, 0x9f, 0xfc, 0x21, 0x7f, 0x01, 0xa9, 0x14, 0x0d, 0x0e, 0x93, 0x43, 0xfb, 0x0b, 0x64,
+    0xeb, 0x09, 0x67, 0x79, 0x2e, 0x83, 0x5b, 0x9a, 0x57, 0xb9, 0xef, 0x94, 0x11, 0x07, 0xab, 0xa6,
+    0x3f, 0xad, 0x4a, 0xc4, 0x00, 0x0e, 0x32, 0xe1, 0xb4, 0x2b, 0xeb, 0x9d, 0xbc, 0xb9, 0xa9, 0x4a,
+    0xb4, 0x37, 0xd6, 0x22, 0x85, 0xac, 0x53, 0xed, 0xa9, 0xce, 0x94, 0x6b, 0xcb, 0x09, 0x56, 0xa0,
+    0x9a, 0x40, 0x12, 0x5a, 0x52, 0xe0, 0xfa, 0x41, 0xdc, 0x19, 0x4d, 0xb2, 0xf0, 0xa9, 0x63, 0x51,
+    0x57, 0x5b, 0x1c, 0xba, 0x69, 0x4e, 0x63, 0x7e, 0x80, 0xe4, 0xa5, 0xe5, 0x46, 0x37, 0x57, 0x46,
+    0x2b, 0xd3, 0x2a, 0x7e, 0x7d, 0xe1, 0xc0, 0xb2, 0xfc, 0xfb, 0xe3, 0xba, 0xc5, 0xef, 0x4f, 0x3e,
+    0x28, 0x9e, 0xc9, 0x9b, 0xe6, 0xf2, 0x34, 0x84, 0x47, 0xbe, 0xf5, 0x35, 0x4c, 0x3d, 0x01, 0xe1,
+    0x38, 0xc9, 0x53, 0xb4, 0x15, 0xc3, 0xbc, 0xbd, 0x27, 0x72, 0x74, 0xc6, 0x3c, 0x44, 0xcd, 0x66,
+    0x48, 0x5a, 0xc8, 0xef, 0x8d, 0x69, 0x5f, 0x9f, 0xe2, 0xeb, 0x4f, 0x15, 0xcf, 0x16, 0x1d, 0x07,
+    0x09, 0x37, 0x4a, 0x75, 0x03, 0x25, 0xe4, 0xb5, 0x2f, 0xeb, 0x6a, 0x4c, 0x8a, 0xce, 0xd3, 0x6f,
+    0x19, 0x75, 0x4a, 0x38, 0xe3, 0x2f, 0x5b, 0xfc, 0x91, 0x41, 0xb1, 0x07, 0xed, 0xee, 0x37, 0xcf,
+    0x6b, 0x55, 0xf0, 0xbb, 0x3f, 0x2c, 0xc8, 0xd0, 0x1a, 0xf2, 0x07, 0x95, 0x4e, 0xe7, 0xe8, 0x05,
+    0xb9, 0x16, 0xe6, 0xca, 0xa4, 0x2e, 0xf2, 0xfb, 0xe2, 0xcf, 0xb3, 0x78, 0x3c, 0xc3, 0xfd, 0x4b,
+    0xab, 0x13, 0x46, 0xa6, 0x44, 0x9f, 0x36, 0x1b, 0xc8, 0xac, 0x1b, 0x08, 0x79, 0x63, 0xa2, 0x6e,
+    0x43, 0x7a, 0xaf, 0xea, 0x99, 0x25, 0x7a, 0x25, 0xbf, 0x3b, 0x44, 0xe2, 0x39, 0x64, 0xd7, 0x75,
+    0x70, 0x0d, 0x64, 0x85, 0x73, 0x9e, 0x09, 0x5d, 0xdf, 0xf2, 0x2f, 0x59, 0xaa, 0x5e, 0xaa, 0x93,
+    0x35, 0xd3, 0xa1, 0x92, 0x12, 0x35, 0xae, 0x07, 0x9e, 0xe2, 0xa4, 0xa4, 0x82, 0x3f, 0x84, 0x73,
+    0xc6, 0x23, 0xc7, 0xdf, 0xa2, 0xfd, 0xb7, 0xf3, 0xd5, 0x5e, 0xf3, 0x1f, 0x98, 0xa0, 0x24, 0xba,
+    0x54, 0xdc, 0x6d, 0x7f, 0x96, 0x50, 0x55, 0x52, 0xbd, 0xf8, 0x63, 0xc3, 0x4a, 0xa1, 0x76, 0x36,
+    0xfb, 0xa2, 0x33, 0xf9, 0x87, 0x2a, 0xb9, 0x44, 0x0c, 0x1f, 0xd9, 0x7b, 0x07, 0xb0, 0x47, 0x0a,
+    0x2e, 0x38, 0x8a, 0x00, 0xc1, 0x10, 0xb2, 0xbb, 0x76, 0xca, 0xb1, 0x78, 0x6a, 0x3b, 0xeb, 0xf0,
+    0x6a, 0x7e, 0x7c, 0xfc, 0x27, 0x93, 0xf3, 0x18, 0x1b, 0x98, 0x20, 0x00, 0x00,
+};
+
+#endif
@@ -2,18 +2,24 @@
 #define PHOTOCELL_CONTROL_H
 
 #include <Arduino.h>
+#include "config.h"
+#include "SensorFilter.h"
+
+// Résultat d'une acquisition : brut et pourcentage de la même mesure
+struct LightReading {
+    int raw;        // moyenne filtrée (0-4095)
+    int percent;    // 0-100
+};
 
 class PhotocellControl {
 private:
     uint8_t _pin;
-    int _buffer[10];
-    int _bufferIndex;
-    
-    int getAverage(int buffer[], int size);
+    SensorFilter<FILTER_SIZE> _filter;
     
 public:
     PhotocellControl(uint8_t pin);
     void begin();
+    LightReading read();
     int readValue();
     int readPercent();
 };
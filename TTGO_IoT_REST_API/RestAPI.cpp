@@ -1,58 +1,203 @@
 #include "RestAPI.h"
+#include <math.h>
+#include <strings.h>
+#include <WiFi.h>
+#include "Logger.h"
+#include "OpenApiSpec.h"
 
 // ========================================
 // CONSTRUCTEUR
 // ========================================
-RestAPI::RestAPI(WebServer* server, TemperatureControl* temp, 
-                 PhotocellControl* light, LedControl* led) {
+RestAPI::RestAPI(HttpServer* server, TemperatureControl* temp, 
+                 PhotocellControl* light, LedControl* led,
+                 SensorSampler* sampler)
+    : _webServerBackend(NULL) {
     _server = server;
     _tempSensor = temp;
     _lightSensor = light;
     _led = led;
-    _tempThreshold = 30.0;
-    _lightThreshold = 50;
-    _autoMode = false;
-    _currentMode = "MANUEL";
+    _sampler = sampler;
+    _monitor = NULL;
+    _history = NULL;
+    _flashLog = NULL;
+    _outbox = NULL;
+    _telemetry = NULL;
+    _settings.tempThreshold = 30.0;
+    _settings.lightThreshold = 50;
+    _settings.autoMode = false;
+    strcpy(_settings.mode, "MANUEL");
+    memset(&_eventState, 0, sizeof(_eventState));
+    _eventId = 0;
+    _eventAt = 0;
+    _eventPending = false;
+    memset(&_apiState, 0, sizeof(_apiState));
+    _stateVersion = 0;
+    _settingsVersion = 0;
+    _bootId = esp_random();
+    for (int i = 0; i < LONGPOLL_MAX_WAITERS; i++) _longPolls[i].client = -1;
+    _format = FORMAT_JSON;
+    buildRouteIndex();
+#ifdef ARDUINO_ARCH_ESP32
+    _settingsMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
 }
 
+RestAPI::RestAPI(WebServer* server, TemperatureControl* temp, 
+                 PhotocellControl* light, LedControl* led,
+                 SensorSampler* sampler)
+    : RestAPI((HttpServer*)NULL, temp, light, led, sampler) {
+    _webServerBackend = WebServerBackend(server);
+    _server = &_webServerBackend;
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void RestAPI::lockSettings() { portENTER_CRITICAL(&_settingsMux); }
+void RestAPI::unlockSettings() { portEXIT_CRITICAL(&_settingsMux); }
+#else
+void RestAPI::lockSettings() { _settingsMutex.lock(); }
+void RestAPI::unlockSettings() { _settingsMutex.unlock(); }
+#endif
+
 // ========================================
-// HEADERS CORS
+// TABLE DES ROUTES
 // ========================================
-void RestAPI::sendCorsHeaders() {
-    _server->sendHeader("Access-Control-Allow-Origin", "*");
-    _server->sendHeader("Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
-    _server->sendHeader("Access-Control-Allow-Headers", "Content-Type, Authorization");
-    _server->sendHeader("Access-Control-Max-Age", "86400");
+// FNV-1a 32 bits ; constexpr : les hash de la table sont des constantes
+static constexpr uint32_t routeHash(const char* s, uint32_t h = 2166136261u) {
+    return *s ? routeHash(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+static_assert(routeHash("a") == 0xE40C292Cu, "FNV-1a");
+
+#define ROUTE(path, method, handler) { routeHash(path), path, method, &RestAPI::handler }
+
+const RestAPI::Route RestAPI::ROUTES[] = {
+    ROUTE("/sensors",             HTTP_GET,  handleGetSensors),
+    ROUTE("/sensors/temperature", HTTP_GET,  handleGetTemperature),
+    ROUTE("/sensors/light",       HTTP_GET,  handleGetLight),
+    ROUTE("/led/on",              HTTP_POST, handleLedOn),
+    ROUTE("/led/off",             HTTP_POST, handleLedOff),
+    ROUTE("/led/toggle",          HTTP_POST, handleLedToggle),
+    ROUTE("/threshold/set",       HTTP_POST, handleSetThreshold),
+    ROUTE("/threshold",           HTTP_GET,  handleGetThreshold),
+    ROUTE("/mode/set",            HTTP_POST, handleSetMode),
+    ROUTE("/batch",               HTTP_POST, handleBatch),
+    ROUTE("/status",              HTTP_GET,  handleGetStatus),
+    ROUTE("/system",              HTTP_GET,  handleGetSystem),
+    ROUTE("/history",             HTTP_GET,  handleGetHistory),
+    ROUTE("/history/flash",       HTTP_GET,  handleGetFlashHistory),
+    ROUTE("/events",              HTTP_GET,  handleEvents),
+    ROUTE("/ws",                  HTTP_GET,  handleWebSocket),
+    ROUTE("/telemetry",           HTTP_GET,  handleGetTelemetry),
+    ROUTE("/telemetry/set",       HTTP_POST, handleSetTelemetry),
+    ROUTE("/api-docs",            HTTP_GET,  handleApiDocs),
+};
+
+const uint8_t RestAPI::ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);
+
+// En-têtes CORS de toutes les réponses, copiés d'un bloc depuis la flash
+static const char CORS_HEADERS[] PROGMEM =
+    "Access-Control-Allow-Origin: *\r\n"
+    "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
+    "Access-Control-Allow-Headers: Content-Type, Authorization, If-None-Match\r\n"
+    "Access-Control-Expose-Headers: ETag\r\n"
+    "Access-Control-Max-Age: 86400\r\n";
+
+// Adressage ouvert, sondage linéaire ; les routes d'un même chemin se
+// suivent dans la chaîne de leur hash
+void RestAPI::buildRouteIndex() {
+    memset(_routeIndex, 0, sizeof(_routeIndex));
+    for (uint8_t i = 0; i < ROUTE_COUNT; i++) {
+        uint8_t slot = ROUTES[i].hash & (API_ROUTE_BUCKETS - 1);
+        while (_routeIndex[slot]) slot = (slot + 1) & (API_ROUTE_BUCKETS - 1);
+        _routeIndex[slot] = i + 1;
+    }
+}
+
+// Un hash, un ou deux sondages, un strcmp pour écarter une collision.
+// OPTIONS sur un chemin connu : pré-vol CORS générique ; chemin connu mais
+// autre méthode : 405 avec Allow.
+void RestAPI::handleRequest() {
+    _server->sendHeaders_P(CORS_HEADERS);
+    _format = negotiateFormat(_server->header("Accept").c_str());
+    const char* path = _server->path();
+    HTTPMethod method = _server->method();
+    uint32_t hash = routeHash(path);
+
+    char allow[48] = "";
+    for (uint8_t slot = hash & (API_ROUTE_BUCKETS - 1); _routeIndex[slot];
+         slot = (slot + 1) & (API_ROUTE_BUCKETS - 1)) {
+        const Route& route = ROUTES[_routeIndex[slot] - 1];
+        if (route.hash != hash || strcmp(route.path, path) != 0) continue;
+        if (route.method == method) {
+            (this->*route.handler)();
+            return;
+        }
+        size_t len = strlen(allow);
+        snprintf(allow + len, sizeof(allow) - len, "%s, ", route.method == HTTP_POST ? "POST" : "GET");
+    }
+
+    if (!allow[0]) {
+        handleNotFound();
+    } else if (method == HTTP_OPTIONS) {
+        _server->send(204);
+    } else {
+        strncat(allow, "OPTIONS", sizeof(allow) - strlen(allow) - 1);
+        _server->sendHeader("Allow", allow);
+        StaticJsonDocument<128> doc;
+        doc["code"] = 405;
+        doc["status"] = "ERROR";
+        doc["message"] = "Methode non autorisee";
+        sendJson(405, doc);
+    }
+}
+
+// ========================================
+// ENVOI JSON
+// ========================================
+// Sérialise dans le tampon fixe de l'instance et l'envoie tel quel :
+// ni String intermédiaire ni copie du corps sur le tas. Même document en
+// CBOR ou MessagePack si l'en-tête Accept le demande.
+void RestAPI::sendJson(int code, JsonDocument& doc) {
+    size_t len = _format == FORMAT_JSON
+        ? serializeJson(doc, _jsonBuffer, sizeof(_jsonBuffer))
+        : serializeBinary(doc.as<JsonVariant>(), _format, (uint8_t*)_jsonBuffer, sizeof(_jsonBuffer));
+    _server->sendHeader("Vary", "Accept");
+    _server->send_P(code, formatContentType(_format), _jsonBuffer, len);
+}
+
+void RestAPI::setMonitor(TaskMonitor* monitor) {
+    _monitor = monitor;
+}
+
+void RestAPI::setHistory(SensorHistory* history) {
+    _history = history;
+}
+
+void RestAPI::setFlashLog(FlashLog* flashLog) {
+    _flashLog = flashLog;
+}
+
+void RestAPI::setOutbox(FirebaseOutbox* outbox) {
+    _outbox = outbox;
+}
+
+void RestAPI::setTelemetryPolicy(TelemetryPolicy* policy) {
+    _telemetry = policy;
 }
 
 // ========================================
 // INITIALISATION DU SERVEUR
 // ========================================
 void RestAPI::begin() {
-    // Handlers OPTIONS pour CORS
-    _server->on("/sensors", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-    _server->on("/sensors/temperature", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-    _server->on("/sensors/light", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-    _server->on("/led/on", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-    _server->on("/led/off", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-    _server->on("/led/toggle", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-    _server->on("/threshold/set", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-    _server->on("/threshold", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-    _server->on("/mode/set", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-    _server->on("/status", HTTP_OPTIONS, [this]() { sendCorsHeaders(); _server->send(204); });
-
-    // Routes normales
-    _server->on("/sensors", HTTP_GET, [this]() { handleGetSensors(); });
-    _server->on("/sensors/temperature", HTTP_GET, [this]() { handleGetTemperature(); });
-    _server->on("/sensors/light", HTTP_GET, [this]() { handleGetLight(); });
-    _server->on("/led/on", HTTP_POST, [this]() { handleLedOn(); });
-    _server->on("/led/off", HTTP_POST, [this]() { handleLedOff(); });
-    _server->on("/led/toggle", HTTP_POST, [this]() { handleLedToggle(); });
-    _server->on("/threshold/set", HTTP_POST, [this]() { handleSetThreshold(); });
-    _server->on("/threshold", HTTP_GET, [this]() { handleGetThreshold(); });
-    _server->on("/mode/set", HTTP_POST, [this]() { handleSetMode(); });
-    _server->on("/status", HTTP_GET, [this]() { handleGetStatus(); });
-    _server->onNotFound([this]() { handleNotFound(); });
+    // En-têtes de requête lus par les handlers (le serveur ne garde que ceux-là)
+    const char* headerKeys[] = { "If-None-Match", "Accept-Encoding", "Accept" };
+    _server->collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
+
+    // Aucune route dans le moteur : tout arrive au handler par défaut, qui
+    // consulte la table
+    _server->onNotFound([this]() { handleRequest(); });
+    _server->onWebSocket([this](int client, bool binary, const uint8_t* data, size_t len) {
+        handleWebSocketMessage(client, binary, data, len);
+    });
 
     _server->begin();
 }
@@ -62,15 +207,15 @@ void RestAPI::begin() {
 // ========================================
 void RestAPI::handleClient() {
     _server->handleClient();
+    publishEvents();
+    serveLongPolls();
 }
 
 // ========================================
 // HANDLERS API
 // ========================================
 void RestAPI::handleGetSensors() {
-    sendCorsHeaders();
     StaticJsonDocument<256> doc;
-    String response;
 
     doc["code"] = 200;
     doc["status"] = "OK";
@@ -89,50 +234,40 @@ void RestAPI::handleGetSensors() {
     light["pin"] = LDR_PIN;
     light["unit"] = "percent";
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    sendJson(200, doc);
 }
 
 void RestAPI::handleGetTemperature() {
-    sendCorsHeaders();
     StaticJsonDocument<200> doc;
-    String response;
 
-    float temp = _tempSensor->readTemperature();
+    SensorSnapshot snap = _sampler->getSnapshot();
 
     doc["code"] = 200;
     doc["status"] = "OK";
-    doc["temperature_celsius"] = temp;
+    doc["temperature_celsius"] = snap.temperature;
     doc["sensor"] = "NTC 10k";
     doc["pin"] = TEMP_SENSOR_PIN;
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    sendJson(200, doc);
 }
 
 void RestAPI::handleGetLight() {
-    sendCorsHeaders();
     StaticJsonDocument<200> doc;
-    String response;
 
-    int lightRaw = _lightSensor->readValue();
-    int lightPercent = _lightSensor->readPercent();
+    SensorSnapshot snap = _sampler->getSnapshot();
 
     doc["code"] = 200;
     doc["status"] = "OK";
-    doc["light_raw"] = lightRaw;
-    doc["light_percent"] = lightPercent;
+    doc["light_raw"] = snap.lightRaw;
+    doc["light_percent"] = snap.lightPercent;
     doc["sensor"] = "Photocell";
     doc["pin"] = LDR_PIN;
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    sendJson(200, doc);
 }
 
 void RestAPI::handleLedOn() {
-    sendCorsHeaders();
     StaticJsonDocument<200> doc;
-    String response;
 
     _led->on();
 
@@ -141,14 +276,11 @@ void RestAPI::handleLedOn() {
     doc["led_state"] = "ON";
     doc["message"] = "LED allumee";
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    sendJson(200, doc);
 }
 
 void RestAPI::handleLedOff() {
-    sendCorsHeaders();
     StaticJsonDocument<200> doc;
-    String response;
 
     _led->off();
 
@@ -157,14 +289,11 @@ void RestAPI::handleLedOff() {
     doc["led_state"] = "OFF";
     doc["message"] = "LED eteinte";
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    sendJson(200, doc);
 }
 
 void RestAPI::handleLedToggle() {
-    sendCorsHeaders();
     StaticJsonDocument<200> doc;
-    String response;
 
     _led->toggle();
 
@@ -173,203 +302,1063 @@ void RestAPI::handleLedToggle() {
     doc["led_state"] = _led->getState() ? "ON" : "OFF";
     doc["message"] = "LED basculee";
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    sendJson(200, doc);
 }
 
 void RestAPI::handleSetThreshold() {
-    sendCorsHeaders();
     StaticJsonDocument<200> doc;
-    String response;
 
     if (!_server->hasArg("temp") || !_server->hasArg("light")) {
         doc["code"] = 400;
         doc["status"] = "ERROR";
         doc["message"] = "Parametres manquants: temp, light";
-        serializeJson(doc, response);
-        _server->send(400, "application/json", response);
+        sendJson(400, doc);
         return;
     }
 
-    _tempThreshold = _server->arg("temp").toFloat();
-    _lightThreshold = _server->arg("light").toInt();
+    setThreshold(_server->arg("temp").toFloat(), _server->arg("light").toInt());
+    ControlSettings settings = getSettings();
 
     doc["code"] = 200;
     doc["status"] = "OK";
-    doc["temp_threshold"] = _tempThreshold;
-    doc["light_threshold"] = _lightThreshold;
-    doc["auto_mode"] = _autoMode;
+    doc["temp_threshold"] = settings.tempThreshold;
+    doc["light_threshold"] = settings.lightThreshold;
+    doc["auto_mode"] = settings.autoMode;
     doc["message"] = "Seuils definis";
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    sendJson(200, doc);
 }
 
 void RestAPI::handleGetThreshold() {
-    sendCorsHeaders();
+    handleConditional(RESOURCE_THRESHOLD);
+}
+
+void RestAPI::sendThreshold() {
     StaticJsonDocument<200> doc;
-    String response;
+    const ControlSettings& settings = _apiState.settings;
 
     doc["code"] = 200;
     doc["status"] = "OK";
-    doc["temp_threshold"] = _tempThreshold;
-    doc["light_threshold"] = _lightThreshold;
-    doc["auto_mode"] = _autoMode;
-    doc["current_mode"] = _currentMode;
+    doc["temp_threshold"] = settings.tempThreshold;
+    doc["light_threshold"] = settings.lightThreshold;
+    doc["auto_mode"] = settings.autoMode;
+    doc["current_mode"] = (const char*)settings.mode;
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    sendJson(200, doc);
 }
 
 void RestAPI::handleSetMode() {
-    sendCorsHeaders();
     StaticJsonDocument<200> doc;
-    String response;
 
     if (!_server->hasArg("mode")) {
         doc["code"] = 400;
         doc["status"] = "ERROR";
         doc["message"] = "Parametre manquant: mode (MANUEL, AUTO-TEMP, AUTO-LIGHT)";
-        serializeJson(doc, response);
-        _server->send(400, "application/json", response);
+        sendJson(400, doc);
         return;
     }
 
-    String mode = _server->arg("mode");
-    mode.toUpperCase();
-
-    if (mode == "AUTO-TEMP") {
-        _autoMode = true;
-        _currentMode = "AUTO-TEMP";
-    } else if (mode == "AUTO-LIGHT") {
-        _autoMode = true;
-        _currentMode = "AUTO-LIGHT";
-    } else if (mode == "MANUEL") {
-        _autoMode = false;
-        _currentMode = "MANUEL";
-    } else {
+    if (!applyMode(_server->arg("mode"))) {
         doc["code"] = 400;
         doc["status"] = "ERROR";
         doc["message"] = "Mode invalide. Utilisez: MANUEL, AUTO-TEMP, AUTO-LIGHT";
-        serializeJson(doc, response);
-        _server->send(400, "application/json", response);
+        sendJson(400, doc);
         return;
     }
+    ControlSettings settings = getSettings();
 
     doc["code"] = 200;
     doc["status"] = "OK";
-    doc["mode"] = _currentMode;
-    doc["auto_mode"] = _autoMode;
+    doc["mode"] = (const char*)settings.mode;
+    doc["auto_mode"] = settings.autoMode;
     doc["message"] = "Mode defini avec succes";
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+    sendJson(200, doc);
 }
 
 void RestAPI::handleGetStatus() {
-    sendCorsHeaders();
-    StaticJsonDocument<300> doc;
-    String response;
+    handleConditional(RESOURCE_STATUS);
+}
 
-    float temp = _tempSensor->readTemperature();
-    int lightRaw = _lightSensor->readValue();
-    int lightPercent = _lightSensor->readPercent();
-    bool ledState = _led->getState();
+// Corps de /status depuis l'état relevé par refreshVersion()
+void RestAPI::sendStatus() {
+    StaticJsonDocument<384> doc;
+    const ApiState& state = _apiState;
+    const ControlSettings& current = state.settings;
 
     doc["code"] = 200;
     doc["status"] = "OK";
 
     JsonObject sensors = doc.createNestedObject("sensors");
-    sensors["temperature"] = temp;
-    sensors["light_raw"] = lightRaw;
-    sensors["light_percent"] = lightPercent;
+    sensors["temperature"] = state.temperature;
+    sensors["light_raw"] = state.lightRaw;
+    sensors["light_percent"] = state.lightPercent;
 
     JsonObject actuators = doc.createNestedObject("actuators");
-    actuators["led"] = ledState;
+    actuators["led"] = state.led;
 
     JsonObject settings = doc.createNestedObject("settings");
-    settings["auto_mode"] = _autoMode;
-    settings["current_mode"] = _currentMode;
-    settings["temp_threshold"] = _tempThreshold;
-    settings["light_threshold"] = _lightThreshold;
+    settings["auto_mode"] = current.autoMode;
+    settings["current_mode"] = (const char*)current.mode;
+    settings["temp_threshold"] = current.tempThreshold;
+    settings["light_threshold"] = current.lightThreshold;
+
+    // Envoi différé : arriéré en attente du lien et débit de vidage
+    if (state.outbox) {
+        JsonObject outbox = doc.createNestedObject("outbox");
+        outbox["depth"] = state.outboxDepth;
+        outbox["drain_rate"] = state.outboxDrainRate;
+        outbox["delivered"] = state.outboxDelivered;
+        outbox["failed"] = state.outboxFailed;
+    }
+
+    sendJson(200, doc);
+}
+
+// Tâches applicatives : cœur, pile libre minimale, part de CPU
+void RestAPI::handleGetSystem() {
+    StaticJsonDocument<640> doc;
+
+    doc["code"] = 200;
+    doc["status"] = "OK";
+    doc["uptime_ms"] = millis();
+
+    JsonArray tasks = doc.createNestedArray("tasks");
+    int count = _monitor ? _monitor->taskCount() : 0;
+    for (int i = 0; i < count; i++) {
+        TaskInfo info;
+        if (!_monitor->getTask(i, info)) continue;
+
+        JsonObject task = tasks.createNestedObject();
+        task["name"] = info.name;
+        task["core"] = info.core;
+        // null hors FreeRTOS (build host) : le high-water mark n'existe pas
+        if (info.stackFree >= 0) {
+            task["stack_free"] = info.stackFree;
+        } else {
+            task["stack_free"] = (const char*)0;
+        }
+        task["cpu_percent"] = info.cpuPercent;
+    }
+
+    sendJson(200, doc);
+}
+
+// ========================================
+// HISTORIQUE
+// ========================================
+static bool parseUnsigned(const String& text, unsigned long& value) {
+    if (text.length() == 0) return false;
+    char* end;
+    value = strtoul(text.c_str(), &end, 10);
+    return *end == '\0' && text[0] != '-';
+}
+
+// Tranches min/max/moyenne envoyées en chunked au fil de l'agrégation :
+// aucun document complet en RAM, et la connexion ne produit la suite que
+// quand le client a lu la précédente
+void RestAPI::handleGetHistory() {
+    StaticJsonDocument<200> doc;
+
+    if (!_history) {
+        doc["code"] = 503;
+        doc["status"] = "ERROR";
+        doc["message"] = "Historique indisponible";
+        sendJson(503, doc);
+        return;
+    }
+
+    unsigned long since = 0;
+    unsigned long step = HISTORY_INTERVAL;
+    if ((_server->hasArg("since") && !parseUnsigned(_server->arg("since"), since)) ||
+        (_server->hasArg("step") && (!parseUnsigned(_server->arg("step"), step) || step == 0))) {
+        doc["code"] = 400;
+        doc["status"] = "ERROR";
+        doc["message"] = "Parametres invalides: since (ms), step (ms > 0)";
+        sendJson(400, doc);
+        return;
+    }
+
+    HistoryCursor cursor;
+    cursor.since = since;
+    cursor.step = step;
+    cursor.now = millis();
+    cursor.started = false;
+    cursor.first = true;
+    cursor.done = false;
+
+    _server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    _server->send(200, "application/json", "");
+    _server->sendContentFrom([this, cursor](char* buffer, size_t size) mutable {
+        return produceHistory(cursor, buffer, size);
+    });
+}
+
+// Ligne la plus longue : 2 entiers 32 bits, 6 centièmes 16 bits, 1 pourcentage
+#define HISTORY_ROW_MAX 96
+
+// Lot suivant de /history : en-tête au premier appel, puis autant de
+// tranches que buffer en peut contenir ; "]}" après la dernière
+size_t RestAPI::produceHistory(HistoryCursor& cursor, char* buffer, size_t size) {
+    if (cursor.done) return 0;
+    size_t len = 0;
+    if (!cursor.started) {
+        len = snprintf(buffer, size,
+            "{\"code\":200,\"status\":\"OK\",\"now\":%lu,\"interval\":%u,\"step\":%lu,"
+            "\"fields\":[\"t\",\"n\",\"temp_min\",\"temp_max\",\"temp_avg\","
+            "\"light_min\",\"light_max\",\"light_avg\",\"led_on_percent\"],\"data\":[",
+            cursor.now, (unsigned)HISTORY_INTERVAL, (unsigned long)cursor.step);
+        cursor.started = true;
+    }
+
+    size_t rows = (size - len - 2) / HISTORY_ROW_MAX;
+    size_t emitted = _history->aggregate(cursor.since, cursor.step, [&](const HistoryBucket& b) {
+        char* out = buffer + len;
+        size_t space = size - len;
+        int n = snprintf(out, space, "%s[%lu,%u,", cursor.first ? "" : ",", (unsigned long)b.start, b.count);
+        n += SensorHistory::formatCenti(out + n, space - n, b.tempMin);
+        out[n++] = ',';
+        n += SensorHistory::formatCenti(out + n, space - n, b.tempMax);
+        out[n++] = ',';
+        n += SensorHistory::formatCenti(out + n, space - n, lroundf((float)b.tempSum / b.count));
+        out[n++] = ',';
+        n += SensorHistory::formatCenti(out + n, space - n, b.lightMin);
+        out[n++] = ',';
+        n += SensorHistory::formatCenti(out + n, space - n, b.lightMax);
+        out[n++] = ',';
+        n += SensorHistory::formatCenti(out + n, space - n, lroundf((float)b.lightSum / b.count));
+        n += snprintf(out + n, space - n, ",%u]", (unsigned)(b.ledOn * 100 / b.count));
+        len += n;
+        cursor.first = false;
+        cursor.since = b.start + cursor.step - 1;
+    }, rows);
+
+    if (emitted < rows) {
+        memcpy(buffer + len, "]}", 2);
+        len += 2;
+        cursor.done = true;
+    }
+    return len;
+}
+
+// Échantillons bruts du journal flash sur [from, to] (secondes epoch),
+// envoyés en chunked comme /history
+void RestAPI::handleGetFlashHistory() {
+    StaticJsonDocument<200> doc;
+
+    if (!_flashLog) {
+        doc["code"] = 503;
+        doc["status"] = "ERROR";
+        doc["message"] = "Journal flash indisponible";
+        sendJson(503, doc);
+        return;
+    }
+
+    unsigned long from = 0;
+    unsigned long to = 0xFFFFFFFFUL;
+    unsigned long limit = FLASHLOG_QUERY_LIMIT;
+    if ((_server->hasArg("from") && !parseUnsigned(_server->arg("from"), from)) ||
+        (_server->hasArg("to") && !parseUnsigned(_server->arg("to"), to)) ||
+        (_server->hasArg("limit") && (!parseUnsigned(_server->arg("limit"), limit) || limit == 0)) ||
+        from > to) {
+        doc["code"] = 400;
+        doc["status"] = "ERROR";
+        doc["message"] = "Parametres invalides: from <= to (s epoch), limit > 0";
+        sendJson(400, doc);
+        return;
+    }
+    if (limit > FLASHLOG_QUERY_LIMIT) limit = FLASHLOG_QUERY_LIMIT;
+
+    FlashLogStats stats = _flashLog->getStats();
+    _server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    _server->send(200, "application/json", "");
+
+    size_t len = snprintf(_jsonBuffer, sizeof(_jsonBuffer),
+        "{\"code\":200,\"status\":\"OK\",\"from\":%lu,\"to\":%lu,\"segments\":%lu,\"bytes\":%lu,"
+        "\"fields\":[\"t\",\"temp\",\"light\",\"led\"],\"data\":[",
+        from, to, (unsigned long)stats.segments, (unsigned long)stats.bytes);
+
+    bool first = true;
+    size_t count = _flashLog->query(from, to, limit, [&](const LogSample& sample) {
+        if (len > sizeof(_jsonBuffer) - 64) {
+            _server->sendContent(_jsonBuffer, len);
+            len = 0;
+        }
+        char* out = _jsonBuffer + len;
+        size_t space = sizeof(_jsonBuffer) - len;
+        int n = snprintf(out, space, "%s[%lu,", first ? "" : ",", (unsigned long)sample.time);
+        n += SensorHistory::formatCenti(out + n, space - n, sample.temp);
+        out[n++] = ',';
+        n += SensorHistory::formatCenti(out + n, space - n, sample.light);
+        n += snprintf(out + n, space - n, ",%d]", sample.led ? 1 : 0);
+        len += n;
+        first = false;
+    });
+
+    len += snprintf(_jsonBuffer + len, sizeof(_jsonBuffer) - len,
+                    "],\"count\":%u,\"truncated\":%s}", (unsigned)count, count >= limit ? "true" : "false");
+    _server->sendContent(_jsonBuffer, len);
+    _server->sendContent("");
+}
+
+// ========================================
+// GET CONDITIONNEL ET LONG-POLL
+// ========================================
+ApiState RestAPI::currentState() {
+    SensorSnapshot snap = _sampler->getSnapshot();
+    ControlSettings settings = getSettings();
+    // Champ par champ sur une base nulle : memcmp() sans octet de bourrage
+    ApiState state;
+    memset(&state, 0, sizeof(state));
+    state.settings.tempThreshold = settings.tempThreshold;
+    state.settings.lightThreshold = settings.lightThreshold;
+    state.settings.autoMode = settings.autoMode;
+    memcpy(state.settings.mode, settings.mode, sizeof(state.settings.mode));
+    state.temperature = snap.temperature;
+    state.lightRaw = snap.lightRaw;
+    state.lightPercent = snap.lightPercent;
+    state.led = _led->getState();
+    if (_outbox) {
+        OutboxStats stats = _outbox->getStats();
+        state.outbox = true;
+        state.outboxDepth = stats.depth;
+        state.outboxDrainRate = stats.drainRate;
+        state.outboxDelivered = stats.delivered;
+        state.outboxFailed = stats.failed;
+    }
+    return state;
+}
+
+void RestAPI::refreshVersion() {
+    ApiState state = currentState();
+    if (_stateVersion > 0 && memcmp(&state, &_apiState, sizeof(state)) == 0) return;
+    _stateVersion++;
+    if (_settingsVersion == 0 || memcmp(&state.settings, &_apiState.settings, sizeof(state.settings)) != 0) {
+        _settingsVersion = _stateVersion;
+    }
+    _apiState = state;
+}
+
+uint32_t RestAPI::resourceVersion(uint8_t resource) {
+    return resource == RESOURCE_THRESHOLD ? _settingsVersion : _stateVersion;
+}
+
+// "boot-version[-format]" : une représentation par format négocié
+void RestAPI::formatETag(char* etag, size_t size, uint32_t version) {
+    const char* suffix = _format == FORMAT_CBOR ? "-cbor" : _format == FORMAT_MSGPACK ? "-msgpack" : "";
+    snprintf(etag, size, "\"%08lx-%lu%s\"", (unsigned long)_bootId, (unsigned long)version, suffix);
+}
+
+// If-None-Match : liste d'entity-tags séparés par des virgules, comparés
+// en faible (W/ ignoré) ; "*" désigne la représentation courante
+static bool etagMatches(const char* header, const char* etag) {
+    size_t etagLen = strlen(etag);
+    const char* p = header;
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == ',') p++;
+        if (!*p) break;
+        if (*p == '*') return true;
+        if (p[0] == 'W' && p[1] == '/') p += 2;
+        // Fin du tag : guillemet fermant, la virgule peut figurer entre guillemets
+        const char* end = p;
+        if (*end == '"') {
+            end = strchr(end + 1, '"');
+            end = end ? end + 1 : p + strlen(p);
+        } else {
+            end += strcspn(end, ", \t");
+        }
+        if ((size_t)(end - p) == etagLen && memcmp(p, etag, etagLen) == 0) return true;
+        p = end;
+        while (*p && *p != ',') p++;
+    }
+    return false;
+}
+
+// If-None-Match à jour -> 304 sans corps. ?wait_for_change=ms : réponse
+// retenue jusqu'à ce que la version bouge ou que le délai expire (304 si
+// le client avait la version courante, 200 sinon). Client déjà en retard
+// ou moteur sans réponse différée : réponse immédiate.
+void RestAPI::handleConditional(uint8_t resource) {
+    refreshVersion();
+    uint32_t version = resourceVersion(resource);
+    char etag[40];
+    formatETag(etag, sizeof(etag), version);
+    String ifNoneMatch = _server->header("If-None-Match");
+    bool current = etagMatches(ifNoneMatch.c_str(), etag);
+
+    if (_server->hasArg("wait_for_change")) {
+        unsigned long wait;
+        if (!parseUnsigned(_server->arg("wait_for_change"), wait)) {
+            StaticJsonDocument<200> doc;
+            doc["code"] = 400;
+            doc["status"] = "ERROR";
+            doc["message"] = "Parametre invalide: wait_for_change (ms)";
+            sendJson(400, doc);
+            return;
+        }
+        if (wait > 0 && (current || ifNoneMatch.length() == 0) &&
+            parkRequest(resource, version, current, wait)) {
+            return;
+        }
+    }
+    sendVersioned(resource, current);
+}
+
+bool RestAPI::parkRequest(uint8_t resource, uint32_t version, bool conditional, unsigned long wait) {
+    int waiting = 0;
+    LongPoll* entry = NULL;
+    for (int i = 0; i < LONGPOLL_MAX_WAITERS; i++) {
+        if (_longPolls[i].client >= 0) waiting++;
+        else if (!entry) entry = &_longPolls[i];
+    }
+    // Flux, attentes et celle-ci laissent une connexion au reste de l'API
+    if (!entry || _server->streamCount() + waiting + 2 > HTTP_MAX_CLIENTS) return false;
+
+    int client = _server->deferResponse();
+    if (client < 0) return false;
+    // Connexion refermée puis réattribuée : l'ancienne attente est caduque
+    for (int i = 0; i < LONGPOLL_MAX_WAITERS; i++) {
+        if (_longPolls[i].client == client) _longPolls[i].client = -1;
+    }
+    entry->client = client;
+    entry->resource = resource;
+    entry->format = _format;
+    entry->conditional = conditional;
+    entry->version = version;
+    entry->start = millis();
+    entry->timeout = wait < LONGPOLL_MAX_WAIT ? wait : LONGPOLL_MAX_WAIT;
+    return true;
+}
+
+void RestAPI::sendVersioned(uint8_t resource, bool notModified) {
+    char etag[40];
+    formatETag(etag, sizeof(etag), resourceVersion(resource));
+    _server->sendHeader("ETag", etag);
+    _server->sendHeader("Cache-Control", "no-cache");
+    if (notModified) {
+        _server->sendHeader("Vary", "Accept");
+        _server->send(304);
+        return;
+    }
+    if (resource == RESOURCE_STATUS) sendStatus();
+    else sendThreshold();
+}
+
+// Attentes servies dès que leur version bouge ou à leur délai ; l'état
+// n'est relevé que s'il y en a
+void RestAPI::serveLongPolls() {
+    bool waiting = false;
+    for (int i = 0; i < LONGPOLL_MAX_WAITERS; i++) {
+        if (_longPolls[i].client >= 0) waiting = true;
+    }
+    if (!waiting) return;
+
+    refreshVersion();
+    unsigned long now = millis();
+    for (int i = 0; i < LONGPOLL_MAX_WAITERS; i++) {
+        LongPoll& poll = _longPolls[i];
+        if (poll.client < 0) continue;
+        bool moved = resourceVersion(poll.resource) != poll.version;
+        if (!moved && now - poll.start < poll.timeout) continue;
+
+        int client = poll.client;
+        poll.client = -1;
+        if (!_server->resumeResponse(client)) continue;   // client parti
+        _format = (ResponseFormat)poll.format;
+        _server->sendHeaders_P(CORS_HEADERS);
+        sendVersioned(poll.resource, !moved && poll.conditional);
+        _server->endResponse();
+    }
+}
+
+// ========================================
+// ÉVÉNEMENTS SSE
+// ========================================
+EventState RestAPI::currentEvent() {
+    SensorSnapshot snap = _sampler->getSnapshot();
+    ControlSettings settings = getSettings();
+    EventState state;
+    memset(&state, 0, sizeof(state));
+    state.temp = SensorHistory::centiTemp(snap.temperature);
+    state.lightRaw = snap.lightRaw;
+    state.lightPercent = snap.lightPercent;
+    state.led = _led->getState();
+    state.autoMode = settings.autoMode;
+    memcpy(state.mode, settings.mode, sizeof(state.mode));
+    return state;
+}
+
+// Un événement SSE complet dans _jsonBuffer : id, data JSON sur une ligne.
+// jsonAt/jsonLen situent le JSON seul, envoyé tel quel aux clients /ws.
+size_t RestAPI::formatEvent(const EventState& state, bool retry, size_t& jsonAt, size_t& jsonLen) {
+    size_t len = 0;
+    if (retry) len += snprintf(_jsonBuffer, sizeof(_jsonBuffer), "retry: %d\n", EVENTS_RETRY);
+    len += snprintf(_jsonBuffer + len, sizeof(_jsonBuffer) - len, "id: %lu\ndata: ",
+                    (unsigned long)_eventId);
+    jsonAt = len;
+    len += snprintf(_jsonBuffer + len, sizeof(_jsonBuffer) - len, "{\"id\":%lu,\"temperature\":",
+                    (unsigned long)_eventId);
+    len += SensorHistory::formatCenti(_jsonBuffer + len, sizeof(_jsonBuffer) - len, state.temp);
+    len += snprintf(_jsonBuffer + len, sizeof(_jsonBuffer) - len,
+                    ",\"light_raw\":%d,\"light_percent\":%d,\"led\":%s,\"auto_mode\":%s,\"mode\":\"%s\"}",
+                    state.lightRaw, state.lightPercent, state.led ? "true" : "false",
+                    state.autoMode ? "true" : "false", state.mode);
+    jsonLen = len - jsonAt;
+    len += snprintf(_jsonBuffer + len, sizeof(_jsonBuffer) - len, "\n\n");
+    return len;
+}
+
+// Nouvel état : un identifiant, une sérialisation, tous les flux
+void RestAPI::broadcastEvent(const EventState& state) {
+    _eventState = state;
+    _eventId++;
+    size_t jsonAt, jsonLen;
+    size_t len = formatEvent(state, false, jsonAt, jsonLen);
+    _server->broadcast(_jsonBuffer, len);
+    _server->broadcastWebSocket(false, (const uint8_t*)_jsonBuffer + jsonAt, jsonLen);
+    _eventAt = millis();
+}
 
-    serializeJson(doc, response);
-    _server->send(200, "application/json", response);
+// Changement pas encore diffusé : publié à tous les abonnés existants
+bool RestAPI::flushEvent() {
+    EventState state = currentEvent();
+    if (memcmp(&state, &_eventState, sizeof(state)) == 0) return false;
+    broadcastEvent(state);
+    return true;
+}
+
+void RestAPI::sendEventState(int client) {
+    size_t jsonAt, jsonLen;
+    formatEvent(_eventState, false, jsonAt, jsonLen);
+    _server->sendWebSocket(client, false, (const uint8_t*)_jsonBuffer + jsonAt, jsonLen);
+}
+
+// Abonnement : état courant tout de suite, puis les diffusions de publishEvents()
+void RestAPI::handleEvents() {
+    StaticJsonDocument<200> doc;
+
+    if (_server->streamCount() >= HTTP_MAX_STREAMS) {
+        doc["code"] = 503;
+        doc["status"] = "ERROR";
+        doc["message"] = "Trop d'abonnes";
+        sendJson(503, doc);
+        return;
+    }
+
+    // Le nouvel abonné part du même identifiant que les autres
+    flushEvent();
+
+    _server->sendHeader("Cache-Control", "no-cache");
+    if (!_server->beginStream("text/event-stream")) {
+        doc["code"] = 503;
+        doc["status"] = "ERROR";
+        doc["message"] = "Flux non supporte par ce serveur";
+        sendJson(503, doc);
+        return;
+    }
+
+    size_t jsonAt, jsonLen;
+    size_t len = formatEvent(_eventState, true, jsonAt, jsonLen);
+    _server->sendContent(_jsonBuffer, len);
+}
+
+// Au plus un événement par EVENTS_MIN_INTERVAL (sauf après une commande
+// WebSocket), sérialisé une seule fois quel que soit le nombre d'abonnés ;
+// rien à faire sans abonné
+void RestAPI::publishEvents() {
+    if (_server->streamCount() == 0) {
+        _eventPending = false;
+        return;
+    }
+    unsigned long now = millis();
+    if (!_eventPending && now - _eventAt < EVENTS_MIN_INTERVAL) return;
+    _eventPending = false;
+
+    if (flushEvent()) return;
+    if (now - _eventAt >= EVENTS_KEEPALIVE) {
+        // Commentaire SSE : garde les proxys et détecte les abonnés partis.
+        // Les clients WebSocket ont leurs propres ping.
+        size_t len = snprintf(_jsonBuffer, sizeof(_jsonBuffer), ": ping\n\n");
+        _server->broadcast(_jsonBuffer, len);
+        _eventAt = now;
+    }
+}
+
+// ========================================
+// CANAL DE COMMANDE WEBSOCKET
+// ========================================
+static const char* const MODE_NAMES[] = { "MANUEL", "AUTO-TEMP", "AUTO-LIGHT" };
+static const char* const COMMAND_ERRORS[] = { "", "commande inconnue", "arguments invalides" };
+
+// Mise à niveau puis état courant ; les commandes arrivent ensuite par
+// handleWebSocketMessage(), hors de toute requête HTTP
+void RestAPI::handleWebSocket() {
+    StaticJsonDocument<200> doc;
+
+    if (_server->streamCount() >= HTTP_MAX_STREAMS) {
+        doc["code"] = 503;
+        doc["status"] = "ERROR";
+        doc["message"] = "Trop d'abonnes";
+        sendJson(503, doc);
+        return;
+    }
+
+    flushEvent();
+    int client = _server->beginWebSocket();
+    if (client < 0) {
+        doc["code"] = 400;
+        doc["status"] = "ERROR";
+        doc["message"] = "Mise a niveau WebSocket attendue";
+        sendJson(400, doc);
+        return;
+    }
+    sendEventState(client);
+}
+
+// Texte JSON -> commande validée : {"cmd":"led","state":..}, "mode" +
+// "mode", "threshold" + "temp" et "light", "state"
+uint8_t RestAPI::parseCommand(JsonVariant op, ApiCommand& command) {
+    const char* cmd = op["cmd"].as<const char*>();
+    if (!cmd) cmd = "";
+    command.arg = -1;
+    command.temp = op.containsKey("temp") ? op["temp"].as<float>() : NAN;
+    command.light = op.containsKey("light") ? op["light"].as<int>() : -1;
+
+    if (strcmp(cmd, "led") == 0) {
+        command.command = WS_CMD_LED;
+        const char* state = op["state"].as<const char*>();
+        static const char* const states[] = { "off", "on", "toggle" };
+        for (int i = 0; state && i < 3; i++) {
+            if (strcasecmp(state, states[i]) == 0) command.arg = i;
+        }
+    } else if (strcmp(cmd, "mode") == 0) {
+        command.command = WS_CMD_MODE;
+        const char* mode = op["mode"].as<const char*>();
+        for (int i = 0; mode && i < 3; i++) {
+            if (strcasecmp(mode, MODE_NAMES[i]) == 0) command.arg = i;
+        }
+    } else if (strcmp(cmd, "threshold") == 0) {
+        command.command = WS_CMD_THRESHOLD;
+    } else if (strcmp(cmd, "state") == 0) {
+        command.command = WS_CMD_STATE;
+    } else {
+        command.command = 0;
+    }
+    return checkCommand(command);
+}
+
+uint8_t RestAPI::checkCommand(const ApiCommand& command) {
+    switch (command.command) {
+        case WS_CMD_LED:
+        case WS_CMD_MODE:
+            return command.arg >= 0 && command.arg <= 2 ? WS_STATUS_OK : WS_STATUS_BAD_ARGS;
+        case WS_CMD_THRESHOLD:
+            return command.temp > -100 && command.temp < 200 && command.light >= 0 && command.light <= 100
+                ? WS_STATUS_OK : WS_STATUS_BAD_ARGS;
+        case WS_CMD_STATE:
+            return WS_STATUS_OK;
+        default:
+            return WS_STATUS_BAD_COMMAND;
+    }
+}
+
+// Commandes déjà validées, appliquées dans une seule section critique :
+// updateAutoMode() décide de la LED sous le même verrou et ne voit jamais
+// une configuration à moitié appliquée
+void RestAPI::applyCommands(const ApiCommand* commands, size_t count) {
+    lockSettings();
+    for (size_t i = 0; i < count; i++) {
+        const ApiCommand& command = commands[i];
+        switch (command.command) {
+            case WS_CMD_LED:
+                if (command.arg == 0) _led->off();
+                else if (command.arg == 1) _led->on();
+                else _led->toggle();
+                break;
+            case WS_CMD_MODE:
+                _settings.autoMode = command.arg != 0;
+                strncpy(_settings.mode, MODE_NAMES[command.arg], sizeof(_settings.mode) - 1);
+                _settings.mode[sizeof(_settings.mode) - 1] = '\0';
+                break;
+            case WS_CMD_THRESHOLD:
+                _settings.tempThreshold = command.temp;
+                _settings.lightThreshold = command.light;
+                break;
+        }
+    }
+    unlockSettings();
+}
+
+// Même action que les routes HTTP ; le nouvel état part aussitôt après
+// l'acquittement (publishEvents() sans délai minimal)
+void RestAPI::handleWebSocketMessage(int client, bool binary, const uint8_t* data, size_t len) {
+    ApiCommand command;
+    command.command = 0;
+    uint8_t status;
+
+    if (binary) {
+        // [commande][seq u16 LE][arguments]
+        if (len < 3) return;
+        const uint8_t* args = data + 3;
+        size_t argLen = len - 3;
+        command.command = data[0];
+        command.arg = -1;
+        command.temp = NAN;
+        command.light = -1;
+        if ((command.command == WS_CMD_LED || command.command == WS_CMD_MODE) && argLen >= 1) {
+            command.arg = args[0];
+        } else if (command.command == WS_CMD_THRESHOLD && argLen >= 3) {
+            command.temp = (int16_t)(args[0] | args[1] << 8) / 100.0f;
+            command.light = args[2];
+        }
+        status = checkCommand(command);
+        if (status == WS_STATUS_OK) applyCommands(&command, 1);
+        uint8_t ack[4] = { (uint8_t)(0x80 | command.command), data[1], data[2], status };
+        _server->sendWebSocket(client, true, ack, sizeof(ack));
+    } else {
+        StaticJsonDocument<256> doc;
+        unsigned long seq = 0;
+        status = WS_STATUS_BAD_COMMAND;
+        if (!deserializeJson(doc, (const char*)data, len)) {
+            seq = doc["seq"].as<unsigned long>();
+            status = parseCommand(doc.as<JsonVariant>(), command);
+            if (status == WS_STATUS_OK) applyCommands(&command, 1);
+        }
+        char ack[96];
+        int n = status == WS_STATUS_OK
+            ? snprintf(ack, sizeof(ack), "{\"ack\":%lu,\"ok\":true}", seq)
+            : snprintf(ack, sizeof(ack), "{\"ack\":%lu,\"ok\":false,\"error\":\"%s\"}", seq,
+                       COMMAND_ERRORS[status]);
+        _server->sendWebSocket(client, false, (const uint8_t*)ack, n);
+    }
+    if (status != WS_STATUS_OK) return;
+
+    // Demande d'état : changement en attente diffusé à tous, sinon envoyé seul
+    if (command.command == WS_CMD_STATE) {
+        if (!flushEvent()) sendEventState(client);
+    } else {
+        _eventPending = true;
+    }
+}
+
+// ========================================
+// COMMANDES GROUPÉES
+// ========================================
+// Tableau d'opérations au format des commandes texte /ws, sans "seq" :
+// toutes validées d'abord, puis appliquées d'un bloc. Une seule invalide
+// et rien n'est appliqué.
+void RestAPI::handleBatch() {
+    StaticJsonDocument<BATCH_JSON_SIZE> doc;
+
+    if (!_server->hasArg("plain") || deserializeJson(doc, _server->arg("plain")) || !doc.is<JsonArray>()) {
+        doc.clear();
+        doc["code"] = 400;
+        doc["status"] = "ERROR";
+        doc["message"] = "Corps attendu: tableau JSON d'operations";
+        sendJson(400, doc);
+        return;
+    }
+
+    JsonArray ops = doc.as<JsonArray>();
+    if (ops.size() == 0 || ops.size() > BATCH_MAX_OPS) {
+        char message[48];
+        snprintf(message, sizeof(message), "Entre 1 et %d operations", BATCH_MAX_OPS);
+        doc.clear();
+        doc["code"] = 400;
+        doc["status"] = "ERROR";
+        doc["message"] = message;
+        sendJson(400, doc);
+        return;
+    }
+
+    ApiCommand commands[BATCH_MAX_OPS];
+    size_t count = 0;
+    for (JsonVariant op : ops) {
+        uint8_t status = parseCommand(op, commands[count]);
+        if (status != WS_STATUS_OK) {
+            doc.clear();
+            doc["code"] = 400;
+            doc["status"] = "ERROR";
+            doc["index"] = count;
+            doc["message"] = COMMAND_ERRORS[status];
+            doc["applied"] = 0;
+            sendJson(400, doc);
+            return;
+        }
+        count++;
+    }
+
+    applyCommands(commands, count);
+    _eventPending = true;
+
+    // Résultat unique : état complet après application
+    ControlSettings settings = getSettings();
+    doc.clear();
+    doc["code"] = 200;
+    doc["status"] = "OK";
+    doc["applied"] = count;
+    doc["led_state"] = _led->getState() ? "ON" : "OFF";
+    doc["mode"] = (const char*)settings.mode;
+    doc["auto_mode"] = settings.autoMode;
+    doc["temp_threshold"] = settings.tempThreshold;
+    doc["light_threshold"] = settings.lightThreshold;
+    sendJson(200, doc);
+}
+
+// ========================================
+// TÉLÉMÉTRIE PAR EXCEPTION
+// ========================================
+// Bande morte et heartbeat de chaque champ du miroir Firebase, plus le
+// nombre d'écritures évitées
+void RestAPI::handleGetTelemetry() {
+    StaticJsonDocument<640> doc;
+
+    if (!_telemetry) {
+        doc["code"] = 503;
+        doc["status"] = "ERROR";
+        doc["message"] = "Telemetrie indisponible";
+        sendJson(503, doc);
+        return;
+    }
+
+    doc["code"] = 200;
+    doc["status"] = "OK";
+    JsonObject fields = doc.createNestedObject("fields");
+    for (int i = 0; i < TELEMETRY_FIELD_COUNT; i++) {
+        TelemetryFieldConfig config = _telemetry->getConfig(i);
+        JsonObject field = fields.createNestedObject(TelemetryPolicy::fieldName(i));
+        if (TelemetryPolicy::isAnalog(i)) field["deadband"] = config.deadband;
+        field["heartbeat_ms"] = config.heartbeat;
+    }
+
+    TelemetryStats stats = _telemetry->getStats();
+    doc["evaluations"] = stats.evaluations;
+    doc["updates"] = stats.updates;
+    doc["fields_sent"] = stats.fieldsSent;
+    doc["fields_suppressed"] = stats.fieldsSuppressed;
+
+    sendJson(200, doc);
+}
+
+// ?field=<nom>&deadband=<écart>&heartbeat=<ms>, l'un ou l'autre réglage
+void RestAPI::handleSetTelemetry() {
+    StaticJsonDocument<200> doc;
+
+    if (!_telemetry) {
+        doc["code"] = 503;
+        doc["status"] = "ERROR";
+        doc["message"] = "Telemetrie indisponible";
+        sendJson(503, doc);
+        return;
+    }
+
+    int field = _server->hasArg("field") ? TelemetryPolicy::fieldIndex(_server->arg("field").c_str()) : -1;
+    TelemetryFieldConfig config = field >= 0 ? _telemetry->getConfig(field) : TelemetryFieldConfig();
+    bool valid = field >= 0 && (_server->hasArg("deadband") || _server->hasArg("heartbeat"));
+    if (valid && _server->hasArg("deadband")) {
+        String text = _server->arg("deadband");
+        char* end;
+        config.deadband = strtof(text.c_str(), &end);
+        valid = text.length() > 0 && *end == '\0' && config.deadband >= 0 &&
+                TelemetryPolicy::isAnalog(field);
+    }
+    if (valid && _server->hasArg("heartbeat")) {
+        valid = parseUnsigned(_server->arg("heartbeat"), config.heartbeat);
+    }
+    if (!valid || !_telemetry->configure(field, config.deadband, config.heartbeat)) {
+        doc["code"] = 400;
+        doc["status"] = "ERROR";
+        doc["message"] = "Parametres: field (temperature, lightRaw, lightPercent, led, mode, autoMode), "
+                         "deadband >= 0 (analogiques), heartbeat (ms)";
+        sendJson(400, doc);
+        return;
+    }
+
+    doc["code"] = 200;
+    doc["status"] = "OK";
+    doc["field"] = TelemetryPolicy::fieldName(field);
+    if (TelemetryPolicy::isAnalog(field)) doc["deadband"] = config.deadband;
+    doc["heartbeat_ms"] = config.heartbeat;
+
+    sendJson(200, doc);
+}
+
+// ========================================
+// DOCUMENTATION OPENAPI
+// ========================================
+// Suite de parts (flash ou RAM) vue comme un seul corps : copie à partir
+// de offset, qui avance. Retourne la longueur copiée, 0 à la fin.
+static size_t copyParts(PGM_P const parts[], const size_t lens[], size_t count,
+                        size_t& offset, char* buffer, size_t size) {
+    size_t copied = 0;
+    size_t start = 0;
+    for (size_t i = 0; i < count && copied < size; i++) {
+        if (offset < start + lens[i]) {
+            size_t from = offset - start;
+            size_t n = lens[i] - from;
+            if (n > size - copied) n = size - copied;
+            memcpy_P(buffer + copied, parts[i] + from, n);
+            copied += n;
+            offset += n;
+        }
+        start += lens[i];
+    }
+    return copied;
+}
+
+// Spécification générée à la compilation (api-docs/gen_openapi.py) et lue
+// depuis la flash : seule l'URL du serveur est insérée à l'envoi.
+void RestAPI::handleApiDocs() {
+    _server->sendHeader("Vary", "Accept-Encoding");
+
+    // La version gzip porte une URL relative, la version texte l'IP locale :
+    // l'ETag dépend donc de la variante servie
+    bool gzip = _server->header("Accept-Encoding").indexOf("gzip") >= 0;
+    IPAddress ip = WiFi.localIP();
+    char etag[32];
+    if (gzip) {
+        snprintf(etag, sizeof(etag), "\"%s-gz\"", OPENAPI_SPEC_HASH);
+    } else {
+        snprintf(etag, sizeof(etag), "\"%s-%02x%02x%02x%02x\"", OPENAPI_SPEC_HASH,
+                 ip[0], ip[1], ip[2], ip[3]);
+    }
+    _server->sendHeader("ETag", etag);
+    _server->sendHeader("Cache-Control", "no-cache");
+
+    if (etagMatches(_server->header("If-None-Match").c_str(), etag)) {
+        _server->send(304);
+        return;
+    }
+
+    // Corps plus grands que le tampon d'émission : copiés de la flash par
+    // morceaux, à mesure que le client lit
+    if (gzip) {
+        _server->sendHeader("Content-Encoding", "gzip");
+        _server->setContentLength(OPENAPI_GZ_LEN);
+        _server->send(200, "application/json", "");
+        size_t offset = 0;
+        _server->sendContentFrom([offset](char* buffer, size_t size) mutable {
+            PGM_P parts[] = { (PGM_P)OPENAPI_GZ };
+            const size_t lens[] = { OPENAPI_GZ_LEN };
+            return copyParts(parts, lens, 1, offset, buffer, size);
+        });
+        return;
+    }
+
+    char url[24];
+    size_t urlLen = snprintf(url, sizeof(url), "http://%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+
+    // Transfert chunked : en-tête, URL et suite
+    _server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    _server->send(200, "application/json", "");
+    size_t offset = 0;
+    _server->sendContentFrom([url, urlLen, offset](char* buffer, size_t size) mutable {
+        PGM_P parts[] = { OPENAPI_HEAD, url, OPENAPI_TAIL };
+        const size_t lens[] = { OPENAPI_HEAD_LEN, urlLen, OPENAPI_TAIL_LEN };
+        return copyParts(parts, lens, 3, offset, buffer, size);
+    });
 }
 
 void RestAPI::handleNotFound() {
-    sendCorsHeaders();
     StaticJsonDocument<200> doc;
-    String response;
 
     doc["code"] = 404;
     doc["status"] = "ERROR";
     doc["message"] = "Route non trouvee";
 
-    serializeJson(doc, response);
-    _server->send(404, "application/json", response);
+    sendJson(404, doc);
 }
 
 // ========================================
 // FONCTIONS UTILITAIRES
 // ========================================
 void RestAPI::setThreshold(float temp, int light) {
-    _tempThreshold = temp;
-    _lightThreshold = light;
+    lockSettings();
+    _settings.tempThreshold = temp;
+    _settings.lightThreshold = light;
+    unlockSettings();
 }
 
 void RestAPI::setAutoMode(bool mode) {
-    _autoMode = mode;
+    lockSettings();
+    _settings.autoMode = mode;
+    unlockSettings();
 }
 
 bool RestAPI::getAutoMode() {
-    return _autoMode;
+    lockSettings();
+    bool mode = _settings.autoMode;
+    unlockSettings();
+    return mode;
+}
+
+// MANUEL, AUTO-TEMP ou AUTO-LIGHT, casse indifférente ; false si inconnu
+bool RestAPI::applyMode(String mode) {
+    mode.toUpperCase();
+    bool autoMode;
+    if (mode == "AUTO-TEMP" || mode == "AUTO-LIGHT") {
+        autoMode = true;
+    } else if (mode == "MANUEL") {
+        autoMode = false;
+    } else {
+        return false;
+    }
+
+    lockSettings();
+    _settings.autoMode = autoMode;
+    strncpy(_settings.mode, mode.c_str(), sizeof(_settings.mode) - 1);
+    _settings.mode[sizeof(_settings.mode) - 1] = '\0';
+    unlockSettings();
+    return true;
 }
 
 void RestAPI::setCurrentMode(String mode) {
-    _currentMode = mode;
+    lockSettings();
+    strncpy(_settings.mode, mode.c_str(), sizeof(_settings.mode) - 1);
+    _settings.mode[sizeof(_settings.mode) - 1] = '\0';
+    unlockSettings();
 }
 
+// Copie sous verrou, String construite hors section critique
 String RestAPI::getCurrentMode() {
-    return _currentMode;
+    ControlSettings settings = getSettings();
+    return String(settings.mode);
+}
+
+ControlSettings RestAPI::getSettings() {
+    lockSettings();
+    ControlSettings settings = _settings;
+    unlockSettings();
+    return settings;
 }
 
 void RestAPI::updateAutoMode(float currentTemp, int currentLightPercent) {
-    if (!_autoMode) return;
+    // Décision et écriture de la LED sous le verrou des réglages : un
+    // /batch appliqué en même temps est vu avant ou après, jamais à moitié
+    lockSettings();
+    ControlSettings settings = _settings;
+    if (!settings.autoMode) {
+        unlockSettings();
+        return;
+    }
 
-    // 🔍 DEBUG - Ajoute ces lignes
-    Serial.println("=== UPDATE AUTO MODE ===");
-    Serial.print("Mode: ");
-    Serial.println(_currentMode);
-    
-    if (_currentMode == "AUTO-TEMP") {
-        Serial.print("Temp: ");
-        Serial.print(currentTemp);
-        Serial.print(" > ");
-        Serial.print(_tempThreshold);
-        Serial.println(" ?");
-        
-        if (currentTemp > _tempThreshold) {
+    if (strcmp(settings.mode, "AUTO-TEMP") == 0) {
+        if (currentTemp > settings.tempThreshold) {
             _led->on();
-            Serial.println("LED ON");
         } else {
             _led->off();
-            Serial.println("LED OFF");
         }
-    } else if (_currentMode == "AUTO-LIGHT") {
-        Serial.print("Light: ");
-        Serial.print(currentLightPercent);
-        Serial.print(" < ");
-        Serial.print(_lightThreshold);
-        Serial.println(" ?");
-        
-        if (currentLightPercent < _lightThreshold) {
+    } else if (strcmp(settings.mode, "AUTO-LIGHT") == 0) {
+        if (currentLightPercent < settings.lightThreshold) {
             _led->on();
-            Serial.println("LED ON");
         } else {
             _led->off();
-            Serial.println("LED OFF");
         }
     }
-    Serial.println("========================");
+    unlockSettings();
+    
+    // 🔍 DEBUG - une ligne par seconde au plus
+    LOG_EVERY(LOG_LEVEL_DEBUG, 1000, "Auto %s: T=%.2f/%.2f L=%d/%d -> LED %s",
+              settings.mode, currentTemp, settings.tempThreshold,
+              currentLightPercent, settings.lightThreshold, _led->getState() ? "ON" : "OFF");
 }
@@ -1,27 +1,203 @@
 #ifndef REST_API_H
 #define REST_API_H
 
-#include <WebServer.h>
 #include <ArduinoJson.h>
+#ifndef ARDUINO_ARCH_ESP32
+#include <mutex>
+#endif
 #include "config.h"
+#include "BinaryJson.h"
+#include "HttpServer.h"
 #include "TemperatureControl.h"
 #include "PhotocellControl.h"
 #include "LedControl.h"
+#include "SensorSampler.h"
+#include "TaskMonitor.h"
+#include "SensorHistory.h"
+#include "FlashLog.h"
+#include "FirebaseOutbox.h"
+#include "TelemetryPolicy.h"
+
+// Taille du tampon de réponse JSON (le plus gros document : /system)
+#define JSON_RESPONSE_SIZE 768
+// Corps de /batch désérialisé (BATCH_MAX_OPS opérations de 3 membres)
+#define BATCH_JSON_SIZE 1024
+
+// Index de la table des routes : puissance de 2, au moins deux fois le
+// nombre de routes pour des sondages courts
+#define API_ROUTE_BUCKETS 64
+
+// Réglages du mode automatique, copiés d'un bloc sous verrou : les handlers
+// HTTP (cœur réseau) et les tâches boutons/auto/écran (cœur contrôle) y
+// accèdent en parallèle
+struct ControlSettings {
+    float tempThreshold;
+    int lightThreshold;
+    bool autoMode;
+    char mode[16];
+};
+
+// Dernier état diffusé sur /events, température en centièmes : pas
+// d'événement pour un écart invisible dans le JSON
+struct EventState {
+    long temp;
+    int lightRaw;
+    int lightPercent;
+    bool led;
+    bool autoMode;
+    char mode[16];
+};
+
+// Canal de commande WebSocket /ws. Texte :
+//   {"seq":N,"cmd":"led","state":"on|off|toggle"}, "mode" + "mode",
+//   "threshold" + "temp"/"light", "state" -> {"ack":N,"ok":true|false[,"error":".."]}
+// Binaire : [commande u8][seq u16 LE][arguments] -> [0x80|commande][seq][statut u8]
+//   LED : 0 éteinte, 1 allumée, 2 bascule ; mode : 0 MANUEL, 1 AUTO-TEMP,
+//   2 AUTO-LIGHT ; seuils : i16 LE centièmes de °C + u8 lumière (%)
+// Les changements d'état sont poussés en texte, même JSON que /events.
+enum WebSocketCommand {
+    WS_CMD_LED = 1,
+    WS_CMD_MODE = 2,
+    WS_CMD_THRESHOLD = 3,
+    WS_CMD_STATE = 4
+};
+
+enum WebSocketStatus {
+    WS_STATUS_OK = 0,
+    WS_STATUS_BAD_COMMAND = 1,
+    WS_STATUS_BAD_ARGS = 2
+};
+
+// État servi par /status, relevé d'un bloc : l'ETag et le corps viennent
+// de la même lecture. Toute différence fait avancer la version.
+struct ApiState {
+    ControlSettings settings;   // contenu de /threshold
+    float temperature;
+    int lightRaw;
+    int lightPercent;
+    bool led;
+    bool outbox;                // FirebaseOutbox attachée
+    uint32_t outboxDepth;
+    float outboxDrainRate;
+    unsigned long outboxDelivered;
+    unsigned long outboxFailed;
+};
+
+// Ressources versionnées (GET conditionnel, long-poll)
+enum VersionedResource {
+    RESOURCE_STATUS,
+    RESOURCE_THRESHOLD
+};
+
+// Requête ?wait_for_change=ms retenue par le moteur (deferResponse)
+struct LongPoll {
+    int client;              // connexion, -1 : entrée libre
+    uint8_t resource;        // VersionedResource
+    uint8_t format;          // ResponseFormat négocié à la requête
+    bool conditional;        // If-None-Match à jour : 304 si rien ne bouge
+    uint32_t version;        // version à dépasser
+    unsigned long start;     // millis()
+    unsigned long timeout;   // ms
+};
+
+// Réponse /history en cours, gardée par la connexion (sendContentFrom) :
+// les tranches partent par lots à mesure que le client lit
+struct HistoryCursor {
+    uint32_t since;      // dernière tranche émise : reprise après sa fin
+    uint32_t step;
+    unsigned long now;   // millis() de la requête
+    bool started;        // en-tête du document écrit
+    bool first;          // aucune ligne écrite
+    bool done;
+};
+
+// Commande décodée (canal /ws ou /batch), validée avant d'être appliquée
+struct ApiCommand {
+    uint8_t command;   // WebSocketCommand
+    int arg;           // LED : 0 éteinte, 1 allumée, 2 bascule ; mode : index
+    float temp;
+    int light;
+};
 
 class RestAPI {
 private:
-    WebServer* _server;
+    // Route : chemin exact, méthode, handler ; hash FNV-1a du chemin calculé
+    // à la compilation (table constante en flash)
+    struct Route {
+        uint32_t hash;
+        const char* path;
+        HTTPMethod method;
+        void (RestAPI::*handler)();
+    };
+    static const Route ROUTES[];
+    static const uint8_t ROUTE_COUNT;
+    uint8_t _routeIndex[API_ROUTE_BUCKETS];   // numéro de route + 1, 0 = libre
+    void buildRouteIndex();
+    void handleRequest();
+
+    HttpServer* _server;
+    WebServerBackend _webServerBackend;   // constructeur WebServer* uniquement
     TemperatureControl* _tempSensor;
     PhotocellControl* _lightSensor;
     LedControl* _led;
+    SensorSampler* _sampler;
+    TaskMonitor* _monitor;
+    SensorHistory* _history;
+    FlashLog* _flashLog;
+    FirebaseOutbox* _outbox;
+    TelemetryPolicy* _telemetry;
     
-    float _tempThreshold;
-    int _lightThreshold;
-    bool _autoMode;
-    String _currentMode;
+    ControlSettings _settings;
+#ifdef ARDUINO_ARCH_ESP32
+    portMUX_TYPE _settingsMux;
+#else
+    std::mutex _settingsMutex;
+#endif
+    void lockSettings();
+    void unlockSettings();
+
+    // Flux /events et /ws : comparé et publié depuis handleClient(), même
+    // tâche que les handlers et que le serveur
+    EventState _eventState;
+    uint32_t _eventId;
+    unsigned long _eventAt;   // millis() du dernier envoi (événement ou ping)
+    bool _eventPending;       // commande WebSocket : publié sans délai minimal
+    EventState currentEvent();
+    size_t formatEvent(const EventState& state, bool retry, size_t& jsonAt, size_t& jsonLen);
+    void broadcastEvent(const EventState& state);
+    bool flushEvent();
+    void sendEventState(int client);
+    void publishEvents();
+
+    // Version de l'état : avance à chaque différence constatée (handlers et
+    // handleClient(), même tâche) ; /threshold garde celle de son dernier
+    // changement de réglages. Préfixe aléatoire : pas de 304 d'un boot à l'autre.
+    ApiState _apiState;
+    uint32_t _stateVersion;
+    uint32_t _settingsVersion;
+    uint32_t _bootId;
+    LongPoll _longPolls[LONGPOLL_MAX_WAITERS];
+    ApiState currentState();
+    void refreshVersion();
+    uint32_t resourceVersion(uint8_t resource);
+    void formatETag(char* etag, size_t size, uint32_t version);
+    void handleConditional(uint8_t resource);
+    bool parkRequest(uint8_t resource, uint32_t version, bool conditional, unsigned long wait);
+    void sendVersioned(uint8_t resource, bool notModified);
+    void sendStatus();
+    void sendThreshold();
+    void serveLongPolls();
+
+    bool applyMode(String mode);
+    void handleWebSocketMessage(int client, bool binary, const uint8_t* data, size_t len);
+    uint8_t parseCommand(JsonVariant op, ApiCommand& command);
+    uint8_t checkCommand(const ApiCommand& command);
+    void applyCommands(const ApiCommand* commands, size_t count);
     
-    // ✅ AJOUTÉ : Fonction pour les headers CORS
-    void sendCorsHeaders();
+    // Tampon réutilisé par toutes les réponses (handlers exécutés un par un)
+    char _jsonBuffer[JSON_RESPONSE_SIZE];
+    ResponseFormat _format;   // négocié par handleRequest() (en-tête Accept)
+    void sendJson(int code, JsonDocument& doc);
     
     // Handlers privés
     void handleGetSensors();
@@ -34,12 +210,32 @@ private:
     void handleGetThreshold();
     void handleSetMode();
     void handleGetStatus();
+    void handleGetSystem();
+    void handleGetHistory();
+    size_t produceHistory(HistoryCursor& cursor, char* buffer, size_t size);
+    void handleGetFlashHistory();
+    void handleEvents();
+    void handleWebSocket();
+    void handleBatch();
+    void handleGetTelemetry();
+    void handleSetTelemetry();
+    void handleApiDocs();
     void handleNotFound();
     
 public:
+    RestAPI(HttpServer* server, TemperatureControl* temp, 
+            PhotocellControl* light, LedControl* led,
+            SensorSampler* sampler);
+    // Repli : bibliothèque WebServer du core, enveloppée dans WebServerBackend
     RestAPI(WebServer* server, TemperatureControl* temp, 
-            PhotocellControl* light, LedControl* led);
+            PhotocellControl* light, LedControl* led,
+            SensorSampler* sampler);
     
+    void setMonitor(TaskMonitor* monitor);
+    void setHistory(SensorHistory* history);
+    void setFlashLog(FlashLog* flashLog);
+    void setOutbox(FirebaseOutbox* outbox);
+    void setTelemetryPolicy(TelemetryPolicy* policy);
     void begin();
     void handleClient();
     void setThreshold(float temp, int light);
@@ -47,6 +243,7 @@ public:
     bool getAutoMode();
     void setCurrentMode(String mode);
     String getCurrentMode();  // ✅ AJOUTEZ cette ligne
+    ControlSettings getSettings();
     void updateAutoMode(float currentTemp, int currentLight);
 };
 
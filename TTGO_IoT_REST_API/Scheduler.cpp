@@ -0,0 +1,137 @@
+#include "Scheduler.h"
+
+Scheduler::Scheduler(TaskCallback service) {
+    _count = 0;
+    _service = service;
+    _lastService = 0;
+    _maxServiceGap = 0;
+    _services = 0;
+}
+
+// ========================================
+// TÂCHES
+// ========================================
+// Retourne l'identifiant de la tâche, -1 si la table est pleine
+int Scheduler::add(const char* name, unsigned long periodMs, TaskCallback callback,
+                   unsigned long offsetMs) {
+    if (_count >= SCHEDULER_MAX_TASKS) return -1;
+
+    ScheduledTask& task = _tasks[_count];
+    task.name = name;
+    task.callback = callback;
+    task.period = periodMs;
+    task.next = millis() + offsetMs;
+    task.runs = 0;
+    task.skipped = 0;
+    task.maxDuration = 0;
+    task.enabled = true;
+    return _count++;
+}
+
+void Scheduler::setPeriod(int id, unsigned long periodMs) {
+    if (id < 0 || id >= _count) return;
+    _tasks[id].period = periodMs;
+    _tasks[id].next = millis() + periodMs;
+}
+
+void Scheduler::setEnabled(int id, bool enabled) {
+    if (id < 0 || id >= _count) return;
+    _tasks[id].enabled = enabled;
+    if (enabled) _tasks[id].next = millis();
+}
+
+// NULL : le service est assuré ailleurs (tâche HTTP sur l'autre cœur)
+void Scheduler::setService(TaskCallback service) {
+    _service = service;
+}
+
+// ========================================
+// EXÉCUTION
+// ========================================
+void Scheduler::service() {
+    unsigned long now = micros();
+    if (_services > 0 && now - _lastService > _maxServiceGap) {
+        _maxServiceGap = now - _lastService;
+    }
+    _lastService = now;
+    _services++;
+
+    if (_service) _service();
+}
+
+// Un passage : service, puis chaque tâche échue suivie d'un service.
+// À appeler en boucle depuis loop(), sans delay().
+void Scheduler::runOnce() {
+    service();
+
+    for (int i = 0; i < _count; i++) {
+        ScheduledTask& task = _tasks[i];
+        if (!task.enabled) continue;
+
+        unsigned long now = millis();
+        if ((long)(now - task.next) < 0) continue;
+
+        unsigned long start = micros();
+        task.callback();
+        unsigned long duration = micros() - start;
+        if (duration > task.maxDuration) task.maxDuration = duration;
+        task.runs++;
+
+        // Cadence fixe ; après un gros retard on repart de maintenant
+        // plutôt que d'enchaîner les exécutions en rafale
+        task.next += task.period;
+        if ((long)(millis() - task.next) >= 0) {
+            task.skipped += (millis() - task.next) / task.period + 1;
+            task.next = millis() + task.period;
+        }
+
+        service();
+    }
+    yield();
+}
+
+// Attente active qui continue de servir les clients (démarrage)
+void Scheduler::serviceFor(unsigned long ms) {
+    unsigned long start = millis();
+    while (millis() - start < ms) {
+        service();
+        yield();
+    }
+}
+
+// Temps avant la prochaine échéance : loop() peut dormir au lieu de boucler
+// quand aucune fonction de service n'est à appeler
+unsigned long Scheduler::msUntilNext() {
+    unsigned long now = millis();
+    unsigned long wait = (unsigned long)-1;
+    for (int i = 0; i < _count; i++) {
+        if (!_tasks[i].enabled) continue;
+        long remaining = (long)(_tasks[i].next - now);
+        if (remaining <= 0) return 0;
+        if ((unsigned long)remaining < wait) wait = remaining;
+    }
+    return wait == (unsigned long)-1 ? 0 : wait;
+}
+
+// ========================================
+// STATISTIQUES
+// ========================================
+int Scheduler::taskCount() { return _count; }
+
+const ScheduledTask* Scheduler::task(int id) {
+    if (id < 0 || id >= _count) return NULL;
+    return &_tasks[id];
+}
+
+unsigned long Scheduler::maxServiceGap() { return _maxServiceGap; }
+unsigned long Scheduler::serviceCount() { return _services; }
+
+void Scheduler::resetStats() {
+    _maxServiceGap = 0;
+    _services = 0;
+    for (int i = 0; i < _count; i++) {
+        _tasks[i].runs = 0;
+        _tasks[i].skipped = 0;
+        _tasks[i].maxDuration = 0;
+    }
+}
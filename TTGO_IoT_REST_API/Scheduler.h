@@ -0,0 +1,60 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+#define SCHEDULER_MAX_TASKS 8
+
+typedef void (*TaskCallback)();
+
+// Tâche périodique : échéance en millis(), statistiques d'exécution
+struct ScheduledTask {
+    const char* name;
+    TaskCallback callback;
+    unsigned long period;
+    unsigned long next;          // prochaine échéance (millis)
+    unsigned long runs;
+    unsigned long skipped;       // périodes sautées (retard > une période)
+    unsigned long maxDuration;   // µs
+    bool enabled;
+};
+
+// ========================================
+// ORDONNANCEUR COOPÉRATIF
+// ========================================
+// Remplace les delay() de loop() : chaque tâche a une échéance millis() et
+// la fonction de service (handleClient) est appelée avant chaque tâche.
+// L'écart entre deux services est donc borné par la tâche la plus longue.
+class Scheduler {
+private:
+    ScheduledTask _tasks[SCHEDULER_MAX_TASKS];
+    int _count;
+    TaskCallback _service;
+
+    unsigned long _lastService;   // µs
+    unsigned long _maxServiceGap; // µs
+    unsigned long _services;
+
+    void service();
+
+public:
+    Scheduler(TaskCallback service);
+
+    int add(const char* name, unsigned long periodMs, TaskCallback callback,
+            unsigned long offsetMs = 0);
+    void setPeriod(int id, unsigned long periodMs);
+    void setEnabled(int id, bool enabled);
+    void setService(TaskCallback service);
+
+    void runOnce();
+    void serviceFor(unsigned long ms);
+    unsigned long msUntilNext();
+
+    int taskCount();
+    const ScheduledTask* task(int id);
+    unsigned long maxServiceGap();
+    unsigned long serviceCount();
+    void resetStats();
+};
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef SENSOR_FILTER_H
+#define SENSOR_FILTER_H
+
+#include <stdint.h>
+
+// ========================================
+// FILTRES DE LISSAGE ADC
+// ========================================
+// Taille fixée à la compilation (FILTER_SIZE), aucune allocation.
+//   FILTER_MEAN   : moyenne glissante, somme tenue à jour -> O(1)
+//   FILTER_MEDIAN : médiane glissante, tableau trié tenu à jour -> O(N)
+//   FILTER_EMA    : moyenne exponentielle, alpha = 2 / (N + 1) -> O(1)
+enum FilterKind {
+    FILTER_MEAN,
+    FILTER_MEDIAN,
+    FILTER_EMA
+};
+
+template <int N, FilterKind K = FILTER_MEAN>
+class SensorFilter;
+
+// ========================================
+// MOYENNE GLISSANTE
+// ========================================
+template <int N>
+class SensorFilter<N, FILTER_MEAN> {
+private:
+    int _buffer[N];
+    int _index;
+    long _sum;
+
+public:
+    SensorFilter() { fill(0); }
+
+    void fill(int value) {
+        for (int i = 0; i < N; i++) _buffer[i] = value;
+        _index = 0;
+        _sum = (long)value * N;
+    }
+
+    int update(int sample) {
+        _sum += sample - _buffer[_index];
+        _buffer[_index] = sample;
+        if (++_index == N) _index = 0;
+        return value();
+    }
+
+    int value() const { return _sum / N; }
+};
+
+// ========================================
+// MÉDIANE GLISSANTE
+// ========================================
+template <int N>
+class SensorFilter<N, FILTER_MEDIAN> {
+private:
+    int _buffer[N];   // ordre d'arrivée
+    int _sorted[N];   // mêmes valeurs, triées
+    int _index;
+
+public:
+    SensorFilter() { fill(0); }
+
+    void fill(int value) {
+        for (int i = 0; i < N; i++) {
+            _buffer[i] = value;
+            _sorted[i] = value;
+        }
+        _index = 0;
+    }
+
+    int update(int sample) {
+        int outgoing = _buffer[_index];
+        _buffer[_index] = sample;
+        if (++_index == N) _index = 0;
+
+        // Retire la valeur sortante puis insère la nouvelle à sa place
+        int pos = 0;
+        while (_sorted[pos] != outgoing) pos++;
+        for (; pos < N - 1; pos++) _sorted[pos] = _sorted[pos + 1];
+
+        pos = N - 1;
+        while (pos > 0 && _sorted[pos - 1] > sample) {
+            _sorted[pos] = _sorted[pos - 1];
+            pos--;
+        }
+        _sorted[pos] = sample;
+
+        return value();
+    }
+
+    int value() const {
+        if (N % 2) return _sorted[N / 2];
+        return (_sorted[N / 2 - 1] + _sorted[N / 2]) / 2;
+    }
+};
+
+// ========================================
+// MOYENNE EXPONENTIELLE
+// ========================================
+template <int N>
+class SensorFilter<N, FILTER_EMA> {
+private:
+    static const int SHIFT = 16;   // état en virgule fixe Q16
+    int64_t _state;
+
+public:
+    SensorFilter() { fill(0); }
+
+    void fill(int value) {
+        _state = (int64_t)value << SHIFT;
+    }
+
+    int update(int sample) {
+        _state += (((int64_t)sample << SHIFT) - _state) * 2 / (N + 1);
+        return value();
+    }
+
+    int value() const {
+        return (int)((_state + (1 << (SHIFT - 1))) >> SHIFT);
+    }
+};
+
+#endif
@@ -0,0 +1,163 @@
+#include "SensorHistory.h"
+
+SensorHistory::SensorHistory() {
+    _total = 0;
+#ifdef ARDUINO_ARCH_ESP32
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void SensorHistory::lock() { portENTER_CRITICAL(&_mux); }
+void SensorHistory::unlock() { portEXIT_CRITICAL(&_mux); }
+#else
+void SensorHistory::lock() { _mutex.lock(); }
+void SensorHistory::unlock() { _mutex.unlock(); }
+#endif
+
+// ========================================
+// ENREGISTREMENT
+// ========================================
+int16_t SensorHistory::centiTemp(float temperature) {
+    float centi = temperature * 100.0f;
+    return centi > 32767.0f ? 32767 : centi < -32768.0f ? -32768 : (int16_t)lroundf(centi);
+}
+
+uint16_t SensorHistory::centiLight(int lightRaw) {
+    return (uint16_t)(constrain((long)lightRaw, 0L, 4095L) * 10000L / 4095L);
+}
+
+int SensorHistory::formatCenti(char* out, size_t size, long centi) {
+    const char* sign = centi < 0 ? "-" : "";
+    if (centi < 0) centi = -centi;
+    return snprintf(out, size, "%s%ld.%02ld", sign, centi / 100, centi % 100);
+}
+
+void SensorHistory::record(float temperature, int lightRaw, bool led, uint32_t timestamp) {
+    int16_t temp = centiTemp(temperature);
+    uint16_t light = centiLight(lightRaw);
+
+    lock();
+    size_t slot = _total % HISTORY_CAPACITY;
+    _time[slot] = timestamp;
+    _temp[slot] = temp;
+    _light[slot] = light;
+    if (led) {
+        _led[slot / 8] |= (uint8_t)(1 << (slot % 8));
+    } else {
+        _led[slot / 8] &= (uint8_t)~(1 << (slot % 8));
+    }
+    _total++;
+    unlock();
+}
+
+void SensorHistory::clear() {
+    lock();
+    _total = 0;
+    unlock();
+}
+
+size_t SensorHistory::size() {
+    lock();
+    size_t count = _total < HISTORY_CAPACITY ? _total : HISTORY_CAPACITY;
+    unlock();
+    return count;
+}
+
+uint32_t SensorHistory::total() {
+    lock();
+    uint32_t count = _total;
+    unlock();
+    return count;
+}
+
+// ========================================
+// LECTURE
+// ========================================
+// Index global du premier échantillon postérieur à since (horodatages
+// croissants : recherche dichotomique). Appelé verrou pris.
+uint32_t SensorHistory::firstAfter(uint32_t since) {
+    uint32_t low = _total > HISTORY_CAPACITY ? _total - HISTORY_CAPACITY : 0;
+    uint32_t high = _total;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if ((int32_t)(_time[mid % HISTORY_CAPACITY] - since) > 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+size_t SensorHistory::aggregate(uint32_t since, uint32_t step,
+                                std::function<void(const HistoryBucket&)> emit,
+                                size_t maxBuckets) {
+    if (step == 0) step = 1;
+    if (maxBuckets == 0) return 0;
+
+    uint32_t time[HISTORY_BATCH];
+    int16_t temp[HISTORY_BATCH];
+    uint16_t light[HISTORY_BATCH];
+    bool led[HISTORY_BATCH];
+
+    HistoryBucket bucket;
+    bucket.count = 0;
+    size_t buckets = 0;
+
+    // Borne fixée à l'entrée : un lecteur lent ne poursuit pas l'écrivain
+    lock();
+    uint32_t next = firstAfter(since);
+    uint32_t end = _total;
+    unlock();
+
+    for (;;) {
+        // Lot suivant ; si l'écrivain a dépassé le lecteur, on reprend au plus ancien
+        size_t n = 0;
+        lock();
+        uint32_t oldest = _total > HISTORY_CAPACITY ? _total - HISTORY_CAPACITY : 0;
+        if (next < oldest) next = oldest;
+        while (n < HISTORY_BATCH && next < end) {
+            size_t slot = next % HISTORY_CAPACITY;
+            time[n] = _time[slot];
+            temp[n] = _temp[slot];
+            light[n] = _light[slot];
+            led[n] = (_led[slot / 8] >> (slot % 8)) & 1;
+            n++;
+            next++;
+        }
+        unlock();
+        if (n == 0) break;
+
+        for (size_t i = 0; i < n; i++) {
+            uint32_t start = time[i] - time[i] % step;
+            if (bucket.count > 0 && start != bucket.start) {
+                emit(bucket);
+                if (++buckets == maxBuckets) return buckets;
+                bucket.count = 0;
+            }
+            if (bucket.count == 0) {
+                bucket.start = start;
+                bucket.tempMin = bucket.tempMax = temp[i];
+                bucket.tempSum = 0;
+                bucket.lightMin = bucket.lightMax = light[i];
+                bucket.lightSum = 0;
+                bucket.ledOn = 0;
+            }
+            if (temp[i] < bucket.tempMin) bucket.tempMin = temp[i];
+            if (temp[i] > bucket.tempMax) bucket.tempMax = temp[i];
+            if (light[i] < bucket.lightMin) bucket.lightMin = light[i];
+            if (light[i] > bucket.lightMax) bucket.lightMax = light[i];
+            bucket.tempSum += temp[i];
+            bucket.lightSum += light[i];
+            if (led[i]) bucket.ledOn++;
+            bucket.count++;
+        }
+    }
+
+    if (bucket.count > 0) {
+        emit(bucket);
+        buckets++;
+    }
+    return buckets;
+}
@@ -0,0 +1,78 @@
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <Arduino.h>
+#include <functional>
+#ifndef ARDUINO_ARCH_ESP32
+#include <mutex>
+#endif
+#include "config.h"
+
+// Échantillons copiés par lot sous verrou avant agrégation
+#define HISTORY_BATCH 32
+
+// Agrégat d'une tranche de temps (valeurs en virgule fixe)
+struct HistoryBucket {
+    uint32_t start;        // millis() du début de la tranche
+    uint16_t count;
+    int16_t tempMin;       // centièmes de °C
+    int16_t tempMax;
+    int32_t tempSum;
+    uint16_t lightMin;     // centièmes de %
+    uint16_t lightMax;
+    uint32_t lightSum;
+    uint16_t ledOn;        // échantillons LED allumée
+};
+
+// ========================================
+// HISTORIQUE CIRCULAIRE EN RAM
+// ========================================
+// Tableaux séparés par champ (struct-of-arrays), 16 bits en virgule fixe :
+// 8 octets et 1 bit par échantillon, HISTORY_CAPACITY échantillons au plus,
+// les plus anciens écrasés. Un écrivain (tâche de contrôle), des lecteurs
+// HTTP sur l'autre cœur : les lecteurs copient par lots de HISTORY_BATCH
+// sous une courte section critique et agrègent hors verrou.
+class SensorHistory {
+private:
+    uint32_t _time[HISTORY_CAPACITY];
+    int16_t _temp[HISTORY_CAPACITY];
+    uint16_t _light[HISTORY_CAPACITY];
+    uint8_t _led[(HISTORY_CAPACITY + 7) / 8];
+    uint32_t _total;   // échantillons enregistrés depuis le démarrage
+
+#ifdef ARDUINO_ARCH_ESP32
+    portMUX_TYPE _mux;
+#else
+    std::mutex _mutex;
+#endif
+    void lock();
+    void unlock();
+
+    uint32_t firstAfter(uint32_t since);
+
+public:
+    SensorHistory();
+
+    void record(float temperature, int lightRaw, bool led, uint32_t timestamp);
+    void clear();
+
+    // Agrège les échantillons postérieurs à since par tranches de step ms
+    // et appelle emit pour chacune, dans l'ordre chronologique ; s'arrête
+    // après maxBuckets tranches (reprise : since = début + step - 1)
+    size_t aggregate(uint32_t since, uint32_t step,
+                     std::function<void(const HistoryBucket&)> emit,
+                     size_t maxBuckets = SIZE_MAX);
+
+    size_t size();
+    uint32_t total();
+    static size_t capacity() { return HISTORY_CAPACITY; }
+
+    // Virgule fixe partagée avec le journal flash : centièmes de °C
+    // (bornés à int16) et centièmes de % de la plage ADC
+    static int16_t centiTemp(float temperature);
+    static uint16_t centiLight(int lightRaw);
+    // Centièmes -> "12.34" sans passer par un float ; retourne comme snprintf
+    static int formatCenti(char* out, size_t size, long centi);
+};
+
+#endif
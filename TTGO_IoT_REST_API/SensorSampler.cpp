@@ -0,0 +1,129 @@
+#include "SensorSampler.h"
+
+SensorSampler::SensorSampler(TemperatureControl* temp, PhotocellControl* light,
+                             unsigned long periodMs)
+    : _seq(0), _running(false) {
+    _tempSensor = temp;
+    _lightSensor = light;
+    _periodMs = periodMs;
+    _published = 0;
+    _monitor = NULL;
+
+    _snapshot.temperature = 25.0;
+    _snapshot.lightRaw = 0;
+    _snapshot.lightPercent = 0;
+    _snapshot.timestamp = 0;
+    _snapshot.sequence = 0;
+
+#ifdef ARDUINO_ARCH_ESP32
+    _task = NULL;
+#endif
+}
+
+// ========================================
+// DÉMARRAGE / ARRÊT DE LA TÂCHE
+// ========================================
+void SensorSampler::begin() {
+    if (_running) return;
+
+    // Première acquisition synchrone : le snapshot est valide dès le retour
+    sampleOnce();
+    _running = true;
+
+#ifdef ARDUINO_ARCH_ESP32
+    xTaskCreatePinnedToCore(taskEntry, "sampler", 4096, this, 1, &_task, CORE_CONTROL);
+#else
+    _thread = std::thread([this]() { run(); });
+#endif
+}
+
+// À appeler avant begin() : la tâche s'enregistre au démarrage
+void SensorSampler::setMonitor(TaskMonitor* monitor) {
+    _monitor = monitor;
+}
+
+void SensorSampler::stop() {
+    if (!_running) return;
+    _running = false;
+
+#ifdef ARDUINO_ARCH_ESP32
+    // La tâche se termine d'elle-même à la fin de sa période
+    _task = NULL;
+#else
+    if (_thread.joinable()) _thread.join();
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void SensorSampler::taskEntry(void* arg) {
+    static_cast<SensorSampler*>(arg)->run();
+    vTaskDelete(NULL);
+}
+#endif
+
+void SensorSampler::run() {
+    int monitorId = _monitor ? _monitor->registerCurrentTask("sampler", CORE_CONTROL) : -1;
+    unsigned long next = millis();
+    while (_running) {
+        unsigned long start = micros();
+        sampleOnce();
+        if (_monitor) _monitor->addBusy(monitorId, micros() - start);
+
+        // Période fixe : on vise l'échéance, pas "période après la fin"
+        next += _periodMs;
+        long wait = (long)(next - millis());
+        if (wait > 0) {
+            delay(wait);
+        } else {
+            next = millis();
+        }
+    }
+    if (_monitor) _monitor->detach(monitorId);
+}
+
+// ========================================
+// ACQUISITION
+// ========================================
+void SensorSampler::sampleOnce() {
+    TemperatureReading temp = _tempSensor->read();
+    LightReading light = _lightSensor->read();
+
+    publish(temp.celsius, light.raw, light.percent);
+}
+
+// ========================================
+// SEQLOCK
+// ========================================
+void SensorSampler::publish(float temperature, int lightRaw, int lightPercent) {
+    uint32_t seq = _seq.load(std::memory_order_relaxed);
+    _seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _published++;
+    _snapshot.temperature = temperature;
+    _snapshot.lightRaw = lightRaw;
+    _snapshot.lightPercent = lightPercent;
+    _snapshot.timestamp = millis();
+    _snapshot.sequence = _published;
+
+    _seq.store(seq + 2, std::memory_order_release);
+}
+
+SensorSnapshot SensorSampler::getSnapshot() const {
+    SensorSnapshot copy;
+    uint32_t before;
+    uint32_t after;
+
+    do {
+        before = _seq.load(std::memory_order_acquire);
+        copy = _snapshot;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = _seq.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    return copy;
+}
+
+unsigned long SensorSampler::getPeriod() {
+    return _periodMs;
+}
@@ -0,0 +1,64 @@
+#ifndef SENSOR_SAMPLER_H
+#define SENSOR_SAMPLER_H
+
+#include <Arduino.h>
+#include <atomic>
+#ifndef ARDUINO_ARCH_ESP32
+#include <thread>
+#endif
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "TaskMonitor.h"
+
+// Dernières valeurs mesurées, publiées par le sampler
+struct SensorSnapshot {
+    float temperature;
+    int lightRaw;
+    int lightPercent;
+    unsigned long timestamp;   // millis() de l'acquisition
+    uint32_t sequence;         // nombre d'acquisitions publiées
+};
+
+// ========================================
+// ÉCHANTILLONNEUR EN TÂCHE DE FOND
+// ========================================
+// Lit les capteurs à période fixe dans sa propre tâche et publie un
+// snapshot via un seqlock : un seul écrivain, lecteurs sans verrou.
+// Les handlers HTTP, loop(), l'écran et Firebase lisent getSnapshot()
+// en O(1) sans jamais toucher à l'ADC.
+class SensorSampler {
+private:
+    TemperatureControl* _tempSensor;
+    PhotocellControl* _lightSensor;
+    unsigned long _periodMs;
+
+    std::atomic<uint32_t> _seq;   // impair = écriture en cours
+    SensorSnapshot _snapshot;
+    uint32_t _published;
+    std::atomic<bool> _running;
+    TaskMonitor* _monitor;
+
+    void publish(float temperature, int lightRaw, int lightPercent);
+    void run();
+
+#ifdef ARDUINO_ARCH_ESP32
+    TaskHandle_t _task;
+    static void taskEntry(void* arg);
+#else
+    std::thread _thread;
+#endif
+
+public:
+    SensorSampler(TemperatureControl* temp, PhotocellControl* light,
+                  unsigned long periodMs = SAMPLE_INTERVAL);
+
+    void setMonitor(TaskMonitor* monitor);
+    void begin();
+    void stop();
+    void sampleOnce();
+    SensorSnapshot getSnapshot() const;
+    unsigned long getPeriod();
+};
+
+#endif
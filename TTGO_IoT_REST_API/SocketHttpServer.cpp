@@ -0,0 +1,1023 @@
+#include "SocketHttpServer.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#ifdef ARDUINO_ARCH_ESP32
+#include <lwip/sockets.h>
+#else
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#endif
+#include "Logger.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static const char* statusText(int code) {
+    switch (code) {
+        case 101: return "Switching Protocols";
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default:  return "";
+    }
+}
+
+static bool parseMethod(const char* name, HTTPMethod& method) {
+    static const struct { const char* name; HTTPMethod method; } methods[] = {
+        { "GET", HTTP_GET }, { "POST", HTTP_POST }, { "PUT", HTTP_PUT },
+        { "PATCH", HTTP_PATCH }, { "DELETE", HTTP_DELETE },
+        { "OPTIONS", HTTP_OPTIONS }, { "HEAD", HTTP_HEAD },
+    };
+    for (size_t i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+        if (strcmp(name, methods[i].name) == 0) {
+            method = methods[i].method;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// Décodage URL en place (+ et %XX), le résultat n'est jamais plus long
+static void urlDecode(char* s) {
+    char* out = s;
+    for (char* in = s; *in; in++) {
+        if (*in == '+') {
+            *out++ = ' ';
+        } else if (*in == '%' && in[1] && in[2]) {
+            char hex[3] = { in[1], in[2], 0 };
+            *out++ = (char)strtol(hex, NULL, 16);
+            in += 2;
+        } else {
+            *out++ = *in;
+        }
+    }
+    *out = '\0';
+}
+
+// Content-Length lu sans modifier le tampon : la requête peut être incomplète.
+// Chiffres décimaux seuls (strtoul accepterait "-1") ; la valeur est plafonnée
+// à HTTP_RX_BUFFER, déjà trop grande, pour que l'addition ne déborde pas.
+// Retourne false si la valeur est mal formée.
+static bool scanContentLength(const char* start, const char* end, size_t& length) {
+    static const char name[] = "\r\nContent-Length:";
+    const size_t nameLen = sizeof(name) - 1;
+    length = 0;
+    for (const char* p = start; p + nameLen <= end; p++) {
+        if (*p != '\r' || strncasecmp(p, name, nameLen) != 0) continue;
+        p += nameLen;
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        if (p == end || *p < '0' || *p > '9') return false;
+        for (; p < end && *p >= '0' && *p <= '9'; p++) {
+            if (length < HTTP_RX_BUFFER) length = length * 10 + (*p - '0');
+        }
+        if (length > HTTP_RX_BUFFER) length = HTTP_RX_BUFFER;
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        return p < end && *p == '\r';
+    }
+    return true;
+}
+
+// ========================================
+// POIGNÉE DE MAIN WEBSOCKET
+// ========================================
+// SHA-1 (RFC 3174) du seul message key + GUID, ~60 octets : pas besoin de
+// l'API mbedTLS de l'ESP32, et le même code tourne sur l'hôte
+static uint32_t rotl(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+static void sha1Block(uint32_t h[5], const uint8_t block[64]) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t)block[i * 4] << 24 | (uint32_t)block[i * 4 + 1] << 16 |
+               (uint32_t)block[i * 4 + 2] << 8 | block[i * 4 + 3];
+    }
+    for (int i = 16; i < 80; i++) w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (int i = 0; i < 80; i++) {
+        uint32_t f, k;
+        if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+        else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+        else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+        else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+        uint32_t t = rotl(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rotl(b, 30);
+        b = a;
+        a = t;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+}
+
+static void sha1(const uint8_t* data, size_t len, uint8_t digest[20]) {
+    uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    uint8_t block[64];
+    size_t done = 0;
+    for (; done + 64 <= len; done += 64) sha1Block(h, data + done);
+
+    // Bourrage : 0x80, zéros, longueur en bits sur 64 bits
+    size_t rest = len - done;
+    memset(block, 0, sizeof(block));
+    memcpy(block, data + done, rest);
+    block[rest] = 0x80;
+    if (rest >= 56) {
+        sha1Block(h, block);
+        memset(block, 0, sizeof(block));
+    }
+    uint64_t bits = (uint64_t)len * 8;
+    for (int i = 0; i < 8; i++) block[63 - i] = (uint8_t)(bits >> (i * 8));
+    sha1Block(h, block);
+
+    for (int i = 0; i < 20; i++) digest[i] = (uint8_t)(h[i / 4] >> (24 - (i % 4) * 8));
+}
+
+static size_t base64(const uint8_t* data, size_t len, char* out) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t n = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)data[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < len) v |= data[i + 2];
+        out[n++] = alphabet[(v >> 18) & 0x3F];
+        out[n++] = alphabet[(v >> 12) & 0x3F];
+        out[n++] = i + 1 < len ? alphabet[(v >> 6) & 0x3F] : '=';
+        out[n++] = i + 2 < len ? alphabet[v & 0x3F] : '=';
+    }
+    out[n] = '\0';
+    return n;
+}
+
+// Sec-WebSocket-Accept = base64(SHA-1(clé + GUID))
+static void webSocketAccept(const char* key, char out[29]) {
+    static const char guid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    char message[64 + sizeof(guid)];
+    int len = snprintf(message, sizeof(message), "%.64s%s", key, guid);
+    uint8_t digest[20];
+    sha1((const uint8_t*)message, len, digest);
+    base64(digest, sizeof(digest), out);
+}
+
+enum WebSocketOpcode {
+    WS_CONTINUATION = 0x0,
+    WS_TEXT = 0x1,
+    WS_BINARY = 0x2,
+    WS_CLOSE = 0x8,
+    WS_PING = 0x9,
+    WS_PONG = 0xA
+};
+
+SocketHttpServer::SocketHttpServer(uint16_t port) {
+    _port = port;
+    _listenFd = -1;
+    _pollTimeout = 0;
+    _routeCount = 0;
+    _collectedCount = 0;
+    _current = NULL;
+    _uri = NULL;
+    _argCount = 0;
+    _headerCount = 0;
+    _body = NULL;
+    _bodyLen = 0;
+    _webSocketKey = NULL;
+    _responseHeadersLen = 0;
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+    _responseStarted = false;
+    _chunked = false;
+    _requests = 0;
+    _accepted = 0;
+    _streamsDropped = 0;
+
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        _clients[i].fd = -1;
+        _clients[i].rxLen = 0;
+        _clients[i].txLen = 0;
+        _clients[i].txSent = 0;
+        _clients[i].closeAfterSend = false;
+        _clients[i].stream = HTTP_STREAM_NONE;
+        _clients[i].chunked = false;
+    }
+}
+
+SocketHttpServer::~SocketHttpServer() {
+    stop();
+}
+
+// ========================================
+// DÉMARRAGE / ARRÊT
+// ========================================
+void SocketHttpServer::begin() {
+    if (_listenFd >= 0) return;
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        LOG_ERROR("HTTP: socket() errno %d", errno);
+        return;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(_port);
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(fd, HTTP_MAX_CLIENTS * 2) < 0) {
+        LOG_ERROR("HTTP: port %u indisponible (errno %d)", _port, errno);
+        close(fd);
+        return;
+    }
+    setNonBlocking(fd);
+
+    // Port 0 : port éphémère choisi par le système (tests, charge)
+    socklen_t len = sizeof(addr);
+    if (getsockname(fd, (struct sockaddr*)&addr, &len) == 0) {
+        _port = ntohs(addr.sin_port);
+    }
+    _listenFd = fd;
+}
+
+void SocketHttpServer::stop() {
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        if (_clients[i].fd >= 0) closeClient(_clients[i]);
+    }
+    if (_listenFd >= 0) {
+        close(_listenFd);
+        _listenFd = -1;
+    }
+}
+
+// 0 : handleClient() ne fait que constater l'état des sockets (loop()).
+// > 0 : attente dans select(), pour une tâche dédiée au HTTP.
+void SocketHttpServer::setPollTimeout(unsigned long ms) {
+    _pollTimeout = ms;
+}
+
+uint16_t SocketHttpServer::port() { return _port; }
+
+// ========================================
+// BOUCLE D'ÉVÉNEMENTS
+// ========================================
+void SocketHttpServer::handleClient() {
+    if (_listenFd < 0) return;
+
+    fd_set readSet;
+    fd_set writeSet;
+    FD_ZERO(&readSet);
+    FD_ZERO(&writeSet);
+    int maxFd = -1;
+    bool freeSlot = false;
+
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        HttpConnection& client = _clients[i];
+        if (client.fd < 0) {
+            freeSlot = true;
+            continue;
+        }
+        // Réponse en attente : on ne lit pas la requête suivante avant.
+        // Réponse différée et tampon plein : rien à lire avant la reprise,
+        // select() rendrait la main aussitôt et la boucle tournerait à vide.
+        if (client.txSent < client.txLen) {
+            FD_SET(client.fd, &writeSet);
+        } else if (client.stream != HTTP_STREAM_DEFERRED || client.rxLen < HTTP_RX_BUFFER - 1) {
+            FD_SET(client.fd, &readSet);
+        }
+        if (client.fd > maxFd) maxFd = client.fd;
+    }
+    // Toutes les connexions occupées : les suivantes attendent dans le backlog
+    if (freeSlot) {
+        FD_SET(_listenFd, &readSet);
+        if (_listenFd > maxFd) maxFd = _listenFd;
+    }
+
+    struct timeval timeout;
+    timeout.tv_sec = _pollTimeout / 1000;
+    timeout.tv_usec = (_pollTimeout % 1000) * 1000;
+    int ready = select(maxFd + 1, &readSet, &writeSet, NULL, &timeout);
+
+    if (ready > 0) {
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+            HttpConnection& client = _clients[i];
+            if (client.fd < 0) continue;
+            if (FD_ISSET(client.fd, &writeSet)) {
+                if (flushClient(client)) processPending(client);
+            } else if (FD_ISSET(client.fd, &readSet)) {
+                readClient(client);
+            }
+        }
+        if (freeSlot && FD_ISSET(_listenFd, &readSet)) acceptClients();
+    }
+
+    // Connexions keep-alive inactives (un flux se tait entre deux événements) ;
+    // un corps produit dont le client ne lit plus rien est abandonné de même
+    unsigned long now = millis();
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        HttpConnection& client = _clients[i];
+        bool timed = !client.stream || client.stream == HTTP_STREAM_BODY;
+        if (client.fd >= 0 && timed && now - client.lastActivity > HTTP_KEEPALIVE_TIMEOUT) {
+            closeClient(client);
+        }
+    }
+}
+
+void SocketHttpServer::acceptClients() {
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        HttpConnection& client = _clients[i];
+        if (client.fd >= 0) continue;
+
+        int fd = accept(_listenFd, NULL, NULL);
+        if (fd < 0) return;
+
+        setNonBlocking(fd);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        client.fd = fd;
+        client.rxLen = 0;
+        client.txLen = 0;
+        client.txSent = 0;
+        client.closeAfterSend = false;
+        client.stream = HTTP_STREAM_NONE;
+        client.lastActivity = millis();
+        _accepted++;
+    }
+}
+
+void SocketHttpServer::readClient(HttpConnection& client) {
+    // Un octet réservé : la fin du corps est terminée par '\0'
+    size_t space = HTTP_RX_BUFFER - 1 - client.rxLen;
+    if (space == 0) {
+        processPending(client);
+        return;
+    }
+
+    ssize_t n = recv(client.fd, client.rx + client.rxLen, space, 0);
+    if (n == 0) {
+        closeClient(client);
+        return;
+    }
+    if (n < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) closeClient(client);
+        return;
+    }
+    // Un client SSE n'envoie rien d'utile : lu pour voir la fermeture
+    if (client.stream == HTTP_STREAM_EVENTS) return;
+    client.rxLen += n;
+    client.lastActivity = millis();
+    processPending(client);
+}
+
+// Traite les requêtes complètes du tampon, une réponse à la fois
+void SocketHttpServer::processPending(HttpConnection& client) {
+    if (client.fd >= 0 && !produceBody(client)) return;
+    while (client.fd >= 0 && client.txSent == client.txLen && !client.closeAfterSend && !client.stream) {
+        if (!processRequest(client)) break;
+        if (!flushClient(client)) return;
+        if (!produceBody(client)) return;
+    }
+    if (client.fd >= 0 && client.stream == HTTP_STREAM_WEBSOCKET) processFrames(client);
+    if (client.fd >= 0 && client.closeAfterSend && client.txSent == client.txLen &&
+        client.stream != HTTP_STREAM_DEFERRED && client.stream != HTTP_STREAM_BODY) {
+        closeClient(client);
+    }
+}
+
+// Envoie ce que la socket accepte. Retourne false si la connexion a été fermée.
+bool SocketHttpServer::flushClient(HttpConnection& client) {
+    while (client.txSent < client.txLen) {
+        ssize_t n = ::send(client.fd, client.tx + client.txSent,
+                         client.txLen - client.txSent, MSG_NOSIGNAL);
+        if (n > 0) {
+            client.txSent += n;
+            client.lastActivity = millis();
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        closeClient(client);
+        return false;
+    }
+    client.txLen = 0;
+    client.txSent = 0;
+    return true;
+}
+
+// Reste d'un envoi partiel ramené en tête du tampon
+void SocketHttpServer::compactTx(HttpConnection& client) {
+    if (client.txSent == 0) return;
+    memmove(client.tx, client.tx + client.txSent, client.txLen - client.txSent);
+    client.txLen -= client.txSent;
+    client.txSent = 0;
+}
+
+// Corps produit (sendContentFrom) : un morceau tant que le tampon a la place
+// et que la socket suit. Socket pleine : la suite attend que select() la dise
+// inscriptible. Retourne false si la connexion a été fermée.
+bool SocketHttpServer::produceBody(HttpConnection& client) {
+    while (client.stream == HTTP_STREAM_BODY) {
+        compactTx(client);
+        // Chunked : taille sur 4 chiffres hexa + CRLF, CRLF final, "0\r\n\r\n"
+        size_t framing = client.chunked ? 6 + 2 + 5 : 0;
+        size_t space = HTTP_TX_BUFFER - client.txLen;
+        if (space < HTTP_CONTENT_CHUNK + framing) return true;
+        size_t size = space - framing;
+        if (size > 0xFFFF) size = 0xFFFF;
+
+        char* out = client.tx + client.txLen + (client.chunked ? 6 : 0);
+        size_t n = client.producer(out, size);
+        if (n > 0 && client.chunked) {
+            char head[7];
+            snprintf(head, sizeof(head), "%04x\r\n", (unsigned)n);
+            memcpy(client.tx + client.txLen, head, 6);
+            memcpy(out + n, "\r\n", 2);
+            client.txLen += 6 + n + 2;
+        } else if (n > 0) {
+            client.txLen += n;
+        } else {
+            if (client.chunked) {
+                memcpy(client.tx + client.txLen, "0\r\n\r\n", 5);
+                client.txLen += 5;
+            }
+            client.producer = nullptr;
+            client.stream = HTTP_STREAM_NONE;
+        }
+        if (!flushClient(client)) return false;
+    }
+    return true;
+}
+
+void SocketHttpServer::closeClient(HttpConnection& client) {
+    close(client.fd);
+    client.fd = -1;
+    client.rxLen = 0;
+    client.txLen = 0;
+    client.txSent = 0;
+    client.closeAfterSend = false;
+    client.stream = HTTP_STREAM_NONE;
+    client.producer = nullptr;   // libère l'état du producteur
+}
+
+// ========================================
+// ANALYSE DE LA REQUÊTE
+// ========================================
+// Retourne true si une requête a été consommée (réponse en file)
+bool SocketHttpServer::processRequest(HttpConnection& client) {
+    client.rx[client.rxLen] = '\0';
+    char* headerEnd = strstr(client.rx, "\r\n\r\n");
+    if (!headerEnd) {
+        if (client.rxLen >= HTTP_RX_BUFFER - 1) sendError(client, 413, "En-tetes trop longs");
+        return false;
+    }
+
+    size_t headerLen = headerEnd - client.rx + 4;
+    size_t contentLength;
+    if (!scanContentLength(client.rx, headerEnd + 2, contentLength)) {
+        sendError(client, 400, "Content-Length invalide");
+        return false;
+    }
+    if (headerLen + contentLength + 1 > HTTP_RX_BUFFER - 1) {
+        sendError(client, 413, "Requete trop longue");
+        return false;
+    }
+    if (client.rxLen < headerLen + contentLength) return false;
+
+    // Corps terminé par '\0' : les octets suivants (pipelining) sont décalés
+    size_t total = headerLen + contentLength;
+    memmove(client.rx + total + 1, client.rx + total, client.rxLen - total);
+    client.rx[total] = '\0';
+    client.rxLen++;
+
+    bool keepAlive;
+    if (!parseRequest(client, headerLen, contentLength, keepAlive)) {
+        sendError(client, 400, "Requete invalide");
+        return false;
+    }
+    client.closeAfterSend = !keepAlive;
+
+    // Réponse, sauf si le handler l'a différée
+    startResponse(client);
+    dispatch();
+    if (client.stream != HTTP_STREAM_DEFERRED) endResponse();
+    _current = NULL;
+    _requests++;
+
+    if (client.fd < 0) return false;
+    size_t consumed = total + 1;
+    memmove(client.rx, client.rx + consumed, client.rxLen - consumed);
+    client.rxLen -= consumed;
+    if (client.stream == HTTP_STREAM_EVENTS) client.rxLen = 0;
+    return true;
+}
+
+bool SocketHttpServer::parseRequest(HttpConnection& client, size_t headerLen,
+                                    size_t contentLength, bool& keepAlive) {
+    char* rx = client.rx;
+    char* headerEnd = rx + headerLen - 4;
+
+    // Ligne de requête : MÉTHODE cible HTTP/1.x
+    char* lineEnd = strstr(rx, "\r\n");
+    *lineEnd = '\0';
+    char* target = strchr(rx, ' ');
+    if (!target) return false;
+    *target++ = '\0';
+    char* version = strchr(target, ' ');
+    if (!version) return false;
+    *version++ = '\0';
+    if (!parseMethod(rx, _method)) return false;
+    keepAlive = strcmp(version, "HTTP/1.1") == 0;
+
+    // En-têtes : seuls ceux demandés par collectHeaders() sont conservés
+    const char* contentType = "";
+    _headerCount = 0;
+    _webSocketKey = NULL;
+    char* line = lineEnd + 2;
+    while (line < headerEnd + 2) {
+        char* eol = strstr(line, "\r\n");
+        *eol = '\0';
+        char* colon = strchr(line, ':');
+        if (colon) {
+            *colon = '\0';
+            char* value = colon + 1;
+            while (*value == ' ' || *value == '\t') value++;
+
+            if (strcasecmp(line, "Connection") == 0) {
+                if (strcasecmp(value, "close") == 0) keepAlive = false;
+                else if (strcasecmp(value, "keep-alive") == 0) keepAlive = true;
+            } else if (strcasecmp(line, "Content-Type") == 0) {
+                contentType = value;
+            } else if (strcasecmp(line, "Sec-WebSocket-Key") == 0) {
+                _webSocketKey = value;
+            }
+            for (size_t i = 0; i < _collectedCount; i++) {
+                if (_headerCount < HTTP_MAX_COLLECTED_HEADERS && strcasecmp(line, _collected[i]) == 0) {
+                    _headers[_headerCount].name = _collected[i];
+                    _headers[_headerCount].value = value;
+                    _headerCount++;
+                }
+            }
+        }
+        line = eol + 2;
+    }
+
+    _body = rx + headerLen;
+    _bodyLen = contentLength;
+
+    _argCount = 0;
+    char* query = strchr(target, '?');
+    if (query) *query++ = '\0';
+    _uri = target;
+    if (query) parseArgs(query);
+    if (contentLength > 0 &&
+        strncasecmp(contentType, "application/x-www-form-urlencoded", 33) == 0) {
+        parseArgs((char*)_body);
+    }
+    return true;
+}
+
+void SocketHttpServer::parseArgs(char* query) {
+    char* p = query;
+    while (*p && _argCount < HTTP_MAX_ARGS) {
+        char* amp = strchr(p, '&');
+        if (amp) *amp = '\0';
+        char* eq = strchr(p, '=');
+        if (eq) *eq = '\0';
+
+        urlDecode(p);
+        if (eq) urlDecode(eq + 1);
+        _args[_argCount].name = p;
+        _args[_argCount].value = eq ? eq + 1 : "";
+        _argCount++;
+
+        if (!amp) break;
+        p = amp + 1;
+    }
+}
+
+void SocketHttpServer::dispatch() {
+    for (int i = 0; i < _routeCount; i++) {
+        const Route& route = _routes[i];
+        if ((route.method == HTTP_ANY || route.method == _method) && strcmp(route.uri, _uri) == 0) {
+            route.handler();
+            return;
+        }
+    }
+    if (_notFound) {
+        _notFound();
+    } else {
+        send(404, "text/plain", "Not found");
+    }
+}
+
+// Réponse d'erreur hors handler, la connexion est fermée ensuite
+void SocketHttpServer::sendError(HttpConnection& client, int code, const char* message) {
+    client.rxLen = 0;
+    client.closeAfterSend = true;
+
+    startResponse(client);
+    send(code, "text/plain", message);
+    _current = NULL;
+
+    if (flushClient(client) && client.txLen == 0) closeClient(client);
+}
+
+// Nouvelle réponse sur la connexion : en-têtes et longueur remis à zéro
+void SocketHttpServer::startResponse(HttpConnection& client) {
+    _current = &client;
+    _responseHeadersLen = 0;
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+    _responseStarted = false;
+    _chunked = false;
+}
+
+// ========================================
+// ROUTES
+// ========================================
+void SocketHttpServer::on(const char* uri, HTTPMethod method, THandlerFunction handler) {
+    if (_routeCount >= HTTP_MAX_ROUTES) {
+        LOG_ERROR("HTTP: table des routes pleine (%s)", uri);
+        return;
+    }
+    _routes[_routeCount].uri = uri;
+    _routes[_routeCount].method = method;
+    _routes[_routeCount].handler = handler;
+    _routeCount++;
+}
+
+void SocketHttpServer::onNotFound(THandlerFunction handler) {
+    _notFound = handler;
+}
+
+// Les noms doivent rester valides (littéraux) : seuls les pointeurs sont gardés
+void SocketHttpServer::collectHeaders(const char* headerKeys[], size_t headerKeysCount) {
+    _collectedCount = 0;
+    for (size_t i = 0; i < headerKeysCount && i < HTTP_MAX_COLLECTED_HEADERS; i++) {
+        _collected[_collectedCount++] = headerKeys[i];
+    }
+}
+
+// ========================================
+// REQUÊTE COURANTE
+// ========================================
+String SocketHttpServer::uri() { return String(_uri ? _uri : ""); }
+const char* SocketHttpServer::path() { return _uri ? _uri : ""; }
+HTTPMethod SocketHttpServer::method() { return _method; }
+
+bool SocketHttpServer::hasArg(const String& name) {
+    if (name == "plain") return _bodyLen > 0;
+    for (size_t i = 0; i < _argCount; i++) {
+        if (strcmp(_args[i].name, name.c_str()) == 0) return true;
+    }
+    return false;
+}
+
+String SocketHttpServer::arg(const String& name) {
+    if (name == "plain") return String(_bodyLen > 0 ? _body : "");
+    for (size_t i = 0; i < _argCount; i++) {
+        if (strcmp(_args[i].name, name.c_str()) == 0) return String(_args[i].value);
+    }
+    return String("");
+}
+
+String SocketHttpServer::header(const String& name) {
+    for (size_t i = 0; i < _headerCount; i++) {
+        if (strcasecmp(_headers[i].name, name.c_str()) == 0) return String(_headers[i].value);
+    }
+    return String("");
+}
+
+// ========================================
+// RÉPONSE
+// ========================================
+// Écrit dans le tampon d'émission de la connexion courante. Plein : on
+// envoie ce que la socket prend sans attendre ; s'il manque encore de la
+// place, la réponse ne tient pas (un gros corps passe par sendContentFrom())
+// et la connexion est fermée plutôt que de bloquer la boucle.
+void SocketHttpServer::write(const char* data, size_t len) {
+    HttpConnection& client = *_current;
+    if (client.fd < 0) return;
+    if (HTTP_TX_BUFFER - client.txLen < len) {
+        if (!flushClient(client)) return;
+        compactTx(client);
+    }
+    if (HTTP_TX_BUFFER - client.txLen < len) {
+        LOG_EVERY(LOG_LEVEL_WARN, 10000, "HTTP: reponse trop grande pour %s", _uri ? _uri : "?");
+        closeClient(client);
+        return;
+    }
+    memcpy(client.tx + client.txLen, data, len);
+    client.txLen += len;
+}
+
+void SocketHttpServer::sendHeader(const char* name, const char* value) {
+    size_t space = sizeof(_responseHeaders) - _responseHeadersLen;
+    int n = snprintf(_responseHeaders + _responseHeadersLen, space, "%s: %s\r\n", name, value);
+    if (n > 0 && (size_t)n < space) _responseHeadersLen += n;
+}
+
+// Une seule copie du bloc, ignoré entier s'il ne tient pas
+void SocketHttpServer::sendHeaders_P(PGM_P headers) {
+    size_t len = strlen_P(headers);
+    if (len > sizeof(_responseHeaders) - _responseHeadersLen) return;
+    memcpy_P(_responseHeaders + _responseHeadersLen, headers, len);
+    _responseHeadersLen += len;
+}
+
+void SocketHttpServer::setContentLength(size_t contentLength) {
+    _contentLength = contentLength;
+}
+
+void SocketHttpServer::send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) {
+    if (!_current || _responseStarted) return;
+    _responseStarted = true;
+    _chunked = _contentLength == CONTENT_LENGTH_UNKNOWN;
+
+    char head[128];
+    int n = snprintf(head, sizeof(head), "HTTP/1.1 %d %s\r\nContent-Type: %s\r\n",
+                     code, statusText(code), contentType ? contentType : "text/html");
+    write(head, n);
+    write(_responseHeaders, _responseHeadersLen);
+
+    if (_chunked) {
+        n = snprintf(head, sizeof(head), "Transfer-Encoding: chunked\r\n");
+    } else {
+        size_t length = _contentLength == CONTENT_LENGTH_NOT_SET ? contentLength : _contentLength;
+        n = snprintf(head, sizeof(head), "Content-Length: %u\r\n", (unsigned)length);
+    }
+    write(head, n);
+    n = snprintf(head, sizeof(head), "Connection: %s\r\n\r\n",
+                 _current->closeAfterSend ? "close" : "keep-alive");
+    write(head, n);
+
+    if (contentLength > 0) sendContent_P(content, contentLength);
+}
+
+// En chunked, un contenu vide termine la réponse
+void SocketHttpServer::sendContent_P(PGM_P content, size_t contentLength) {
+    if (!_current || !_responseStarted) return;
+    if (!_chunked) {
+        write(content, contentLength);
+        return;
+    }
+    char size[12];
+    int n = snprintf(size, sizeof(size), "%x\r\n", (unsigned)contentLength);
+    write(size, n);
+    write(content, contentLength);
+    write("\r\n", 2);
+    if (contentLength == 0) _chunked = false;
+}
+
+// Producteur gardé par la connexion : la suite du corps est écrite par
+// produceBody() à mesure que la socket se vide, fin de corps comprise
+void SocketHttpServer::sendContentFrom(TContentProducer producer) {
+    if (!_current || !_responseStarted || _current->stream) return;
+    _current->producer = producer;
+    _current->chunked = _chunked;
+    _current->stream = HTTP_STREAM_BODY;
+    _chunked = false;   // endResponse() ne termine pas le corps
+}
+
+// ========================================
+// FLUX
+// ========================================
+// Corps délimité par la fermeture : ni Content-Length ni chunked
+bool SocketHttpServer::beginStream(PGM_P contentType) {
+    if (!_current || _responseStarted) return false;
+    _responseStarted = true;
+    _chunked = false;
+
+    char head[128];
+    int n = snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: %s\r\n", contentType);
+    write(head, n);
+    write(_responseHeaders, _responseHeadersLen);
+    write("Connection: keep-alive\r\n\r\n", 26);
+
+    _current->stream = HTTP_STREAM_EVENTS;
+    _current->closeAfterSend = false;
+    return true;
+}
+
+// Ajoute en-tête + données au tampon d'émission d'un flux et envoie ce qui
+// passe, sans attendre. Plus de place : le client ne suit pas, il est fermé.
+bool SocketHttpServer::queue(HttpConnection& client, const uint8_t* head, size_t headLen,
+                             const uint8_t* data, size_t len) {
+    compactTx(client);
+    if (HTTP_TX_BUFFER - client.txLen < headLen + len) {
+        LOG_EVERY(LOG_LEVEL_WARN, 10000, "HTTP: flux trop lent ferme");
+        closeClient(client);
+        _streamsDropped++;
+        return false;
+    }
+    if (headLen > 0) memcpy(client.tx + client.txLen, head, headLen);
+    memcpy(client.tx + client.txLen + headLen, data, len);
+    client.txLen += headLen + len;
+    return flushClient(client);
+}
+
+int SocketHttpServer::broadcast(const char* data, size_t len) {
+    int served = 0;
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        HttpConnection& client = _clients[i];
+        if (client.fd < 0 || client.stream != HTTP_STREAM_EVENTS) continue;
+        if (queue(client, NULL, 0, (const uint8_t*)data, len)) served++;
+    }
+    return served;
+}
+
+int SocketHttpServer::streamCount() {
+    int count = 0;
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        uint8_t stream = _clients[i].stream;
+        if (_clients[i].fd >= 0 && (stream == HTTP_STREAM_EVENTS || stream == HTTP_STREAM_WEBSOCKET)) count++;
+    }
+    return count;
+}
+
+// ========================================
+// RÉPONSES DIFFÉRÉES
+// ========================================
+// La requête est consommée ; la connexion n'en lit pas d'autre et échappe
+// au délai keep-alive jusqu'à resumeResponse()
+int SocketHttpServer::deferResponse() {
+    if (!_current || _responseStarted) return -1;
+    _current->stream = HTTP_STREAM_DEFERRED;
+    return _current - _clients;
+}
+
+bool SocketHttpServer::resumeResponse(int index) {
+    if (_current || index < 0 || index >= HTTP_MAX_CLIENTS) return false;
+    HttpConnection& client = _clients[index];
+    if (client.fd < 0 || client.stream != HTTP_STREAM_DEFERRED) return false;
+    client.stream = HTTP_STREAM_NONE;
+    client.lastActivity = millis();
+    startResponse(client);
+    return true;
+}
+
+// Réponse en file : partie au prochain handleClient(), qui reprend ensuite
+// les requêtes suivantes de la connexion
+void SocketHttpServer::endResponse() {
+    if (!_current) return;
+    if (!_responseStarted) send(500, "text/plain", "Pas de reponse");
+    if (_chunked) sendContent_P("", 0);
+    _current = NULL;
+}
+
+// ========================================
+// WEBSOCKET
+// ========================================
+// Accepte la demande de mise à niveau de la requête courante
+int SocketHttpServer::beginWebSocket() {
+    if (!_current || _responseStarted || !_webSocketKey || _method != HTTP_GET) return -1;
+    _responseStarted = true;
+    _chunked = false;
+
+    char accept[29];
+    webSocketAccept(_webSocketKey, accept);
+    char head[160];
+    int n = snprintf(head, sizeof(head),
+                     "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                     "Connection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n", accept);
+    write(head, n);
+    write(_responseHeaders, _responseHeadersLen);
+    write("\r\n", 2);
+
+    _current->stream = HTTP_STREAM_WEBSOCKET;
+    _current->closeAfterSend = false;
+    return _current - _clients;
+}
+
+void SocketHttpServer::onWebSocket(TWebSocketHandler handler) {
+    _webSocketHandler = handler;
+}
+
+// Trame serveur : jamais masquée, longueur sur 7 ou 16 bits
+bool SocketHttpServer::sendFrame(HttpConnection& client, uint8_t opcode,
+                                 const uint8_t* data, size_t len) {
+    if (len > 0xFFFF) return false;
+    uint8_t head[4];
+    size_t headLen = 2;
+    head[0] = 0x80 | opcode;
+    if (len < 126) {
+        head[1] = len;
+    } else {
+        head[1] = 126;
+        head[2] = len >> 8;
+        head[3] = len & 0xFF;
+        headLen = 4;
+    }
+    return queue(client, head, headLen, data, len);
+}
+
+bool SocketHttpServer::sendWebSocket(int client, bool binary, const uint8_t* data, size_t len) {
+    if (client < 0 || client >= HTTP_MAX_CLIENTS) return false;
+    HttpConnection& connection = _clients[client];
+    if (connection.fd < 0 || connection.stream != HTTP_STREAM_WEBSOCKET) return false;
+    return sendFrame(connection, binary ? WS_BINARY : WS_TEXT, data, len);
+}
+
+int SocketHttpServer::broadcastWebSocket(bool binary, const uint8_t* data, size_t len) {
+    int served = 0;
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        HttpConnection& client = _clients[i];
+        if (client.fd < 0 || client.stream != HTTP_STREAM_WEBSOCKET) continue;
+        if (sendFrame(client, binary ? WS_BINARY : WS_TEXT, data, len)) served++;
+    }
+    return served;
+}
+
+// Trames complètes du tampon de réception : démasquées sur place, passées
+// au handler puis retirées. Trame fragmentée, non masquée ou plus grande
+// que le tampon : fermeture avec le code RFC 6455 correspondant.
+void SocketHttpServer::processFrames(HttpConnection& client) {
+    auto fail = [&](uint16_t status) {
+        uint8_t code[2] = { (uint8_t)(status >> 8), (uint8_t)(status & 0xFF) };
+        client.rxLen = 0;
+        if (sendFrame(client, WS_CLOSE, code, sizeof(code))) client.closeAfterSend = true;
+    };
+
+    while (client.fd >= 0 && !client.closeAfterSend && client.rxLen >= 2) {
+        uint8_t* rx = (uint8_t*)client.rx;
+        bool fin = rx[0] & 0x80;
+        uint8_t opcode = rx[0] & 0x0F;
+        size_t len = rx[1] & 0x7F;
+        size_t headLen = 2;
+        if (!(rx[1] & 0x80)) return fail(1002);
+        // Trames de contrôle (RFC 6455 §5.5) : jamais fragmentées, 125 octets
+        // au plus ; un close porte 0 octet ou un code d'état sur 2
+        if ((opcode & 0x08) && (!fin || len > 125 || (opcode == WS_CLOSE && len == 1))) return fail(1002);
+        if (len == 127) return fail(1009);
+        if (len == 126) {
+            if (client.rxLen < 4) return;
+            len = (size_t)rx[2] << 8 | rx[3];
+            headLen = 4;
+        }
+        headLen += 4;   // clé de masque
+        if (headLen + len > HTTP_RX_BUFFER - 1) return fail(1009);
+        if (client.rxLen < headLen + len) return;
+
+        uint8_t* data = rx + headLen;
+        const uint8_t* mask = data - 4;
+        for (size_t i = 0; i < len; i++) data[i] ^= mask[i & 3];
+
+        switch (opcode) {
+            case WS_TEXT:
+            case WS_BINARY:
+                if (!fin) return fail(1003);
+                if (_webSocketHandler) _webSocketHandler(&client - _clients, opcode == WS_BINARY, data, len);
+                break;
+            case WS_PING:
+                sendFrame(client, WS_PONG, data, len);
+                break;
+            case WS_PONG:
+                break;
+            case WS_CLOSE:
+                // Écho du code reçu, fermeture une fois la trame partie
+                if (sendFrame(client, WS_CLOSE, data, len < 2 ? len : 2)) client.closeAfterSend = true;
+                client.rxLen = 0;
+                return;
+            default:
+                return fail(1003);
+        }
+        // Le handler a pu fermer la connexion (envoi vers un client lent)
+        if (client.fd < 0) return;
+        size_t consumed = headLen + len;
+        memmove(client.rx, client.rx + consumed, client.rxLen - consumed);
+        client.rxLen -= consumed;
+    }
+}
+
+// ========================================
+// STATISTIQUES
+// ========================================
+int SocketHttpServer::clientCount() {
+    int count = 0;
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        if (_clients[i].fd >= 0) count++;
+    }
+    return count;
+}
+
+unsigned long SocketHttpServer::requestCount() { return _requests; }
+unsigned long SocketHttpServer::acceptedCount() { return _accepted; }
+unsigned long SocketHttpServer::streamsDropped() { return _streamsDropped; }
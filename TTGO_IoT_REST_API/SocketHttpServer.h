@@ -0,0 +1,168 @@
+#ifndef SOCKET_HTTP_SERVER_H
+#define SOCKET_HTTP_SERVER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "HttpServer.h"
+
+#define HTTP_MAX_ROUTES 8   // RestAPI aiguille elle-même (table de routes) : onNotFound() seul
+#define HTTP_MAX_ARGS 8
+#define HTTP_MAX_COLLECTED_HEADERS 6
+#define HTTP_HEADER_BUFFER 512   // en-têtes de réponse ajoutés par sendHeader()
+
+// Usage d'une connexion après la requête qui l'a ouverte
+enum HttpStream {
+    HTTP_STREAM_NONE,        // requêtes/réponses
+    HTTP_STREAM_EVENTS,      // flux SSE : plus rien de lu
+    HTTP_STREAM_WEBSOCKET,   // trames WebSocket dans les deux sens
+    HTTP_STREAM_DEFERRED,    // réponse différée : requêtes suivantes en attente
+    HTTP_STREAM_BODY         // corps produit au fil de l'envoi (sendContentFrom)
+};
+
+// Connexion cliente : tampons fixes, aucune allocation par requête
+struct HttpConnection {
+    int fd;
+    char rx[HTTP_RX_BUFFER];
+    size_t rxLen;
+    char tx[HTTP_TX_BUFFER];
+    size_t txLen;
+    size_t txSent;
+    unsigned long lastActivity;   // millis()
+    bool closeAfterSend;
+    uint8_t stream;               // HttpStream ; flux : pas de délai keep-alive
+    bool chunked;                 // corps produit : morceaux chunked
+    HttpServer::TContentProducer producer;
+};
+
+// ========================================
+// SERVEUR HTTP ÉVÉNEMENTIEL SUR SOCKETS
+// ========================================
+// Sockets BSD non bloquantes (lwIP sur ESP32, POSIX sur Linux) et un
+// select() par handleClient() : jusqu'à HTTP_MAX_CLIENTS connexions
+// keep-alive servies en parallèle, requêtes enchaînées (pipelining)
+// comprises. Chaque connexion est une petite machine à états ; aucun
+// appel n'attend un client lent. Avec un délai de poll nul (défaut),
+// handleClient() ne bloque jamais loop(). Une connexion passée en flux
+// (beginStream) ne reçoit plus que des broadcast() ; une connexion
+// WebSocket échange des trames non fragmentées d'au plus HTTP_RX_BUFFER.
+// Une réponse différée (deferResponse) part quand l'application la reprend.
+// Rien n'attend la socket : un corps plus grand que HTTP_TX_BUFFER passe par
+// sendContentFrom(), produit quand la connexion se vide ; une réponse
+// directe qui déborde ferme la connexion.
+class SocketHttpServer : public HttpServer {
+private:
+    struct Route {
+        const char* uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+    struct Field {
+        const char* name;
+        const char* value;
+    };
+
+    uint16_t _port;
+    int _listenFd;
+    unsigned long _pollTimeout;   // ms
+
+    Route _routes[HTTP_MAX_ROUTES];
+    int _routeCount;
+    THandlerFunction _notFound;
+    const char* _collected[HTTP_MAX_COLLECTED_HEADERS];
+    size_t _collectedCount;
+
+    HttpConnection _clients[HTTP_MAX_CLIENTS];
+
+    // Requête en cours (pointeurs dans le tampon rx de la connexion)
+    HttpConnection* _current;
+    HTTPMethod _method;
+    const char* _uri;
+    Field _args[HTTP_MAX_ARGS];
+    size_t _argCount;
+    Field _headers[HTTP_MAX_COLLECTED_HEADERS];
+    size_t _headerCount;
+    const char* _body;
+    size_t _bodyLen;
+    const char* _webSocketKey;    // Sec-WebSocket-Key d'une demande de mise à niveau
+    TWebSocketHandler _webSocketHandler;
+
+    // Réponse en cours
+    char _responseHeaders[HTTP_HEADER_BUFFER];
+    size_t _responseHeadersLen;
+    size_t _contentLength;
+    bool _responseStarted;
+    bool _chunked;
+
+    unsigned long _requests;
+    unsigned long _accepted;
+    unsigned long _streamsDropped;
+
+    void acceptClients();
+    void readClient(HttpConnection& client);
+    bool flushClient(HttpConnection& client);
+    void compactTx(HttpConnection& client);
+    bool produceBody(HttpConnection& client);
+    void closeClient(HttpConnection& client);
+    void startResponse(HttpConnection& client);
+
+    void processPending(HttpConnection& client);
+    bool processRequest(HttpConnection& client);
+    bool parseRequest(HttpConnection& client, size_t headerLen, size_t contentLength,
+                      bool& keepAlive);
+    void parseArgs(char* query);
+    void dispatch();
+    void write(const char* data, size_t len);
+    void sendError(HttpConnection& client, int code, const char* message);
+    bool queue(HttpConnection& client, const uint8_t* head, size_t headLen,
+               const uint8_t* data, size_t len);
+    bool sendFrame(HttpConnection& client, uint8_t opcode, const uint8_t* data, size_t len);
+    void processFrames(HttpConnection& client);
+
+public:
+    SocketHttpServer(uint16_t port = 80);
+    ~SocketHttpServer();
+
+    void begin();
+    void stop();
+    void handleClient();
+    void setPollTimeout(unsigned long ms);
+    uint16_t port();
+
+    void on(const char* uri, HTTPMethod method, THandlerFunction handler);
+    void onNotFound(THandlerFunction handler);
+    void collectHeaders(const char* headerKeys[], size_t headerKeysCount);
+
+    String uri();
+    const char* path();
+    HTTPMethod method();
+    bool hasArg(const String& name);
+    String arg(const String& name);
+    String header(const String& name);
+
+    void sendHeader(const char* name, const char* value);
+    void sendHeaders_P(PGM_P headers);
+    void setContentLength(size_t contentLength);
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength);
+    void sendContent_P(PGM_P content, size_t contentLength);
+    void sendContentFrom(TContentProducer producer);
+
+    bool beginStream(PGM_P contentType);
+    int broadcast(const char* data, size_t len);
+    int streamCount();
+
+    int beginWebSocket();
+    void onWebSocket(TWebSocketHandler handler);
+    bool sendWebSocket(int client, bool binary, const uint8_t* data, size_t len);
+    int broadcastWebSocket(bool binary, const uint8_t* data, size_t len);
+
+    int deferResponse();
+    bool resumeResponse(int client);
+    void endResponse();
+
+    int clientCount();
+    unsigned long requestCount();
+    unsigned long acceptedCount();
+    unsigned long streamsDropped();   // flux fermés car trop lents
+};
+
+#endif
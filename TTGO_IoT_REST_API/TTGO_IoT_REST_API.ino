@@ -8,119 +8,198 @@
 #include "addons/TokenHelper.h"
 #include "addons/RTDBHelper.h"
 #include <TFT_eSPI.h>
+#include <LittleFS.h>
 
 #include "config.h"
+#include "Logger.h"
 #include "TemperatureControl.h"
 #include "PhotocellControl.h"
 #include "LedControl.h"
 #include "DisplayControl.h"
+#include "SensorSampler.h"
+#include "FirebaseUploader.h"
+#include "TelemetryPolicy.h"
+#include "SocketHttpServer.h"
 #include "RestAPI.h"
+#include "Scheduler.h"
+#include "TaskMonitor.h"
+#include "SensorHistory.h"
+#include "FlashLog.h"
+#include "FirebaseOutbox.h"
 
 // ========================================
 // OBJETS GLOBAUX
 // ========================================
 TFT_eSPI tft = TFT_eSPI();
-WebServer server(80);
+#if HTTP_BACKEND == HTTP_BACKEND_SOCKET
+SocketHttpServer server(HTTP_PORT);
+#else
+WebServer webServer(HTTP_PORT);
+WebServerBackend server(&webServer);
+#endif
 
 TemperatureControl tempSensor(TEMP_SENSOR_PIN);
 PhotocellControl lightSensor(LDR_PIN);
 LedControl led(LED_PIN);
 DisplayControl display(&tft);
-RestAPI api(&server, &tempSensor, &lightSensor, &led);
+SensorSampler sampler(&tempSensor, &lightSensor);
+RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
 
 // Firebase
 FirebaseData fbdo;
 FirebaseAuth auth;
 FirebaseConfig config;
+FirebaseUploader uploader(&fbdo);
+// Bandes mortes du miroir d'état, réglables sur POST /telemetry/set
+TelemetryPolicy telemetryPolicy;
+
+// Deux heures de mesures en RAM, servies sur GET /history
+SensorHistory history;
+// Les mêmes en flash, conservées après une coupure : GET /history/flash
+FlashLog flashLog(&LittleFS);
+// Fin du journal pas encore livrée à Firebase, vidée par l'uploader
+FirebaseOutbox outbox(&flashLog, &LittleFS);
+bool flashLogReady = false;
+
+// Pile et part de CPU de chaque tâche, exposées sur GET /system
+TaskMonitor taskMonitor;
+int loopMonitorId = -1;
 
 // Variables globales
 bool wifiConnected = false;
 bool firebaseReady = false;
-unsigned long lastFirebaseUpdate = 0;
-unsigned long lastDisplayUpdate = 0;
+bool firebaseStarted = false;   // Firebase.begin() appelé, lien suivi ensuite
+
+// Dernières mesures, rafraîchies par la tâche capteurs
+float temperature = 25.0;
+int lightRaw = 0;
+int lightPercent = 0;
+
+// Bouton avec anti-rebond par millis()
+struct Button {
+  uint8_t pin;
+  bool stable;             // état validé
+  bool last;               // dernière lecture
+  unsigned long changedAt; // millis() du dernier changement de lecture
+};
+
+Button buttonLeft = { BUTTON_LEFT, HIGH, HIGH, 0 };
+Button buttonRight = { BUTTON_RIGHT, HIGH, HIGH, 0 };
 
-bool lastButtonLeft = HIGH;
-bool lastButtonRight = HIGH;
+// Ordonnanceur : handleClient() entre chaque tâche. Première fonction du
+// sketch après les types : les prototypes générés par l'IDE voient Button.
+void serviceHttp() { api.handleClient(); }
+Scheduler scheduler(serviceHttp);
+
+#if DUAL_CORE
+// Serveur HTTP sur le cœur réseau, à côté de la pile WiFi : un handler lent
+// ne retarde plus les boutons ni l'écran, et inversement
+void httpTask(void* arg) {
+  int id = taskMonitor.registerCurrentTask("http", CORE_NETWORK);
+  for (;;) {
+    unsigned long start = micros();
+    api.handleClient();
+    taskMonitor.addBusy(id, micros() - start);
+    vTaskDelay(1);
+  }
+}
+#endif
 
 // ========================================
 // SETUP
 // ========================================
 void setup() {
   Serial.begin(115200);
-  delay(1000);
+  scheduler.serviceFor(1000);
   
-  Serial.println("\n========================================");
-  Serial.println("   TTGO IoT REST API");
-  Serial.println("========================================\n");
+  LOG_INFO("========================================");
+  LOG_INFO("   TTGO IoT REST API");
+  LOG_INFO("========================================");
   
   // Initialisation composants
   tempSensor.begin();
   lightSensor.begin();
   led.begin();
   display.begin();
+  sampler.setMonitor(&taskMonitor);
+  uploader.setMonitor(&taskMonitor);
+  uploader.setPolicy(&telemetryPolicy);
+  api.setMonitor(&taskMonitor);
+  api.setTelemetryPolicy(&telemetryPolicy);
+  api.setHistory(&history);
+  if (LittleFS.begin(true) && flashLog.begin()) {
+    flashLogReady = true;
+    outbox.begin();
+    uploader.setOutbox(&outbox);
+    api.setFlashLog(&flashLog);
+    api.setOutbox(&outbox);
+  } else {
+    LOG_ERROR("LittleFS indisponible, journal flash desactive");
+  }
+  sampler.begin();
   
   pinMode(BUTTON_LEFT, INPUT_PULLUP);
   pinMode(BUTTON_RIGHT, INPUT_PULLUP);
   
   display.showMessage("TTGO IoT", "Demarrage...", TFT_CYAN);
-  delay(1500);
+  scheduler.serviceFor(1500);
   
   // ========================================
   // CONNEXION WIFI
   // ========================================
   display.showMessage("WiFi", "Connexion...", TFT_YELLOW);
-  Serial.println(">>> Connexion WiFi...");
-  Serial.print("SSID: ");
-  Serial.println(WIFI_SSID);
+  LOG_INFO(">>> Connexion WiFi (SSID: %s)...", WIFI_SSID);
+  Logger::flush();
   
   WiFi.mode(WIFI_STA);
   WiFi.disconnect();
-  delay(100);
+  scheduler.serviceFor(100);
   WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
   
   int wifiAttempts = 0;
   while (WiFi.status() != WL_CONNECTED && wifiAttempts < 40) {
-    delay(500);
-    Serial.print(".");
+    scheduler.serviceFor(500);
     wifiAttempts++;
     if(wifiAttempts % 10 == 0) {
-      Serial.println();
-      Serial.print("Tentative ");
-      Serial.print(wifiAttempts);
-      Serial.print("/40...");
+      LOG_INFO("Tentative %d/40...", wifiAttempts);
+      Logger::flush();
     }
   }
-  Serial.println();
   
   if (WiFi.status() == WL_CONNECTED) {
     wifiConnected = true;
-    Serial.println("WiFi OK!");
-    Serial.print("IP: ");
-    Serial.println(WiFi.localIP());
+    LOG_INFO("WiFi OK! IP: %s", WiFi.localIP().toString().c_str());
     
     display.showMessage("WiFi OK", WiFi.localIP().toString(), TFT_GREEN);
-    delay(2000);
+    // Horodatage epoch du journal flash ; synchro SNTP en arrière-plan
+    configTime(0, 0, NTP_SERVER);
+    scheduler.serviceFor(2000);
     
     // ========================================
     // DÉMARRAGE API REST
     // ========================================
     display.showMessage("API REST", "Demarrage...", TFT_YELLOW);
-    Serial.println("\n>>> Demarrage serveur HTTP...");
+    LOG_INFO(">>> Demarrage serveur HTTP...");
     
     api.begin();
+#if DUAL_CORE
+    // Les réglages partagés sont protégés dans RestAPI ; loop() ne sert plus les clients
+    xTaskCreatePinnedToCore(httpTask, "http", HTTP_TASK_STACK, NULL, 1, NULL, CORE_NETWORK);
+    scheduler.setService(NULL);
+#endif
     
-    Serial.println("Serveur HTTP demarre!");
-    Serial.print("Adresse API: http://");
-    Serial.println(WiFi.localIP());
+    LOG_INFO("Serveur HTTP demarre! Adresse API: http://%s", WiFi.localIP().toString().c_str());
+    Logger::flush();
     
     display.showMessage("API REST", "Demarre!", TFT_GREEN);
-    delay(1500);
+    scheduler.serviceFor(1500);
     
     // ========================================
     // CONNEXION FIREBASE
     // ========================================
     display.showMessage("Firebase", "Connexion...", TFT_YELLOW);
-    Serial.println("\n>>> Configuration Firebase...");
+    LOG_INFO(">>> Configuration Firebase...");
+    Logger::flush();
     
     config.api_key = API_KEY;
     config.database_url = DATABASE_URL;
@@ -130,159 +209,207 @@ void setup() {
     
     Firebase.begin(&config, &auth);
     Firebase.reconnectWiFi(true);
+    // Tâche lancée même sans jeton : miroir et arriéré partent à la reconnexion.
+    // Plus aucun appel Firebase.* ici ensuite : le lien est suivi par la tâche.
+    uploader.begin();
+    firebaseStarted = true;
     
     int fbAttempts = 0;
-    while (!Firebase.ready() && fbAttempts < 15) {
-      delay(500);
-      Serial.print(".");
+    while (!uploader.isReady() && fbAttempts < 15) {
+      scheduler.serviceFor(500);
       fbAttempts++;
     }
-    Serial.println();
     
-    if (Firebase.ready()) {
+    if (uploader.isReady()) {
       firebaseReady = true;
-      Serial.println("Firebase OK!");
+      LOG_INFO("Firebase OK!");
       display.showMessage("Firebase", "Connecte!", TFT_GREEN);
-      delay(1500);
+      scheduler.serviceFor(1500);
     } else {
-      Serial.println("Firebase timeout");
+      LOG_WARN("Firebase timeout");
       display.showMessage("Firebase", "Timeout", TFT_ORANGE);
-      delay(1500);
+      scheduler.serviceFor(1500);
     }
     
   } else {
-    Serial.println("WiFi ERREUR");
+    LOG_ERROR("WiFi ERREUR");
     display.showMessage("WiFi", "ERREUR", TFT_RED);
-    delay(3000);
+    scheduler.serviceFor(3000);
   }
   
   display.showMessage("Systeme", "PRET!", TFT_GREEN);
-  delay(1000);
+  scheduler.serviceFor(1000);
   
-  Serial.println("\n========================================");
-  Serial.println("   Systeme operationnel");
-  Serial.println("========================================");
-  Serial.println("\nRoutes API disponibles:");
-  Serial.println("  GET  /sensors");
-  Serial.println("  GET  /sensors/temperature");
-  Serial.println("  GET  /sensors/light");
-  Serial.println("  POST /led/on");
-  Serial.println("  POST /led/off");
-  Serial.println("  POST /led/toggle");
-  Serial.println("  POST /threshold/set?temp=30&light=50");
-  Serial.println("  GET  /threshold");
-  Serial.println("  POST /mode/set?mode=AUTO-TEMP");
-  Serial.println("  GET  /status");
-  Serial.println("\n========================================\n");
+  LOG_INFO("========================================");
+  LOG_INFO("   Systeme operationnel");
+  LOG_INFO("========================================");
+  LOG_INFO("Routes API disponibles:");
+  LOG_INFO("  GET  /sensors");
+  LOG_INFO("  GET  /sensors/temperature");
+  LOG_INFO("  GET  /sensors/light");
+  LOG_INFO("  POST /led/on");
+  LOG_INFO("  POST /led/off");
+  LOG_INFO("  POST /led/toggle");
+  LOG_INFO("  POST /threshold/set?temp=30&light=50");
+  LOG_INFO("  GET  /threshold");
+  LOG_INFO("  POST /mode/set?mode=AUTO-TEMP");
+  LOG_INFO("  GET  /status");
+  LOG_INFO("  GET  /system");
+  LOG_INFO("  GET  /history?since=0&step=60000");
+  LOG_INFO("  GET  /history/flash?from=&to=&limit=");
+  LOG_INFO("  GET  /api-docs");
+  LOG_INFO("========================================");
+  Logger::flush();
+
+  // Décalages : les tâches lentes ne tombent pas sur la même itération
+  scheduler.add("capteurs", SAMPLE_INTERVAL, taskSensors);
+  scheduler.add("boutons", BUTTON_POLL_INTERVAL, taskButtons);
+  scheduler.add("auto", AUTO_MODE_INTERVAL, taskAutoMode, 5);
+  scheduler.add("ecran", DISPLAY_UPDATE_INTERVAL, taskDisplay, 20);
+  scheduler.add("firebase", FIREBASE_UPDATE_INTERVAL, taskFirebase, 40);
+  scheduler.add("stats", STATS_INTERVAL, taskStats, 60);
+  scheduler.add("journal", LOG_FLUSH_INTERVAL, taskLogFlush, 15);
+  scheduler.add("historique", HISTORY_INTERVAL, taskHistory, 30);
+
+  // setup() et loop() tournent dans la même tâche Arduino (cœur contrôle)
+  loopMonitorId = taskMonitor.registerCurrentTask("loop", CORE_CONTROL);
 }
 
 // ========================================
-// LOOP PRINCIPAL
+// TÂCHES PÉRIODIQUES
 // ========================================
-void loop() {
-  // ========================================
-  // GESTION SERVEUR HTTP
-  // ========================================
-  api.handleClient();
-  
-  // ========================================
-  // LECTURE CAPTEURS
-  // ========================================
-  float temperature = tempSensor.readTemperature();
-  int lightRaw = lightSensor.readValue();
-  int lightPercent = lightSensor.readPercent();
-  
-  // ========================================
-  // GESTION BOUTONS
-  // ========================================
-  bool btnL = digitalRead(BUTTON_LEFT);
-  bool btnR = digitalRead(BUTTON_RIGHT);
-  
+// Capteurs : copie du snapshot publié par le sampler
+void taskSensors() {
+  SensorSnapshot snap = sampler.getSnapshot();
+  temperature = snap.temperature;
+  lightRaw = snap.lightRaw;
+  lightPercent = snap.lightPercent;
+}
+
+// Retourne true sur un appui validé (niveau bas stable BUTTON_DEBOUNCE ms)
+bool buttonPressed(Button& button) {
+  bool reading = digitalRead(button.pin);
+  unsigned long now = millis();
+
+  if (reading != button.last) {
+    button.last = reading;
+    button.changedAt = now;
+  }
+  if (reading != button.stable && now - button.changedAt >= BUTTON_DEBOUNCE) {
+    button.stable = reading;
+    return reading == LOW;
+  }
+  return false;
+}
+
+void taskButtons() {
   // Bouton GAUCHE : Toggle LED
-  if (lastButtonLeft == HIGH && btnL == LOW) {
-    delay(50);
+  if (buttonPressed(buttonLeft)) {
     led.toggle();
-    Serial.print("LED: ");
-    Serial.println(led.getState() ? "ON" : "OFF");
+    LOG_INFO("LED: %s", led.getState() ? "ON" : "OFF");
   }
-  
+
   // Bouton DROIT : Cycle modes
- // Bouton DROIT : Cycle modes
-if (lastButtonRight == HIGH && btnR == LOW) {
-  delay(50);
-  
-  String currentMode = api.getCurrentMode();  // ✅ Lire depuis l'API
-  
-  if (currentMode == "MANUEL") {
-    api.setCurrentMode("AUTO-TEMP");
-    api.setAutoMode(true);
-    api.setThreshold(30.0, 50);
-    Serial.println(">>> Mode AUTO-TEMP");
-  } else if (currentMode == "AUTO-TEMP") {
-    api.setCurrentMode("AUTO-LIGHT");
-    api.setAutoMode(true);
-    api.setThreshold(30.0, 50); 
-    Serial.println(">>> Mode AUTO-LIGHT");
+  if (buttonPressed(buttonRight)) {
+    String currentMode = api.getCurrentMode();  // ✅ Lire depuis l'API
+
+    if (currentMode == "MANUEL") {
+      api.setCurrentMode("AUTO-TEMP");
+      api.setAutoMode(true);
+      api.setThreshold(30.0, 50);
+      LOG_INFO(">>> Mode AUTO-TEMP");
+    } else if (currentMode == "AUTO-TEMP") {
+      api.setCurrentMode("AUTO-LIGHT");
+      api.setAutoMode(true);
+      api.setThreshold(30.0, 50); 
+      LOG_INFO(">>> Mode AUTO-LIGHT");
+    } else {
+      api.setCurrentMode("MANUEL");
+      api.setAutoMode(false);
+      LOG_INFO(">>> Mode MANUEL");
+    }
+  }
+}
+
+// Échantillon horodaté à l'acquisition, pas à l'enregistrement
+void taskHistory() {
+  SensorSnapshot snap = sampler.getSnapshot();
+  history.record(snap.temperature, snap.lightRaw, led.getState(), snap.timestamp);
+
+  // En flash seulement une fois l'heure connue : un horodatage depuis le
+  // boot ne se comparerait pas d'un démarrage à l'autre
+  if (!flashLogReady) return;
+  time_t now = time(NULL);
+  if (now >= (time_t)FLASHLOG_MIN_EPOCH) {
+    flashLog.record(snap.temperature, snap.lightRaw, led.getState(), (uint32_t)now);
+    outbox.recorded();
   } else {
-    api.setCurrentMode("MANUEL");
-    api.setAutoMode(false);
-    Serial.println(">>> Mode MANUEL");
+    LOG_EVERY(LOG_LEVEL_WARN, 60000, "FlashLog: heure non synchronisee, echantillon non persiste");
   }
 }
-  
-  lastButtonLeft = btnL;
-  lastButtonRight = btnR;
-  
-  // ========================================
-  // MODE AUTOMATIQUE
-  // ========================================
+
+void taskAutoMode() {
   if (api.getAutoMode()) {
     api.updateAutoMode(temperature, lightPercent);
   }
-  
-  // ========================================
-  // ENVOI FIREBASE
-  // ========================================
-  if (wifiConnected && firebaseReady) {
-    if (millis() - lastFirebaseUpdate >= FIREBASE_UPDATE_INTERVAL) {
-      if (Firebase.ready()) {
-        Serial.println(">>> Envoi Firebase...");
-        
-        Firebase.RTDB.setFloat(&fbdo, "/sensors/temperature", temperature);
-        Firebase.RTDB.setInt(&fbdo, "/sensors/lightRaw", lightRaw);
-        Firebase.RTDB.setInt(&fbdo, "/sensors/lightPercent", lightPercent);
-        Firebase.RTDB.setBool(&fbdo, "/actuators/led", led.getState());
-        
-        Firebase.RTDB.setString(&fbdo, "/settings/mode", api.getCurrentMode());  // ✅ Lire depuis l'API
-        Firebase.RTDB.setBool(&fbdo, "/settings/autoMode", api.getAutoMode());  // ✅ AJOUTÉ
-        Firebase.RTDB.setTimestamp(&fbdo, "/sensors/lastUpdate");
-        
-        Serial.println("OK");
-        lastFirebaseUpdate = millis();
-      }
-    }
-  }
-  
-  // ========================================
-  // MISE À JOUR ÉCRAN
-  // ========================================
-  if (millis() - lastDisplayUpdate >= 500) {
-   display.showStatus(temperature, lightPercent, led.getState(), 
-                   wifiConnected, firebaseReady, api.getCurrentMode());  // ✅ Lire depuis l'API
-    lastDisplayUpdate = millis();
-  }
-  
-  // ========================================
-  // SERIAL MONITOR
-  // ========================================
-  static unsigned long lastSerialPrint = 0;
-  if (millis() - lastSerialPrint > 2000) {
-   Serial.printf("T:%.1fC | L:%d%% | LED:%s | Mode:%s\n", 
-              temperature, lightPercent,
-              led.getState() ? "ON" : "OFF",
-              api.getCurrentMode().c_str());  // ✅ Lire depuis l'API
-    lastSerialPrint = millis();
+}
+
+// Dépôt non bloquant : l'envoi (un seul updateNode) se fait dans la tâche uploader,
+// qui n'écrit que les champs sortis de leur bande morte.
+// Lien lu dans l'uploader (seule tâche à appeler Firebase) : hors ligne, seul le miroir d'état est sauté,
+// les mesures attendent dans le journal flash (outbox).
+void taskFirebase() {
+  if (!firebaseStarted) return;
+  wifiConnected = WiFi.status() == WL_CONNECTED;
+  firebaseReady = wifiConnected && uploader.isReady();
+  if (!firebaseReady) return;
+
+  TelemetryRecord record;
+  record.temperature = temperature;
+  record.lightRaw = lightRaw;
+  record.lightPercent = lightPercent;
+  record.led = led.getState();
+  record.autoMode = api.getAutoMode();
+  strncpy(record.mode, api.getCurrentMode().c_str(), sizeof(record.mode) - 1);
+  record.mode[sizeof(record.mode) - 1] = '\0';
+  record.timestamp = millis();
+
+  if (!uploader.submit(record)) {
+    LOG_EVERY(LOG_LEVEL_WARN, 10000, "Firebase: file pleine (%lu refus)", uploader.getRejected());
   }
-  
-  delay(50);
+}
+
+void taskDisplay() {
+  display.showStatus(temperature, lightPercent, led.getState(), 
+                     wifiConnected, firebaseReady, api.getCurrentMode());  // ✅ Lire depuis l'API
+}
+
+void taskStats() {
+  taskMonitor.sample();
+  LOG_INFO("T:%.1fC | L:%d%% | LED:%s | Mode:%s | ecart HTTP max:%lu us",
+           temperature, lightPercent,
+           led.getState() ? "ON" : "OFF",
+           api.getCurrentMode().c_str(),  // ✅ Lire depuis l'API
+           scheduler.maxServiceGap());
+  scheduler.resetStats();
+}
+
+void taskLogFlush() {
+  Logger::flush();
+}
+
+// ========================================
+// LOOP PRINCIPAL
+// ========================================
+// Un cœur : l'ordonnanceur appelle handleClient() entre chaque tâche.
+// Deux cœurs : le HTTP a sa tâche, loop() dort jusqu'à la prochaine échéance.
+void loop() {
+  unsigned long start = micros();
+  scheduler.runOnce();
+  taskMonitor.addBusy(loopMonitorId, micros() - start);
+
+#if DUAL_CORE
+  unsigned long wait = scheduler.msUntilNext();
+  if (wait > 0) vTaskDelay(pdMS_TO_TICKS(wait));
+#endif
 }
@@ -0,0 +1,91 @@
+#include "TaskMonitor.h"
+
+TaskMonitor::TaskMonitor() : _reserved(0), _count(0) {
+    _lastSample = micros();
+    for (int i = 0; i < TASK_MONITOR_MAX_TASKS; i++) {
+        _slots[i].name = "";
+        _slots[i].core = -1;
+        _slots[i].handle = NULL;
+        _slots[i].busyUs = 0;
+        _slots[i].lastBusyUs = 0;
+        _slots[i].cpuPermille = 0;
+    }
+}
+
+// ========================================
+// ENREGISTREMENT
+// ========================================
+// À appeler depuis la tâche suivie. Retourne -1 si la table est pleine.
+int TaskMonitor::registerCurrentTask(const char* name, int core) {
+    int id = _reserved.fetch_add(1);
+    if (id >= TASK_MONITOR_MAX_TASKS) return -1;
+
+    Slot& slot = _slots[id];
+    slot.name = name;
+    slot.core = core;
+#ifdef ARDUINO_ARCH_ESP32
+    slot.handle = xTaskGetCurrentTaskHandle();
+#endif
+
+    // Publication dans l'ordre de réservation
+    int expected = id;
+    while (!_count.compare_exchange_weak(expected, id + 1)) {
+        expected = id;
+        yield();
+    }
+    return id;
+}
+
+// Tâche sur le point de se terminer : son handle ne doit plus être lu
+void TaskMonitor::detach(int id) {
+    if (id < 0 || id >= TASK_MONITOR_MAX_TASKS) return;
+    _slots[id].handle = NULL;
+    _slots[id].cpuPermille = 0;
+}
+
+void TaskMonitor::addBusy(int id, unsigned long us) {
+    if (id < 0 || id >= TASK_MONITOR_MAX_TASKS) return;
+    _slots[id].busyUs.fetch_add(us, std::memory_order_relaxed);
+}
+
+// ========================================
+// FENÊTRE DE MESURE
+// ========================================
+void TaskMonitor::sample() {
+    unsigned long now = micros();
+    unsigned long window = now - _lastSample;
+    if (window == 0) return;
+    _lastSample = now;
+
+    int count = _count;
+    for (int i = 0; i < count; i++) {
+        Slot& slot = _slots[i];
+        unsigned long busy = slot.busyUs.load(std::memory_order_relaxed);
+        unsigned long delta = busy - slot.lastBusyUs;
+        slot.lastBusyUs = busy;
+
+        unsigned long permille = (unsigned long)((unsigned long long)delta * 1000 / window);
+        slot.cpuPermille = permille > 1000 ? 1000 : permille;
+    }
+}
+
+// ========================================
+// LECTURE
+// ========================================
+int TaskMonitor::taskCount() { return _count; }
+
+bool TaskMonitor::getTask(int id, TaskInfo& info) {
+    if (id < 0 || id >= _count) return false;
+
+    const Slot& slot = _slots[id];
+    info.name = slot.name;
+    info.core = slot.core;
+    info.cpuPercent = slot.cpuPermille / 10.0f;
+#ifdef ARDUINO_ARCH_ESP32
+    // Sur ESP32 le high-water mark est exprimé en octets
+    info.stackFree = slot.handle ? (long)uxTaskGetStackHighWaterMark((TaskHandle_t)slot.handle) : -1;
+#else
+    info.stackFree = -1;
+#endif
+    return true;
+}
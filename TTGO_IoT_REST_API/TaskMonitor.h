@@ -0,0 +1,53 @@
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+
+#define TASK_MONITOR_MAX_TASKS 6
+
+// Vue d'une tâche pour /system
+struct TaskInfo {
+    const char* name;
+    int core;
+    long stackFree;        // octets jamais utilisés de la pile, -1 si inconnu
+    float cpuPercent;      // part du cœur sur la dernière fenêtre de sample()
+};
+
+// ========================================
+// SUIVI DES TÂCHES FREERTOS
+// ========================================
+// Chaque tâche s'enregistre depuis son propre contexte (handle courant)
+// puis cumule son temps actif avec addBusy(). sample() convertit le cumul
+// en pourcentage sur la fenêtre écoulée. Compteurs atomiques : écrits par
+// la tâche suivie, lus par le handler HTTP sur l'autre cœur.
+class TaskMonitor {
+private:
+    struct Slot {
+        const char* name;
+        int core;
+        void* handle;
+        std::atomic<unsigned long> busyUs;
+        unsigned long lastBusyUs;
+        std::atomic<unsigned long> cpuPermille;
+    };
+
+    Slot _slots[TASK_MONITOR_MAX_TASKS];
+    std::atomic<int> _reserved;
+    std::atomic<int> _count;      // emplacements complètement initialisés
+    unsigned long _lastSample;    // µs
+
+public:
+    TaskMonitor();
+
+    int registerCurrentTask(const char* name, int core);
+    void detach(int id);
+    void addBusy(int id, unsigned long us);
+    void sample();
+
+    int taskCount();
+    bool getTask(int id, TaskInfo& info);
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include "TelemetryPolicy.h"
+#include <math.h>
+#include <string.h>
+
+static const char* const FIELD_NAMES[TELEMETRY_FIELD_COUNT] = {
+    "temperature", "lightRaw", "lightPercent", "led", "mode", "autoMode"
+};
+
+TelemetryPolicy::TelemetryPolicy() {
+    for (int i = 0; i < TELEMETRY_FIELD_COUNT; i++) {
+        _config[i].deadband = 0;
+        _config[i].heartbeat = TELEMETRY_HEARTBEAT;
+        _sentAt[i] = 0;
+    }
+    _config[TELEMETRY_TEMPERATURE].deadband = TELEMETRY_TEMP_DEADBAND;
+    _config[TELEMETRY_LIGHT_RAW].deadband = TELEMETRY_LIGHT_RAW_DEADBAND;
+    _config[TELEMETRY_LIGHT_PERCENT].deadband = TELEMETRY_LIGHT_PERCENT_DEADBAND;
+    memset(&_last, 0, sizeof(_last));
+    memset(&_stats, 0, sizeof(_stats));
+    _known = 0;
+#ifdef ARDUINO_ARCH_ESP32
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void TelemetryPolicy::lock() { portENTER_CRITICAL(&_mux); }
+void TelemetryPolicy::unlock() { portEXIT_CRITICAL(&_mux); }
+#else
+void TelemetryPolicy::lock() { _mutex.lock(); }
+void TelemetryPolicy::unlock() { _mutex.unlock(); }
+#endif
+
+// ========================================
+// CHAMPS
+// ========================================
+int TelemetryPolicy::fieldIndex(const char* name) {
+    for (int i = 0; i < TELEMETRY_FIELD_COUNT; i++) {
+        if (strcmp(name, FIELD_NAMES[i]) == 0) return i;
+    }
+    return -1;
+}
+
+const char* TelemetryPolicy::fieldName(int field) {
+    return field >= 0 && field < TELEMETRY_FIELD_COUNT ? FIELD_NAMES[field] : "";
+}
+
+// Seuls les champs analogiques ont une bande morte
+bool TelemetryPolicy::isAnalog(int field) {
+    return field == TELEMETRY_TEMPERATURE || field == TELEMETRY_LIGHT_RAW ||
+           field == TELEMETRY_LIGHT_PERCENT;
+}
+
+bool TelemetryPolicy::configure(int field, float deadband, unsigned long heartbeat) {
+    if (field < 0 || field >= TELEMETRY_FIELD_COUNT || !(deadband >= 0)) return false;
+    lock();
+    _config[field].deadband = isAnalog(field) ? deadband : 0;
+    _config[field].heartbeat = heartbeat;
+    unlock();
+    return true;
+}
+
+TelemetryFieldConfig TelemetryPolicy::getConfig(int field) {
+    lock();
+    TelemetryFieldConfig config = _config[field];
+    unlock();
+    return config;
+}
+
+// ========================================
+// SÉLECTION
+// ========================================
+// Appelé sous verrou
+bool TelemetryPolicy::changed(int field, const TelemetryRecord& record) {
+    float deadband = _config[field].deadband;
+    float delta;
+    switch (field) {
+        case TELEMETRY_TEMPERATURE:   delta = fabsf(record.temperature - _last.temperature); break;
+        case TELEMETRY_LIGHT_RAW:     delta = abs(record.lightRaw - _last.lightRaw); break;
+        case TELEMETRY_LIGHT_PERCENT: delta = abs(record.lightPercent - _last.lightPercent); break;
+        case TELEMETRY_LED:           return record.led != _last.led;
+        case TELEMETRY_AUTO_MODE:     return record.autoMode != _last.autoMode;
+        case TELEMETRY_MODE:          return strcmp(record.mode, _last.mode) != 0;
+        default:                      return true;
+    }
+    // Bande morte nulle : tout changement, mais pas une valeur identique
+    return delta > 0 && delta >= deadband;
+}
+
+unsigned int TelemetryPolicy::select(const TelemetryRecord& record, unsigned long now) {
+    unsigned int fields = 0;
+    int skipped = 0;
+    lock();
+    for (int i = 0; i < TELEMETRY_FIELD_COUNT; i++) {
+        if (!(_known & TELEMETRY_BIT(i)) || now - _sentAt[i] >= _config[i].heartbeat ||
+            changed(i, record)) {
+            fields |= TELEMETRY_BIT(i);
+        } else {
+            skipped++;
+        }
+    }
+    _stats.evaluations++;
+    _stats.fieldsSuppressed += skipped;
+    unlock();
+    return fields;
+}
+
+void TelemetryPolicy::commit(const TelemetryRecord& record, unsigned int fields, unsigned long now) {
+    lock();
+    int sent = 0;
+    for (int i = 0; i < TELEMETRY_FIELD_COUNT; i++) {
+        if (!(fields & TELEMETRY_BIT(i))) continue;
+        switch (i) {
+            case TELEMETRY_TEMPERATURE:   _last.temperature = record.temperature; break;
+            case TELEMETRY_LIGHT_RAW:     _last.lightRaw = record.lightRaw; break;
+            case TELEMETRY_LIGHT_PERCENT: _last.lightPercent = record.lightPercent; break;
+            case TELEMETRY_LED:           _last.led = record.led; break;
+            case TELEMETRY_AUTO_MODE:     _last.autoMode = record.autoMode; break;
+            case TELEMETRY_MODE:          memcpy(_last.mode, record.mode, sizeof(_last.mode)); break;
+        }
+        _sentAt[i] = now;
+        sent++;
+    }
+    _known |= fields;
+    _stats.updates++;
+    _stats.fieldsSent += sent;
+    unlock();
+}
+
+TelemetryStats TelemetryPolicy::getStats() {
+    lock();
+    TelemetryStats stats = _stats;
+    unlock();
+    return stats;
+}
@@ -0,0 +1,93 @@
+#ifndef TELEMETRY_POLICY_H
+#define TELEMETRY_POLICY_H
+
+#include <Arduino.h>
+#ifndef ARDUINO_ARCH_ESP32
+#include <mutex>
+#endif
+#include "config.h"
+
+// État du miroir Firebase, évalué à chaque FIREBASE_UPDATE_INTERVAL
+struct TelemetryRecord {
+    float temperature;
+    int lightRaw;
+    int lightPercent;
+    bool led;
+    bool autoMode;
+    char mode[16];
+    unsigned long timestamp;   // millis() de la mise en file
+};
+
+// Champs du miroir, dans l'ordre des bits de select()
+enum TelemetryField {
+    TELEMETRY_TEMPERATURE,
+    TELEMETRY_LIGHT_RAW,
+    TELEMETRY_LIGHT_PERCENT,
+    TELEMETRY_LED,
+    TELEMETRY_MODE,
+    TELEMETRY_AUTO_MODE,
+    TELEMETRY_FIELD_COUNT
+};
+
+#define TELEMETRY_BIT(field) (1u << (field))
+#define TELEMETRY_ALL_FIELDS (TELEMETRY_BIT(TELEMETRY_FIELD_COUNT) - 1)
+
+struct TelemetryFieldConfig {
+    float deadband;            // écart minimal avant envoi (champs analogiques)
+    unsigned long heartbeat;   // silence max (ms) ; 0 = à chaque évaluation
+};
+
+struct TelemetryStats {
+    unsigned long evaluations;
+    unsigned long updates;           // PATCH acquittés
+    unsigned long fieldsSent;
+    unsigned long fieldsSuppressed;  // champs évalués inchangés, non écrits
+};
+
+// ========================================
+// TÉLÉMÉTRIE PAR EXCEPTION
+// ========================================
+// Un champ part quand il s'écarte de la dernière valeur acquittée de plus
+// que sa bande morte (LED, mode : tout changement), ou quand il n'a pas été
+// écrit depuis son heartbeat. La référence est la valeur envoyée, pas la
+// précédente mesure : une dérive lente finit par passer. Un échec d'envoi
+// ne valide rien, les champs repartent à l'évaluation suivante.
+// select()/commit() : tâche uploader ; configure() : handlers HTTP.
+class TelemetryPolicy {
+private:
+    TelemetryFieldConfig _config[TELEMETRY_FIELD_COUNT];
+    TelemetryRecord _last;                          // dernières valeurs acquittées
+    unsigned long _sentAt[TELEMETRY_FIELD_COUNT];
+    unsigned int _known;                            // champs déjà acquittés une fois
+    TelemetryStats _stats;
+
+#ifdef ARDUINO_ARCH_ESP32
+    portMUX_TYPE _mux;
+#else
+    std::mutex _mutex;
+#endif
+    void lock();
+    void unlock();
+
+    bool changed(int field, const TelemetryRecord& record);
+
+public:
+    TelemetryPolicy();
+
+    // Nom REST du champ (= feuille Firebase) <-> index ; -1 si inconnu
+    static int fieldIndex(const char* name);
+    static const char* fieldName(int field);
+    static bool isAnalog(int field);
+
+    bool configure(int field, float deadband, unsigned long heartbeat);
+    TelemetryFieldConfig getConfig(int field);
+
+    // Masque TELEMETRY_BIT des champs à écrire ; 0 = rien à envoyer
+    unsigned int select(const TelemetryRecord& record, unsigned long now);
+    // Après acquittement du PATCH contenant ces champs
+    void commit(const TelemetryRecord& record, unsigned int fields, unsigned long now);
+
+    TelemetryStats getStats();
+};
+
+#endif
@@ -1,10 +1,10 @@
 #include "TemperatureControl.h"
 #include "config.h"
+#include "Logger.h"
 #include <math.h>
 
 TemperatureControl::TemperatureControl(uint8_t pin) {
     _pin = pin;
-    _bufferIndex = 0;
     
     _R0 = R0;
     _R_AT_25C = R_AT_25C;
@@ -14,9 +14,10 @@ TemperatureControl::TemperatureControl(uint8_t pin) {
     _ADC_MAX = ADC_MAX;
     _ESP32_VMAX = ESP32_VMAX;
     
-    for(int i = 0; i < 10; i++) {
-        _buffer[i] = 0;
-    }
+    _adcValidMin = 1;
+    _adcValidMax = 0;
+    _adcCold = 0;
+    _adcHot = 0;
 }
 
 void TemperatureControl::begin() {
@@ -24,33 +25,91 @@ void TemperatureControl::begin() {
     analogSetAttenuation(ADC_11db);
     analogSetWidth(12);
     
-    for(int i = 0; i < 10; i++) {
-        _buffer[i] = analogRead(_pin);
+    buildLookupTable();
+    
+    for(int i = 0; i < FILTER_SIZE; i++) {
+        _filter.update(analogRead(_pin));
         delay(10);
     }
 }
 
-int TemperatureControl::getAverage(int buffer[], int size) {
-    long sum = 0;
-    for(int i = 0; i < size; i++) {
-        sum += buffer[i];
-    }
-    return sum / size;
+// ========================================
+// TABLE DE CONVERSION ADC → °C
+// ========================================
+
+// Formule de référence (Steinhart-Hart / B), sans les bornes -10/80°C.
+// Renvoie NAN si la lecture est rejetée (ADC nul, tension ou Rth hors plage).
+float TemperatureControl::steinhartHart(int adcValue) {
+    if (adcValue == 0) return NAN;
+    
+    float voltage = (adcValue / _ADC_MAX) * _ESP32_VMAX;
+    if (voltage >= _VREF - 0.01) voltage = _VREF - 0.01;
+    if (voltage < 0.1) return NAN;
+    
+    float Rth = _R0 * ((_VREF - voltage) / voltage);
+    if(Rth < 100 || Rth > 200000) return NAN;
+    
+    float TempK = 1.0 / ((1.0 / _T0_KELVIN) + (1.0 / _B_COEFFICIENT) * log(Rth / _R_AT_25C));
+    return TempK - 273.15;
 }
 
-float TemperatureControl::readTemperature() {
-    // Nettoyage
-    for(int i = 0; i < 5; i++) {
-        analogRead(_pin);
-        delay(2);
+void TemperatureControl::buildLookupTable() {
+    // Bornes exactes : la courbe est monotone, un seul passage suffit
+    _adcValidMin = 4096;
+    _adcValidMax = -1;
+    _adcCold = 4096;
+    _adcHot = 4096;
+    
+    for(int adc = 0; adc < 4096; adc++) {
+        float tempC = steinhartHart(adc);
+        if (isnan(tempC)) continue;
+        
+        if (adc < _adcValidMin) _adcValidMin = adc;
+        _adcValidMax = adc;
+        if (tempC >= -10.0 && adc < _adcCold) _adcCold = adc;
+        if (tempC > 80.0 && adc < _adcHot) _adcHot = adc;
     }
     
-    _buffer[_bufferIndex % 10] = analogRead(_pin);
-    _bufferIndex++;
+    // Points de la table, sans rejet pour que l'interpolation reste continue
+    for(int i = 0; i < TEMP_LUT_SIZE; i++) {
+        int adc = i * TEMP_LUT_STEP;
+        if (adc < 1) adc = 1;
+        if (adc > 4094) adc = 4094;
+        
+        float voltage = (adc / _ADC_MAX) * _ESP32_VMAX;
+        if (voltage >= _VREF - 0.01) voltage = _VREF - 0.01;
+        float Rth = _R0 * ((_VREF - voltage) / voltage);
+        float TempK = 1.0 / ((1.0 / _T0_KELVIN) + (1.0 / _B_COEFFICIENT) * log(Rth / _R_AT_25C));
+        _lut[i] = TempK - 273.15;
+    }
+}
+
+float TemperatureControl::adcToCelsius(int adcValue) {
+    if (adcValue < _adcValidMin || adcValue > _adcValidMax) return 25.0;
+    if (adcValue < _adcCold) return 20.0;
+    if (adcValue >= _adcHot) return 40.0;
+    
+    int index = adcValue / TEMP_LUT_STEP;
+    int frac = adcValue % TEMP_LUT_STEP;
+    float low = _lut[index];
+    return low + (_lut[index + 1] - low) * frac / TEMP_LUT_STEP;
+}
+
+TemperatureReading TemperatureControl::read() {
+    TemperatureReading reading;
+    reading.adc = 0;
+    reading.voltage = 0.0;
+    reading.resistance = 0.0;
+    reading.celsius = 25.0;
+
+    // Conversion de purge après changement de canal : pas d'attente,
+    // une conversion ADC suffit à recharger l'échantillonneur
+    analogRead(_pin);
     
-    int adcValue = getAverage(_buffer, 10);
+    int adcValue = _filter.update(analogRead(_pin));
+    reading.adc = adcValue;
     
-    if (adcValue == 0) return 25.0;
+    if (adcValue == 0) return reading;
     
     // ========================================
     // ⭐ CALCUL CORRIGÉ POUR 3.3V
@@ -61,7 +120,8 @@ float TemperatureControl::readTemperature() {
     float voltage = (adcValue / _ADC_MAX) * _ESP32_VMAX;
     
     if (voltage >= _VREF - 0.01) voltage = _VREF - 0.01;
-    if (voltage < 0.1) return 25.0;
+    reading.voltage = voltage;
+    if (voltage < 0.1) return reading;
     
     // Calcul résistance NTC
     // Circuit: 3.3V ─── R0 (10kΩ) ─── [GPIO36] ─── NTC ─── GND
@@ -69,36 +129,22 @@ float TemperatureControl::readTemperature() {
     //                                 mesure ici
     float Rth = _R0 * ((_VREF - voltage) / voltage);
     
-    // ========================================
-    // 🔍 CODE DEBUG
-    // ========================================
-    Serial.println("========================================");
-    Serial.print("ADC brut: ");
-    Serial.println(adcValue);
-    Serial.print("Tension mesurée: ");
-    Serial.print(voltage, 3);
-    Serial.println(" V");
-    Serial.print("Résistance NTC (Rth): ");
-    Serial.print(Rth, 0);
-    Serial.println(" Ω");
-    // ========================================
+    if(Rth < 100 || Rth > 200000) return reading;
+    reading.resistance = Rth;
     
-    if(Rth < 100 || Rth > 200000) return 25.0;
+    // Équation Steinhart-Hart précalculée (table + interpolation)
+    float tempC = adcToCelsius(adcValue);
     
-    // Équation Steinhart-Hart
-    float TempK = 1.0 / ((1.0 / _T0_KELVIN) + (1.0 / _B_COEFFICIENT) * log(Rth / _R_AT_25C));
-    float tempC = TempK - 273.15;
-    
-    // 🔍 DEBUG - Affiche la température calculée
-    Serial.print("Température calculée: ");
-    Serial.print(tempC, 1);
-    Serial.println(" °C");
-    Serial.println("========================================");
-    
-    if(tempC < -10.0) tempC = 20.0;
-    if(tempC > 80.0) tempC = 40.0;
+    // 🔍 DEBUG (compilé seulement si LOG_LEVEL >= LOG_LEVEL_DEBUG)
+    LOG_EVERY(LOG_LEVEL_DEBUG, 1000, "ADC brut: %d | Tension: %.3f V | Rth: %.0f Ohm | %.1f C",
+              adcValue, voltage, Rth, tempC);
     
-    return tempC;
+    reading.celsius = tempC;
+    return reading;
+}
+
+float TemperatureControl::readTemperature() {
+    return read().celsius;
 }
 
 int TemperatureControl::getRawADC() {
@@ -2,12 +2,32 @@
 #define TEMPERATURE_CONTROL_H
 
 #include <Arduino.h>
+#include "config.h"
+#include "SensorFilter.h"
+
+// Résultat complet d'une acquisition de température
+struct TemperatureReading {
+    int adc;            // moyenne filtrée (0-4095)
+    float voltage;      // tension au point milieu (V)
+    float resistance;   // résistance NTC (Ω), 0 si hors plage
+    float celsius;      // température (°C)
+};
+
+// Table ADC → °C : un point tous les TEMP_LUT_STEP pas ADC, interpolation linéaire
+#define TEMP_LUT_STEP 16
+#define TEMP_LUT_SIZE (4096 / TEMP_LUT_STEP + 1)
 
 class TemperatureControl {
 private:
     uint8_t _pin;
-    int _buffer[10];
-    int _bufferIndex;
+    SensorFilter<FILTER_SIZE> _filter;
+    
+    // Courbe précalculée dans begin()
+    float _lut[TEMP_LUT_SIZE];
+    int _adcValidMin;   // en dehors de [min, max] : lecture rejetée (25°C)
+    int _adcValidMax;
+    int _adcCold;       // premier ADC >= -10°C
+    int _adcHot;        // premier ADC > 80°C
     
     float _R0;
     float _R_AT_25C;
@@ -17,12 +37,15 @@ private:
     float _ADC_MAX;
     float _ESP32_VMAX;
     
-    int getAverage(int buffer[], int size);
+    void buildLookupTable();
     
 public:
     TemperatureControl(uint8_t pin);
     void begin();
+    TemperatureReading read();
     float readTemperature();
+    float adcToCelsius(int adcValue);
+    float steinhartHart(int adcValue);
     int getRawADC();
 };
 
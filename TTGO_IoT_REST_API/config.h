@@ -39,6 +39,128 @@
 // PARAMÈTRES SYSTÈME
 // ========================================
 #define FILTER_SIZE 10
-#define FIREBASE_UPDATE_INTERVAL 5000
+#define FIREBASE_UPDATE_INTERVAL 1000   // évaluation du miroir (écrit par exception)
+#define SAMPLE_INTERVAL 100
+#define UPLOAD_QUEUE_SIZE 8
+#define UPLOAD_POLL_INTERVAL 20
+
+// ========================================
+// TÉLÉMÉTRIE PAR EXCEPTION (bandes mortes)
+// ========================================
+// Un champ n'est réécrit dans Firebase que s'il a bougé de plus que sa
+// bande morte, ou après TELEMETRY_HEARTBEAT ms de silence. Réglable par
+// champ via POST /telemetry/set.
+#define TELEMETRY_TEMP_DEADBAND 0.2f         // °C
+#define TELEMETRY_LIGHT_RAW_DEADBAND 82      // points ADC (~2 %)
+#define TELEMETRY_LIGHT_PERCENT_DEADBAND 2   // %
+#define TELEMETRY_HEARTBEAT 300000UL         // silence max par champ (ms)
+
+// ========================================
+// RÉPARTITION SUR LES DEUX CŒURS
+// ========================================
+// Cœur 0 : pile WiFi, serveur HTTP, envoi Firebase
+// Cœur 1 : loop() (boutons, mode auto, écran), échantillonneur
+#define CORE_NETWORK 0
+#define CORE_CONTROL 1
+// 0 = handleClient() reste dans loop() (un seul cœur applicatif)
+#ifndef DUAL_CORE
+#define DUAL_CORE 1
+#endif
+#define HTTP_TASK_STACK 6144
+
+// ========================================
+// SERVEUR HTTP
+// ========================================
+// SOCKET = serveur événementiel multi-connexions (SocketHttpServer)
+// WEBSERVER = bibliothèque WebServer du core, une connexion à la fois
+#define HTTP_BACKEND_WEBSERVER 0
+#define HTTP_BACKEND_SOCKET 1
+#ifndef HTTP_BACKEND
+#define HTTP_BACKEND HTTP_BACKEND_SOCKET
+#endif
+#ifndef HTTP_PORT
+#define HTTP_PORT 80
+#endif
+#define HTTP_MAX_CLIENTS 6           // dont HTTP_MAX_STREAMS flux au plus
+#define HTTP_RX_BUFFER 1024          // requête complète (en-têtes + corps)
+#define HTTP_TX_BUFFER 3072          // réponse mise en attente par connexion
+#define HTTP_KEEPALIVE_TIMEOUT 5000  // ms sans activité avant fermeture
+#define BATCH_MAX_OPS 8              // opérations par POST /batch
+
+// Flux SSE /events et WebSocket /ws : un événement par changement d'état,
+// sérialisé une fois pour tous les abonnés. Un abonné qui ne suit pas est
+// déconnecté.
+#define HTTP_MAX_STREAMS 4           // laisse deux connexions au reste de l'API
+#define EVENTS_MIN_INTERVAL 250      // ms entre deux événements
+#define EVENTS_KEEPALIVE 15000       // commentaire SSE sur un flux sans changement
+#define EVENTS_RETRY 2000            // délai de reconnexion proposé au navigateur
+
+// GET conditionnel (ETag) et long-poll ?wait_for_change=ms sur /status et
+// /threshold. Une connexion reste toujours libre pour le reste de l'API.
+#define LONGPOLL_MAX_WAITERS 4       // réponses retenues en même temps
+#define LONGPOLL_MAX_WAIT 30000      // ms, plafond de wait_for_change
+
+// Périodes des tâches de loop() (ms)
+#define BUTTON_POLL_INTERVAL 10
+#define BUTTON_DEBOUNCE 50
+#define AUTO_MODE_INTERVAL 100
+#define DISPLAY_UPDATE_INTERVAL 500
+#define STATS_INTERVAL 2000
+#define LOG_FLUSH_INTERVAL 20
+
+// ========================================
+// HISTORIQUE EN RAM
+// ========================================
+// 1440 échantillons toutes les 5 s = 2 h, ~11,7 Ko
+#define HISTORY_CAPACITY 1440
+#define HISTORY_INTERVAL 5000
+
+// ========================================
+// JOURNAL EN FLASH (LittleFS)
+// ========================================
+// Mêmes échantillons que l'historique RAM, horodatés en secondes epoch
+// (NTP) pour survivre aux redémarrages. Une page en RAM, écrite d'un bloc
+// quand elle est pleine (~70 échantillons, ~6 min) ; segments tournants :
+// 8 x 16 Ko ~ 2 jours.
+#define FLASHLOG_DIR "/hist"
+#define FLASHLOG_PAGE_SIZE 256
+#define FLASHLOG_SEGMENT_SIZE 16384
+#define FLASHLOG_MAX_SEGMENTS 8
+#define FLASHLOG_QUERY_LIMIT 2000        // lignes max par requête
+#define FLASHLOG_MIN_EPOCH 1600000000UL  // horloge non synchronisée en dessous
+#define NTP_SERVER "pool.ntp.org"
+
+// ========================================
+// ENVOI DIFFÉRÉ VERS FIREBASE (store-and-forward)
+// ========================================
+// Le journal flash sert de file persistante : un curseur marque le dernier
+// échantillon livré sous OUTBOX_PATH/<epoch>. Lien coupé, l'arriéré
+// s'accumule (borné par le quota du journal) ; au retour il part du plus
+// ancien, un updateNode par lot, 25 échantillons/s au plus.
+#define OUTBOX_PATH "/history"
+#define OUTBOX_CURSOR_FILE FLASHLOG_DIR "/outbox"
+#define OUTBOX_BATCH 50
+#define OUTBOX_DRAIN_INTERVAL 2000    // ms entre deux lots
+#define OUTBOX_MAX_DELAY 60000        // lot partiel envoyé au plus tard après 1 min
+#define OUTBOX_SAVE_INTERVAL 60000    // curseur réécrit en flash au plus 1 fois/min
+#define OUTBOX_RATE_WINDOW 10000      // fenêtre de mesure du débit (ms)
+
+// ========================================
+// ÉCRAN
+// ========================================
+// 0  = dessin direct sur le TFT (aucune RAM d'image)
+// 16 = image 240x135 en 16 bits (~64 Ko) poussée par DMA, sans bloquer loop()
+// 8  = image en 8 bits RGB332 (~32 Ko), couleurs approchées, envoi bloquant
+#ifndef DISPLAY_SPRITE_DEPTH
+#define DISPLAY_SPRITE_DEPTH 0
+#endif
+
+// ========================================
+// JOURNALISATION
+// ========================================
+// 0 = aucun, 1 = erreurs, 2 = warnings, 3 = info, 4 = debug
+#ifndef LOG_LEVEL
+#define LOG_LEVEL 3
+#endif
 
 #endif
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""Génère TTGO_IoT_REST_API/OpenApiSpec.h à partir de api-docs/openapi.json.
+
+La spécification est minifiée et découpée autour de {{SERVER_URL}} : le
+firmware envoie OPENAPI_HEAD, l'URL du serveur, puis OPENAPI_TAIL, le tout
+depuis la flash. Une version gzip (URL relative "/") est jointe pour les
+clients qui l'acceptent.
+
+Usage : python3 api-docs/gen_openapi.py
+"""
+
+import gzip
+import json
+import os
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SOURCE = os.path.join(HERE, "openapi.json")
+TARGET = os.path.join(HERE, "..", "TTGO_IoT_REST_API", "OpenApiSpec.h")
+PLACEHOLDER = "{{SERVER_URL}}"
+
+
+def fnv1a(data):
+    h = 0x811C9DC5
+    for b in data:
+        h ^= b
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    return "%08x" % h
+
+
+def c_string(text, indent="    "):
+    lines = []
+    step = 96
+    for i in range(0, len(text), step):
+        chunk = text[i:i + step].replace("\\", "\\\\").replace('"', '\\"')
+        lines.append('%s"%s"' % (indent, chunk))
+    return "\n".join(lines)
+
+
+def c_bytes(data, indent="    "):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        spec = json.load(f)
+
+    text = json.dumps(spec, separators=(",", ":"), ensure_ascii=True)
+    if text.count(PLACEHOLDER) != 1:
+        raise SystemExit("openapi.json doit contenir %s exactement une fois" % PLACEHOLDER)
+
+    head, tail = text.split(PLACEHOLDER)
+    relative = text.replace(PLACEHOLDER, "/").encode("ascii")
+    compressed = gzip.compress(relative, compresslevel=9, mtime=0)
+    digest = fnv1a(text.encode("ascii"))
+
+    out = []
+    out.append("// Généré par api-docs/gen_openapi.py depuis api-docs/openapi.json")
+    out.append("// Ne pas éditer : modifier openapi.json puis relancer le script.")
+    out.append("#ifndef OPENAPI_SPEC_H")
+    out.append("#define OPENAPI_SPEC_H")
+    out.append("")
+    out.append("#include <Arduino.h>")
+    out.append("")
+    out.append('#define OPENAPI_SPEC_HASH "%s"' % digest)
+    out.append("#define OPENAPI_HEAD_LEN %d" % len(head))
+    out.append("#define OPENAPI_TAIL_LEN %d" % len(tail))
+    out.append("#define OPENAPI_GZ_LEN %d" % len(compressed))
+    out.append("")
+    out.append("// Spécification jusqu'à l'URL du serveur")
+    out.append("static const char OPENAPI_HEAD[] PROGMEM =")
+    out.append(c_string(head) + ";")
+    out.append("")
+    out.append("// Suite de la spécification après l'URL du serveur")
+    out.append("static const char OPENAPI_TAIL[] PROGMEM =")
+    out.append(c_string(tail) + ";")
+    out.append("")
+    out.append("// Spécification complète gzip, URL de serveur relative \"/\"")
+    out.append("static const uint8_t OPENAPI_GZ[] PROGMEM = {")
+    out.append(c_bytes(compressed))
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+
+    with open(TARGET, "w", encoding="utf-8") as f:
+        f.write("\n".join(out))
+    print("%s : %d octets (%d gzip), hash %s" % (
+        os.path.relpath(TARGET), len(head) + len(tail), len(compressed), digest))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,208 @@
+#include "Arduino.h"
+#include "Waveform.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
+HardwareSerial Serial;
+
+namespace {
+    std::mutex sourceMutex;
+    hal::AnalogSource analogSource;
+    std::atomic<unsigned long> analogReads(0);
+    std::atomic<unsigned long> delays(0);
+    std::atomic<bool> serialEnabled(true);
+    int digitalPins[64] = {0};
+
+    const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+    // Horloge simulée : millis()/micros() ne bougent que par delay() ou advance*()
+    std::atomic<bool> simulatedClock(false);
+    std::atomic<unsigned long long> simulatedMicros(0);
+
+    // Horloge réelle accélérée : virtuel = base + (réel - baseRéelle) × facteur
+    std::mutex scaleMutex;
+    std::atomic<bool> scaled(false);
+    double timeScale = 1.0;
+    unsigned long long scaleBaseVirtual = 0;
+    unsigned long long scaleBaseReal = 0;
+
+    unsigned long long realMicros() {
+        return (unsigned long long)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - bootTime).count();
+    }
+
+    unsigned long long clockMicros() {
+        if (simulatedClock) return simulatedMicros;
+        if (!scaled) return realMicros();
+        std::lock_guard<std::mutex> lock(scaleMutex);
+        return scaleBaseVirtual + (unsigned long long)((realMicros() - scaleBaseReal) * timeScale);
+    }
+}
+
+// ========================================
+// GPIO / ADC
+// ========================================
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < 64 && mode == INPUT_PULLUP) digitalPins[pin] = HIGH;
+}
+
+int analogRead(uint8_t pin) {
+    analogReads++;
+    int value;
+    if (!hal::scriptedAnalog(pin, value)) {
+        std::lock_guard<std::mutex> lock(sourceMutex);
+        if (!analogSource) return 2048;
+        value = analogSource(pin);
+    }
+    if (value < 0) value = 0;
+    if (value > 4095) value = 4095;
+    return value;
+}
+
+void analogSetAttenuation(adc_attenuation_t) {}
+void analogSetWidth(uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < 64) digitalPins[pin] = value;
+}
+
+int digitalRead(uint8_t pin) {
+    int value;
+    if (hal::scriptedDigital(pin, value)) return value;
+    return pin < 64 ? digitalPins[pin] : LOW;
+}
+
+// ========================================
+// TEMPS
+// ========================================
+unsigned long millis() {
+    return (unsigned long)(clockMicros() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)clockMicros();
+}
+
+void delay(unsigned long ms) {
+    delays++;
+    if (simulatedClock) {
+        simulatedMicros += (unsigned long long)ms * 1000;
+        return;
+    }
+    if (scaled) {
+        double scale;
+        {
+            std::lock_guard<std::mutex> lock(scaleMutex);
+            scale = timeScale;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds((long long)(ms * 1000 / scale)));
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+uint32_t esp_random() {
+    static std::random_device device;
+    return device();
+}
+
+void yield() {
+    if (!simulatedClock) std::this_thread::yield();
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ========================================
+// SERIAL
+// ========================================
+void HardwareSerial::begin(unsigned long) {}
+
+size_t HardwareSerial::printf(const char* fmt, ...) {
+    if (!serialEnabled) return 0;
+    va_list args;
+    va_start(args, fmt);
+    int n = vprintf(fmt, args);
+    va_end(args);
+    return n < 0 ? 0 : (size_t)n;
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t len) {
+    if (!serialEnabled) return len;
+    return fwrite(data, 1, len, stdout);
+}
+
+// Tampon TX de l'UART ESP32 : 128 octets
+int HardwareSerial::availableForWrite() {
+    return 128;
+}
+
+size_t HardwareSerial::print(const char* s) { return printf("%s", s); }
+size_t HardwareSerial::print(char c) { return printf("%c", c); }
+size_t HardwareSerial::print(int n) { return printf("%d", n); }
+size_t HardwareSerial::print(unsigned int n) { return printf("%u", n); }
+size_t HardwareSerial::print(long n) { return printf("%ld", n); }
+size_t HardwareSerial::print(unsigned long n) { return printf("%lu", n); }
+size_t HardwareSerial::print(double n, int digits) { return printf("%.*f", digits, n); }
+
+size_t HardwareSerial::println() { return printf("\n"); }
+size_t HardwareSerial::println(const char* s) { return printf("%s\n", s); }
+size_t HardwareSerial::println(char c) { return printf("%c\n", c); }
+size_t HardwareSerial::println(int n) { return printf("%d\n", n); }
+size_t HardwareSerial::println(unsigned int n) { return printf("%u\n", n); }
+size_t HardwareSerial::println(long n) { return printf("%ld\n", n); }
+size_t HardwareSerial::println(unsigned long n) { return printf("%lu\n", n); }
+size_t HardwareSerial::println(double n, int digits) { return printf("%.*f\n", digits, n); }
+
+// ========================================
+// CONTRÔLE DU HAL SIMULÉ
+// ========================================
+namespace hal {
+    void setAnalogSource(AnalogSource source) {
+        std::lock_guard<std::mutex> lock(sourceMutex);
+        analogSource = source;
+    }
+
+    void setDigitalInput(uint8_t pin, int value) {
+        if (pin < 64) digitalPins[pin] = value;
+    }
+
+    int getDigitalOutput(uint8_t pin) {
+        return pin < 64 ? digitalPins[pin] : LOW;
+    }
+
+    void setSerialEnabled(bool enabled) {
+        serialEnabled = enabled;
+    }
+
+    unsigned long analogReadCount() { return analogReads; }
+    unsigned long delayCount() { return delays; }
+
+    void resetCounters() {
+        analogReads = 0;
+        delays = 0;
+    }
+
+    void useSimulatedClock(bool enabled) {
+        simulatedMicros = 0;
+        simulatedClock = enabled;
+    }
+
+    void setTimeScale(double scale) {
+        if (scale <= 0) return;
+        unsigned long long now = clockMicros();
+        std::lock_guard<std::mutex> lock(scaleMutex);
+        scaleBaseVirtual = now;
+        scaleBaseReal = realMicros();
+        timeScale = scale;
+        scaled = true;
+    }
+
+    void advanceMicros(unsigned long us) { simulatedMicros += us; }
+    void advanceMillis(unsigned long ms) { simulatedMicros += (unsigned long long)ms * 1000; }
+}
@@ -0,0 +1,112 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// ========================================
+// STAND-IN ARDUINO POUR BUILD LINUX
+// ========================================
+// Reproduit le sous-ensemble de l'API Arduino/ESP32 utilisé par le
+// firmware. L'ADC est simulé par une source remplaçable (hal::setAnalogSource)
+// et delay() dort réellement pour que les latences mesurées soient réalistes.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <functional>
+
+#include "WString.h"
+
+// Flash adressable directement sur ESP32 : PROGMEM est sans effet
+typedef const char* PGM_P;
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define strlen_P strlen
+#define memcpy_P memcpy
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+enum adc_attenuation_t { ADC_0db, ADC_2_5db, ADC_6db, ADC_11db };
+
+void pinMode(uint8_t pin, uint8_t mode);
+int analogRead(uint8_t pin);
+void analogSetAttenuation(adc_attenuation_t attenuation);
+void analogSetWidth(uint8_t bits);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+// Générateur matériel du core ESP32 (esp_system.h)
+uint32_t esp_random();
+
+// SNTP : l'horloge système de l'hôte est déjà à l'heure
+inline void configTime(long, int, const char*, const char* = 0, const char* = 0) {}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class HardwareSerial {
+public:
+    void begin(unsigned long baud);
+    size_t print(const char* s);
+    size_t print(const String& s) { return print(s.c_str()); }
+    size_t print(char c);
+    size_t print(int n);
+    size_t print(unsigned int n);
+    size_t print(long n);
+    size_t print(unsigned long n);
+    size_t print(double n, int digits = 2);
+    size_t println();
+    size_t println(const char* s);
+    size_t println(const String& s) { return println(s.c_str()); }
+    size_t println(char c);
+    size_t println(int n);
+    size_t println(unsigned int n);
+    size_t println(long n);
+    size_t println(unsigned long n);
+    size_t println(double n, int digits = 2);
+    size_t printf(const char* fmt, ...);
+    size_t write(const uint8_t* data, size_t len);
+    int availableForWrite();
+};
+
+extern HardwareSerial Serial;
+
+// ========================================
+// CONTRÔLE DU HAL SIMULÉ
+// ========================================
+namespace hal {
+    typedef std::function<int(uint8_t pin)> AnalogSource;
+
+    void setAnalogSource(AnalogSource source);
+    void setDigitalInput(uint8_t pin, int value);
+    int getDigitalOutput(uint8_t pin);
+    void setSerialEnabled(bool enabled);
+
+    // Compteurs pour les benchmarks
+    unsigned long analogReadCount();
+    unsigned long delayCount();
+    void resetCounters();
+
+    // Horloge simulée (tests d'ordonnancement) : repart de 0, delay() avance
+    // le temps sans dormir
+    void useSimulatedClock(bool enabled);
+    void advanceMicros(unsigned long us);
+    void advanceMillis(unsigned long ms);
+
+    // Horloge réelle accélérée (x > 1) ou ralentie : millis(), micros() et
+    // delay() suivent le facteur, le temps reste continu au changement
+    void setTimeScale(double scale);
+}
+
+#endif
@@ -0,0 +1,775 @@
+#include "ArduinoJson.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// ========================================
+// POOL
+// ========================================
+JsonNode* JsonPool::newNode(uint8_t type) {
+    size_t align = sizeof(void*);
+    size_t start = (used + align - 1) & ~(align - 1);
+    if (start + sizeof(JsonNode) > capacity) {
+        overflowed = true;
+        return 0;
+    }
+    JsonNode* node = reinterpret_cast<JsonNode*>(memory + start);
+    used = start + sizeof(JsonNode);
+
+    node->type = type;
+    node->singlePrecision = false;
+    node->key = 0;
+    node->next = 0;
+    node->child = 0;
+    node->last = 0;
+    node->value.i = 0;
+    return node;
+}
+
+const char* JsonPool::copy(const char* s, size_t len) {
+    if (used + len + 1 > capacity) {
+        overflowed = true;
+        return 0;
+    }
+    char* out = memory + used;
+    memcpy(out, s, len);
+    out[len] = '\0';
+    used += len + 1;
+    return out;
+}
+
+static void appendChild(JsonNode* parent, JsonNode* child) {
+    if (parent->last) parent->last->next = child;
+    else parent->child = child;
+    parent->last = child;
+}
+
+static JsonNode* findMember(const JsonNode* object, const char* key) {
+    if (!object || object->type != JSON_OBJECT) return 0;
+    for (JsonNode* n = object->child; n; n = n->next) {
+        if (n->key && strcmp(n->key, key) == 0) return n;
+    }
+    return 0;
+}
+
+static JsonNode* elementAt(const JsonNode* array, size_t index) {
+    if (!array || array->type != JSON_ARRAY) return 0;
+    JsonNode* n = array->child;
+    while (n && index--) n = n->next;
+    return n;
+}
+
+static size_t childCount(const JsonNode* node) {
+    if (!node || (node->type != JSON_OBJECT && node->type != JSON_ARRAY)) return 0;
+    size_t n = 0;
+    for (JsonNode* c = node->child; c; c = c->next) n++;
+    return n;
+}
+
+// ========================================
+// VARIANT
+// ========================================
+JsonVariant::JsonVariant(JsonPool* pool, JsonNode* parent, const char* key, bool copyKey)
+    : _pool(pool), _node(findMember(parent, key)), _parent(parent), _key(key),
+      _copyKey(copyKey), _index(0) {}
+
+JsonVariant::JsonVariant(JsonPool* pool, JsonNode* parent, size_t index)
+    : _pool(pool), _node(elementAt(parent, index)), _parent(parent), _key(0),
+      _copyKey(false), _index(index) {}
+
+// Crée le nœud en attente (membre ou élément) au moment de l'écriture
+JsonNode* JsonVariant::resolve(uint8_t typeOnCreate) {
+    if (_node) return _node;
+    if (!_pool || !_parent) return 0;
+
+    if (_key) {
+        if (_parent->type == JSON_NULL) _parent->type = JSON_OBJECT;
+        if (_parent->type != JSON_OBJECT) return 0;
+        const char* key = _copyKey ? _pool->copy(_key, strlen(_key)) : _key;
+        if (!key) return 0;
+        JsonNode* node = _pool->newNode(typeOnCreate);
+        if (!node) return 0;
+        node->key = key;
+        appendChild(_parent, node);
+        _node = node;
+    } else {
+        if (_parent->type == JSON_NULL) _parent->type = JSON_ARRAY;
+        if (_parent->type != JSON_ARRAY) return 0;
+        // Complète le tableau jusqu'à l'index demandé
+        size_t count = childCount(_parent);
+        JsonNode* node = 0;
+        while (count <= _index) {
+            node = _pool->newNode(JSON_NULL);
+            if (!node) return 0;
+            appendChild(_parent, node);
+            count++;
+        }
+        node->type = typeOnCreate;
+        _node = node;
+    }
+    return _node;
+}
+
+void JsonVariant::setScalar(uint8_t type) {
+    _node->type = type;
+    _node->child = 0;
+    _node->last = 0;
+    _node->singlePrecision = false;
+}
+
+bool JsonVariant::set(bool value) {
+    if (!resolve(JSON_NULL)) return false;
+    setScalar(JSON_BOOL);
+    _node->value.b = value;
+    return true;
+}
+
+bool JsonVariant::set(long long value) {
+    if (!resolve(JSON_NULL)) return false;
+    setScalar(JSON_INT);
+    _node->value.i = value;
+    return true;
+}
+
+bool JsonVariant::set(float value) {
+    if (!set((double)value)) return false;
+    _node->singlePrecision = true;
+    return true;
+}
+
+bool JsonVariant::set(double value) {
+    if (!resolve(JSON_NULL)) return false;
+    setScalar(JSON_FLOAT);
+    _node->value.f = value;
+    return true;
+}
+
+// const char* : pointeur conservé tel quel, comme ArduinoJson
+bool JsonVariant::set(const char* value) {
+    if (!resolve(JSON_NULL)) return false;
+    if (!value) {
+        setScalar(JSON_NULL);
+        return true;
+    }
+    setScalar(JSON_STRING);
+    _node->value.s = value;
+    return true;
+}
+
+bool JsonVariant::set(char* value) {
+    if (!value) return set((const char*)0);
+    const char* copy = _pool ? _pool->copy(value, strlen(value)) : 0;
+    if (!copy) return false;
+    return set(copy);
+}
+
+bool JsonVariant::set(const String& value) {
+    const char* copy = _pool ? _pool->copy(value.c_str(), value.length()) : 0;
+    if (!copy) return false;
+    return set(copy);
+}
+
+bool JsonVariant::set(const JsonVariant& value) {
+    const JsonNode* src = value._node;
+    if (!src || src->type == JSON_NULL) return set((const char*)0);
+    switch (src->type) {
+        case JSON_BOOL: return set(src->value.b);
+        case JSON_INT: return set(src->value.i);
+        case JSON_FLOAT: return set(src->value.f);
+        case JSON_STRING: return set(src->value.s);
+        default: break;
+    }
+    // Copie profonde des objets/tableaux
+    if (!resolve(src->type)) return false;
+    setScalar(src->type);
+    for (JsonNode* c = src->child; c; c = c->next) {
+        JsonVariant child = src->type == JSON_OBJECT
+            ? JsonVariant(_pool, _node, c->key, true)
+            : JsonVariant(_pool, _node, childCount(_node));
+        if (!child.set(JsonVariant(value._pool, c))) return false;
+    }
+    return true;
+}
+
+JsonVariant JsonVariant::operator[](const char* key) {
+    JsonNode* node = resolve(JSON_OBJECT);
+    return JsonVariant(_pool, node, key, false);
+}
+
+JsonVariant JsonVariant::operator[](const String& key) {
+    JsonNode* node = resolve(JSON_OBJECT);
+    if (!node || !_pool) return JsonVariant();
+    const char* copy = _pool->copy(key.c_str(), key.length());
+    return JsonVariant(_pool, node, copy ? copy : "", false);
+}
+
+JsonVariant JsonVariant::operator[](int index) {
+    return (*this)[(size_t)index];
+}
+
+JsonVariant JsonVariant::operator[](size_t index) {
+    JsonNode* node = resolve(JSON_ARRAY);
+    return JsonVariant(_pool, node, index);
+}
+
+size_t JsonVariant::size() const {
+    return childCount(_node);
+}
+
+bool JsonVariant::containsKey(const char* key) const {
+    return findMember(_node, key) != 0;
+}
+
+JsonArray JsonVariant::createNestedArray(const char* key) {
+    JsonVariant member = (*this)[key];
+    return member.to<JsonArray>();
+}
+
+JsonObject JsonVariant::createNestedObject(const char* key) {
+    JsonVariant member = (*this)[key];
+    return member.to<JsonObject>();
+}
+
+JsonArray JsonVariant::arrayForAdd() {
+    JsonNode* node = resolve(JSON_ARRAY);
+    if (!node) return JsonArray();
+    if (node->type == JSON_NULL) node->type = JSON_ARRAY;
+    return node->type == JSON_ARRAY ? JsonArray(_pool, node) : JsonArray();
+}
+
+bool JsonVariant::add(const JsonVariant& value) {
+    return arrayForAdd().addElement().set(value);
+}
+
+bool JsonVariant::operator==(const char* s) const {
+    if (!_node || _node->type != JSON_STRING || !s) return false;
+    return strcmp(_node->value.s, s) == 0;
+}
+
+const char* JsonVariant::operator|(const char* fallback) const {
+    return is<const char*>() ? _node->value.s : fallback;
+}
+
+// ----- conversions -----
+static long long toInteger(const JsonNode* n) {
+    if (!n) return 0;
+    switch (n->type) {
+        case JSON_BOOL: return n->value.b ? 1 : 0;
+        case JSON_INT: return n->value.i;
+        case JSON_FLOAT: return (long long)n->value.f;
+        case JSON_STRING: return atoll(n->value.s);
+        default: return 0;
+    }
+}
+
+static double toReal(const JsonNode* n) {
+    if (!n) return 0;
+    switch (n->type) {
+        case JSON_BOOL: return n->value.b ? 1 : 0;
+        case JSON_INT: return (double)n->value.i;
+        case JSON_FLOAT: return n->value.f;
+        case JSON_STRING: return atof(n->value.s);
+        default: return 0;
+    }
+}
+
+template <> bool JsonVariant::as<bool>() const {
+    if (!_node) return false;
+    if (_node->type == JSON_BOOL) return _node->value.b;
+    return toInteger(_node) != 0;
+}
+template <> int JsonVariant::as<int>() const { return (int)toInteger(_node); }
+template <> unsigned int JsonVariant::as<unsigned int>() const { return (unsigned int)toInteger(_node); }
+template <> long JsonVariant::as<long>() const { return (long)toInteger(_node); }
+template <> unsigned long JsonVariant::as<unsigned long>() const { return (unsigned long)toInteger(_node); }
+template <> long long JsonVariant::as<long long>() const { return toInteger(_node); }
+template <> uint8_t JsonVariant::as<uint8_t>() const { return (uint8_t)toInteger(_node); }
+template <> uint16_t JsonVariant::as<uint16_t>() const { return (uint16_t)toInteger(_node); }
+template <> float JsonVariant::as<float>() const { return (float)toReal(_node); }
+template <> double JsonVariant::as<double>() const { return toReal(_node); }
+template <> const char* JsonVariant::as<const char*>() const {
+    return _node && _node->type == JSON_STRING ? _node->value.s : 0;
+}
+template <> String JsonVariant::as<String>() const {
+    if (!_node || _node->type == JSON_NULL) return String("null");
+    if (_node->type == JSON_STRING) return String(_node->value.s);
+    String out;
+    serializeJson(*this, out);
+    return out;
+}
+template <> JsonObject JsonVariant::as<JsonObject>() const {
+    return _node && _node->type == JSON_OBJECT ? JsonObject(_pool, _node) : JsonObject();
+}
+template <> JsonArray JsonVariant::as<JsonArray>() const {
+    return _node && _node->type == JSON_ARRAY ? JsonArray(_pool, _node) : JsonArray();
+}
+template <> JsonVariant JsonVariant::as<JsonVariant>() const { return *this; }
+
+template <> bool JsonVariant::is<bool>() const { return _node && _node->type == JSON_BOOL; }
+template <> bool JsonVariant::is<int>() const { return _node && _node->type == JSON_INT; }
+template <> bool JsonVariant::is<unsigned int>() const { return _node && _node->type == JSON_INT && _node->value.i >= 0; }
+template <> bool JsonVariant::is<long>() const { return _node && _node->type == JSON_INT; }
+template <> bool JsonVariant::is<unsigned long>() const { return _node && _node->type == JSON_INT && _node->value.i >= 0; }
+template <> bool JsonVariant::is<long long>() const { return _node && _node->type == JSON_INT; }
+template <> bool JsonVariant::is<uint8_t>() const { return _node && _node->type == JSON_INT && _node->value.i >= 0 && _node->value.i <= 255; }
+template <> bool JsonVariant::is<uint16_t>() const { return _node && _node->type == JSON_INT && _node->value.i >= 0 && _node->value.i <= 65535; }
+template <> bool JsonVariant::is<float>() const { return _node && (_node->type == JSON_FLOAT || _node->type == JSON_INT); }
+template <> bool JsonVariant::is<double>() const { return _node && (_node->type == JSON_FLOAT || _node->type == JSON_INT); }
+template <> bool JsonVariant::is<const char*>() const { return _node && _node->type == JSON_STRING; }
+template <> bool JsonVariant::is<String>() const { return _node && _node->type == JSON_STRING; }
+template <> bool JsonVariant::is<JsonObject>() const { return _node && _node->type == JSON_OBJECT; }
+template <> bool JsonVariant::is<JsonArray>() const { return _node && _node->type == JSON_ARRAY; }
+
+template <> JsonObject JsonVariant::to<JsonObject>() {
+    if (!resolve(JSON_OBJECT)) return JsonObject();
+    setScalar(JSON_OBJECT);
+    return JsonObject(_pool, _node);
+}
+template <> JsonArray JsonVariant::to<JsonArray>() {
+    if (!resolve(JSON_ARRAY)) return JsonArray();
+    setScalar(JSON_ARRAY);
+    return JsonArray(_pool, _node);
+}
+
+// ========================================
+// OBJET / TABLEAU
+// ========================================
+JsonVariant JsonObject::operator[](const char* key) const {
+    return JsonVariant(_pool, _node, key, false);
+}
+
+JsonVariant JsonObject::operator[](const String& key) const {
+    return JsonVariant(_pool, _node, key.c_str(), true);
+}
+
+JsonArray JsonObject::createNestedArray(const char* key) const {
+    JsonVariant member = (*this)[key];
+    return member.to<JsonArray>();
+}
+
+JsonObject JsonObject::createNestedObject(const char* key) const {
+    JsonVariant member = (*this)[key];
+    return member.to<JsonObject>();
+}
+
+bool JsonObject::containsKey(const char* key) const {
+    return findMember(_node, key) != 0;
+}
+
+size_t JsonObject::size() const {
+    return childCount(_node);
+}
+
+JsonVariant JsonArray::operator[](size_t index) const {
+    return JsonVariant(_pool, _node, index);
+}
+
+JsonVariant JsonArray::addElement() const {
+    if (!_node || !_pool) return JsonVariant();
+    JsonNode* node = _pool->newNode(JSON_NULL);
+    if (!node) return JsonVariant();
+    appendChild(_node, node);
+    return JsonVariant(_pool, node);
+}
+
+JsonObject JsonArray::createNestedObject() const {
+    return addElement().to<JsonObject>();
+}
+
+JsonArray JsonArray::createNestedArray() const {
+    return addElement().to<JsonArray>();
+}
+
+size_t JsonArray::size() const {
+    return childCount(_node);
+}
+
+// ========================================
+// DOCUMENTS
+// ========================================
+JsonDocument::JsonDocument(char* memory, size_t capacity) : _root(0) {
+    _pool.memory = memory;
+    _pool.capacity = capacity;
+    clear();
+}
+
+void JsonDocument::clear() {
+    _pool.used = 0;
+    _pool.overflowed = false;
+    _root = _pool.newNode(JSON_NULL);
+}
+
+JsonNode* JsonDocument::rootAs(uint8_t type) {
+    if (!_root) return 0;
+    if (_root->type == JSON_NULL) _root->type = type;
+    return _root->type == type ? _root : 0;
+}
+
+JsonVariant JsonDocument::operator[](const char* key) {
+    return JsonVariant(&_pool, rootAs(JSON_OBJECT), key, false);
+}
+
+JsonVariant JsonDocument::operator[](const String& key) {
+    return JsonVariant(&_pool, rootAs(JSON_OBJECT), key.c_str(), true);
+}
+
+JsonVariant JsonDocument::operator[](size_t index) {
+    return JsonVariant(&_pool, rootAs(JSON_ARRAY), index);
+}
+
+JsonArray JsonDocument::createNestedArray(const char* key) {
+    return JsonObject(&_pool, rootAs(JSON_OBJECT)).createNestedArray(key);
+}
+
+JsonObject JsonDocument::createNestedObject(const char* key) {
+    return JsonObject(&_pool, rootAs(JSON_OBJECT)).createNestedObject(key);
+}
+
+JsonObject JsonDocument::createNestedObject() {
+    return JsonArray(&_pool, rootAs(JSON_ARRAY)).createNestedObject();
+}
+
+bool JsonDocument::containsKey(const char* key) const {
+    return findMember(_root, key) != 0;
+}
+
+size_t JsonDocument::size() const {
+    return childCount(_root);
+}
+
+template <> JsonObject JsonDocument::to<JsonObject>() {
+    clear();
+    return JsonObject(&_pool, rootAs(JSON_OBJECT));
+}
+
+template <> JsonArray JsonDocument::to<JsonArray>() {
+    clear();
+    return JsonArray(&_pool, rootAs(JSON_ARRAY));
+}
+
+DynamicJsonDocument::DynamicJsonDocument(size_t capacity)
+    : JsonDocument(new char[capacity * HOST_JSON_CAPACITY_SCALE],
+                   capacity * HOST_JSON_CAPACITY_SCALE) {}
+
+DynamicJsonDocument::~DynamicJsonDocument() {
+    delete[] _pool.memory;
+}
+
+// ========================================
+// SÉRIALISATION
+// ========================================
+namespace {
+    // Écrit dans un tampon borné, ou compte seulement si out == 0
+    struct Writer {
+        char* out;
+        size_t size;
+        size_t len;
+        String* string;
+
+        void write(const char* s, size_t n) {
+            if (string) string->concat(s, n);
+            else if (out) {
+                for (size_t i = 0; i < n && len + i + 1 < size; i++) out[len + i] = s[i];
+            }
+            len += n;
+        }
+        void write(const char* s) { write(s, strlen(s)); }
+        void write(char c) { write(&c, 1); }
+    };
+
+    void writeString(Writer& w, const char* s) {
+        w.write('"');
+        for (const char* p = s; *p; p++) {
+            char c = *p;
+            switch (c) {
+                case '"': w.write("\\\"", 2); break;
+                case '\\': w.write("\\\\", 2); break;
+                case '\n': w.write("\\n", 2); break;
+                case '\r': w.write("\\r", 2); break;
+                case '\t': w.write("\\t", 2); break;
+                case '\b': w.write("\\b", 2); break;
+                case '\f': w.write("\\f", 2); break;
+                default:
+                    if ((unsigned char)c < 0x20) {
+                        char esc[8];
+                        snprintf(esc, sizeof(esc), "\\u%04x", c);
+                        w.write(esc);
+                    } else {
+                        w.write(c);
+                    }
+            }
+        }
+        w.write('"');
+    }
+
+    void writeNode(Writer& w, const JsonNode* n) {
+        char tmp[32];
+        if (!n) {
+            w.write("null");
+            return;
+        }
+        switch (n->type) {
+            case JSON_NULL: w.write("null"); break;
+            case JSON_BOOL: w.write(n->value.b ? "true" : "false"); break;
+            case JSON_INT:
+                snprintf(tmp, sizeof(tmp), "%lld", n->value.i);
+                w.write(tmp);
+                break;
+            case JSON_FLOAT:
+                if (isnan(n->value.f) || isinf(n->value.f)) {
+                    w.write("null");
+                } else {
+                    snprintf(tmp, sizeof(tmp), n->singlePrecision ? "%.7g" : "%.15g", n->value.f);
+                    w.write(tmp);
+                }
+                break;
+            case JSON_STRING: writeString(w, n->value.s); break;
+            case JSON_OBJECT:
+                w.write('{');
+                for (const JsonNode* c = n->child; c; c = c->next) {
+                    if (c != n->child) w.write(',');
+                    writeString(w, c->key);
+                    w.write(':');
+                    writeNode(w, c);
+                }
+                w.write('}');
+                break;
+            case JSON_ARRAY:
+                w.write('[');
+                for (const JsonNode* c = n->child; c; c = c->next) {
+                    if (c != n->child) w.write(',');
+                    writeNode(w, c);
+                }
+                w.write(']');
+                break;
+        }
+    }
+
+    size_t serializeNode(const JsonNode* n, char* out, size_t size) {
+        Writer w = { out, size, 0, 0 };
+        writeNode(w, n);
+        if (out && size) out[w.len < size ? w.len : size - 1] = '\0';
+        return w.len < size ? w.len : (size ? size - 1 : 0);
+    }
+
+    size_t serializeNode(const JsonNode* n, String& output) {
+        output = "";
+        Writer w = { 0, 0, 0, &output };
+        writeNode(w, n);
+        return w.len;
+    }
+}
+
+size_t measureJson(const JsonDocument& doc) {
+    Writer w = { 0, 0, 0, 0 };
+    writeNode(w, doc.root());
+    return w.len;
+}
+
+size_t measureJson(const JsonVariant& value) {
+    Writer w = { 0, 0, 0, 0 };
+    writeNode(w, value.node());
+    return w.len;
+}
+
+size_t serializeJson(const JsonDocument& doc, String& output) {
+    return serializeNode(doc.root(), output);
+}
+
+size_t serializeJson(const JsonDocument& doc, char* output, size_t size) {
+    return serializeNode(doc.root(), output, size);
+}
+
+size_t serializeJson(const JsonVariant& value, char* output, size_t size) {
+    return serializeNode(value.node(), output, size);
+}
+
+size_t serializeJson(const JsonVariant& value, String& output) {
+    return serializeNode(value.node(), output);
+}
+
+// ========================================
+// DÉSÉRIALISATION
+// ========================================
+const char* DeserializationError::c_str() const {
+    switch (_code) {
+        case Ok: return "Ok";
+        case EmptyInput: return "EmptyInput";
+        case IncompleteInput: return "IncompleteInput";
+        case InvalidInput: return "InvalidInput";
+        case NoMemory: return "NoMemory";
+        case TooDeep: return "TooDeep";
+    }
+    return "Unknown";
+}
+
+namespace {
+    struct Parser {
+        const char* p;
+        const char* end;
+        JsonPool* pool;
+        DeserializationError::Code error;
+        int depth;
+
+        void skipSpace() {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+        }
+
+        bool fail(DeserializationError::Code code) {
+            if (error == DeserializationError::Ok) error = code;
+            return false;
+        }
+
+        bool parseString(const char** out) {
+            // p pointe sur le guillemet ouvrant ; la chaîne est recopiée dans le pool
+            p++;
+            const char* start = p;
+            size_t len = 0;
+            bool escaped = false;
+            while (p < end && *p != '"') {
+                if (*p == '\\') {
+                    escaped = true;
+                    p++;
+                    if (p >= end) return fail(DeserializationError::IncompleteInput);
+                    if (*p == 'u') p += 4;
+                }
+                p++;
+                len++;
+            }
+            if (p >= end) return fail(DeserializationError::IncompleteInput);
+
+            if (!escaped) {
+                *out = pool->copy(start, (size_t)(p - start));
+            } else {
+                char* buf = (char*)pool->copy(start, len);
+                if (buf) {
+                    size_t n = 0;
+                    for (const char* q = start; q < p; q++) {
+                        if (*q != '\\') { buf[n++] = *q; continue; }
+                        q++;
+                        switch (*q) {
+                            case 'n': buf[n++] = '\n'; break;
+                            case 'r': buf[n++] = '\r'; break;
+                            case 't': buf[n++] = '\t'; break;
+                            case 'b': buf[n++] = '\b'; break;
+                            case 'f': buf[n++] = '\f'; break;
+                            case 'u': {
+                                char hex[5] = { q[1], q[2], q[3], q[4], 0 };
+                                long code = strtol(hex, 0, 16);
+                                buf[n++] = code < 0x80 ? (char)code : '?';
+                                q += 4;
+                                break;
+                            }
+                            default: buf[n++] = *q;
+                        }
+                    }
+                    buf[n] = '\0';
+                }
+                *out = buf;
+            }
+            p++;
+            if (!*out) return fail(DeserializationError::NoMemory);
+            return true;
+        }
+
+        bool parseValue(JsonNode* node) {
+            skipSpace();
+            if (p >= end) return fail(DeserializationError::IncompleteInput);
+
+            if (*p == '{' || *p == '[') {
+                if (++depth > 10) return fail(DeserializationError::TooDeep);
+                bool object = *p == '{';
+                char close = object ? '}' : ']';
+                node->type = object ? JSON_OBJECT : JSON_ARRAY;
+                p++;
+                skipSpace();
+                if (p < end && *p == close) {
+                    p++;
+                    depth--;
+                    return true;
+                }
+                while (true) {
+                    JsonNode* child = pool->newNode(JSON_NULL);
+                    if (!child) return fail(DeserializationError::NoMemory);
+                    if (object) {
+                        skipSpace();
+                        if (p >= end) return fail(DeserializationError::IncompleteInput);
+                        if (*p != '"') return fail(DeserializationError::InvalidInput);
+                        if (!parseString(&child->key)) return false;
+                        skipSpace();
+                        if (p >= end) return fail(DeserializationError::IncompleteInput);
+                        if (*p != ':') return fail(DeserializationError::InvalidInput);
+                        p++;
+                    }
+                    if (!parseValue(child)) return false;
+                    appendChild(node, child);
+                    skipSpace();
+                    if (p >= end) return fail(DeserializationError::IncompleteInput);
+                    if (*p == ',') { p++; continue; }
+                    if (*p == close) { p++; depth--; return true; }
+                    return fail(DeserializationError::InvalidInput);
+                }
+            }
+
+            if (*p == '"') {
+                node->type = JSON_STRING;
+                return parseString(&node->value.s);
+            }
+
+            if (end - p >= 4 && strncmp(p, "true", 4) == 0) {
+                node->type = JSON_BOOL; node->value.b = true; p += 4; return true;
+            }
+            if (end - p >= 5 && strncmp(p, "false", 5) == 0) {
+                node->type = JSON_BOOL; node->value.b = false; p += 5; return true;
+            }
+            if (end - p >= 4 && strncmp(p, "null", 4) == 0) {
+                node->type = JSON_NULL; p += 4; return true;
+            }
+
+            if (*p == '-' || (*p >= '0' && *p <= '9')) {
+                char num[40];
+                size_t n = 0;
+                bool real = false;
+                while (p < end && n < sizeof(num) - 1 &&
+                       (strchr("+-0123456789", *p) || *p == '.' || *p == 'e' || *p == 'E')) {
+                    if (*p == '.' || *p == 'e' || *p == 'E') real = true;
+                    num[n++] = *p++;
+                }
+                num[n] = '\0';
+                if (real) {
+                    node->type = JSON_FLOAT;
+                    node->value.f = atof(num);
+                } else {
+                    node->type = JSON_INT;
+                    node->value.i = atoll(num);
+                }
+                return true;
+            }
+
+            if (p >= end) return fail(DeserializationError::IncompleteInput);
+            return fail(DeserializationError::InvalidInput);
+        }
+    };
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t length) {
+    doc.clear();
+    if (!input || length == 0) return DeserializationError::EmptyInput;
+
+    Parser parser = { input, input + length, doc.pool(), DeserializationError::Ok, 0 };
+    parser.skipSpace();
+    if (parser.p >= parser.end) return DeserializationError::EmptyInput;
+    if (!doc.root()) return DeserializationError::NoMemory;
+
+    parser.parseValue(doc.root());
+    return parser.error;
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input) {
+    return deserializeJson(doc, input, input ? strlen(input) : 0);
+}
+
+DeserializationError deserializeJson(JsonDocument& doc, const String& input) {
+    return deserializeJson(doc, input.c_str(), input.length());
+}
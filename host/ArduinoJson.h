@@ -0,0 +1,327 @@
+#ifndef HOST_ARDUINOJSON_H
+#define HOST_ARDUINOJSON_H
+
+// ========================================
+// STAND-IN ARDUINOJSON (API v6)
+// ========================================
+// Sous-ensemble utilisé par le firmware : documents à pool fixe
+// (StaticJsonDocument) ou alloué une fois (DynamicJsonDocument), objets,
+// tableaux, sérialisation et désérialisation. Comme la vraie bibliothèque,
+// aucun accès au tas une fois le document construit.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "WString.h"
+
+enum JsonNodeType {
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_INT,
+    JSON_FLOAT,
+    JSON_STRING,
+    JSON_OBJECT,
+    JSON_ARRAY
+};
+
+struct JsonNode {
+    uint8_t type;
+    bool singlePrecision;
+    const char* key;
+    JsonNode* next;
+    JsonNode* child;
+    JsonNode* last;
+    union {
+        bool b;
+        long long i;
+        double f;
+        const char* s;
+    } value;
+};
+
+class JsonPool {
+public:
+    char* memory;
+    size_t capacity;
+    size_t used;
+    bool overflowed;
+
+    JsonPool() : memory(0), capacity(0), used(0), overflowed(false) {}
+    JsonNode* newNode(uint8_t type);
+    const char* copy(const char* s, size_t len);
+};
+
+class JsonObject;
+class JsonArray;
+
+// ========================================
+// VARIANT (valeur ou membre pas encore créé)
+// ========================================
+class JsonVariant {
+protected:
+    JsonPool* _pool;
+    JsonNode* _node;
+    JsonNode* _parent;      // objet/tableau qui recevra le nœud à l'écriture
+    const char* _key;       // clé en attente (membre d'objet)
+    bool _copyKey;
+    size_t _index;          // index en attente (élément de tableau)
+
+    JsonNode* resolve(uint8_t typeOnCreate);
+    void setScalar(uint8_t type);
+    JsonArray arrayForAdd();
+
+public:
+    JsonVariant() : _pool(0), _node(0), _parent(0), _key(0), _copyKey(false), _index(0) {}
+    JsonVariant(JsonPool* pool, JsonNode* node)
+        : _pool(pool), _node(node), _parent(0), _key(0), _copyKey(false), _index(0) {}
+    JsonVariant(JsonPool* pool, JsonNode* parent, const char* key, bool copyKey);
+    JsonVariant(JsonPool* pool, JsonNode* parent, size_t index);
+
+    JsonNode* node() const { return _node; }
+    JsonPool* pool() const { return _pool; }
+
+    bool set(bool value);
+    bool set(int value) { return set((long long)value); }
+    bool set(unsigned int value) { return set((long long)value); }
+    bool set(long value) { return set((long long)value); }
+    bool set(unsigned long value) { return set((long long)value); }
+    bool set(long long value);
+    bool set(unsigned long long value) { return set((long long)value); }
+    bool set(float value);
+    bool set(double value);
+    bool set(const char* value);
+    bool set(char* value);
+    bool set(const String& value);
+    bool set(const JsonVariant& value);
+
+    template <typename T>
+    JsonVariant& operator=(const T& value) { set(value); return *this; }
+    JsonVariant& operator=(const JsonVariant& value) { set(value); return *this; }
+
+    JsonVariant operator[](const char* key);
+    JsonVariant operator[](const String& key);
+    JsonVariant operator[](int index);
+    JsonVariant operator[](size_t index);
+
+    template <typename T> T as() const;
+    template <typename T> bool is() const;
+    template <typename T> T to();
+    template <typename T> operator T() const { return as<T>(); }
+
+    bool isNull() const { return !_node || _node->type == JSON_NULL; }
+    size_t size() const;
+    bool containsKey(const char* key) const;
+    JsonArray createNestedArray(const char* key);
+    JsonObject createNestedObject(const char* key);
+    bool add(const JsonVariant& value);
+    template <typename T> bool add(const T& value);
+
+    bool operator==(const char* s) const;
+    bool operator!=(const char* s) const { return !(*this == s); }
+
+    template <typename T>
+    T operator|(const T& fallback) const { return is<T>() ? as<T>() : fallback; }
+    const char* operator|(const char* fallback) const;
+};
+
+// ========================================
+// OBJET / TABLEAU
+// ========================================
+// Clé d'un membre : comme ArduinoJson 6, pas de conversion implicite en char*
+class JsonString {
+private:
+    const char* _str;
+
+public:
+    JsonString(const char* str) : _str(str) {}
+    const char* c_str() const { return _str; }
+    size_t size() const { return _str ? strlen(_str) : 0; }
+    bool isNull() const { return !_str; }
+};
+
+struct JsonPair {
+    const char* _key;
+    JsonVariant _value;
+    JsonString key() const { return JsonString(_key); }
+    JsonVariant value() const { return _value; }
+};
+
+class JsonObject {
+private:
+    JsonPool* _pool;
+    JsonNode* _node;
+
+public:
+    JsonObject() : _pool(0), _node(0) {}
+    JsonObject(JsonPool* pool, JsonNode* node) : _pool(pool), _node(node) {}
+
+    JsonVariant operator[](const char* key) const;
+    JsonVariant operator[](const String& key) const;
+    JsonArray createNestedArray(const char* key) const;
+    JsonObject createNestedObject(const char* key) const;
+    bool containsKey(const char* key) const;
+    bool isNull() const { return !_node; }
+    size_t size() const;
+    JsonNode* node() const { return _node; }
+
+    class iterator {
+        JsonPool* _pool;
+        JsonNode* _node;
+    public:
+        iterator(JsonPool* pool, JsonNode* node) : _pool(pool), _node(node) {}
+        JsonPair operator*() const { JsonPair p = { _node->key, JsonVariant(_pool, _node) }; return p; }
+        iterator& operator++() { _node = _node->next; return *this; }
+        bool operator!=(const iterator& other) const { return _node != other._node; }
+    };
+    iterator begin() const { return iterator(_pool, _node ? _node->child : 0); }
+    iterator end() const { return iterator(_pool, 0); }
+};
+
+class JsonArray {
+private:
+    JsonPool* _pool;
+    JsonNode* _node;
+
+public:
+    JsonArray() : _pool(0), _node(0) {}
+    JsonArray(JsonPool* pool, JsonNode* node) : _pool(pool), _node(node) {}
+
+    JsonVariant operator[](size_t index) const;
+    JsonVariant addElement() const;
+    template <typename T> bool add(const T& value) const { return addElement().set(value); }
+    JsonObject createNestedObject() const;
+    JsonArray createNestedArray() const;
+    bool isNull() const { return !_node; }
+    size_t size() const;
+    JsonNode* node() const { return _node; }
+
+    class iterator {
+        JsonPool* _pool;
+        JsonNode* _node;
+    public:
+        iterator(JsonPool* pool, JsonNode* node) : _pool(pool), _node(node) {}
+        JsonVariant operator*() const { return JsonVariant(_pool, _node); }
+        iterator& operator++() { _node = _node->next; return *this; }
+        bool operator!=(const iterator& other) const { return _node != other._node; }
+    };
+    iterator begin() const { return iterator(_pool, _node ? _node->child : 0); }
+    iterator end() const { return iterator(_pool, 0); }
+};
+
+template <typename T>
+bool JsonVariant::add(const T& value) {
+    return arrayForAdd().add(value);
+}
+
+// ========================================
+// DOCUMENTS
+// ========================================
+class JsonDocument {
+protected:
+    JsonPool _pool;
+    JsonNode* _root;
+
+    JsonDocument(char* memory, size_t capacity);
+    JsonNode* rootAs(uint8_t type);
+
+private:
+    JsonDocument(const JsonDocument&);
+    JsonDocument& operator=(const JsonDocument&);
+
+public:
+    void clear();
+    size_t capacity() const { return _pool.capacity; }
+    size_t memoryUsage() const { return _pool.used; }
+    bool overflowed() const { return _pool.overflowed; }
+    JsonNode* root() const { return _root; }
+    JsonPool* pool() { return &_pool; }
+
+    JsonVariant operator[](const char* key);
+    JsonVariant operator[](const String& key);
+    JsonVariant operator[](size_t index);
+    JsonArray createNestedArray(const char* key);
+    JsonObject createNestedObject(const char* key);
+    JsonObject createNestedObject();
+    bool containsKey(const char* key) const;
+    size_t size() const;
+
+    template <typename T> bool add(const T& value) { return to<JsonArray>().add(value); }
+    template <typename T> T as() { return JsonVariant(&_pool, _root).as<T>(); }
+    template <typename T> bool is() { return JsonVariant(&_pool, _root).is<T>(); }
+    template <typename T> T to();
+};
+
+// Un nœud fait 48 octets ici contre 16 pour un slot ArduinoJson sur ESP32 :
+// la capacité est mise à l'échelle pour que les mêmes tailles de document
+// tiennent (ou débordent) comme sur la cible.
+#define HOST_JSON_CAPACITY_SCALE 4
+
+template <size_t CAPACITY>
+class StaticJsonDocument : public JsonDocument {
+private:
+    char _storage[CAPACITY * HOST_JSON_CAPACITY_SCALE];
+
+public:
+    StaticJsonDocument() : JsonDocument(_storage, sizeof(_storage)) {}
+};
+
+class DynamicJsonDocument : public JsonDocument {
+public:
+    explicit DynamicJsonDocument(size_t capacity);
+    ~DynamicJsonDocument();
+};
+
+// ========================================
+// SÉRIALISATION
+// ========================================
+size_t measureJson(const JsonDocument& doc);
+size_t measureJson(const JsonVariant& value);
+size_t serializeJson(const JsonDocument& doc, String& output);
+size_t serializeJson(const JsonDocument& doc, char* output, size_t size);
+size_t serializeJson(const JsonVariant& value, char* output, size_t size);
+size_t serializeJson(const JsonVariant& value, String& output);
+
+template <size_t N>
+size_t serializeJson(const JsonDocument& doc, char (&output)[N]) {
+    return serializeJson(doc, output, N);
+}
+
+class DeserializationError {
+public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+
+    DeserializationError(Code code = Ok) : _code(code) {}
+    Code code() const { return _code; }
+    const char* c_str() const;
+    explicit operator bool() const { return _code != Ok; }
+    bool operator==(Code code) const { return _code == code; }
+    bool operator!=(Code code) const { return _code != code; }
+
+private:
+    Code _code;
+};
+
+DeserializationError deserializeJson(JsonDocument& doc, const char* input);
+DeserializationError deserializeJson(JsonDocument& doc, const char* input, size_t length);
+DeserializationError deserializeJson(JsonDocument& doc, const String& input);
+
+// Spécialisations définies dans ArduinoJson.cpp
+#define HOST_JSON_SCALAR_TYPES(X) \
+    X(bool) X(int) X(unsigned int) X(long) X(unsigned long) X(long long) \
+    X(uint8_t) X(uint16_t) X(float) X(double) X(const char*) X(String) \
+    X(JsonObject) X(JsonArray)
+
+#define HOST_JSON_DECLARE(T) \
+    template <> T JsonVariant::as<T>() const; \
+    template <> bool JsonVariant::is<T>() const;
+HOST_JSON_SCALAR_TYPES(HOST_JSON_DECLARE)
+#undef HOST_JSON_DECLARE
+
+template <> JsonVariant JsonVariant::as<JsonVariant>() const;
+template <> JsonObject JsonVariant::to<JsonObject>();
+template <> JsonArray JsonVariant::to<JsonArray>();
+template <> JsonObject JsonDocument::to<JsonObject>();
+template <> JsonArray JsonDocument::to<JsonArray>();
+
+#endif
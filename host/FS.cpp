@@ -0,0 +1,215 @@
+#include "FS.h"
+#include "LittleFS.h"
+
+#include <atomic>
+#include <dirent.h>
+#include <errno.h>
+#include <ftw.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+fs::LittleFSFS LittleFS;
+
+static std::string root = "littlefs";
+static std::atomic<unsigned long> bytesWritten(0);
+
+void hal::setFsRoot(const char* path) { root = path; }
+const char* hal::fsRoot() { return root.c_str(); }
+unsigned long hal::fsBytesWritten() { return bytesWritten; }
+void hal::resetFsCounters() { bytesWritten = 0; }
+
+static std::string hostPath(const char* path) {
+    std::string full = root;
+    if (path[0] != '/') full += '/';
+    full += path;
+    return full;
+}
+
+// ========================================
+// POIGNÉE PARTAGÉE
+// ========================================
+struct fs::FileImpl {
+    FILE* fp;
+    DIR* dir;
+    std::string path;   // chemin firmware, "/hist/0001.log"
+    std::string name;   // dernier composant
+
+    FileImpl(const char* p) : fp(0), dir(0), path(p) {
+        size_t slash = path.rfind('/');
+        name = slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+    ~FileImpl() { close(); }
+
+    void close() {
+        if (fp) fclose(fp);
+        if (dir) closedir(dir);
+        fp = 0;
+        dir = 0;
+    }
+};
+
+using namespace fs;
+
+size_t File::write(const uint8_t* buf, size_t size) {
+    if (!_impl || !_impl->fp) return 0;
+    size_t written = fwrite(buf, 1, size, _impl->fp);
+    bytesWritten += written;
+    return written;
+}
+
+int File::available() {
+    if (!_impl || !_impl->fp) return 0;
+    return (int)(size() - position());
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+    if (!_impl || !_impl->fp) return 0;
+    return fread(buf, 1, size, _impl->fp);
+}
+
+void File::flush() {
+    if (_impl && _impl->fp) fflush(_impl->fp);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!_impl || !_impl->fp) return false;
+    int whence = mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END;
+    return fseek(_impl->fp, pos, whence) == 0;
+}
+
+size_t File::position() const {
+    if (!_impl || !_impl->fp) return 0;
+    long pos = ftell(_impl->fp);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+    if (!_impl || !_impl->fp) return 0;
+    fflush(_impl->fp);
+    struct stat st;
+    return fstat(fileno(_impl->fp), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close() {
+    if (_impl) _impl->close();
+    _impl.reset();
+}
+
+File::operator bool() const {
+    return _impl && (_impl->fp || _impl->dir);
+}
+
+const char* File::path() const { return _impl ? _impl->path.c_str() : NULL; }
+const char* File::name() const { return _impl ? _impl->name.c_str() : NULL; }
+
+bool File::isDirectory() const { return _impl && _impl->dir; }
+
+File File::openNextFile(const char* mode) {
+    if (!_impl || !_impl->dir) return File();
+    struct dirent* entry;
+    while ((entry = readdir(_impl->dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+        std::string child = _impl->path;
+        if (child.empty() || child[child.size() - 1] != '/') child += '/';
+        child += entry->d_name;
+        return LittleFS.open(child.c_str(), mode);
+    }
+    return File();
+}
+
+void File::rewindDirectory() {
+    if (_impl && _impl->dir) rewinddir(_impl->dir);
+}
+
+// ========================================
+// SYSTÈME DE FICHIERS
+// ========================================
+File FS::open(const char* path, const char* mode, bool create) {
+    std::string full = hostPath(path);
+    std::shared_ptr<FileImpl> impl(new FileImpl(path));
+
+    struct stat st;
+    if (stat(full.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        impl->dir = opendir(full.c_str());
+        return impl->dir ? File(impl) : File();
+    }
+
+    if (create && mode[0] != 'r') {
+        // Répertoires intermédiaires, comme open(path, mode, true) sur la cible
+        for (size_t i = root.size() + 1; i < full.size(); i++) {
+            if (full[i] == '/') ::mkdir(full.substr(0, i).c_str(), 0755);
+        }
+    }
+    const char* hostMode = mode[0] == 'w' ? "wb" : mode[0] == 'a' ? "ab" : "rb";
+    impl->fp = fopen(full.c_str(), hostMode);
+    return impl->fp ? File(impl) : File();
+}
+
+bool FS::exists(const char* path) {
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) {
+    return unlink(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char* pathFrom, const char* pathTo) {
+    return ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+    return ::mkdir(hostPath(path).c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+bool FS::rmdir(const char* path) {
+    return ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+// ========================================
+// PARTITION LITTLEFS
+// ========================================
+// Partition "spiffs" du schéma par défaut (default.csv)
+#define HOST_FS_PARTITION_SIZE 0x160000
+#define HOST_FS_BLOCK_SIZE 4096
+
+static size_t usedTotal;
+
+static int removeEntry(const char* path, const struct stat*, int, struct FTW* ftw) {
+    return ftw->level == 0 ? 0 : ::remove(path);
+}
+
+static int sumEntry(const char*, const struct stat* st, int type, struct FTW*) {
+    if (type == FTW_F) {
+        usedTotal += (st->st_size + HOST_FS_BLOCK_SIZE - 1) / HOST_FS_BLOCK_SIZE * HOST_FS_BLOCK_SIZE;
+    }
+    return 0;
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char*, uint8_t, const char*) {
+    (void)formatOnFail;
+    ::mkdir(root.c_str(), 0755);
+    struct stat st;
+    _mounted = stat(root.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+    return _mounted;
+}
+
+bool LittleFSFS::format() {
+    return nftw(root.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS) == 0;
+}
+
+size_t LittleFSFS::totalBytes() {
+    return HOST_FS_PARTITION_SIZE;
+}
+
+size_t LittleFSFS::usedBytes() {
+    usedTotal = 0;
+    nftw(root.c_str(), sumEntry, 16, FTW_PHYS);
+    return usedTotal;
+}
@@ -0,0 +1,86 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+// ========================================
+// STAND-IN FS ESP32 (fs::FS, fs::File)
+// ========================================
+// Fichiers ordinaires sous une racine hôte (hal::setFsRoot) : les chemins
+// du firmware ("/hist/0001.log") y sont résolus tels quels. Comme sur la
+// cible, File est une poignée partagée, copiable, fermée au dernier
+// exemplaire. Les octets écrits sont comptés pour les benchmarks d'usure.
+
+#include <Arduino.h>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+struct FileImpl;
+
+class File {
+public:
+    File() {}
+    explicit File(std::shared_ptr<FileImpl> impl) : _impl(impl) {}
+
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t size);
+    int available();
+    int read();
+    size_t read(uint8_t* buf, size_t size);
+    void flush();
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    operator bool() const;
+    const char* path() const;
+    const char* name() const;
+
+    bool isDirectory() const;
+    File openNextFile(const char* mode = FILE_READ);
+    void rewindDirectory();
+
+private:
+    std::shared_ptr<FileImpl> _impl;
+};
+
+class FS {
+public:
+    File open(const char* path, const char* mode = FILE_READ, bool create = false);
+    File open(const String& path, const char* mode = FILE_READ, bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+    bool exists(const char* path);
+    bool remove(const char* path);
+    bool rename(const char* pathFrom, const char* pathTo);
+    bool mkdir(const char* path);
+    bool rmdir(const char* path);
+};
+
+}
+
+using fs::FS;
+using fs::File;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+namespace hal {
+    // Répertoire hôte qui tient lieu de partition (créé au besoin)
+    void setFsRoot(const char* path);
+    const char* fsRoot();
+
+    // Octets passés à File::write() depuis le dernier reset
+    unsigned long fsBytesWritten();
+    void resetFsCounters();
+}
+
+#endif
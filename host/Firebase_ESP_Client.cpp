@@ -0,0 +1,116 @@
+#include "Firebase_ESP_Client.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+FirebaseClass Firebase;
+
+void FirebaseData::setResult(int code, const char* error) {
+    _httpCode = code;
+    snprintf(_error, sizeof(_error), "%s", error ? error : "");
+}
+
+void FirebaseClass::setEndpoint(const char* host, uint16_t port) {
+    snprintf(_host, sizeof(_host), "%s", host);
+    _port = port;
+}
+
+// ========================================
+// REQUÊTE HTTP
+// ========================================
+static bool httpRequest(FirebaseData* fbdo, const char* method, const char* path,
+                        const char* query, const char* body) {
+    if (!Firebase.port()) {
+        fbdo->setResult(-1, "endpoint non configure");
+        return false;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        fbdo->setResult(-1, "socket");
+        return false;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(Firebase.port());
+    inet_pton(AF_INET, Firebase.host(), &addr.sin_addr);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        fbdo->setResult(-1, "connection refused");
+        return false;
+    }
+
+    // "/" -> "/.json", "/sensors/temperature" -> "/sensors/temperature.json"
+    size_t bodyLen = strlen(body);
+    char head[384];
+    int headLen = snprintf(head, sizeof(head),
+                           "%s %s.json%s HTTP/1.1\r\nHost: %s\r\n"
+                           "Content-Type: application/json\r\nContent-Length: %zu\r\n"
+                           "Connection: close\r\n\r\n",
+                           method, path, query, Firebase.host(), bodyLen);
+
+    bool ok = send(fd, head, headLen, MSG_NOSIGNAL) == headLen &&
+              send(fd, body, bodyLen, MSG_NOSIGNAL) == (ssize_t)bodyLen;
+
+    char status[64];
+    ssize_t n = ok ? recv(fd, status, sizeof(status) - 1, 0) : -1;
+    close(fd);
+
+    int code = 0;
+    if (n > 0) {
+        status[n] = '\0';
+        sscanf(status, "HTTP/1.%*d %d", &code);
+    }
+    if (code >= 200 && code < 300) {
+        fbdo->setResult(code, "");
+        return true;
+    }
+    fbdo->setResult(code ? code : -1, code ? "bad request" : "connection lost");
+    return false;
+}
+
+// ========================================
+// RTDB
+// ========================================
+bool FirebaseRTDB::setFloat(FirebaseData* fbdo, const char* path, float value) {
+    char body[32];
+    snprintf(body, sizeof(body), "%.7g", value);
+    return httpRequest(fbdo, "PUT", path, "", body);
+}
+
+bool FirebaseRTDB::setInt(FirebaseData* fbdo, const char* path, int value) {
+    char body[16];
+    snprintf(body, sizeof(body), "%d", value);
+    return httpRequest(fbdo, "PUT", path, "", body);
+}
+
+bool FirebaseRTDB::setBool(FirebaseData* fbdo, const char* path, bool value) {
+    return httpRequest(fbdo, "PUT", path, "", value ? "true" : "false");
+}
+
+bool FirebaseRTDB::setString(FirebaseData* fbdo, const char* path, const String& value) {
+    char body[128];
+    snprintf(body, sizeof(body), "\"%s\"", value.c_str());
+    return httpRequest(fbdo, "PUT", path, "", body);
+}
+
+bool FirebaseRTDB::setTimestamp(FirebaseData* fbdo, const char* path) {
+    return httpRequest(fbdo, "PUT", path, "", "{\".sv\":\"timestamp\"}");
+}
+
+bool FirebaseRTDB::updateNode(FirebaseData* fbdo, const char* path, FirebaseJson* json) {
+    return httpRequest(fbdo, "PATCH", path, "", json->raw());
+}
+
+bool FirebaseRTDB::updateNodeSilent(FirebaseData* fbdo, const char* path, FirebaseJson* json) {
+    return httpRequest(fbdo, "PATCH", path, "?print=silent", json->raw());
+}
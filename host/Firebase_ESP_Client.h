@@ -0,0 +1,88 @@
+#ifndef HOST_FIREBASE_ESP_CLIENT_H
+#define HOST_FIREBASE_ESP_CLIENT_H
+
+// ========================================
+// STAND-IN Firebase_ESP_Client
+// ========================================
+// Les appels RTDB utilisés par le firmware deviennent de vraies requêtes
+// HTTP/1.1 (PUT pour set*, PATCH pour updateNode) vers un point d'accès
+// local, par exemple RtdbServer. Un aller-retour par appel, connexion
+// fermée à chaque fois : le coût d'un appel bloquant reste visible.
+
+#include <Arduino.h>
+#include <atomic>
+
+class FirebaseJson {
+public:
+    bool setJsonData(const String& data) { _raw = data; return true; }
+    bool setJsonData(const char* data) { _raw = data; return true; }
+    const char* raw() const { return _raw.c_str(); }
+
+private:
+    String _raw;
+};
+
+class FirebaseData {
+public:
+    FirebaseData() : _httpCode(0) {}
+
+    int httpCode() const { return _httpCode; }
+    String errorReason() const { return String(_error); }
+
+    void setResult(int code, const char* error);
+
+private:
+    int _httpCode;
+    char _error[64];
+};
+
+class FirebaseRTDB {
+public:
+    bool setFloat(FirebaseData* fbdo, const char* path, float value);
+    bool setInt(FirebaseData* fbdo, const char* path, int value);
+    bool setBool(FirebaseData* fbdo, const char* path, bool value);
+    bool setString(FirebaseData* fbdo, const char* path, const String& value);
+    bool setTimestamp(FirebaseData* fbdo, const char* path);
+    bool updateNode(FirebaseData* fbdo, const char* path, FirebaseJson* json);
+    bool updateNodeSilent(FirebaseData* fbdo, const char* path, FirebaseJson* json);
+};
+
+struct TokenInfo {
+    int status;
+};
+
+struct FirebaseAuth {
+    struct { String email; String password; } user;
+};
+
+struct FirebaseConfig {
+    String api_key;
+    String database_url;
+    void (*token_status_callback)(TokenInfo);
+};
+
+class FirebaseClass {
+public:
+    FirebaseClass() : _port(0), _ready(true) {}
+
+    FirebaseRTDB RTDB;
+
+    void begin(FirebaseConfig*, FirebaseAuth*) {}
+    void reconnectWiFi(bool) {}
+    bool ready() const { return _ready; }
+
+    // SIMULATION (host uniquement)
+    void setEndpoint(const char* host, uint16_t port);
+    void setReady(bool ready) { _ready = ready; }
+    const char* host() const { return _host; }
+    uint16_t port() const { return _port; }
+
+private:
+    char _host[64];
+    uint16_t _port;
+    std::atomic<bool> _ready;   // basculé par les tests pendant la tâche d'envoi
+};
+
+extern FirebaseClass Firebase;
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+// ========================================
+// STAND-IN LittleFS ESP32
+// ========================================
+// Partition simulée par le répertoire hal::fsRoot() ; totalBytes() est la
+// taille de la partition "spiffs" du schéma par défaut.
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+    LittleFSFS() : _mounted(false) {}
+
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    bool format();
+    size_t totalBytes();
+    size_t usedBytes();
+    void end() { _mounted = false; }
+
+private:
+    bool _mounted;
+};
+
+}
+
+extern fs::LittleFSFS LittleFS;
+
+#endif
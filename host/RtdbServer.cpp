@@ -0,0 +1,115 @@
+#include "RtdbServer.h"
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+RtdbServer::RtdbServer()
+    : _listenFd(-1), _port(0), _running(false), _latencyMs(0), _requests(0), _bytes(0) {}
+
+RtdbServer::~RtdbServer() {
+    stop();
+}
+
+uint16_t RtdbServer::start(unsigned long latencyMs) {
+    _latencyMs = latencyMs;
+    _listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (_listenFd < 0) return 0;
+
+    int one = 1;
+    setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (bind(_listenFd, (sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(_listenFd, 16) != 0 ||
+        getsockname(_listenFd, (sockaddr*)&addr, &len) != 0) {
+        close(_listenFd);
+        _listenFd = -1;
+        return 0;
+    }
+
+    _port = ntohs(addr.sin_port);
+    _running = true;
+    _thread = std::thread([this]() { run(); });
+    return _port;
+}
+
+void RtdbServer::stop() {
+    if (!_running) return;
+    _running = false;
+    if (_thread.joinable()) _thread.join();
+    close(_listenFd);
+    _listenFd = -1;
+}
+
+std::string RtdbServer::lastRequest() {
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _last;
+}
+
+void RtdbServer::run() {
+    while (_running) {
+        pollfd pfd = { _listenFd, POLLIN, 0 };
+        if (poll(&pfd, 1, 50) <= 0) continue;
+        int fd = accept(_listenFd, 0, 0);
+        if (fd < 0) continue;
+        serve(fd);
+        close(fd);
+    }
+}
+
+// Lit en-têtes + corps (Content-Length), attend la latence, répond
+void RtdbServer::serve(int fd) {
+    std::string request;
+    char chunk[1024];
+    size_t headerEnd = std::string::npos;
+    size_t contentLength = 0;
+
+    while (true) {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return;
+        request.append(chunk, n);
+
+        if (headerEnd == std::string::npos) {
+            headerEnd = request.find("\r\n\r\n");
+            if (headerEnd == std::string::npos) continue;
+            const char* cl = strcasestr(request.c_str(), "Content-Length:");
+            if (cl && cl < request.c_str() + headerEnd) contentLength = strtoul(cl + 15, 0, 10);
+        }
+        if (request.size() >= headerEnd + 4 + contentLength) break;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(_latencyMs.load()));
+
+    bool silent = request.find("print=silent") < headerEnd;
+    bool known = request.compare(0, 4, "PUT ") == 0 || request.compare(0, 6, "PATCH ") == 0;
+
+    const char* response;
+    if (!known) {
+        response = "HTTP/1.1 405 Method Not Allowed\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    } else if (silent) {
+        response = "HTTP/1.1 204 No Content\r\nConnection: close\r\n\r\n";
+    } else {
+        response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                   "Content-Length: 2\r\nConnection: close\r\n\r\n{}";
+    }
+    // Compteurs à jour avant la réponse : le client peut les lire dès son retour
+    _requests++;
+    _bytes += request.size();
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _last = request;
+    }
+    send(fd, response, strlen(response), MSG_NOSIGNAL);
+}
@@ -0,0 +1,46 @@
+#ifndef HOST_RTDB_SERVER_H
+#define HOST_RTDB_SERVER_H
+
+// ========================================
+// POINT D'ACCÈS RTDB LOCAL
+// ========================================
+// Serveur HTTP minimal sur 127.0.0.1 qui accepte PUT/PATCH *.json comme la
+// Realtime Database. Une latence configurable simule un lien lent ; les
+// requêtes sont servies une par une, comme par une seule connexion.
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+
+class RtdbServer {
+public:
+    RtdbServer();
+    ~RtdbServer();
+
+    // Retourne le port choisi (0 = échec)
+    uint16_t start(unsigned long latencyMs);
+    void stop();
+
+    void setLatency(unsigned long latencyMs) { _latencyMs = latencyMs; }
+    unsigned long requests() const { return _requests; }
+    unsigned long bytes() const { return _bytes; }
+    std::string lastRequest();
+
+private:
+    int _listenFd;
+    uint16_t _port;
+    std::atomic<bool> _running;
+    std::atomic<unsigned long> _latencyMs;
+    std::atomic<unsigned long> _requests;
+    std::atomic<unsigned long> _bytes;
+    std::mutex _mutex;
+    std::string _last;
+    std::thread _thread;
+
+    void run();
+    void serve(int fd);
+};
+
+#endif
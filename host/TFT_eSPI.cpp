@@ -0,0 +1,250 @@
+#include "TFT_eSPI.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <chrono>
+
+// Horloge SPI de la cible : 40 MHz, 16 bits par pixel
+#define HOST_SPI_HZ 40000000UL
+
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
+    : _width(w), _height(h), _frame(0), _pixels(0), _dmaPixels(0), _commands(0), _dmaUntil(0), _spiHz(HOST_SPI_HZ),
+      _cursorX(0), _cursorY(0), _textSize(1), _textColor(TFT_WHITE), _textBg(TFT_BLACK),
+      _textOpaque(false), _nativeWidth(w), _nativeHeight(h) {
+    _frame = w && h ? new uint16_t[(size_t)w * h]() : 0;
+}
+
+TFT_eSPI::~TFT_eSPI() {
+    delete[] _frame;
+}
+
+void TFT_eSPI::init() {
+    _commands++;
+}
+
+void TFT_eSPI::setRotation(uint8_t rotation) {
+    // Paysage pour 1 et 3 : l'image mémoire garde la même taille
+    bool landscape = rotation & 1;
+    _width = landscape ? _nativeHeight : _nativeWidth;
+    _height = landscape ? _nativeWidth : _nativeHeight;
+    _commands++;
+}
+
+uint16_t TFT_eSPI::pixelAt(int32_t x, int32_t y) const {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+    return _frame[y * _width + x];
+}
+
+// ========================================
+// PRIMITIVES
+// ========================================
+void TFT_eSPI::plot(int32_t x, int32_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    _frame[y * _width + x] = color;
+    _pixels++;
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+    _commands++;
+    plot(x, y, (uint16_t)color);
+}
+
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+    _commands++;
+    int32_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int32_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx + dy;
+    while (true) {
+        plot(x0, y0, (uint16_t)color);
+        if (x0 == x1 && y0 == y1) break;
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+    fillRect(x, y, w, 1, color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+    fillRect(x, y, 1, h, color);
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y + 1, h - 2, color);
+    drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    _commands++;
+    for (int32_t j = y; j < y + h; j++) {
+        for (int32_t i = x; i < x + w; i++) plot(i, j, (uint16_t)color);
+    }
+}
+
+void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+    _commands++;
+    for (int32_t dy = -r; dy <= r; dy++) {
+        for (int32_t dx = -r; dx <= r; dx++) {
+            if (dx * dx + dy * dy <= r * r) plot(x0 + dx, y0 + dy, (uint16_t)color);
+        }
+    }
+}
+
+// ========================================
+// TEXTE
+// ========================================
+void TFT_eSPI::setTextColor(uint16_t color) {
+    _textColor = color;
+    _textOpaque = false;
+}
+
+void TFT_eSPI::setTextColor(uint16_t fg, uint16_t bg) {
+    _textColor = fg;
+    _textBg = bg;
+    _textOpaque = true;
+}
+
+void TFT_eSPI::setTextSize(uint8_t size) {
+    _textSize = size ? size : 1;
+}
+
+void TFT_eSPI::setCursor(int16_t x, int16_t y) {
+    _cursorX = x;
+    _cursorY = y;
+}
+
+int16_t TFT_eSPI::textWidth(const char* text) const {
+    return (int16_t)(strlen(text) * 6 * _textSize);
+}
+
+// Cellule 6x8 : motif 5x7 pseudo-aléatoire mais stable pour chaque caractère
+void TFT_eSPI::drawChar(char c) {
+    if (c == '\n') {
+        _cursorX = 0;
+        _cursorY += 8 * _textSize;
+        return;
+    }
+    _commands++;
+    uint32_t pattern = (uint32_t)(unsigned char)c * 2654435761u;
+    for (int cy = 0; cy < 8; cy++) {
+        for (int cx = 0; cx < 6; cx++) {
+            bool on = c != ' ' && cx < 5 && cy < 7 && ((pattern >> ((cx * 7 + cy) % 32)) & 1);
+            if (!on && !_textOpaque) continue;
+            uint16_t color = on ? _textColor : _textBg;
+            for (int sy = 0; sy < _textSize; sy++) {
+                for (int sx = 0; sx < _textSize; sx++) {
+                    plot(_cursorX + cx * _textSize + sx, _cursorY + cy * _textSize + sy, color);
+                }
+            }
+        }
+    }
+    _cursorX += 6 * _textSize;
+}
+
+size_t TFT_eSPI::print(const char* s) {
+    size_t n = 0;
+    while (s && *s) { drawChar(*s++); n++; }
+    return n;
+}
+
+size_t TFT_eSPI::print(char c) { drawChar(c); return 1; }
+size_t TFT_eSPI::print(int n) { char t[16]; snprintf(t, sizeof(t), "%d", n); return print(t); }
+size_t TFT_eSPI::print(unsigned int n) { char t[16]; snprintf(t, sizeof(t), "%u", n); return print(t); }
+size_t TFT_eSPI::print(long n) { char t[24]; snprintf(t, sizeof(t), "%ld", n); return print(t); }
+
+size_t TFT_eSPI::print(double n, int digits) {
+    char t[32];
+    snprintf(t, sizeof(t), "%.*f", digits, n);
+    return print(t);
+}
+
+size_t TFT_eSPI::println() { drawChar('\n'); return 1; }
+size_t TFT_eSPI::println(const char* s) { size_t n = print(s); drawChar('\n'); return n + 1; }
+
+// ========================================
+// IMAGES / DMA
+// ========================================
+bool TFT_eSPI::initDMA() {
+    return true;
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+    _commands++;
+    for (int32_t j = 0; j < h; j++) {
+        for (int32_t i = 0; i < w; i++) plot(x + i, y + j, data[j * w + i]);
+    }
+}
+
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+    dmaWait();
+    unsigned long before = _pixels;
+    pushImage(x, y, w, h, data);
+    unsigned long pushed = _pixels - before;
+    _pixels = before;
+    _dmaPixels += pushed;
+    if (_spiHz) _dmaUntil = micros() + (unsigned long)((unsigned long long)pushed * 16 * 1000000 / _spiHz);
+}
+
+bool TFT_eSPI::dmaBusy() const {
+    return (long)(_dmaUntil - micros()) > 0;
+}
+
+void TFT_eSPI::dmaWait() const {
+    while (dmaBusy()) std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
+
+// ========================================
+// SPRITE
+// ========================================
+TFT_eSprite::TFT_eSprite(TFT_eSPI* tft)
+    : TFT_eSPI(0, 0), _tft(tft), _depth(16), _created(false), _line(0) {}
+
+void* TFT_eSprite::createSprite(int16_t w, int16_t h) {
+    deleteSprite();
+    _frame = new uint16_t[(size_t)w * h]();
+    _line = new uint16_t[w];
+    _width = _nativeWidth = w;
+    _height = _nativeHeight = h;
+    _created = true;
+    return _frame;
+}
+
+void TFT_eSprite::deleteSprite() {
+    delete[] _frame;
+    delete[] _line;
+    _frame = 0;
+    _line = 0;
+    _width = _height = 0;
+    _created = false;
+}
+
+static uint16_t rgb332(uint16_t color) {
+    // 565 -> 332 -> 565, comme l'aller-retour d'un sprite 8 bits
+    uint8_t c = (uint8_t)(((color & 0xE000) >> 8) | ((color & 0x0700) >> 6) | ((color & 0x0018) >> 3));
+    uint16_t r = (c & 0xE0) >> 5, g = (c & 0x1C) >> 2, b = c & 0x03;
+    return (uint16_t)(((r * 31 / 7) << 11) | ((g * 63 / 7) << 5) | (b * 31 / 3));
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+    pushSprite(x, y, 0, 0, _width, _height);
+}
+
+bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh) {
+    if (!_created) return false;
+    // Conversion ligne par ligne, envoi bloquant
+    for (int32_t j = 0; j < sh; j++) {
+        const uint16_t* src = _frame + (sy + j) * _width + sx;
+        for (int32_t i = 0; i < sw; i++) _line[i] = _depth == 8 ? rgb332(src[i]) : src[i];
+        _tft->pushImage(tx, ty + j, sw, 1, _line);
+    }
+    return true;
+}
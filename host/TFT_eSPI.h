@@ -0,0 +1,147 @@
+#ifndef HOST_TFT_ESPI_H
+#define HOST_TFT_ESPI_H
+
+// ========================================
+// STAND-IN TFT_eSPI (TTGO T-Display 135x240)
+// ========================================
+// Dessine dans une image mémoire et compte les pixels envoyés au contrôleur,
+// ce qui représente le trafic SPI. La police est factice (motif 5x7 dérivé
+// du code du caractère) : même texte = mêmes pixels, ce qui suffit pour
+// comparer deux rendus.
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#define TFT_WIDTH  135
+#define TFT_HEIGHT 240
+
+#define TFT_BLACK   0x0000
+#define TFT_NAVY    0x000F
+#define TFT_BLUE    0x001F
+#define TFT_GREEN   0x07E0
+#define TFT_CYAN    0x07FF
+#define TFT_RED     0xF800
+#define TFT_MAGENTA 0xF81F
+#define TFT_YELLOW  0xFFE0
+#define TFT_WHITE   0xFFFF
+#define TFT_ORANGE  0xFDA0
+
+class TFT_eSPI {
+public:
+    TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+    virtual ~TFT_eSPI();
+
+    void init();
+    void begin() { init(); }
+    void setRotation(uint8_t rotation);
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    void fillScreen(uint32_t color);
+    void drawPixel(int32_t x, int32_t y, uint32_t color);
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+
+    void setTextColor(uint16_t color);
+    void setTextColor(uint16_t fg, uint16_t bg);
+    void setTextSize(uint8_t size);
+    void setCursor(int16_t x, int16_t y);
+    int16_t getCursorX() const { return _cursorX; }
+    int16_t getCursorY() const { return _cursorY; }
+    int16_t textWidth(const char* text) const;
+    int16_t fontHeight() const { return 8 * _textSize; }
+
+    size_t print(const char* s);
+    size_t print(const String& s) { return print(s.c_str()); }
+    size_t print(char c);
+    size_t print(int n);
+    size_t print(unsigned int n);
+    size_t print(long n);
+    size_t print(double n, int digits = 2);
+    size_t println();
+    size_t println(const char* s);
+    size_t println(const String& s) { return println(s.c_str()); }
+
+    // DMA : copie immédiate, mais le bus reste occupé le temps du transfert
+    bool initDMA();
+    void startWrite() {}
+    void endWrite() {}
+    void setSwapBytes(bool swap) { (void)swap; }
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+    bool dmaBusy() const;
+    void dmaWait() const;
+
+    // ========================================
+    // SIMULATION (host uniquement)
+    // ========================================
+    // pixelsPushed() : pixels envoyés en bloquant le CPU ; dmaPixelsPushed() : par DMA
+    unsigned long pixelsPushed() const { return _pixels; }
+    unsigned long dmaPixelsPushed() const { return _dmaPixels; }
+    unsigned long commands() const { return _commands; }
+    void resetCounters() { _pixels = 0; _dmaPixels = 0; _commands = 0; }
+    // Durée simulée des transferts DMA ; 0 = instantanés (tests)
+    void setSpiFrequency(unsigned long hz) { _spiHz = hz; }
+    uint16_t pixelAt(int32_t x, int32_t y) const;
+    const uint16_t* frame() const { return _frame; }
+
+protected:
+    int16_t _width;
+    int16_t _height;
+    uint16_t* _frame;
+    unsigned long _pixels;
+    unsigned long _dmaPixels;
+    unsigned long _commands;
+    unsigned long _dmaUntil;   // micros() de fin du transfert DMA en cours
+    unsigned long _spiHz;
+
+    int16_t _cursorX;
+    int16_t _cursorY;
+    uint8_t _textSize;
+    uint16_t _textColor;
+    uint16_t _textBg;
+    bool _textOpaque;
+
+    int16_t _nativeWidth;
+    int16_t _nativeHeight;
+
+    void plot(int32_t x, int32_t y, uint16_t color);
+    void drawChar(char c);
+
+private:
+    TFT_eSPI(const TFT_eSPI&);
+    TFT_eSPI& operator=(const TFT_eSPI&);
+};
+
+// ========================================
+// SPRITE (image hors écran)
+// ========================================
+// Mêmes primitives que TFT_eSPI mais en RAM. En 8 bits, les couleurs sont
+// ramenées en RGB332 comme sur la cible.
+class TFT_eSprite : public TFT_eSPI {
+public:
+    explicit TFT_eSprite(TFT_eSPI* tft);
+
+    void setColorDepth(int8_t bits) { _depth = bits == 8 ? 8 : 16; }
+    int8_t getColorDepth() const { return _depth; }
+    void* createSprite(int16_t w, int16_t h);
+    void deleteSprite();
+    bool created() const { return _created; }
+    void* getPointer() { return _created ? _frame : 0; }
+    size_t bufferSize() const { return _created ? (size_t)_width * _height * (_depth / 8) : 0; }
+
+    void pushSprite(int32_t x, int32_t y);
+    bool pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
+
+private:
+    TFT_eSPI* _tft;
+    int8_t _depth;
+    bool _created;
+    uint16_t* _line;
+};
+
+#endif
@@ -0,0 +1,271 @@
+#include "WString.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ========================================
+// CONSTRUCTION
+// ========================================
+String::String() : _buffer(0), _len(0), _capacity(0) {}
+
+String::String(const char* s) : _buffer(0), _len(0), _capacity(0) {
+    if (s) assign(s, strlen(s));
+}
+
+String::String(const char* s, size_t len) : _buffer(0), _len(0), _capacity(0) {
+    assign(s, len);
+}
+
+String::String(const String& other) : _buffer(0), _len(0), _capacity(0) {
+    assign(other._buffer, other._len);
+}
+
+String::String(String&& other) : _buffer(other._buffer), _len(other._len), _capacity(other._capacity) {
+    other._buffer = 0;
+    other._len = 0;
+    other._capacity = 0;
+}
+
+String::String(char c) : _buffer(0), _len(0), _capacity(0) {
+    assign(&c, 1);
+}
+
+static void formatInteger(char* out, size_t size, unsigned long value, bool negative, unsigned char base) {
+    char tmp[70];
+    size_t n = 0;
+    if (base < 2 || base > 36) base = 10;
+    do {
+        unsigned long digit = value % base;
+        tmp[n++] = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    } while (value && n < sizeof(tmp));
+
+    size_t pos = 0;
+    if (negative && pos < size - 1) out[pos++] = '-';
+    while (n && pos < size - 1) out[pos++] = tmp[--n];
+    out[pos] = '\0';
+}
+
+String::String(int value, unsigned char base) : String((long)value, base) {}
+
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) : _buffer(0), _len(0), _capacity(0) {
+    char tmp[72];
+    bool negative = value < 0 && base == 10;
+    unsigned long magnitude = negative ? 0UL - (unsigned long)value : (unsigned long)value;
+    formatInteger(tmp, sizeof(tmp), magnitude, negative, base);
+    assign(tmp, strlen(tmp));
+}
+
+String::String(unsigned long value, unsigned char base) : _buffer(0), _len(0), _capacity(0) {
+    char tmp[72];
+    formatInteger(tmp, sizeof(tmp), value, false, base);
+    assign(tmp, strlen(tmp));
+}
+
+String::String(float value, unsigned int decimals) : String((double)value, decimals) {}
+
+String::String(double value, unsigned int decimals) : _buffer(0), _len(0), _capacity(0) {
+    char tmp[64];
+    snprintf(tmp, sizeof(tmp), "%.*f", (int)decimals, value);
+    assign(tmp, strlen(tmp));
+}
+
+String::~String() {
+    delete[] _buffer;
+}
+
+// ========================================
+// AFFECTATION
+// ========================================
+bool String::grow(size_t capacity) {
+    if (_buffer && capacity <= _capacity) return true;
+    char* next = new char[capacity + 1];
+    if (_buffer) {
+        memcpy(next, _buffer, _len + 1);
+        delete[] _buffer;
+    } else {
+        next[0] = '\0';
+    }
+    _buffer = next;
+    _capacity = capacity;
+    return true;
+}
+
+void String::assign(const char* data, size_t len) {
+    if (!data || len == 0) {
+        _len = 0;
+        if (_buffer) _buffer[0] = '\0';
+        return;
+    }
+    grow(len);
+    memmove(_buffer, data, len);
+    _buffer[len] = '\0';
+    _len = len;
+}
+
+String& String::operator=(const String& other) {
+    if (this != &other) assign(other._buffer, other._len);
+    return *this;
+}
+
+String& String::operator=(String&& other) {
+    if (this != &other) {
+        delete[] _buffer;
+        _buffer = other._buffer;
+        _len = other._len;
+        _capacity = other._capacity;
+        other._buffer = 0;
+        other._len = 0;
+        other._capacity = 0;
+    }
+    return *this;
+}
+
+String& String::operator=(const char* s) {
+    assign(s, s ? strlen(s) : 0);
+    return *this;
+}
+
+bool String::reserve(size_t size) {
+    return grow(size);
+}
+
+// ========================================
+// CONCATÉNATION
+// ========================================
+bool String::concat(const char* s, size_t len) {
+    if (!s || len == 0) return true;
+    size_t needed = _len + len;
+    if (!_buffer || needed > _capacity) {
+        size_t capacity = _capacity ? _capacity : 8;
+        while (capacity < needed) capacity *= 2;
+        grow(capacity);
+    }
+    memcpy(_buffer + _len, s, len);
+    _len = needed;
+    _buffer[_len] = '\0';
+    return true;
+}
+
+bool String::concat(const char* s) { return concat(s, s ? strlen(s) : 0); }
+bool String::concat(const String& s) { return concat(s._buffer, s._len); }
+bool String::concat(char c) { return concat(&c, 1); }
+
+bool String::concat(int n) { char t[16]; snprintf(t, sizeof(t), "%d", n); return concat(t); }
+bool String::concat(unsigned int n) { char t[16]; snprintf(t, sizeof(t), "%u", n); return concat(t); }
+bool String::concat(long n) { char t[24]; snprintf(t, sizeof(t), "%ld", n); return concat(t); }
+bool String::concat(unsigned long n) { char t[24]; snprintf(t, sizeof(t), "%lu", n); return concat(t); }
+bool String::concat(double n) { char t[32]; snprintf(t, sizeof(t), "%.2f", n); return concat(t); }
+
+String operator+(const String& a, const String& b) { String r(a); r.concat(b); return r; }
+String operator+(const String& a, const char* b) { String r(a); r.concat(b); return r; }
+String operator+(const char* a, const String& b) { String r(a); r.concat(b); return r; }
+
+// ========================================
+// COMPARAISON / RECHERCHE
+// ========================================
+bool String::equals(const char* s) const {
+    return strcmp(c_str(), s ? s : "") == 0;
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+    if (_len != s._len) return false;
+    for (size_t i = 0; i < _len; i++) {
+        if (tolower((unsigned char)_buffer[i]) != tolower((unsigned char)s._buffer[i])) return false;
+    }
+    return true;
+}
+
+bool String::operator<(const String& s) const {
+    return strcmp(c_str(), s.c_str()) < 0;
+}
+
+int String::indexOf(char c, size_t from) const {
+    for (size_t i = from; i < _len; i++) {
+        if (_buffer[i] == c) return (int)i;
+    }
+    return -1;
+}
+
+int String::indexOf(const char* s, size_t from) const {
+    if (from >= _len) return -1;
+    const char* found = strstr(_buffer + from, s);
+    return found ? (int)(found - _buffer) : -1;
+}
+
+bool String::startsWith(const char* prefix) const {
+    size_t n = strlen(prefix);
+    return n <= _len && strncmp(c_str(), prefix, n) == 0;
+}
+
+bool String::endsWith(const char* suffix) const {
+    size_t n = strlen(suffix);
+    return n <= _len && strcmp(c_str() + _len - n, suffix) == 0;
+}
+
+String String::substring(size_t from) const {
+    return substring(from, _len);
+}
+
+String String::substring(size_t from, size_t to) const {
+    if (from > to) { size_t t = from; from = to; to = t; }
+    if (from >= _len) return String();
+    if (to > _len) to = _len;
+    return String(_buffer + from, to - from);
+}
+
+// ========================================
+// MODIFICATION / CONVERSION
+// ========================================
+void String::toUpperCase() {
+    for (size_t i = 0; i < _len; i++) _buffer[i] = (char)toupper((unsigned char)_buffer[i]);
+}
+
+void String::toLowerCase() {
+    for (size_t i = 0; i < _len; i++) _buffer[i] = (char)tolower((unsigned char)_buffer[i]);
+}
+
+void String::trim() {
+    if (!_len) return;
+    size_t begin = 0;
+    while (begin < _len && isspace((unsigned char)_buffer[begin])) begin++;
+    size_t end = _len;
+    while (end > begin && isspace((unsigned char)_buffer[end - 1])) end--;
+    memmove(_buffer, _buffer + begin, end - begin);
+    _len = end - begin;
+    _buffer[_len] = '\0';
+}
+
+void String::remove(size_t index, size_t count) {
+    if (index >= _len) return;
+    if (count > _len - index) count = _len - index;
+    memmove(_buffer + index, _buffer + index + count, _len - index - count + 1);
+    _len -= count;
+}
+
+void String::replace(const char* find, const char* with) {
+    size_t findLen = strlen(find);
+    if (!findLen || !_len) return;
+    String result;
+    size_t pos = 0;
+    int hit;
+    while ((hit = indexOf(find, pos)) >= 0) {
+        result.concat(_buffer + pos, (size_t)hit - pos);
+        result.concat(with);
+        pos = (size_t)hit + findLen;
+    }
+    result.concat(_buffer + pos, _len - pos);
+    *this = static_cast<String&&>(result);
+}
+
+long String::toInt() const {
+    return _buffer ? atol(_buffer) : 0;
+}
+
+float String::toFloat() const {
+    return _buffer ? (float)atof(_buffer) : 0;
+}
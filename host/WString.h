@@ -0,0 +1,93 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+// ========================================
+// STAND-IN String ARDUINO
+// ========================================
+// Tampon sur le tas comme sur la cible : chaque construction non vide
+// alloue, ce qui permet aux benchmarks de compter les allocations.
+
+#include <stddef.h>
+
+class String {
+private:
+    char* _buffer;
+    size_t _len;
+    size_t _capacity;
+
+    bool grow(size_t capacity);
+    void assign(const char* data, size_t len);
+
+public:
+    String();
+    String(const char* s);
+    String(const char* s, size_t len);
+    String(const String& other);
+    String(String&& other);
+    explicit String(char c);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimals = 2);
+    explicit String(double value, unsigned int decimals = 2);
+    ~String();
+
+    String& operator=(const String& other);
+    String& operator=(String&& other);
+    String& operator=(const char* s);
+
+    bool reserve(size_t size);
+    size_t length() const { return _len; }
+    bool isEmpty() const { return _len == 0; }
+    const char* c_str() const { return _buffer ? _buffer : ""; }
+
+    bool concat(const char* s, size_t len);
+    bool concat(const char* s);
+    bool concat(const String& s);
+    bool concat(char c);
+    bool concat(int n);
+    bool concat(unsigned int n);
+    bool concat(long n);
+    bool concat(unsigned long n);
+    bool concat(double n);
+
+    template <typename T>
+    String& operator+=(const T& value) { concat(value); return *this; }
+
+    bool equals(const char* s) const;
+    bool equals(const String& s) const { return equals(s.c_str()); }
+    bool equalsIgnoreCase(const String& s) const;
+    bool operator==(const char* s) const { return equals(s); }
+    bool operator==(const String& s) const { return equals(s); }
+    bool operator!=(const char* s) const { return !equals(s); }
+    bool operator!=(const String& s) const { return !equals(s); }
+    bool operator<(const String& s) const;
+
+    char operator[](size_t index) const { return index < _len ? _buffer[index] : 0; }
+    char charAt(size_t index) const { return (*this)[index]; }
+
+    int indexOf(char c, size_t from = 0) const;
+    int indexOf(const char* s, size_t from = 0) const;
+    int indexOf(const String& s, size_t from = 0) const { return indexOf(s.c_str(), from); }
+    bool startsWith(const char* prefix) const;
+    bool startsWith(const String& prefix) const { return startsWith(prefix.c_str()); }
+    bool endsWith(const char* suffix) const;
+    String substring(size_t from) const;
+    String substring(size_t from, size_t to) const;
+
+    void toUpperCase();
+    void toLowerCase();
+    void trim();
+    void remove(size_t index, size_t count);
+    void replace(const char* find, const char* with);
+
+    long toInt() const;
+    float toFloat() const;
+};
+
+String operator+(const String& a, const String& b);
+String operator+(const String& a, const char* b);
+String operator+(const char* a, const String& b);
+
+#endif
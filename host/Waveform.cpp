@@ -0,0 +1,199 @@
+#include "Waveform.h"
+#include "Arduino.h"
+
+#include <map>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace hal {
+
+Waveform::Waveform() : _noise(0), _seed(1), _loop(0) {}
+
+// ========================================
+// FORMES
+// ========================================
+Waveform Waveform::constant(float value) {
+    Waveform w;
+    w._shape = [value](unsigned long) { return value; };
+    return w;
+}
+
+Waveform Waveform::sine(float mean, float amplitude, unsigned long periodMs) {
+    Waveform w;
+    w._shape = [mean, amplitude, periodMs](unsigned long ms) {
+        double phase = (double)(ms % periodMs) / periodMs;
+        return (float)(mean + amplitude * sin(2.0 * M_PI * phase));
+    };
+    return w;
+}
+
+Waveform Waveform::ramp(float from, float to, unsigned long durationMs) {
+    std::vector<Point> p;
+    p.push_back(Point(0, from));
+    p.push_back(Point(durationMs, to));
+    return points(p);
+}
+
+Waveform Waveform::square(float low, float high, unsigned long periodMs) {
+    Waveform w;
+    w._shape = [low, high, periodMs](unsigned long ms) {
+        return ms % periodMs < periodMs / 2 ? low : high;
+    };
+    return w;
+}
+
+Waveform Waveform::points(const std::vector<Point>& points) {
+    Waveform w;
+    w._shape = [points](unsigned long ms) {
+        if (points.empty()) return 0.0f;
+        if (ms <= points.front().first) return points.front().second;
+        for (size_t i = 1; i < points.size(); i++) {
+            const Point& a = points[i - 1];
+            const Point& b = points[i];
+            if (ms <= b.first) {
+                if (b.first == a.first) return b.second;
+                float t = (float)(ms - a.first) / (b.first - a.first);
+                return a.second + (b.second - a.second) * t;
+            }
+        }
+        return points.back().second;
+    };
+    return w;
+}
+
+Waveform Waveform::fromCsv(const char* path, bool* ok) {
+    std::vector<Point> p;
+    FILE* file = fopen(path, "r");
+    if (file) {
+        char line[128];
+        while (fgets(line, sizeof(line), file)) {
+            if (line[0] == '#') continue;
+            char* comma = strchr(line, ',');
+            if (!comma) continue;
+            p.push_back(Point(strtoul(line, NULL, 10), (float)atof(comma + 1)));
+        }
+        fclose(file);
+    }
+    if (ok) *ok = file != NULL && !p.empty();
+    return points(p);
+}
+
+Waveform Waveform::parse(const char* spec, bool* ok) {
+    float a = 0;
+    float b = 0;
+    unsigned long period = 0;
+    bool valid = true;
+    Waveform w = constant(0);
+
+    if (strncmp(spec, "csv:", 4) == 0) {
+        w = fromCsv(spec + 4, &valid);
+    } else if (sscanf(spec, "sine:%f:%f:%lu", &a, &b, &period) == 3 && period > 0) {
+        w = sine(a, b, period);
+    } else if (sscanf(spec, "ramp:%f:%f:%lu", &a, &b, &period) == 3) {
+        w = ramp(a, b, period);
+    } else if (sscanf(spec, "square:%f:%f:%lu", &a, &b, &period) == 3 && period > 0) {
+        w = square(a, b, period);
+    } else if (sscanf(spec, "const:%f", &a) == 1) {
+        w = constant(a);
+    } else {
+        valid = false;
+    }
+    if (ok) *ok = valid;
+    return w;
+}
+
+Waveform& Waveform::noise(float amplitude, uint32_t seed) {
+    _noise = amplitude;
+    _seed = seed;
+    return *this;
+}
+
+Waveform& Waveform::loop(unsigned long periodMs) {
+    _loop = periodMs;
+    return *this;
+}
+
+float Waveform::at(unsigned long ms) const {
+    if (_loop > 0) ms %= _loop;
+    float value = _shape ? _shape(ms) : 0.0f;
+    if (_noise > 0) {
+        // Hash entier (xorshift-multiply) : même instant, même bruit
+        uint32_t h = (uint32_t)ms * 2654435761u ^ _seed;
+        h ^= h >> 16;
+        h *= 0x7feb352d;
+        h ^= h >> 15;
+        value += _noise * ((float)h / 4294967295.0f * 2.0f - 1.0f);
+    }
+    return value;
+}
+
+// ========================================
+// BROCHES SCRIPTÉES
+// ========================================
+namespace {
+    struct AnalogScript {
+        Waveform waveform;
+        unsigned long start;
+    };
+    struct DigitalScript {
+        std::vector<std::pair<unsigned long, int> > events;
+        unsigned long start;
+    };
+
+    std::mutex scriptMutex;
+    std::map<uint8_t, AnalogScript> analogScripts;
+    std::map<uint8_t, DigitalScript> digitalScripts;
+}
+
+void setAnalogWaveform(uint8_t pin, const Waveform& waveform) {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    AnalogScript script = { waveform, millis() };
+    analogScripts.erase(pin);
+    analogScripts.insert(std::make_pair(pin, script));
+}
+
+void clearAnalogWaveform(uint8_t pin) {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    analogScripts.erase(pin);
+}
+
+void scriptDigitalInput(uint8_t pin, const std::vector<std::pair<unsigned long, int> >& events) {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    DigitalScript script = { events, millis() };
+    digitalScripts[pin] = script;
+}
+
+void clearScripts() {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    analogScripts.clear();
+    digitalScripts.clear();
+}
+
+bool scriptedAnalog(uint8_t pin, int& value) {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    std::map<uint8_t, AnalogScript>::const_iterator it = analogScripts.find(pin);
+    if (it == analogScripts.end()) return false;
+    float v = it->second.waveform.at(millis() - it->second.start);
+    value = (int)(v + 0.5f);
+    return true;
+}
+
+// Avant le premier événement : false, l'état courant de la broche s'applique
+bool scriptedDigital(uint8_t pin, int& value) {
+    std::lock_guard<std::mutex> lock(scriptMutex);
+    std::map<uint8_t, DigitalScript>::const_iterator it = digitalScripts.find(pin);
+    if (it == digitalScripts.end()) return false;
+
+    unsigned long elapsed = millis() - it->second.start;
+    bool found = false;
+    for (size_t i = 0; i < it->second.events.size(); i++) {
+        if (it->second.events[i].first > elapsed) break;
+        value = it->second.events[i].second;
+        found = true;
+    }
+    return found;
+}
+
+}
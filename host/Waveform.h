@@ -0,0 +1,65 @@
+#ifndef HOST_WAVEFORM_H
+#define HOST_WAVEFORM_H
+
+// ========================================
+// SIGNAUX SCRIPTÉS POUR LE HAL SIMULÉ
+// ========================================
+// Une Waveform donne une valeur en fonction du temps écoulé (ms) depuis
+// son installation sur une broche. analogRead() la suit, en unités ADC
+// brutes (0..4095), aussi bien sur l'horloge réelle que simulée.
+// Toutes les formes sont déterministes, bruit compris (hash du temps).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace hal {
+
+class Waveform {
+public:
+    typedef std::pair<unsigned long, float> Point;   // (ms, valeur)
+
+    static Waveform constant(float value);
+    static Waveform sine(float mean, float amplitude, unsigned long periodMs);
+    static Waveform ramp(float from, float to, unsigned long durationMs);
+    static Waveform square(float low, float high, unsigned long periodMs);
+    // Interpolation linéaire entre points, dernière valeur tenue ensuite
+    static Waveform points(const std::vector<Point>& points);
+    // Fichier "ms,valeur" par ligne ('#' = commentaire) ; ok = false si illisible
+    static Waveform fromCsv(const char* path, bool* ok = NULL);
+    // "const:V", "sine:moy:amp:periode", "ramp:de:a:duree",
+    // "square:bas:haut:periode", "csv:fichier"
+    static Waveform parse(const char* spec, bool* ok = NULL);
+
+    // Bruit uniforme ±amplitude ajouté à la forme
+    Waveform& noise(float amplitude, uint32_t seed = 1);
+    // Forme répétée tous les periodMs (points, CSV, rampe)
+    Waveform& loop(unsigned long periodMs);
+
+    float at(unsigned long ms) const;
+
+private:
+    std::function<float(unsigned long)> _shape;
+    float _noise;
+    uint32_t _seed;
+    unsigned long _loop;
+
+    Waveform();
+};
+
+// Broche ADC pilotée par la forme, prioritaire sur setAnalogSource()
+void setAnalogWaveform(uint8_t pin, const Waveform& waveform);
+void clearAnalogWaveform(uint8_t pin);
+// Niveaux successifs d'une entrée numérique : (ms depuis l'appel, niveau)
+void scriptDigitalInput(uint8_t pin, const std::vector<std::pair<unsigned long, int> >& events);
+void clearScripts();
+
+// Utilisé par analogRead()/digitalRead() du stand-in
+bool scriptedAnalog(uint8_t pin, int& value);
+bool scriptedDigital(uint8_t pin, int& value);
+
+}
+
+#endif
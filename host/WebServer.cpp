@@ -0,0 +1,223 @@
+#include "WebServer.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// ========================================
+// CHAMPS À TAILLE FIXE
+// ========================================
+static void copyField(char* out, size_t size, const char* in, size_t len) {
+    if (len > size - 1) len = size - 1;
+    memcpy(out, in, len);
+    out[len] = '\0';
+}
+
+void HostHttpFields::add(const char* name, const char* value, size_t valueLen, bool first) {
+    if (count >= HOST_HTTP_MAX_FIELDS) return;
+    if (first) {
+        memmove(&items[1], &items[0], count * sizeof(HostHttpField));
+    }
+    HostHttpField& field = items[first ? 0 : count];
+    copyField(field.name, sizeof(field.name), name, strlen(name));
+    copyField(field.value, sizeof(field.value), value, valueLen);
+    count++;
+}
+
+const char* HostHttpFields::find(const char* name, bool ignoreCase) const {
+    for (size_t i = 0; i < count; i++) {
+        int diff = ignoreCase ? strcasecmp(items[i].name, name) : strcmp(items[i].name, name);
+        if (diff == 0) return items[i].value;
+    }
+    return 0;
+}
+
+WebServer::WebServer(int) : _started(false), _method(HTTP_GET), _contentLength(CONTENT_LENGTH_NOT_SET) {
+    // Capacités réservées une fois : le stand-in n'alloue pas en régime établi
+    _uri.reserve(128);
+    _plain.reserve(4096);
+    _response.body.reserve(8192);
+    _response.contentType.reserve(64);
+}
+
+void WebServer::begin() { _started = true; }
+void WebServer::close() { _started = false; }
+void WebServer::handleClient() {}
+
+// ========================================
+// ROUTES
+// ========================================
+void WebServer::on(const String& uri, THandlerFunction handler) {
+    on(uri, HTTP_ANY, handler);
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler) {
+    Route route;
+    route.uri = uri.c_str();
+    route.method = method;
+    route.handler = handler;
+    _routes.push_back(route);
+}
+
+void WebServer::onNotFound(THandlerFunction handler) {
+    _notFound = handler;
+}
+
+// ========================================
+// REQUÊTE COURANTE
+// ========================================
+String WebServer::arg(const String& name) const {
+    if (name == "plain") return String(_plain.c_str(), _plain.size());
+    const char* value = _args.find(name.c_str(), false);
+    return String(value ? value : "");
+}
+
+String WebServer::arg(int i) const {
+    return i >= 0 && i < (int)_args.count ? String(_args.items[i].value) : String("");
+}
+
+String WebServer::argName(int i) const {
+    return i >= 0 && i < (int)_args.count ? String(_args.items[i].name) : String("");
+}
+
+bool WebServer::hasArg(const String& name) const {
+    // Comme le core : le corps brut est l'argument "plain"
+    if (name == "plain") return !_plain.empty();
+    return _args.find(name.c_str(), false) != 0;
+}
+
+void WebServer::collectHeaders(const char*[], const size_t) {
+    // Le stand-in conserve tous les en-têtes de requête
+}
+
+String WebServer::header(const String& name) const {
+    const char* value = _requestHeaders.find(name.c_str(), true);
+    return String(value ? value : "");
+}
+
+bool WebServer::hasHeader(const String& name) const {
+    return _requestHeaders.find(name.c_str(), true) != 0;
+}
+
+// ========================================
+// RÉPONSE
+// ========================================
+void WebServer::beginResponse(int code, const char* contentType, size_t contentLength) {
+    _response.code = code;
+    _response.contentType = contentType ? contentType : "text/html";
+    _response.body.clear();
+    _response.headers = _pendingHeaders;
+    _pendingHeaders.clear();
+    _response.chunked = contentLength == CONTENT_LENGTH_UNKNOWN;
+    _response.sent = true;
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+    size_t length = _contentLength == CONTENT_LENGTH_NOT_SET ? content.length() : _contentLength;
+    beginResponse(code, contentType, length);
+    _response.body.append(content.c_str(), content.length());
+}
+
+void WebServer::send(int code, char* contentType, const String& content) {
+    send(code, (const char*)contentType, content);
+}
+
+void WebServer::send(int code, const String& contentType, const String& content) {
+    send(code, contentType.c_str(), content);
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content) {
+    send_P(code, contentType, content, content ? strlen(content) : 0);
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) {
+    beginResponse(code, contentType, contentLength);
+    if (content) _response.body.append(content, contentLength);
+}
+
+void WebServer::setContentLength(size_t contentLength) {
+    _contentLength = contentLength;
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+    _pendingHeaders.add(name.c_str(), value.c_str(), value.length(), first);
+}
+
+void WebServer::sendContent(const String& content) {
+    sendContent(content.c_str(), content.length());
+}
+
+void WebServer::sendContent(const char* content, size_t contentLength) {
+    if (content) _response.body.append(content, contentLength);
+}
+
+void WebServer::sendContent_P(PGM_P content) {
+    sendContent(content, content ? strlen(content) : 0);
+}
+
+void WebServer::sendContent_P(PGM_P content, size_t contentLength) {
+    sendContent(content, contentLength);
+}
+
+// ========================================
+// SIMULATION
+// ========================================
+void WebServer::setRequestHeader(const char* name, const char* value) {
+    _requestHeaders.add(name, value, strlen(value));
+}
+
+void WebServer::clearRequestHeaders() {
+    _requestHeaders.clear();
+}
+
+const HostHttpResponse& WebServer::request(HTTPMethod method, const char* uri,
+                                           const char* query, const char* body) {
+    _method = method;
+    _uri = uri;
+    _args.clear();
+    _pendingHeaders.clear();
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+    _response.code = 0;
+    _response.body.clear();
+    _response.headers.clear();
+    _response.sent = false;
+
+    // query -> arguments, décodage minimal (+ et %XX)
+    const char* p = query ? query : "";
+    while (*p) {
+        const char* amp = strchr(p, '&');
+        const char* stop = amp ? amp : p + strlen(p);
+        const char* eq = (const char*)memchr(p, '=', stop - p);
+
+        char name[48];
+        copyField(name, sizeof(name), p, (size_t)((eq ? eq : stop) - p));
+        char value[208];
+        size_t len = 0;
+        if (eq) {
+            for (const char* c = eq + 1; c < stop && len < sizeof(value) - 1; c++) {
+                if (*c == '+') value[len++] = ' ';
+                else if (*c == '%' && c + 2 < stop) {
+                    char hex[3] = { c[1], c[2], 0 };
+                    value[len++] = (char)strtol(hex, 0, 16);
+                    c += 2;
+                } else value[len++] = *c;
+            }
+        }
+        _args.add(name, value, len);
+        p = amp ? amp + 1 : stop;
+    }
+    _plain.clear();
+    if (body) _plain = body;
+
+    for (size_t i = 0; i < _routes.size(); i++) {
+        const Route& route = _routes[i];
+        if ((route.method == HTTP_ANY || route.method == method) && route.uri == _uri) {
+            route.handler();
+            return _response;
+        }
+    }
+    if (_notFound) _notFound();
+    else send(404, "text/plain", String("Not found"));
+    return _response;
+}
@@ -0,0 +1,137 @@
+#ifndef HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+// ========================================
+// STAND-IN WebServer ESP32
+// ========================================
+// Même API publique que la bibliothèque WebServer du core ESP32 pour ce que
+// RestAPI utilise. Pas de socket : les requêtes sont injectées par
+// request() et la réponse est capturée pour inspection ou benchmark.
+
+#include <Arduino.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum HTTPMethod {
+    HTTP_ANY,
+    HTTP_GET,
+    HTTP_HEAD,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_PATCH,
+    HTTP_DELETE,
+    HTTP_OPTIONS
+};
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+
+// Paires nom/valeur à taille fixe : le stand-in lui-même n'alloue jamais,
+// les allocations mesurées sont celles du firmware
+struct HostHttpField {
+    char name[48];
+    char value[208];
+};
+
+#define HOST_HTTP_MAX_FIELDS 16
+
+struct HostHttpFields {
+    HostHttpField items[HOST_HTTP_MAX_FIELDS];
+    size_t count;
+
+    HostHttpFields() : count(0) {}
+    void clear() { count = 0; }
+    void add(const char* name, const char* value, size_t valueLen, bool first = false);
+    const char* find(const char* name, bool ignoreCase) const;
+};
+
+// Réponse capturée
+struct HostHttpResponse {
+    int code;
+    std::string contentType;
+    std::string body;
+    HostHttpFields headers;
+    bool chunked;
+    bool sent;
+
+    const char* header(const char* name) const { return headers.find(name, true); }
+};
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit WebServer(int port = 80);
+
+    void begin();
+    void close();
+    void stop() { close(); }
+    void handleClient();
+
+    void on(const String& uri, THandlerFunction handler);
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler);
+    void onNotFound(THandlerFunction handler);
+
+    String uri() const { return String(_uri.c_str()); }
+    HTTPMethod method() const { return _method; }
+
+    String arg(const String& name) const;
+    String arg(int i) const;
+    String argName(int i) const;
+    int args() const { return (int)_args.count; }
+    bool hasArg(const String& name) const;
+
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const String& name) const;
+    bool hasHeader(const String& name) const;
+
+    void send(int code, const char* contentType = NULL, const String& content = String(""));
+    void send(int code, char* contentType, const String& content);
+    void send(int code, const String& contentType, const String& content);
+    void send_P(int code, PGM_P contentType, PGM_P content);
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength);
+
+    void setContentLength(size_t contentLength);
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void sendContent(const String& content);
+    void sendContent(const char* content, size_t contentLength);
+    void sendContent_P(PGM_P content);
+    void sendContent_P(PGM_P content, size_t contentLength);
+
+    // ========================================
+    // SIMULATION (host uniquement)
+    // ========================================
+    // query : "temp=30&light=50" ; body : corps brut, exposé via arg("plain")
+    const HostHttpResponse& request(HTTPMethod method, const char* uri,
+                                    const char* query = "", const char* body = 0);
+    void setRequestHeader(const char* name, const char* value);
+    void clearRequestHeaders();
+    const HostHttpResponse& lastResponse() const { return _response; }
+    size_t routeCount() const { return _routes.size(); }
+
+private:
+    struct Route {
+        std::string uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+
+    std::vector<Route> _routes;
+    THandlerFunction _notFound;
+    bool _started;
+
+    HTTPMethod _method;
+    std::string _uri;
+    HostHttpFields _args;
+    std::string _plain;
+    HostHttpFields _requestHeaders;
+    HostHttpFields _pendingHeaders;
+    size_t _contentLength;
+
+    HostHttpResponse _response;
+
+    void beginResponse(int code, const char* contentType, size_t contentLength);
+};
+
+#endif
@@ -0,0 +1,11 @@
+#include "WiFi.h"
+
+#include <stdio.h>
+
+WiFiClass WiFi;
+
+String IPAddress::toString() const {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+    return String(text);
+}
@@ -0,0 +1,50 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+// ========================================
+// STAND-IN WiFi ESP32
+// ========================================
+// Connexion toujours immédiate (WL_CONNECTED après begin()) et adresse IP
+// locale réglable par les tests.
+
+#include <Arduino.h>
+#include <stdint.h>
+
+class IPAddress {
+public:
+    IPAddress() { _bytes[0] = _bytes[1] = _bytes[2] = _bytes[3] = 0; }
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+        _bytes[0] = a; _bytes[1] = b; _bytes[2] = c; _bytes[3] = d;
+    }
+
+    uint8_t operator[](int index) const { return _bytes[index]; }
+    String toString() const;
+
+private:
+    uint8_t _bytes[4];
+};
+
+typedef enum { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+typedef enum { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 } wl_status_t;
+
+class WiFiClass {
+public:
+    WiFiClass() : _ip(192, 168, 1, 100), _status(WL_DISCONNECTED) {}
+
+    bool mode(wifi_mode_t) { return true; }
+    bool disconnect() { _status = WL_DISCONNECTED; return true; }
+    wl_status_t begin(const char*, const char* = NULL) { _status = WL_CONNECTED; return _status; }
+    wl_status_t status() const { return _status; }
+    IPAddress localIP() const { return _ip; }
+
+    // SIMULATION (host uniquement)
+    void setLocalIP(const IPAddress& ip) { _ip = ip; }
+
+private:
+    IPAddress _ip;
+    wl_status_t _status;
+};
+
+extern WiFiClass WiFi;
+
+#endif
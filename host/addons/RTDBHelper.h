@@ -0,0 +1,7 @@
+#ifndef HOST_RTDB_HELPER_H
+#define HOST_RTDB_HELPER_H
+
+// Stand-in de addons/RTDBHelper.h : helpers d'affichage non utilisés
+#include <Firebase_ESP_Client.h>
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef HOST_TOKEN_HELPER_H
+#define HOST_TOKEN_HELPER_H
+
+// Stand-in de addons/TokenHelper.h : aucun jeton à rafraîchir sur host
+#include <Firebase_ESP_Client.h>
+
+inline void tokenStatusCallback(TokenInfo) {}
+
+#endif
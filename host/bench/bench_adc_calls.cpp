@@ -0,0 +1,66 @@
+// bench_adc_calls.cpp
+// Appels analogRead() et delay() par itération de loop(), avant/après read()
+
+#include <Arduino.h>
+#include <chrono>
+#include <stdio.h>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+
+typedef std::chrono::steady_clock Clock;
+
+struct Cost {
+    unsigned long analogReads;
+    unsigned long delays;
+    double us;
+};
+
+template <typename F>
+static Cost measure(int iterations, F body) {
+    hal::resetCounters();
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; i++) body();
+    double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    Cost cost;
+    cost.analogReads = hal::analogReadCount() / iterations;
+    cost.delays = hal::delayCount() / iterations;
+    cost.us = us / iterations;
+    return cost;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::setAnalogSource([](uint8_t pin) { return pin == TEMP_SENSOR_PIN ? 2200 : 1800; });
+
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    tempSensor.begin();
+    lightSensor.begin();
+
+    const int iterations = 20;
+
+    // Ancienne séquence de loop() : readValue() puis readPercent()
+    Cost before = measure(iterations, [&]() {
+        volatile float t = tempSensor.readTemperature();
+        volatile int raw = lightSensor.readValue();
+        volatile int pct = lightSensor.readPercent();
+        (void)t; (void)raw; (void)pct;
+    });
+
+    // Une seule acquisition par capteur
+    Cost after = measure(iterations, [&]() {
+        volatile TemperatureReading t = tempSensor.read();
+        volatile LightReading l = lightSensor.read();
+        (void)t; (void)l;
+    });
+
+    printf("Cout capteurs par iteration de loop()\n");
+    printf("  avant : %2lu analogRead  %2lu delay  %8.1f us\n",
+           before.analogReads, before.delays, before.us);
+    printf("  apres : %2lu analogRead  %2lu delay  %8.1f us\n",
+           after.analogReads, after.delays, after.us);
+    return 0;
+}
@@ -0,0 +1,74 @@
+// bench_display.cpp
+// Pixels envoyés au TFT par showStatus() : plein écran vs zones invalidées,
+// et temps CPU bloqué sur le SPI selon DISPLAY_SPRITE_DEPTH
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <stdio.h>
+
+#include "config.h"
+#include "DisplayControl.h"
+#include "../test/legacy_display.h"
+
+// SPI à 40 MHz, 16 bits par pixel
+static double spiMs(double pixels) {
+    return pixels * 16.0 / 40e6 * 1000.0;
+}
+
+struct Scenario {
+    const char* name;
+    float tempStep;     // variation par mise à jour
+    int lightStep;
+    int ledEvery;       // bascule LED toutes les N mises à jour (0 = jamais)
+};
+
+static const Scenario scenarios[] = {
+    { "stable",          0.0f,  0, 0 },
+    { "temp qui derive", 0.1f,  0, 0 },
+    { "temp + lumiere",  0.1f,  1, 0 },
+    { "tout change",     0.1f,  3, 1 },
+};
+
+int main() {
+    const int updates = 200;
+    const size_t frameBytes = 240 * 135 * (DISPLAY_SPRITE_DEPTH / 8);
+    printf("DISPLAY_SPRITE_DEPTH=%d, RAM image %u octets\n", DISPLAY_SPRITE_DEPTH, (unsigned)frameBytes);
+    printf("%-16s %12s %12s %12s %9s %18s\n", "scenario", "px/maj avant", "px/maj apres",
+           "dont DMA", "gain", "CPU bloque ms/maj");
+
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        const Scenario& sc = scenarios[i];
+
+        TFT_eSPI legacyPanel;
+        legacyPanel.init();
+        legacyPanel.setRotation(1);
+        TFT_eSPI panel;
+        DisplayControl display(&panel);
+        display.begin();
+
+        // Premier rendu hors mesure : libellés fixes déjà à l'écran
+        display.showStatus(22.0f, 40, false, true, true, "MANUEL");
+        while (display.isBusy()) delay(1);
+        legacyPanel.resetCounters();
+        panel.resetCounters();
+
+        for (int u = 0; u < updates; u++) {
+            float t = 22.0f + sc.tempStep * u;
+            int light = (40 + sc.lightStep * u) % 101;
+            bool led = sc.ledEvery && (u / sc.ledEvery) % 2;
+            legacyShowStatus(&legacyPanel, t, light, led, true, true, "MANUEL");
+            while (display.isBusy()) delay(1);
+            display.showStatus(t, light, led, true, true, "MANUEL");
+        }
+
+        double before = (double)legacyPanel.pixelsPushed() / updates;
+        double blocking = (double)panel.pixelsPushed() / updates;
+        double dma = (double)panel.dmaPixelsPushed() / updates;
+        double after = blocking + dma;
+        char gain[16] = "inf";
+        if (after > 0) snprintf(gain, sizeof(gain), "%.1fx", before / after);
+        printf("%-16s %12.0f %12.0f %12.0f %9s %8.2f -> %5.2f\n", sc.name, before, after, dma,
+               gain, spiMs(before), spiMs(blocking));
+    }
+    return 0;
+}
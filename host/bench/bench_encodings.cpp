@@ -0,0 +1,83 @@
+// bench_encodings.cpp
+// JSON, CBOR et MessagePack par route : octets du corps et temps
+// d'encodage du même document (WebServer simulé)
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "BinaryJson.h"
+#include "RestAPI.h"
+
+static const char* const uris[] = {
+    "/status", "/sensors", "/sensors/temperature", "/sensors/light", "/threshold"
+};
+
+static const ResponseFormat formats[] = { FORMAT_JSON, FORMAT_CBOR, FORMAT_MSGPACK };
+static const char* const formatNames[] = { "JSON", "CBOR", "MsgPack" };
+
+static size_t encode(JsonDocument& doc, ResponseFormat format, char* out, size_t size) {
+    return format == FORMAT_JSON ? serializeJson(doc, out, size)
+                                 : serializeBinary(doc.as<JsonVariant>(), format, (uint8_t*)out, size);
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::setAnalogSource([](uint8_t pin) { return pin == TEMP_SENSOR_PIN ? 2200 : 1800; });
+
+    WebServer server(80);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+
+    tempSensor.begin();
+    lightSensor.begin();
+    led.begin();
+    sampler.sampleOnce();
+    api.begin();
+
+    const int iterations = 100000;
+    DynamicJsonDocument doc(JSON_RESPONSE_SIZE * 2);
+    char buffer[JSON_RESPONSE_SIZE];
+    printf("%-22s %-8s %6s %6s %10s %10s\n", "route", "format", "octets", "gain", "ns/encode", "ns/req");
+
+    for (size_t r = 0; r < sizeof(uris) / sizeof(uris[0]); r++) {
+        // Document de la route, reconstruit depuis sa réponse JSON
+        server.clearRequestHeaders();
+        std::string body = server.request(HTTP_GET, uris[r]).body;
+        if (deserializeJson(doc, body.c_str())) continue;
+
+        size_t jsonBytes = 0;
+        for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+            volatile size_t sink = 0;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; i++) sink = sink + encode(doc, formats[f], buffer, sizeof(buffer));
+            double encodeNs = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start).count() / iterations;
+
+            // Requête complète avec l'en-tête Accept correspondant
+            server.clearRequestHeaders();
+            server.setRequestHeader("Accept", formatContentType(formats[f]));
+            start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations / 10; i++) server.request(HTTP_GET, uris[r]);
+            double requestNs = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start).count() / (iterations / 10);
+
+            size_t bytes = server.lastResponse().body.size();
+            if (f == 0) jsonBytes = bytes;
+            printf("%-22s %-8s %6zu %5.0f%% %10.0f %10.0f\n", f ? "" : uris[r], formatNames[f], bytes,
+                   100.0 * ((double)bytes - jsonBytes) / jsonBytes, encodeNs, requestNs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+// bench_filter.cpp
+// Coût par échantillon : ancien getAverage() vs SensorFilter (moyenne, médiane, EMA)
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "config.h"
+#include "SensorFilter.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int SAMPLES = 20000000;
+static int noise[1024];
+
+// Ancienne implémentation : tampon de 10 + somme complète à chaque lecture
+struct LegacyAverage {
+    int _buffer[10];
+    int _bufferIndex;
+
+    LegacyAverage() : _bufferIndex(0) {
+        for (int i = 0; i < 10; i++) _buffer[i] = 0;
+    }
+
+    int getAverage(int buffer[], int size) {
+        long sum = 0;
+        for (int i = 0; i < size; i++) sum += buffer[i];
+        return sum / size;
+    }
+
+    int update(int sample) {
+        _buffer[_bufferIndex % 10] = sample;
+        _bufferIndex++;
+        return getAverage(_buffer, 10);
+    }
+};
+
+template <typename F>
+static double nsPerSample(const char* name, F& filter, long& checksum) {
+    Clock::time_point start = Clock::now();
+    long acc = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        acc += filter.update(noise[i & 1023]);
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / SAMPLES;
+    printf("  %-18s %6.2f ns/echantillon\n", name, ns);
+    checksum = acc;
+    return ns;
+}
+
+int main() {
+    srand(42);
+    for (int i = 0; i < 1024; i++) noise[i] = 2000 + rand() % 200;
+
+    LegacyAverage legacy;
+    SensorFilter<FILTER_SIZE> mean;
+    SensorFilter<FILTER_SIZE, FILTER_MEDIAN> median;
+    SensorFilter<FILTER_SIZE, FILTER_EMA> ema;
+
+    printf("Filtre N=%d, %d echantillons\n", FILTER_SIZE, SAMPLES);
+    long legacySum, meanSum, medianSum, emaSum;
+    nsPerSample("getAverage (ancien)", legacy, legacySum);
+    nsPerSample("moyenne O(1)", mean, meanSum);
+    nsPerSample("mediane", median, medianSum);
+    nsPerSample("EMA", ema, emaSum);
+
+    if (FILTER_SIZE == 10 && legacySum != meanSum) {
+        printf("ERREUR: la moyenne O(1) differe de getAverage\n");
+        return 1;
+    }
+    printf("  (checksums %ld / %ld / %ld)\n", medianSum, emaSum, meanSum);
+    return 0;
+}
@@ -0,0 +1,101 @@
+// bench_flash_log.cpp
+// Journal flash sur fichier ordinaire : octets par échantillon, écritures
+// et amplification face à un ajout par échantillon, vitesse des requêtes
+//
+//   bench_flash_log [--samples N] [--dir DIR]
+
+#include <LittleFS.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "FlashLog.h"
+
+typedef std::chrono::steady_clock Clock;
+
+#define T0 1700000000UL
+#define STEP (HISTORY_INTERVAL / 1000)
+// Échantillon brut : horodatage 4, température 2, lumière 2, LED 1
+#define RAW_SAMPLE_SIZE 9
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Capteurs réalistes : dérive lente + bruit ADC
+static float tempAt(uint32_t i) { return 22.0f + 3.0f * sinf(i / 2000.0f) + (rand() % 9 - 4) / 100.0f; }
+static int lightAt(uint32_t i) { return 1800 + (int)(1200 * sinf(i / 8000.0f)) + rand() % 17 - 8; }
+
+static void query(FlashLog& log, const char* name, uint32_t from, uint32_t to, int repeat) {
+    size_t count = 0;
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < repeat; r++) {
+        count = log.query(from, to, 0xFFFFFFFF, [](const LogSample&) {});
+    }
+    double ms = msSince(start) / repeat;
+    printf("  %-22s %7u echantillons %8.3f ms %8.1f M ech/s\n", name, (unsigned)count, ms,
+           ms > 0 ? count / ms / 1000.0 : 0.0);
+}
+
+int main(int argc, char** argv) {
+    uint32_t samples = 86400 / STEP;   // un jour
+    const char* dir = NULL;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--samples") == 0) samples = strtoul(argv[i + 1], NULL, 10);
+        else if (strcmp(argv[i], "--dir") == 0) dir = argv[i + 1];
+    }
+
+    char tmp[] = "/tmp/ttgo_bench_flashlog_XXXXXX";
+    hal::setSerialEnabled(false);
+    hal::setFsRoot(dir ? dir : mkdtemp(tmp));
+    LittleFS.begin(true);
+    LittleFS.format();
+    srand(42);
+
+    // ========================================
+    // ÉCRITURE
+    // ========================================
+    FlashLog log(&LittleFS);
+    log.begin();
+    hal::resetFsCounters();
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < samples; i++) {
+        log.record(tempAt(i), lightAt(i), (i / 200) % 2, T0 + i * STEP);
+    }
+    log.flush();
+    double writeMs = msSince(start);
+
+    FlashLogStats stats = log.getStats();
+    unsigned long raw = (unsigned long)samples * RAW_SAMPLE_SIZE;
+    printf("Journal flash : %u echantillons (%u s d'intervalle), page %d o, segments %d x %d o\n",
+           (unsigned)samples, (unsigned)STEP, FLASHLOG_PAGE_SIZE, FLASHLOG_MAX_SEGMENTS, FLASHLOG_SEGMENT_SIZE);
+    printf("  ecriture               %8.1f ms (%.2f us/echantillon)\n", writeMs, writeMs * 1000 / samples);
+    printf("  octets ecrits          %8lu (%.2f o/echantillon, brut %d)\n",
+           hal::fsBytesWritten(), (double)hal::fsBytesWritten() / samples, RAW_SAMPLE_SIZE);
+    printf("  enregistrements        %8lu (%.1f echantillons par ecriture)\n",
+           (unsigned long)stats.flushes, (double)samples / stats.flushes);
+    // Un ajout par échantillon programme au moins une page flash à chaque fois
+    printf("  pages programmees      %8lu contre %u en ajout par echantillon (/%.0f)\n",
+           (unsigned long)stats.flushes, (unsigned)samples, (double)samples / stats.flushes);
+    printf("  amplification          %8.2f (octets ecrits / octets bruts)\n",
+           (double)hal::fsBytesWritten() / raw);
+    printf("  conserve               %8lu octets sur %lu segments\n",
+           (unsigned long)stats.bytes, (unsigned long)stats.segments);
+
+    // ========================================
+    // LECTURE
+    // ========================================
+    uint32_t end = T0 + (samples - 1) * STEP;
+    printf("Requetes :\n");
+    query(log, "tout", 0, 0xFFFFFFFF, 5);
+    query(log, "derniere heure", end - 3600, end, 50);
+    query(log, "derniere minute", end - 60, end, 200);
+    query(log, "une heure au milieu", end - 43200, end - 39600, 50);
+
+    LittleFS.format();
+    if (!dir) rmdir(tmp);
+    return 0;
+}
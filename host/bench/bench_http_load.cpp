@@ -0,0 +1,455 @@
+// bench_http_load.cpp
+// Charge HTTP sur toutes les routes de RestAPI : N connexions parallèles,
+// keep-alive ou non, latences p50/p95/p99, débit et erreurs par route.
+//
+// Sans --host : RestAPI + SocketHttpServer démarrés dans le processus
+// (port éphémère). Avec --host/--port : carte sur le réseau local ou ttgo_sim.
+//
+//   bench_http_load [--host IP] [--port N] [--concurrency N] [--duration S]
+//                   [--close] [--route /status]... [--out resultats.json]
+//                   [--baseline ancien.json] [--max-regression 20]
+//
+// --route retient toutes les méthodes du chemin (GET et OPTIONS /status).
+// Le fichier --out est relu par --baseline : un commit compare ses p99 et
+// son débit à ceux d'un autre, code de sortie 1 au-delà du seuil.
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "config.h"
+#include "Waveform.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "SensorHistory.h"
+#include "FlashLog.h"
+#include "TelemetryPolicy.h"
+#include "SocketHttpServer.h"
+#include "RestAPI.h"
+
+// Routes de RestAPI::ROUTES avec une requête valide ; /events et /ws
+// ouvrent un flux sans fin et n'ont pas de latence par requête
+struct Route {
+    const char* method;
+    const char* path;
+    const char* body;   // NULL : sans corps
+};
+
+static const Route routes[] = {
+    { "GET",     "/sensors", NULL },
+    { "GET",     "/sensors/temperature", NULL },
+    { "GET",     "/sensors/light", NULL },
+    { "POST",    "/led/on", NULL },
+    { "POST",    "/led/off", NULL },
+    { "POST",    "/led/toggle", NULL },
+    { "POST",    "/threshold/set?temp=30&light=50", NULL },
+    { "GET",     "/threshold", NULL },
+    { "POST",    "/mode/set?mode=MANUEL", NULL },
+    { "POST",    "/batch", "[{\"cmd\":\"threshold\",\"temp\":30,\"light\":50},"
+                           "{\"cmd\":\"mode\",\"mode\":\"MANUEL\"},"
+                           "{\"cmd\":\"led\",\"state\":\"toggle\"}]" },
+    { "GET",     "/status", NULL },
+    { "GET",     "/system", NULL },
+    { "GET",     "/history?step=60000", NULL },
+    { "GET",     "/history/flash?limit=500", NULL },
+    { "GET",     "/telemetry", NULL },
+    { "POST",    "/telemetry/set?field=temperature&deadband=0.5", NULL },
+    { "GET",     "/api-docs", NULL },
+    { "OPTIONS", "/status", NULL },
+};
+
+struct Options {
+    const char* host;
+    uint16_t port;
+    int concurrency;
+    double duration;
+    bool keepAlive;
+    std::vector<std::string> only;
+    const char* out;
+    const char* baseline;
+    double maxRegression;   // %
+};
+
+struct RouteResult {
+    std::string name;
+    unsigned long requests;
+    unsigned long errors;
+    double seconds;
+    double p50, p95, p99, max;   // µs
+    double throughput() const { return seconds > 0 ? requests / seconds : 0; }
+};
+
+// ========================================
+// CLIENT HTTP/1.1
+// ========================================
+class Connection {
+public:
+    Connection(const sockaddr_in& addr) : _addr(addr), _fd(-1) {}
+    ~Connection() { disconnect(); }
+
+    // Retourne le code HTTP, -1 en cas d'erreur réseau
+    int request(const std::string& raw, bool keepAlive) {
+        if (_fd < 0 && !connectServer()) return -1;
+        if (::send(_fd, raw.data(), raw.size(), MSG_NOSIGNAL) != (ssize_t)raw.size()) {
+            disconnect();
+            return -1;
+        }
+        int code = readResponse();
+        if (code < 0 || !keepAlive || _serverClose) disconnect();
+        return code;
+    }
+
+private:
+    sockaddr_in _addr;
+    int _fd;
+    std::string _buffer;
+    bool _serverClose;
+
+    bool connectServer() {
+        _fd = socket(AF_INET, SOCK_STREAM, 0);
+        struct timeval timeout = { 5, 0 };
+        setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        int one = 1;
+        setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        _buffer.clear();
+        if (connect(_fd, (const sockaddr*)&_addr, sizeof(_addr)) != 0) {
+            disconnect();
+            return false;
+        }
+        return true;
+    }
+
+    void disconnect() {
+        if (_fd >= 0) close(_fd);
+        _fd = -1;
+    }
+
+    bool fill() {
+        char chunk[4096];
+        ssize_t n = recv(_fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        _buffer.append(chunk, n);
+        return true;
+    }
+
+    int readResponse() {
+        size_t end;
+        while ((end = _buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (!fill()) return -1;
+        }
+        std::string headers = _buffer.substr(0, end + 2);
+        _buffer.erase(0, end + 4);
+        int code = atoi(headers.c_str() + 9);
+        _serverClose = strcasestr(headers.c_str(), "Connection: close") != NULL;
+
+        if (strcasestr(headers.c_str(), "Transfer-Encoding: chunked")) {
+            for (;;) {
+                size_t eol;
+                while ((eol = _buffer.find("\r\n")) == std::string::npos) {
+                    if (!fill()) return -1;
+                }
+                size_t size = strtoul(_buffer.c_str(), NULL, 16);
+                while (_buffer.size() < eol + 2 + size + 2) {
+                    if (!fill()) return -1;
+                }
+                _buffer.erase(0, eol + 2 + size + 2);
+                if (size == 0) return code;
+            }
+        }
+
+        const char* length = strcasestr(headers.c_str(), "Content-Length:");
+        size_t size = length ? strtoul(length + 15, NULL, 10) : 0;
+        while (_buffer.size() < size) {
+            if (!fill()) return -1;
+        }
+        _buffer.erase(0, size);
+        return code;
+    }
+};
+
+// ========================================
+// MESURE D'UNE ROUTE
+// ========================================
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t rank = (size_t)(p / 100.0 * sorted.size() + 0.999999);
+    if (rank < 1) rank = 1;
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+static RouteResult runRoute(const Route& route, const sockaddr_in& addr, const Options& options) {
+    char raw[256];
+    char length[80] = "";
+    if (route.body) {
+        snprintf(length, sizeof(length), "Content-Type: application/json\r\nContent-Length: %u\r\n",
+                 (unsigned)strlen(route.body));
+    } else if (strcmp(route.method, "POST") == 0) {
+        strcpy(length, "Content-Length: 0\r\n");
+    }
+    snprintf(raw, sizeof(raw), "%s %s HTTP/1.1\r\nHost: bench\r\n%s%s\r\n",
+             route.method, route.path, length,
+             options.keepAlive ? "" : "Connection: close\r\n");
+    std::string request(raw);
+    if (route.body) request += route.body;
+
+    std::vector<std::vector<double> > latencies(options.concurrency);
+    std::vector<unsigned long> errors(options.concurrency, 0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point stop =
+        start + std::chrono::microseconds((long long)(options.duration * 1e6));
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < options.concurrency; w++) {
+        workers.push_back(std::thread([&, w]() {
+            Connection connection(addr);
+            latencies[w].reserve(100000);
+            while (std::chrono::steady_clock::now() < stop) {
+                std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+                int code = connection.request(request, options.keepAlive);
+                double us = std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - t0).count();
+                if (code >= 200 && code < 400) latencies[w].push_back(us);
+                else errors[w]++;
+            }
+        }));
+    }
+    for (size_t w = 0; w < workers.size(); w++) workers[w].join();
+
+    RouteResult result;
+    result.name = std::string(route.method) + " " + route.path;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::vector<double> all;
+    result.errors = 0;
+    for (int w = 0; w < options.concurrency; w++) {
+        all.insert(all.end(), latencies[w].begin(), latencies[w].end());
+        result.errors += errors[w];
+    }
+    std::sort(all.begin(), all.end());
+    result.requests = all.size();
+    result.p50 = percentile(all, 50);
+    result.p95 = percentile(all, 95);
+    result.p99 = percentile(all, 99);
+    result.max = all.empty() ? 0 : all.back();
+    return result;
+}
+
+// ========================================
+// RÉSULTATS
+// ========================================
+static bool writeResults(const char* path, const Options& options, const std::vector<RouteResult>& results) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "{\n  \"target\": \"%s:%u\",\n  \"concurrency\": %d,\n  \"keep_alive\": %s,\n"
+                  "  \"duration_s\": %.2f,\n  \"routes\": [\n",
+            options.host ? options.host : "in-process", options.port, options.concurrency,
+            options.keepAlive ? "true" : "false", options.duration);
+    for (size_t i = 0; i < results.size(); i++) {
+        const RouteResult& r = results[i];
+        fprintf(file, "    {\"route\": \"%s\", \"requests\": %lu, \"errors\": %lu, "
+                      "\"rps\": %.1f, \"p50_us\": %.1f, \"p95_us\": %.1f, \"p99_us\": %.1f, "
+                      "\"max_us\": %.1f}%s\n",
+                r.name.c_str(), r.requests, r.errors, r.throughput(),
+                r.p50, r.p95, r.p99, r.max, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+// Retourne le nombre de routes en régression (p99 plus lent ou débit plus
+// faible de plus de maxRegression %)
+static int compareBaseline(const char* path, double maxRegression, const std::vector<RouteResult>& results) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "baseline illisible : %s\n", path);
+        return -1;
+    }
+    std::string text;
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) text.append(chunk, n);
+    fclose(file);
+
+    DynamicJsonDocument doc(16384);
+    if (deserializeJson(doc, text.c_str(), text.size())) {
+        fprintf(stderr, "baseline invalide : %s\n", path);
+        return -1;
+    }
+
+    printf("\n%-38s %12s %12s\n", "comparaison a la baseline", "p99", "debit");
+    int regressions = 0;
+    JsonArray baseRoutes = doc["routes"];
+    for (size_t i = 0; i < results.size(); i++) {
+        const RouteResult& r = results[i];
+        for (JsonVariant base : baseRoutes) {
+            if (base["route"] != r.name.c_str()) continue;
+            double baseP99 = base["p99_us"].as<double>();
+            double baseRps = base["rps"].as<double>();
+            double p99Delta = baseP99 > 0 ? (r.p99 - baseP99) * 100.0 / baseP99 : 0;
+            double rpsDelta = baseRps > 0 ? (r.throughput() - baseRps) * 100.0 / baseRps : 0;
+            bool regressed = p99Delta > maxRegression || -rpsDelta > maxRegression;
+            if (regressed) regressions++;
+            printf("%-38s %+11.1f%% %+11.1f%%%s\n", r.name.c_str(), p99Delta, rpsDelta,
+                   regressed ? "  REGRESSION" : "");
+        }
+    }
+    return regressions;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: bench_http_load [--host IP] [--port N] [--concurrency N] [--duration S]\n"
+            "                       [--close] [--route CHEMIN]... [--out FICHIER]\n"
+            "                       [--baseline FICHIER] [--max-regression POURCENT]\n");
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    options.host = NULL;
+    options.port = 0;
+    options.concurrency = 4;
+    options.duration = 1.0;
+    options.keepAlive = true;
+    options.out = NULL;
+    options.baseline = NULL;
+    options.maxRegression = 20;
+
+    for (int i = 1; i < argc; i++) {
+        const char* option = argv[i];
+        if (strcmp(option, "--close") == 0) {
+            options.keepAlive = false;
+            continue;
+        }
+        if (i + 1 >= argc) { usage(); return 2; }
+        const char* value = argv[++i];
+        if (strcmp(option, "--host") == 0) options.host = value;
+        else if (strcmp(option, "--port") == 0) options.port = (uint16_t)atoi(value);
+        else if (strcmp(option, "--concurrency") == 0) options.concurrency = std::max(1, atoi(value));
+        else if (strcmp(option, "--duration") == 0) options.duration = atof(value);
+        else if (strcmp(option, "--route") == 0) options.only.push_back(value);
+        else if (strcmp(option, "--out") == 0) options.out = value;
+        else if (strcmp(option, "--baseline") == 0) options.baseline = value;
+        else if (strcmp(option, "--max-regression") == 0) options.maxRegression = atof(value);
+        else { usage(); return 2; }
+    }
+
+    hal::setSerialEnabled(false);
+
+    // Serveur dans le processus : le firmware tel qu'il tourne sur la carte
+    hal::setAnalogWaveform(TEMP_SENSOR_PIN, hal::Waveform::sine(2200, 200, 10000).noise(8));
+    hal::setAnalogWaveform(LDR_PIN, hal::Waveform::sine(1800, 1200, 20000).noise(8));
+    SocketHttpServer server(0);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+    static SensorHistory history;
+    FlashLog flashLog(&LittleFS);
+    TelemetryPolicy telemetry;
+    std::atomic<bool> serving(false);
+    std::thread serverThread;
+
+    if (!options.host) {
+        tempSensor.begin();
+        lightSensor.begin();
+        led.begin();
+        sampler.begin();
+        // Historique plein : pire cas de /history
+        for (uint32_t i = 0; i < HISTORY_CAPACITY; i++) {
+            history.record(22.0f + (i % 50) / 10.0f, (int)(i % 4096), i % 3 == 0, i * HISTORY_INTERVAL);
+        }
+        api.setHistory(&history);
+        // Journal flash d'une journée dans un répertoire temporaire
+        char fsRoot[] = "/tmp/ttgo_bench_http_XXXXXX";
+        hal::setFsRoot(mkdtemp(fsRoot));
+        LittleFS.begin(true);
+        LittleFS.format();
+        flashLog.begin();
+        for (uint32_t i = 0; i < 86400 / 60; i++) {
+            flashLog.record(22.0f + (i % 50) / 10.0f, (int)(i % 4096), i % 3 == 0, FLASHLOG_MIN_EPOCH + i * 60);
+        }
+        flashLog.flush();
+        api.setFlashLog(&flashLog);
+        api.setTelemetryPolicy(&telemetry);
+        api.begin();
+        server.setPollTimeout(1);
+        options.port = server.port();
+        serving = true;
+        serverThread = std::thread([&]() { while (serving) server.handleClient(); });
+    } else if (!options.port) {
+        options.port = 80;
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options.port);
+    const char* host = options.host ? options.host : "127.0.0.1";
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+        struct hostent* entry = gethostbyname(host);
+        if (!entry) {
+            fprintf(stderr, "hote inconnu : %s\n", host);
+            return 2;
+        }
+        memcpy(&addr.sin_addr, entry->h_addr_list[0], sizeof(addr.sin_addr));
+    }
+
+    printf("cible %s:%u, %d connexions, %s, %.1f s par route\n", host, options.port,
+           options.concurrency, options.keepAlive ? "keep-alive" : "une connexion par requete",
+           options.duration);
+    printf("%-38s %8s %6s %9s %9s %9s %9s %9s\n",
+           "route", "requetes", "erreurs", "req/s", "p50 us", "p95 us", "p99 us", "max us");
+
+    std::vector<RouteResult> results;
+    for (size_t i = 0; i < sizeof(routes) / sizeof(routes[0]); i++) {
+        const Route& route = routes[i];
+        if (!options.only.empty()) {
+            std::string path = route.path;
+            path = path.substr(0, path.find('?'));
+            if (std::find(options.only.begin(), options.only.end(), path) == options.only.end()) continue;
+        }
+        RouteResult r = runRoute(route, addr, options);
+        printf("%-38s %8lu %6lu %9.0f %9.0f %9.0f %9.0f %9.0f\n", r.name.c_str(), r.requests,
+               r.errors, r.throughput(), r.p50, r.p95, r.p99, r.max);
+        results.push_back(r);
+    }
+
+    if (serving) {
+        serving = false;
+        serverThread.join();
+        sampler.stop();
+    }
+
+    if (options.out && !writeResults(options.out, options, results)) {
+        fprintf(stderr, "ecriture impossible : %s\n", options.out);
+        return 2;
+    }
+    if (options.baseline) {
+        int regressions = compareBaseline(options.baseline, options.maxRegression, results);
+        if (regressions != 0) return regressions < 0 ? 2 : 1;
+    }
+
+    unsigned long errors = 0;
+    for (size_t i = 0; i < results.size(); i++) errors += results[i].errors;
+    return errors == 0 ? 0 : 1;
+}
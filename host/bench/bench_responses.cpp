@@ -0,0 +1,96 @@
+// bench_responses.cpp
+// Allocations tas et temps de réponse par route de RestAPI (WebServer simulé)
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "RestAPI.h"
+
+// ========================================
+// COMPTAGE DES ALLOCATIONS
+// ========================================
+static unsigned long allocations = 0;
+static bool counting = false;
+
+void* operator new(size_t size) {
+    if (counting) allocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+struct Route {
+    HTTPMethod method;
+    const char* uri;
+    const char* query;
+};
+
+static const Route routes[] = {
+    { HTTP_GET,     "/sensors",             "" },
+    { HTTP_GET,     "/sensors/temperature", "" },
+    { HTTP_GET,     "/sensors/light",       "" },
+    { HTTP_POST,    "/led/on",              "" },
+    { HTTP_POST,    "/led/off",             "" },
+    { HTTP_POST,    "/led/toggle",          "" },
+    { HTTP_POST,    "/threshold/set",       "temp=30&light=50" },
+    { HTTP_GET,     "/threshold",           "" },
+    { HTTP_POST,    "/mode/set",            "mode=MANUEL" },
+    { HTTP_GET,     "/status",              "" },
+    { HTTP_OPTIONS, "/status",              "" },
+    { HTTP_GET,     "/inconnue",            "" },
+};
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::setAnalogSource([](uint8_t pin) { return pin == TEMP_SENSOR_PIN ? 2200 : 1800; });
+
+    WebServer server(80);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+
+    tempSensor.begin();
+    lightSensor.begin();
+    led.begin();
+    sampler.sampleOnce();
+    api.begin();
+
+    const int iterations = 20000;
+    printf("%-8s %-22s %6s %8s %10s\n", "methode", "route", "octets", "alloc/req", "ns/req");
+
+    for (size_t r = 0; r < sizeof(routes) / sizeof(routes[0]); r++) {
+        const Route& route = routes[r];
+        // Échauffement : capacités du stand-in réservées
+        for (int i = 0; i < 10; i++) server.request(route.method, route.uri, route.query);
+
+        allocations = 0;
+        counting = true;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) server.request(route.method, route.uri, route.query);
+        double ns = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start).count() / iterations;
+        counting = false;
+
+        const HostHttpResponse& res = server.lastResponse();
+        printf("%-8s %-22s %6zu %9.1f %10.0f\n",
+               route.method == HTTP_GET ? "GET" : route.method == HTTP_POST ? "POST" : "OPTIONS",
+               route.uri, res.body.size(), (double)allocations / iterations, ns);
+    }
+    return 0;
+}
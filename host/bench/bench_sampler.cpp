@@ -0,0 +1,78 @@
+// bench_sampler.cpp
+// Latence du chemin "handler HTTP" : lecture ADC directe vs snapshot du sampler
+
+#include <Arduino.h>
+#include <chrono>
+#include <stdio.h>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "SensorSampler.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedUs(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::setAnalogSource([](uint8_t pin) {
+        // Fausse source : NTC vers 22°C, photorésistance qui varie lentement
+        if (pin == TEMP_SENSOR_PIN) return 2200 + (int)(millis() % 7);
+        return 1500 + (int)(millis() / 10 % 200);
+    });
+
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    tempSensor.begin();
+    lightSensor.begin();
+
+    // ========================================
+    // AVANT : lecture synchrone comme handleGetStatus()
+    // ========================================
+    const int directRuns = 20;
+    double directTotal = 0;
+    double directMax = 0;
+    hal::resetCounters();
+    for (int i = 0; i < directRuns; i++) {
+        Clock::time_point start = Clock::now();
+        volatile float t = tempSensor.readTemperature();
+        volatile int raw = lightSensor.readValue();
+        volatile int pct = lightSensor.readPercent();
+        (void)t; (void)raw; (void)pct;
+        double us = elapsedUs(start);
+        directTotal += us;
+        if (us > directMax) directMax = us;
+    }
+    unsigned long directReads = hal::analogReadCount();
+
+    // ========================================
+    // APRÈS : snapshot publié par le sampler
+    // ========================================
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    sampler.begin();
+
+    const int snapshotRuns = 1000000;
+    double snapshotMax = 0;
+    Clock::time_point all = Clock::now();
+    for (int i = 0; i < snapshotRuns; i++) {
+        Clock::time_point start = Clock::now();
+        volatile SensorSnapshot snap = sampler.getSnapshot();
+        (void)snap;
+        double us = elapsedUs(start);
+        if (us > snapshotMax) snapshotMax = us;
+    }
+    double snapshotTotal = elapsedUs(all);
+    SensorSnapshot last = sampler.getSnapshot();
+    sampler.stop();
+
+    printf("Chemin handler /status\n");
+    printf("  lecture directe : moy %10.1f us  max %10.1f us  (%lu analogRead / requete)\n",
+           directTotal / directRuns, directMax, directReads / directRuns);
+    printf("  snapshot        : moy %10.3f us  max %10.1f us  (0 analogRead / requete)\n",
+           snapshotTotal / snapshotRuns, snapshotMax);
+    printf("  acquisitions publiees pendant la mesure : %u\n", (unsigned)last.sequence);
+    return 0;
+}
@@ -0,0 +1,37 @@
+// bench_thermistor.cpp
+// Conversions ADC → °C par seconde : Steinhart-Hart avec log() vs table
+
+#include <Arduino.h>
+#include <chrono>
+#include <stdio.h>
+
+#include "config.h"
+#include "TemperatureControl.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int ROUNDS = 2000;
+
+template <typename F>
+static void run(const char* name, F convert) {
+    volatile float sink = 0;
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int adc = 0; adc < 4096; adc++) sink = convert(adc);
+    }
+    double s = std::chrono::duration<double>(Clock::now() - start).count();
+    printf("  %-16s %8.1f M conversions/s\n", name, ROUNDS * 4096.0 / s / 1e6);
+    (void)sink;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+
+    TemperatureControl sensor(TEMP_SENSOR_PIN);
+    sensor.begin();
+
+    printf("Conversion ADC -> C (%d points de table, pas %d)\n", TEMP_LUT_SIZE, TEMP_LUT_STEP);
+    run("Steinhart-Hart", [&](int adc) { return sensor.steinhartHart(adc); });
+    run("table", [&](int adc) { return sensor.adcToCelsius(adc); });
+    return 0;
+}
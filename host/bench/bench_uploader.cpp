@@ -0,0 +1,140 @@
+// bench_uploader.cpp
+// Gigue de loop() et débit Firebase : 7 set* bloquants vs file + tâche d'envoi
+// Point d'accès RTDB local (RtdbServer) avec latence simulée
+
+#include <Arduino.h>
+#include <Firebase_ESP_Client.h>
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+#include "config.h"
+#include "FirebaseUploader.h"
+#include "RtdbServer.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const unsigned long LATENCY_MS = 40;       // aller-retour simulé
+static const unsigned long UPDATE_MS = 250;       // FIREBASE_UPDATE_INTERVAL raccourci
+static const unsigned long RUN_MS = 5000;
+static const unsigned long LOOP_WORK_MS = 2;      // le reste de loop()
+
+struct Result {
+    double p50;
+    double p99;
+    double max;
+    unsigned long iterations;
+    unsigned long uploads;
+    unsigned long requests;
+};
+
+static double percentile(std::vector<double>& v, double p) {
+    std::sort(v.begin(), v.end());
+    return v[(size_t)(p * (v.size() - 1))];
+}
+
+static TelemetryRecord sample() {
+    TelemetryRecord record;
+    record.temperature = 22.5;
+    record.lightRaw = 1800;
+    record.lightPercent = 44;
+    record.led = true;
+    record.autoMode = false;
+    snprintf(record.mode, sizeof(record.mode), "MANUEL");
+    record.timestamp = millis();
+    return record;
+}
+
+static Result runLoop(RtdbServer& rtdb, FirebaseData& fbdo, FirebaseUploader* uploader) {
+    std::vector<double> durations;
+    unsigned long startRequests = rtdb.requests();
+    unsigned long uploads = 0;
+    unsigned long lastUpdate = millis() - UPDATE_MS;
+    unsigned long start = millis();
+
+    while (millis() - start < RUN_MS) {
+        Clock::time_point t0 = Clock::now();
+
+        if (millis() - lastUpdate >= UPDATE_MS) {
+            TelemetryRecord r = sample();
+            if (uploader) {
+                uploader->submit(r);
+            } else {
+                // Ancien loop() : sept allers-retours en série
+                Firebase.RTDB.setFloat(&fbdo, "/sensors/temperature", r.temperature);
+                Firebase.RTDB.setInt(&fbdo, "/sensors/lightRaw", r.lightRaw);
+                Firebase.RTDB.setInt(&fbdo, "/sensors/lightPercent", r.lightPercent);
+                Firebase.RTDB.setBool(&fbdo, "/actuators/led", r.led);
+                Firebase.RTDB.setString(&fbdo, "/settings/mode", String(r.mode));
+                Firebase.RTDB.setBool(&fbdo, "/settings/autoMode", r.autoMode);
+                Firebase.RTDB.setTimestamp(&fbdo, "/sensors/lastUpdate");
+                uploads++;
+            }
+            lastUpdate = millis();
+        }
+        delay(LOOP_WORK_MS);
+
+        durations.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+    }
+
+    if (uploader) {
+        while (uploader->pending()) delay(5);
+        delay(LATENCY_MS * 2);
+        uploads = uploader->getSent();
+    }
+
+    Result result;
+    result.iterations = durations.size();
+    result.max = *std::max_element(durations.begin(), durations.end());
+    result.p50 = percentile(durations, 0.50);
+    result.p99 = percentile(durations, 0.99);
+    result.uploads = uploads;
+    result.requests = rtdb.requests() - startRequests;
+    return result;
+}
+
+static void print(const char* name, const Result& r) {
+    printf("%-12s %7lu %8.2f %8.2f %8.2f %8lu %8lu\n", name, r.iterations,
+           r.p50, r.p99, r.max, r.uploads, r.requests);
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+
+    RtdbServer rtdb;
+    uint16_t port = rtdb.start(LATENCY_MS);
+    if (!port) {
+        printf("RtdbServer: echec de demarrage\n");
+        return 1;
+    }
+    Firebase.setEndpoint("127.0.0.1", port);
+
+    FirebaseData fbdo;
+    printf("latence %lu ms, envoi toutes les %lu ms, %lu ms de mesure\n",
+           LATENCY_MS, UPDATE_MS, RUN_MS);
+    printf("%-12s %7s %8s %8s %8s %8s %8s\n",
+           "", "iter", "p50 ms", "p99 ms", "max ms", "envois", "requetes");
+
+    Result sequential = runLoop(rtdb, fbdo, 0);
+    print("sequentiel", sequential);
+
+    FirebaseData uploaderFbdo;
+    FirebaseUploader uploader(&uploaderFbdo);
+    uploader.begin();
+    Result background = runLoop(rtdb, fbdo, &uploader);
+    uploader.stop();
+    print("uploader", background);
+
+    // Lien plus lent que la période : la file fusionne puis refuse
+    rtdb.setLatency(UPDATE_MS * 4);
+    FirebaseUploader slow(&uploaderFbdo);
+    slow.begin();
+    Result saturated = runLoop(rtdb, fbdo, &slow);
+    slow.stop();
+    print("lien lent", saturated);
+    printf("lien lent : %lu fusionnes, %lu refuses\n", slow.getCoalesced(), slow.getRejected());
+
+    rtdb.stop();
+    return 0;
+}
@@ -0,0 +1,138 @@
+// ttgo_sim.cpp
+// Le sketch complet (TTGO_IoT_REST_API.ino) compilé pour Linux : setup()
+// puis loop() sur le HAL simulé, API REST servie sur HTTP_PORT, capteurs
+// pilotés par des formes d'onde scriptées.
+//
+//   ttgo_sim --temp sine:2200:300:60000 --light csv:lumiere.csv \
+//            --speed 10 --duration 600 --rtdb 80 --press-right 5000
+//
+// LittleFS : répertoire ./littlefs (--fs DIR), conservé d'un lancement à
+// l'autre comme la partition de la carte.
+//
+// Formes (unités ADC brutes) : const:V, sine:moy:amp:periode,
+// ramp:de:a:duree, square:bas:haut:periode, csv:fichier (ms,valeur)
+
+#include <Arduino.h>
+#include <algorithm>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Waveform.h"
+#include "RtdbServer.h"
+#include "FS.h"
+
+// Prototypes que l'IDE Arduino génère pour le sketch
+struct Button;
+bool buttonPressed(Button& button);
+void taskSensors();
+void taskButtons();
+void taskAutoMode();
+void taskFirebase();
+void taskDisplay();
+void taskStats();
+void taskLogFlush();
+void taskHistory();
+
+#include "TTGO_IoT_REST_API.ino"
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void onSignal(int) { interrupted = 1; }
+
+static void usage() {
+    fprintf(stderr,
+            "usage: ttgo_sim [--temp FORME] [--light FORME] [--noise N]\n"
+            "                [--speed X] [--duration S] [--rtdb LATENCE_MS]\n"
+            "                [--press-left MS]... [--press-right MS]... [--fs DIR]\n");
+}
+
+// Appui de 150 ms (niveau bas) à chaque instant demandé
+static void scriptPresses(uint8_t pin, std::vector<unsigned long> times) {
+    std::vector<std::pair<unsigned long, int> > events;
+    std::sort(times.begin(), times.end());
+    for (size_t i = 0; i < times.size(); i++) {
+        events.push_back(std::make_pair(times[i], (int)LOW));
+        events.push_back(std::make_pair(times[i] + 150, (int)HIGH));
+    }
+    hal::scriptDigitalInput(pin, events);
+}
+
+int main(int argc, char** argv) {
+    const char* tempSpec = "sine:2200:200:60000";
+    const char* lightSpec = "sine:1800:1200:120000";
+    float noise = 8;
+    double speed = 1.0;
+    unsigned long duration = 0;
+    long rtdbLatency = -1;
+    std::vector<unsigned long> leftPresses;
+    std::vector<unsigned long> rightPresses;
+
+    for (int i = 1; i < argc; i++) {
+        const char* option = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) { usage(); return 2; }
+        i++;
+        if (strcmp(option, "--temp") == 0) tempSpec = value;
+        else if (strcmp(option, "--light") == 0) lightSpec = value;
+        else if (strcmp(option, "--noise") == 0) noise = atof(value);
+        else if (strcmp(option, "--speed") == 0) speed = atof(value);
+        else if (strcmp(option, "--duration") == 0) duration = strtoul(value, NULL, 10);
+        else if (strcmp(option, "--rtdb") == 0) rtdbLatency = atol(value);
+        else if (strcmp(option, "--fs") == 0) hal::setFsRoot(value);
+        else if (strcmp(option, "--press-left") == 0) leftPresses.push_back(strtoul(value, NULL, 10));
+        else if (strcmp(option, "--press-right") == 0) rightPresses.push_back(strtoul(value, NULL, 10));
+        else { usage(); return 2; }
+    }
+
+    bool tempOk;
+    bool lightOk;
+    hal::Waveform temp = hal::Waveform::parse(tempSpec, &tempOk);
+    hal::Waveform light = hal::Waveform::parse(lightSpec, &lightOk);
+    if (!tempOk || !lightOk || speed <= 0) {
+        fprintf(stderr, "forme d'onde ou vitesse invalide\n");
+        return 2;
+    }
+    hal::setAnalogWaveform(TEMP_SENSOR_PIN, temp.noise(noise, 1));
+    hal::setAnalogWaveform(LDR_PIN, light.noise(noise, 2));
+
+    // Firebase : RTDB local, sinon jamais prêt (le sketch passe en timeout)
+    RtdbServer rtdb;
+    if (rtdbLatency >= 0) {
+        Firebase.setEndpoint("127.0.0.1", rtdb.start(rtdbLatency));
+    } else {
+        Firebase.setReady(false);
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    // Démarrage accéléré : les écrans d'accueil du sketch durent ~10 s
+    hal::setTimeScale(100.0);
+    setup();
+    hal::setTimeScale(speed);
+    scriptPresses(BUTTON_LEFT, leftPresses);
+    scriptPresses(BUTTON_RIGHT, rightPresses);
+
+    unsigned long start = millis();
+    while (!interrupted && (duration == 0 || millis() - start < duration * 1000)) {
+        loop();
+        // loop() ne dort pas en mono-cœur : on rend la main au système
+        if (scheduler.msUntilNext() > 0) delay(1);
+    }
+
+    Logger::flush();
+    printf("\n%lu connexions, %lu requetes HTTP, %lu envois Firebase (%lu echecs)\n",
+           server.acceptedCount(), server.requestCount(), uploader.getSent(), uploader.getFailed());
+    for (int i = 0; i < scheduler.taskCount(); i++) {
+        const ScheduledTask* task = scheduler.task(i);
+        printf("  %-10s %8lu executions, max %6lu us, %lu periodes sautees\n",
+               task->name, task->runs, task->maxDuration, task->skipped);
+    }
+    flashLog.flush();
+    uploader.stop();
+    sampler.stop();
+    rtdb.stop();
+    return 0;
+}
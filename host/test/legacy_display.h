@@ -0,0 +1,90 @@
+// legacy_display.h
+// Ancien DisplayControl::showStatus(), recopié tel quel : référence de rendu
+
+#ifndef LEGACY_DISPLAY_H
+#define LEGACY_DISPLAY_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+static void legacyShowStatus(TFT_eSPI* _tft, float temperature, int lightPercent, bool ledState,
+                             bool wifiConnected, bool firebaseReady, String mode) {
+    _tft->fillScreen(TFT_BLACK);
+
+    _tft->setTextSize(2);
+    _tft->setTextColor(TFT_CYAN);
+    _tft->setCursor(40, 5);
+    _tft->print("TTGO IoT");
+    _tft->drawLine(0, 25, 240, 25, TFT_WHITE);
+
+    _tft->setTextSize(1);
+    _tft->setTextColor(TFT_YELLOW);
+    _tft->setCursor(10, 30);
+    _tft->print("Temp:");
+
+    _tft->setTextSize(2);
+    if(temperature < 30.0) _tft->setTextColor(TFT_GREEN);
+    else if(temperature < 35.0) _tft->setTextColor(TFT_CYAN);
+    else if(temperature < 40.0) _tft->setTextColor(TFT_ORANGE);
+    else _tft->setTextColor(TFT_RED);
+
+    _tft->setCursor(70, 28);
+    _tft->print(temperature, 1);
+    _tft->print("C");
+
+    _tft->setTextSize(1);
+    _tft->setTextColor(TFT_YELLOW);
+    _tft->setCursor(10, 52);
+    _tft->print("Lum:");
+
+    _tft->setTextSize(2);
+    if(lightPercent < 30) _tft->setTextColor(TFT_BLUE);
+    else if(lightPercent < 70) _tft->setTextColor(TFT_YELLOW);
+    else _tft->setTextColor(TFT_ORANGE);
+
+    _tft->setCursor(70, 50);
+    _tft->print(lightPercent);
+    _tft->print("%");
+
+    int barWidth = map(lightPercent, 0, 100, 0, 220);
+    uint16_t barColor = TFT_YELLOW;
+    if(lightPercent < 30) barColor = TFT_BLUE;
+    if(lightPercent > 70) barColor = TFT_ORANGE;
+    _tft->fillRect(10, 72, barWidth, 8, barColor);
+    _tft->drawRect(10, 72, 220, 8, TFT_WHITE);
+
+    _tft->setTextSize(1);
+    _tft->setCursor(10, 85);
+    _tft->setTextColor(TFT_MAGENTA);
+    _tft->print("Mode: ");
+    _tft->print(mode);
+
+    if (ledState) {
+        _tft->fillCircle(200, 90, 12, TFT_GREEN);
+        _tft->setTextColor(TFT_GREEN);
+        _tft->setTextSize(1);
+        _tft->setCursor(190, 108);
+        _tft->print("ON");
+    } else {
+        _tft->fillCircle(200, 90, 12, TFT_RED);
+        _tft->setTextColor(TFT_RED);
+        _tft->setTextSize(1);
+        _tft->setCursor(187, 108);
+        _tft->print("OFF");
+    }
+
+    _tft->setTextSize(1);
+    _tft->setCursor(10, 118);
+    if (wifiConnected && firebaseReady) {
+        _tft->setTextColor(TFT_GREEN);
+        _tft->print("WiFi+FB OK");
+    } else if (wifiConnected) {
+        _tft->setTextColor(TFT_ORANGE);
+        _tft->print("WiFi OK");
+    } else {
+        _tft->setTextColor(TFT_RED);
+        _tft->print("Hors ligne");
+    }
+}
+
+#endif
@@ -0,0 +1,90 @@
+// test_api_docs.cpp
+// /api-docs : JSON valide avec l'IP locale, 304 sur ETag connu, variante gzip
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <WiFi.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "RestAPI.h"
+#include "OpenApiSpec.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    WiFi.setLocalIP(IPAddress(10, 0, 0, 42));
+
+    WebServer server(80);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+    api.begin();
+
+    // Variante texte : chunked, URL patchée
+    const HostHttpResponse& plain = server.request(HTTP_GET, "/api-docs");
+    check(plain.code == 200, "200 sans en-tete");
+    check(plain.chunked, "transfert chunked");
+    check(plain.body.size() == OPENAPI_HEAD_LEN + strlen("http://10.0.0.42") + OPENAPI_TAIL_LEN,
+          "taille = tete + URL + suite");
+
+    DynamicJsonDocument doc(16384);
+    DeserializationError error = deserializeJson(doc, plain.body.c_str(), plain.body.size());
+    check(!error, "JSON valide");
+    check(doc["openapi"] == "3.0.0", "version OpenAPI");
+    check(doc["servers"][0]["url"] == "http://10.0.0.42", "URL du serveur = IP locale");
+    check(doc["paths"].containsKey("/status"), "route /status documentee");
+
+    const char* tag = plain.header("ETag");
+    check(tag != 0 && strstr(tag, OPENAPI_SPEC_HASH) != 0, "ETag derive du hash");
+    char etag[64];
+    snprintf(etag, sizeof(etag), "%s", tag ? tag : "");
+
+    // Revalidation
+    server.setRequestHeader("If-None-Match", etag);
+    const HostHttpResponse& cached = server.request(HTTP_GET, "/api-docs");
+    check(cached.code == 304, "304 sur If-None-Match identique");
+    check(cached.body.empty(), "304 sans corps");
+    server.clearRequestHeaders();
+
+    // Changement d'IP : l'ETag texte change
+    WiFi.setLocalIP(IPAddress(10, 0, 0, 43));
+    server.setRequestHeader("If-None-Match", etag);
+    check(server.request(HTTP_GET, "/api-docs").code == 200, "200 apres changement d'IP");
+    server.clearRequestHeaders();
+
+    // Variante gzip : blob précompressé servi tel quel
+    server.setRequestHeader("Accept-Encoding", "gzip, deflate");
+    const HostHttpResponse& gz = server.request(HTTP_GET, "/api-docs");
+    const char* encoding = gz.header("Content-Encoding");
+    check(gz.code == 200, "200 en gzip");
+    check(encoding != 0 && strcmp(encoding, "gzip") == 0, "Content-Encoding: gzip");
+    check(gz.body.size() == OPENAPI_GZ_LEN, "corps = blob gzip");
+    check(gz.body.size() > 2 && (uint8_t)gz.body[0] == 0x1f && (uint8_t)gz.body[1] == 0x8b,
+          "signature gzip");
+    check(gz.header("Vary") != 0, "Vary: Accept-Encoding");
+
+    const char* gzTag = gz.header("ETag");
+    char gzEtag[64];
+    snprintf(gzEtag, sizeof(gzEtag), "%s", gzTag ? gzTag : "");
+    check(strcmp(gzEtag, etag) != 0, "ETag distinct par variante");
+    server.setRequestHeader("If-None-Match", gzEtag);
+    check(server.request(HTTP_GET, "/api-docs").code == 304, "304 en gzip");
+
+    printf(failures ? "ECHEC (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
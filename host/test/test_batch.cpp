@@ -0,0 +1,132 @@
+// test_batch.cpp
+// POST /batch : opérations validées ensemble, rien d'appliqué si une seule
+// est invalide, réglages jamais vus à moitié appliqués par l'autre cœur
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <atomic>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+#include <thread>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "RestAPI.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+
+    WebServer server(80);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor, 10);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+    led.begin();
+    api.begin();
+
+    DynamicJsonDocument doc(1024);
+
+    // ========================================
+    // APPLICATION GROUPÉE
+    // ========================================
+    const HostHttpResponse& response = server.request(HTTP_POST, "/batch", "",
+        "[{\"cmd\":\"threshold\",\"temp\":28.5,\"light\":40},"
+        "{\"cmd\":\"mode\",\"mode\":\"manuel\"},"
+        "{\"cmd\":\"led\",\"state\":\"on\"}]");
+    check(response.code == 200 && !deserializeJson(doc, response.body.c_str(), response.body.size()),
+          "POST /batch -> 200");
+    check(doc["applied"].as<int>() == 3, "trois operations appliquees");
+    check(doc["led_state"] == "ON" && doc["mode"] == "MANUEL" &&
+          doc["temp_threshold"].as<float>() == 28.5f && doc["light_threshold"].as<int>() == 40,
+          "etat complet dans la reponse");
+    check(led.getState(), "LED allumee");
+    check(strcmp(response.header("Access-Control-Allow-Origin"), "*") == 0, "en-tetes CORS");
+
+    // ========================================
+    // TOUT OU RIEN
+    // ========================================
+    const HostHttpResponse& invalid = server.request(HTTP_POST, "/batch", "",
+        "[{\"cmd\":\"led\",\"state\":\"off\"},"
+        "{\"cmd\":\"threshold\",\"temp\":25},"
+        "{\"cmd\":\"mode\",\"mode\":\"AUTO-TEMP\"}]");
+    check(invalid.code == 400 && !deserializeJson(doc, invalid.body.c_str(), invalid.body.size()),
+          "operation invalide -> 400");
+    check(doc["index"].as<int>() == 1 && doc["message"] == "arguments invalides", "index de l'operation fautive");
+    ControlSettings settings = api.getSettings();
+    check(led.getState() && settings.tempThreshold == 28.5f && strcmp(settings.mode, "MANUEL") == 0,
+          "rien d'applique");
+
+    check(server.request(HTTP_POST, "/batch", "", "[{\"cmd\":\"fly\"}]").code == 400, "commande inconnue -> 400");
+    check(server.request(HTTP_POST, "/batch", "", "{\"cmd\":\"led\",\"state\":\"on\"}").code == 400,
+          "objet seul -> 400");
+    check(server.request(HTTP_POST, "/batch", "", "[]").code == 400, "tableau vide -> 400");
+    check(server.request(HTTP_POST, "/batch").code == 400, "sans corps -> 400");
+    std::string many = "[";
+    for (int i = 0; i <= BATCH_MAX_OPS; i++) many += std::string(i ? "," : "") + "{\"cmd\":\"state\"}";
+    many += "]";
+    check(server.request(HTTP_POST, "/batch", "", many.c_str()).code == 400, "trop d'operations -> 400");
+    check(server.request(HTTP_OPTIONS, "/batch").code == 204, "OPTIONS -> 204");
+    check(server.request(HTTP_GET, "/batch").code == 405, "GET -> 405");
+
+    // ========================================
+    // ATOMICITÉ FACE À L'AUTRE CŒUR
+    // ========================================
+    // Deux configurations cohérentes alternées ; un lecteur concurrent ne
+    // doit voir que l'une ou l'autre. Les mêmes réglages par requêtes
+    // séparées laissent voir des états intermédiaires.
+    const char* configA = "[{\"cmd\":\"threshold\",\"temp\":10,\"light\":10},{\"cmd\":\"mode\",\"mode\":\"AUTO-TEMP\"}]";
+    const char* configB = "[{\"cmd\":\"threshold\",\"temp\":90,\"light\":90},{\"cmd\":\"mode\",\"mode\":\"AUTO-LIGHT\"}]";
+    server.request(HTTP_POST, "/batch", "", configA);
+
+    std::atomic<bool> reading(true);
+    std::atomic<unsigned long> reads(0);
+    std::atomic<unsigned long> torn(0);
+    std::thread reader([&]() {
+        while (reading) {
+            api.updateAutoMode(22.0f, 44);
+            ControlSettings s = api.getSettings();
+            bool a = s.tempThreshold == 10.0f && s.lightThreshold == 10 && strcmp(s.mode, "AUTO-TEMP") == 0;
+            bool b = s.tempThreshold == 90.0f && s.lightThreshold == 90 && strcmp(s.mode, "AUTO-LIGHT") == 0;
+            if (!a && !b) torn++;
+            reads++;
+        }
+    });
+
+    bool allOk = true;
+    for (int i = 0; i < 2000; i++) {
+        allOk = allOk && server.request(HTTP_POST, "/batch", "", i % 2 ? configA : configB).code == 200;
+    }
+    unsigned long batchTorn = torn;
+    unsigned long batchReads = reads;
+
+    torn = 0;
+    reads = 0;
+    for (int i = 0; i < 2000; i++) {
+        bool toA = i % 2;
+        server.request(HTTP_POST, "/threshold/set", toA ? "temp=10&light=10" : "temp=90&light=90");
+        server.request(HTTP_POST, "/mode/set", toA ? "mode=AUTO-TEMP" : "mode=AUTO-LIGHT");
+    }
+    reading = false;
+    reader.join();
+
+    printf("      /batch : %lu lectures, %lu incoherentes ; requetes separees : %lu lectures, %lu incoherentes\n",
+           batchReads, batchTorn, (unsigned long)reads, (unsigned long)torn);
+    check(allOk, "2000 lots appliques");
+    check(batchTorn == 0, "aucun etat intermediaire visible");
+
+    printf(failures ? "ECHEC (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+// test_client.h
+// Client TCP minimal des tests sur SocketHttpServer : connexion en boucle
+// locale, tampon de réception, réponses HTTP (Content-Length ou chunked)
+// et flux ouverts (SSE, WebSocket) dont le corps reste dans pending
+
+#ifndef TEST_CLIENT_H
+#define TEST_CLIENT_H
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <strings.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+struct ClientOptions {
+    unsigned long timeoutMs;   // SO_RCVTIMEO : un recv() sans réponse échoue au lieu de bloquer le test
+    int rcvbuf;                // SO_RCVBUF, 0 : taille du système
+    bool nodelay;              // TCP_NODELAY : petites trames sans attente de Nagle
+};
+
+static const ClientOptions CLIENT_DEFAULTS = { 2000, 0, false };
+
+struct Client {
+    int fd;
+    std::string headers;   // en-têtes lus par readHeaders()
+    std::string pending;   // octets reçus au-delà de ce qui a été lu
+};
+
+struct Response {
+    int code;
+    std::string headers;
+    std::string body;
+    bool chunked;
+};
+
+// ========================================
+// CONNEXION
+// ========================================
+static inline int connectTo(uint16_t port, const ClientOptions& options = CLIENT_DEFAULTS) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (options.rcvbuf > 0) setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &options.rcvbuf, sizeof(options.rcvbuf));
+    struct timeval timeout = { (long)(options.timeoutMs / 1000), (long)(options.timeoutMs % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (options.nodelay) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static inline bool connectClient(Client& client, uint16_t port, const ClientOptions& options = CLIENT_DEFAULTS) {
+    client.fd = connectTo(port, options);
+    client.headers.clear();
+    client.pending.clear();
+    return client.fd >= 0;
+}
+
+static inline void sendRaw(Client& client, const std::string& data) {
+    ::send(client.fd, data.data(), data.size(), 0);
+}
+
+// ========================================
+// RÉCEPTION
+// ========================================
+static inline bool fill(Client& client) {
+    char buffer[2048];
+    ssize_t n = recv(client.fd, buffer, sizeof(buffer), 0);
+    if (n <= 0) return false;
+    client.pending.append(buffer, n);
+    return true;
+}
+
+// En-têtes jusqu'à la ligne vide (exclue) dans client.headers
+static inline bool readHeaders(Client& client) {
+    size_t end;
+    while ((end = client.pending.find("\r\n\r\n")) == std::string::npos) {
+        if (!fill(client)) return false;
+    }
+    client.headers = client.pending.substr(0, end + 2);
+    client.pending.erase(0, end + 4);
+    return true;
+}
+
+// Valeur d'un en-tête, vide s'il est absent
+static inline std::string headerValue(const std::string& headers, const char* name) {
+    std::string key = std::string("\r\n") + name + ":";
+    const char* found = strcasestr(headers.c_str(), key.c_str());
+    if (!found) return "";
+    found += key.size();
+    while (*found == ' ') found++;
+    return std::string(found, strcspn(found, "\r"));
+}
+
+static inline bool readResponse(Client& client, Response& response) {
+    if (!readHeaders(client)) return false;
+    response.headers = client.headers;
+    response.code = atoi(response.headers.c_str() + 9);
+    response.chunked = strcasestr(response.headers.c_str(), "Transfer-Encoding: chunked") != NULL;
+    response.body.clear();
+
+    if (!response.chunked) {
+        size_t size = strtoul(headerValue(response.headers, "Content-Length").c_str(), NULL, 10);
+        while (client.pending.size() < size) {
+            if (!fill(client)) return false;
+        }
+        response.body = client.pending.substr(0, size);
+        client.pending.erase(0, size);
+        return true;
+    }
+
+    for (;;) {
+        size_t eol;
+        while ((eol = client.pending.find("\r\n")) == std::string::npos) {
+            if (!fill(client)) return false;
+        }
+        size_t size = strtoul(client.pending.c_str(), NULL, 16);
+        while (client.pending.size() < eol + 2 + size + 2) {
+            if (!fill(client)) return false;
+        }
+        response.body.append(client.pending, eol + 2, size);
+        client.pending.erase(0, eol + 2 + size + 2);
+        if (size == 0) return true;
+    }
+}
+
+// Rien de reçu pendant ms
+static inline bool silent(Client& client, unsigned long ms) {
+    if (!client.pending.empty()) return false;
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(client.fd, &set);
+    struct timeval timeout = { (long)(ms / 1000), (long)(ms % 1000) * 1000 };
+    return select(client.fd + 1, &set, NULL, NULL, &timeout) == 0;
+}
+
+static inline bool closedByPeer(Client& client) {
+    char byte;
+    return recv(client.fd, &byte, 1, 0) == 0;
+}
+
+// ========================================
+// REQUÊTES
+// ========================================
+static inline std::string get(const char* path, const char* extra = "") {
+    return std::string("GET ") + path + " HTTP/1.1\r\nHost: test\r\n" + extra + "\r\n";
+}
+
+static inline bool request(Client& client, const std::string& raw, Response& response) {
+    sendRaw(client, raw);
+    return readResponse(client, response);
+}
+
+// Nouvelle connexion, requête, en-têtes : le corps d'un flux (événements
+// SSE, trames WebSocket) reste dans pending
+static inline bool openStream(Client& client, uint16_t port, const std::string& raw,
+                              const ClientOptions& options = CLIENT_DEFAULTS) {
+    if (!connectClient(client, port, options)) return false;
+    sendRaw(client, raw);
+    return readHeaders(client);
+}
+
+#endif
@@ -0,0 +1,273 @@
+// test_conditional.cpp
+// ETag et 304 sur /status et /threshold, version qui avance à chaque
+// changement, long-poll ?wait_for_change servi sans bloquer la boucle
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <sys/resource.h>
+#include <thread>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "SocketHttpServer.h"
+#include "RestAPI.h"
+#include "test_client.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+// Temps CPU du processus (toutes tâches), en ms
+static unsigned long cpuMs() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000UL +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+}
+
+// Numéro de version d'un ETag "boot-version[-format]"
+static unsigned long etagVersion(const char* etag) {
+    const char* dash = etag ? strchr(etag, '-') : NULL;
+    return dash ? strtoul(dash + 1, NULL, 10) : 0;
+}
+
+// ========================================
+// REQUÊTES CONDITIONNELLES
+// ========================================
+// Délai de lecture au-delà des attentes ?wait_for_change des tests
+static const ClientOptions LONG_POLL = { 5000, 0, false };
+
+struct Reply {
+    int code;
+    std::string etag;
+    std::string body;
+    unsigned long ms;
+};
+
+static void sendRequest(Client& client, const char* target, const std::string& etag = "") {
+    std::string extra = etag.empty() ? "" : "If-None-Match: " + etag + "\r\n";
+    sendRaw(client, get(target, extra.c_str()));
+}
+
+static bool readReply(Client& client, Reply& reply) {
+    unsigned long start = millis();
+    Response response;
+    if (!readResponse(client, response)) return false;
+    reply.code = response.code;
+    reply.etag = headerValue(response.headers, "ETag");
+    reply.body = response.body;
+    reply.ms = millis() - start;
+    return true;
+}
+
+static bool fetch(uint16_t port, const char* target, Reply& reply, const std::string& etag = "") {
+    Client client;
+    if (!connectClient(client, port, LONG_POLL)) return false;
+    sendRequest(client, target, etag);
+    bool ok = readReply(client, reply);
+    close(client.fd);
+    return ok;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::setAnalogSource([](uint8_t pin) { return pin == TEMP_SENSOR_PIN ? 2200 : 1800; });
+
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    tempSensor.begin();
+    lightSensor.begin();
+    led.begin();
+    sampler.sampleOnce();
+
+    // ========================================
+    // ETag ET 304 (MOTEUR WebServer)
+    // ========================================
+    {
+        WebServer server(80);
+        RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+        api.begin();
+
+        const HostHttpResponse& first = server.request(HTTP_GET, "/status");
+        std::string etag = first.header("ETag") ? first.header("ETag") : "";
+        check(first.code == 200 && etag.size() > 2 && etag[0] == '"', "/status -> ETag");
+        check(strcmp(first.header("Cache-Control"), "no-cache") == 0, "revalidation a chaque usage");
+
+        server.setRequestHeader("If-None-Match", etag.c_str());
+        const HostHttpResponse& same = server.request(HTTP_GET, "/status");
+        check(same.code == 304 && same.body.empty() && etag == same.header("ETag"), "inchange -> 304 sans corps");
+
+        server.clearRequestHeaders();
+        const HostHttpResponse& threshold = server.request(HTTP_GET, "/threshold");
+        std::string thresholdTag = threshold.header("ETag");
+        check(threshold.code == 200, "/threshold -> ETag");
+
+        led.on();
+        server.clearRequestHeaders();
+        server.setRequestHeader("If-None-Match", etag.c_str());
+        const HostHttpResponse& changed = server.request(HTTP_GET, "/status");
+        check(changed.code == 200 && changed.body.find("\"led\":true") != std::string::npos,
+              "LED -> 200 et nouvel etat");
+        check(etagVersion(changed.header("ETag")) > etagVersion(etag.c_str()), "version croissante");
+
+        // Liste d'entity-tags : comparaison faible, tag par tag
+        std::string current = changed.header("ETag");
+        std::string list = etag + ", W/" + current;
+        server.clearRequestHeaders();
+        server.setRequestHeader("If-None-Match", list.c_str());
+        check(server.request(HTTP_GET, "/status").code == 304, "perime, W/courant -> 304");
+        server.clearRequestHeaders();
+        list = etag + "," + current.substr(0, current.size() - 1) + "0\"";
+        server.setRequestHeader("If-None-Match", list.c_str());
+        check(server.request(HTTP_GET, "/status").code == 200, "aucun tag exact -> 200");
+        server.clearRequestHeaders();
+        server.setRequestHeader("If-None-Match", "*");
+        const HostHttpResponse& any = server.request(HTTP_GET, "/status");
+        check(any.code == 304 && current == any.header("ETag"), "* -> 304");
+
+        server.clearRequestHeaders();
+        server.setRequestHeader("If-None-Match", thresholdTag.c_str());
+        check(server.request(HTTP_GET, "/threshold").code == 304, "LED sans effet sur /threshold");
+        server.request(HTTP_POST, "/threshold/set", "temp=31&light=40");
+        const HostHttpResponse& newThreshold = server.request(HTTP_GET, "/threshold");
+        check(newThreshold.code == 200 && thresholdTag != newThreshold.header("ETag"), "reglage -> /threshold change");
+
+        server.clearRequestHeaders();
+        etag = server.request(HTTP_GET, "/status").header("ETag");
+        server.setRequestHeader("If-None-Match", etag.c_str());
+        server.setRequestHeader("Accept", "application/cbor");
+        const HostHttpResponse& cbor = server.request(HTTP_GET, "/status");
+        check(cbor.code == 200 && cbor.contentType == "application/cbor" && etag != cbor.header("ETag"),
+              "ETag propre a chaque format");
+
+        server.clearRequestHeaders();
+        check(server.request(HTTP_GET, "/status", "wait_for_change=abc").code == 400, "wait_for_change invalide -> 400");
+        server.setRequestHeader("If-None-Match", etag.c_str());
+        unsigned long start = millis();
+        check(server.request(HTTP_GET, "/status", "wait_for_change=2000").code == 304 && millis() - start < 500,
+              "WebServer : reponse immediate, jamais bloquante");
+        led.off();
+    }
+
+    // ========================================
+    // LONG-POLL (SocketHttpServer)
+    // ========================================
+    SocketHttpServer server(0);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+    api.begin();
+    std::atomic<bool> running(true);
+    server.setPollTimeout(5);
+    std::thread loop([&]() { while (running) api.handleClient(); });
+    uint16_t port = server.port();
+
+    Reply reply;
+    check(fetch(port, "/status", reply) && reply.code == 200 && !reply.etag.empty(), "ETag sur SocketHttpServer");
+    std::string etag = reply.etag;
+
+    // Changement pendant l'attente
+    Client client;
+    connectClient(client, port, LONG_POLL);
+    unsigned long sent = millis();
+    sendRequest(client, "/status?wait_for_change=3000", etag);
+    delay(200);
+    Reply other;
+    check(fetch(port, "/sensors", other) && other.code == 200 && other.ms < 100, "API servie pendant l'attente");
+    led.on();
+    check(readReply(client, reply) && reply.code == 200 && reply.body.find("\"led\":true") != std::string::npos,
+          "changement -> reponse 200");
+    unsigned long elapsed = millis() - sent;
+    printf("      reponse %lu ms apres l'envoi (changement a ~200 ms)\n", elapsed);
+    check(elapsed >= 150 && elapsed < 1000, "reveille par le changement, pas par le delai");
+    check(etagVersion(reply.etag.c_str()) > etagVersion(etag.c_str()), "nouvelle version");
+    etag = reply.etag;
+
+    // Connexion gardée : la requête suivante passe après la réponse différée
+    sendRequest(client, "/threshold");
+    check(readReply(client, reply) && reply.code == 200, "keep-alive apres long-poll");
+    std::string thresholdTag = reply.etag;
+
+    // Rien ne change : 304 au délai
+    sendRequest(client, "/threshold?wait_for_change=300", thresholdTag);
+    check(readReply(client, reply) && reply.code == 304 && reply.ms >= 250 && reply.ms < 1000, "delai -> 304");
+    close(client.fd);
+
+    // Sans If-None-Match : attend le prochain changement, quel qu'il soit
+    connectClient(client, port, LONG_POLL);
+    sendRequest(client, "/threshold?wait_for_change=3000");
+    delay(100);
+    Client setter;
+    connectClient(setter, port, LONG_POLL);
+    sendRaw(setter, "POST /threshold/set?temp=33&light=45 HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+    readReply(setter, other);
+    close(setter.fd);
+    check(readReply(client, reply) && reply.code == 200 && reply.body.find("\"light_threshold\":45") != std::string::npos,
+          "reglage -> attente sans ETag servie");
+    close(client.fd);
+
+    // Version déjà dépassée : réponse immédiate
+    check(fetch(port, "/status?wait_for_change=3000", reply, etag) && reply.code == 200 && reply.ms < 500,
+          "client en retard -> 200 immediat");
+
+    // Client parti pendant l'attente : entrée libérée sans réponse
+    connectClient(client, port, LONG_POLL);
+    sendRequest(client, "/status?wait_for_change=200", reply.etag);
+    delay(50);
+    close(client.fd);
+    delay(400);
+    check(fetch(port, "/status", reply) && reply.code == 200, "client parti sans effet");
+
+    // Attente suivie d'assez d'octets pour remplir le tampon : la boucle
+    // dort jusqu'au délai au lieu de tourner sur une socket illisible
+    connectClient(client, port, LONG_POLL);
+    sendRequest(client, "/status?wait_for_change=600", reply.etag);
+    std::string junk(HTTP_RX_BUFFER + 256, 'x');
+    delay(50);
+    sendRaw(client, junk);
+    unsigned long cpuStart = cpuMs();
+    bool timedOut = readReply(client, other) && other.code == 304;
+    unsigned long cpu = cpuMs() - cpuStart;
+    printf("      %lu ms de CPU pendant l'attente tampon plein\n", cpu);
+    check(timedOut && cpu < 200, "tampon plein pendant l'attente -> pas de boucle a vide");
+    close(client.fd);
+
+    // Plafond : au-delà, réponse sans attente
+    {
+        Client waiters[LONGPOLL_MAX_WAITERS + 1];
+        etag = reply.etag;
+        for (int i = 0; i <= LONGPOLL_MAX_WAITERS; i++) {
+            connectClient(waiters[i], port, LONG_POLL);
+            sendRequest(waiters[i], "/status?wait_for_change=1000", etag);
+            delay(20);
+        }
+        check(readReply(waiters[LONGPOLL_MAX_WAITERS], reply) && reply.code == 304 && reply.ms < 500,
+              "attente en trop -> reponse immediate");
+        check(fetch(port, "/sensors", other) && other.code == 200, "une connexion reste libre");
+        led.off();
+        bool all = true;
+        for (int i = 0; i < LONGPOLL_MAX_WAITERS; i++) {
+            all = all && readReply(waiters[i], reply) && reply.code == 200 && reply.ms < 500;
+        }
+        check(all, "un changement reveille toutes les attentes");
+        for (int i = 0; i <= LONGPOLL_MAX_WAITERS; i++) close(waiters[i].fd);
+    }
+
+    running = false;
+    loop.join();
+    server.stop();
+    printf(failures ? "ECHEC (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+// test_display.cpp
+// Rendu par zones : image identique à l'ancien showStatus() plein écran
+// Compilé pour chaque DISPLAY_SPRITE_DEPTH (0, 16, 8)
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "DisplayControl.h"
+#include "legacy_display.h"
+
+struct Status {
+    float temperature;
+    int lightPercent;
+    bool led;
+    bool wifi;
+    bool firebase;
+    const char* mode;
+};
+
+static const char* modes[] = { "MANUEL", "AUTO-TEMP", "AUTO-LIGHT" };
+
+// Couleur attendue à l'écran : un sprite 8 bits passe par RGB332
+static uint16_t expected(uint16_t color) {
+#if DISPLAY_SPRITE_DEPTH == 8
+    uint8_t c = (uint8_t)(((color & 0xE000) >> 8) | ((color & 0x0700) >> 6) | ((color & 0x0018) >> 3));
+    uint16_t r = (c & 0xE0) >> 5, g = (c & 0x1C) >> 2, b = c & 0x03;
+    return (uint16_t)(((r * 31 / 7) << 11) | ((g * 63 / 7) << 5) | (b * 31 / 3));
+#else
+    return color;
+#endif
+}
+
+static bool sameFrame(const TFT_eSPI& panel, const TFT_eSPI& reference) {
+    size_t count = (size_t)panel.width() * panel.height();
+    for (size_t i = 0; i < count; i++) {
+        if (panel.frame()[i] != expected(reference.frame()[i])) return false;
+    }
+    return true;
+}
+
+int main() {
+    TFT_eSPI panel;
+    TFT_eSPI reference;
+    panel.setSpiFrequency(0);
+    DisplayControl display(&panel);
+    display.begin();
+    reference.init();
+    reference.setRotation(1);
+
+    srand(1234);
+    Status s = { 24.0f, 40, false, true, true, "MANUEL" };
+    int failures = 0;
+
+    for (int step = 0; step < 2000; step++) {
+        // Dérive lente + changements discrets occasionnels
+        s.temperature += (rand() % 5 - 2) * 0.07f;
+        if (s.temperature < -5) s.temperature = -5;
+        if (s.temperature > 60) s.temperature = 60;
+        int light = s.lightPercent + rand() % 7 - 3;
+        s.lightPercent = constrain(light, 0, 100);
+        if (rand() % 20 == 0) s.led = !s.led;
+        if (rand() % 50 == 0) s.wifi = !s.wifi;
+        if (rand() % 50 == 0) s.firebase = !s.firebase;
+        if (rand() % 40 == 0) s.mode = modes[rand() % 3];
+
+        // Un message plein écran doit forcer un redessin complet ensuite
+        if (step % 500 == 250) display.showMessage("Test", "Message", TFT_CYAN);
+
+        // Mise à jour suivante seulement une fois le DMA précédent terminé
+        while (display.isBusy()) delay(1);
+        display.showStatus(s.temperature, s.lightPercent, s.led, s.wifi, s.firebase, s.mode);
+        legacyShowStatus(&reference, s.temperature, s.lightPercent, s.led, s.wifi, s.firebase, s.mode);
+
+        if (!sameFrame(panel, reference)) {
+            printf("ECHEC etape %d : T=%.2f L=%d LED=%d mode=%s\n",
+                   step, s.temperature, s.lightPercent, s.led, s.mode);
+            for (int y = 0; y < panel.height(); y++)
+                for (int x = 0; x < panel.width(); x++)
+                    if (panel.pixelAt(x, y) != expected(reference.pixelAt(x, y))) {
+                        printf("  premier pixel different : (%d, %d)\n", x, y);
+                        y = panel.height();
+                        break;
+                    }
+            if (++failures > 5) break;
+        }
+    }
+
+    if (failures) return 1;
+    printf("OK : 2000 mises a jour identiques au rendu plein ecran (sprite %d bits)\n",
+           DISPLAY_SPRITE_DEPTH);
+    return 0;
+}
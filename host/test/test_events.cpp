@@ -0,0 +1,211 @@
+// test_events.cpp
+// Flux SSE /events sur SocketHttpServer : état à l'abonnement, un seul
+// événement par changement pour tous les abonnés, limite d'abonnés,
+// abonné lent déconnecté sans bloquer la boucle
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+#include <strings.h>
+#include <thread>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "SocketHttpServer.h"
+#include "RestAPI.h"
+#include "test_client.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+// ========================================
+// ABONNÉ SSE
+// ========================================
+static bool subscribe(Client& s, uint16_t port) {
+    return openStream(s, port, "GET /events HTTP/1.1\r\nHost: test\r\nAccept: text/event-stream\r\n\r\n");
+}
+
+// Prochain événement (bloc terminé par une ligne vide), commentaires compris
+static bool nextEvent(Client& s, std::string& event) {
+    size_t end;
+    while ((end = s.pending.find("\n\n")) == std::string::npos) {
+        if (!fill(s)) return false;
+    }
+    event = s.pending.substr(0, end + 1);
+    s.pending.erase(0, end + 2);
+    return true;
+}
+
+static bool eventData(const std::string& event, JsonDocument& doc) {
+    size_t data = event.find("data: ");
+    return data != std::string::npos && !deserializeJson(doc, event.c_str() + data + 6);
+}
+
+static unsigned long eventId(const std::string& event) {
+    size_t id = event.find("id: ");
+    return id == std::string::npos ? 0 : strtoul(event.c_str() + id + 4, NULL, 10);
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::setAnalogSource([](uint8_t pin) { return pin == TEMP_SENSOR_PIN ? 2200 : 1800; });
+
+    SocketHttpServer server(0);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+
+    tempSensor.begin();
+    lightSensor.begin();
+    led.begin();
+    sampler.sampleOnce();
+    api.begin();
+
+    // Tâche HTTP : serveur puis publication, comme api.handleClient() du sketch
+    std::atomic<bool> running(true);
+    server.setPollTimeout(5);
+    std::thread loop([&]() { while (running) api.handleClient(); });
+
+    // ========================================
+    // ABONNEMENT
+    // ========================================
+    Client a, b;
+    check(subscribe(a, server.port()), "abonnement");
+    check(a.headers.compare(0, 15, "HTTP/1.1 200 OK") == 0, "200");
+    check(strcasestr(a.headers.c_str(), "Content-Type: text/event-stream") != NULL, "text/event-stream");
+    check(strcasestr(a.headers.c_str(), "Cache-Control: no-cache") != NULL, "no-cache");
+    check(strcasestr(a.headers.c_str(), "Content-Length") == NULL &&
+          strcasestr(a.headers.c_str(), "chunked") == NULL, "corps ouvert");
+
+    std::string event;
+    DynamicJsonDocument doc(512);
+    check(nextEvent(a, event) && event.find("retry: ") == 0, "delai de reconnexion");
+    check(eventData(event, doc) && !doc["led"].as<bool>() && doc["mode"] == "MANUEL", "etat courant a l'abonnement");
+    check(doc.containsKey("temperature") && doc.containsKey("light_percent"), "mesures dans l'evenement");
+
+    check(subscribe(b, server.port()) && nextEvent(b, event), "deuxieme abonne");
+    check(silent(a, 3 * EVENTS_MIN_INTERVAL), "rien sans changement");
+
+    // ========================================
+    // CHANGEMENTS
+    // ========================================
+    led.on();
+    std::string ea, eb;
+    check(nextEvent(a, ea) && nextEvent(b, eb), "LED -> evenement aux deux abonnes");
+    check(ea == eb, "meme evenement serialise une fois");
+    check(eventData(ea, doc) && doc["led"].as<bool>(), "LED allumee");
+    unsigned long id = eventId(ea);
+
+    // Requête ordinaire à côté des flux
+    {
+        int fd = connectTo(server.port());
+        const char* raw = "POST /mode/set?mode=AUTO-LIGHT HTTP/1.1\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        ::send(fd, raw, strlen(raw), 0);
+        char reply[512];
+        ssize_t n = recv(fd, reply, sizeof(reply) - 1, 0);
+        reply[n > 0 ? n : 0] = '\0';
+        check(strstr(reply, "200 OK") != NULL, "API servie pendant les flux");
+        close(fd);
+    }
+    check(nextEvent(a, event) && eventData(event, doc) && doc["mode"] == "AUTO-LIGHT" &&
+          doc["auto_mode"].as<bool>(), "mode -> evenement");
+    check(eventId(event) == id + 1, "identifiants consecutifs");
+    check(nextEvent(b, event) && eventId(event) == id + 1, "deuxieme abonne a jour");
+
+    // ========================================
+    // LIMITE D'ABONNÉS
+    // ========================================
+    {
+        Client extra[HTTP_MAX_STREAMS];
+        bool all = true;
+        for (int i = 2; i < HTTP_MAX_STREAMS; i++) all = all && subscribe(extra[i], server.port());
+        check(all && server.streamCount() == HTTP_MAX_STREAMS, "abonnes jusqu'a la limite");
+        Client refused;
+        check(subscribe(refused, server.port()) && refused.headers.find(" 503 ") != std::string::npos,
+              "abonne en trop -> 503");
+        close(refused.fd);
+        for (int i = 2; i < HTTP_MAX_STREAMS; i++) close(extra[i].fd);
+        unsigned long start = millis();
+        while (server.streamCount() > 2 && millis() - start < 2000) delay(5);
+        check(server.streamCount() == 2, "abonnes partis liberes");
+    }
+
+    // ========================================
+    // ABONNÉ LENT
+    // ========================================
+    running = false;
+    loop.join();
+    {
+        // Fenêtre de réception minimale et jamais lue
+        const ClientOptions smallWindow = { 2000, 4096, false };
+        int slow = connectTo(server.port(), smallWindow);
+        const char* raw = "GET /events HTTP/1.1\r\n\r\n";
+        ::send(slow, raw, strlen(raw), 0);
+        unsigned long start = millis();
+        while (server.streamCount() < 3 && millis() - start < 2000) server.handleClient();
+
+        // a et b lus en parallèle, diffusion directe de gros événements
+        std::atomic<bool> reading(true);
+        std::atomic<unsigned long> received(0);
+        std::thread reader([&]() {
+            char buffer[8192];
+            while (reading) {
+                ssize_t n = recv(a.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+                if (n > 0) received += n;
+                n = recv(b.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+                if (n > 0) received += n;
+                if (n <= 0) usleep(100);
+            }
+        });
+
+        std::string payload = ": " + std::string(1000, 'x') + "\n\n";
+        double worstMs = 0;
+        unsigned long sent = 0;
+        while (server.streamsDropped() == 0 && sent < 200000) {
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            server.broadcast(payload.data(), payload.size());
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            if (ms > worstMs) worstMs = ms;
+            sent++;
+            if (sent % 64 == 0) usleep(200);   // laisse le lecteur suivre
+        }
+        reading = false;
+        reader.join();
+
+        printf("      abonne lent ferme apres %lu diffusions, pire %.2f ms\n", sent, worstMs);
+        check(server.streamsDropped() == 1 && server.streamCount() == 2, "abonne lent deconnecte");
+        check(worstMs < 50, "diffusion sans attente");
+        close(slow);
+    }
+    close(a.fd);
+    close(b.fd);
+
+    // ========================================
+    // MOTEUR WebServer
+    // ========================================
+    {
+        WebServer webServer(80);
+        RestAPI sync(&webServer, &tempSensor, &lightSensor, &led, &sampler);
+        sync.begin();
+        check(webServer.request(HTTP_GET, "/events").code == 503, "WebServer sans flux -> 503");
+        check(webServer.request(HTTP_OPTIONS, "/events").code == 204, "OPTIONS -> 204");
+    }
+
+    server.stop();
+    printf(failures ? "ECHEC (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
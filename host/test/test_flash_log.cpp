@@ -0,0 +1,262 @@
+// test_flash_log.cpp
+// Journal flash : encodage delta/varint, CRC, reprise après redémarrage et
+// coupure en cours d'écriture, rotation des segments, route /history/flash
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+#include <WebServer.h>
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "FlashLog.h"
+#include "RestAPI.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+#define T0 1700000000UL
+
+// Forme déterministe : température et lumière dérivées de l'horodatage
+static float tempAt(uint32_t t) { return 20.0f + (t % 600) / 100.0f; }
+static int lightAt(uint32_t t) { return (int)((t * 7) % 4096); }
+static bool ledAt(uint32_t t) { return (t / 30) % 2 == 0; }
+
+static bool matches(const LogSample& s) {
+    return s.temp == SensorHistory::centiTemp(tempAt(s.time)) &&
+           s.light == SensorHistory::centiLight(lightAt(s.time)) &&
+           s.led == ledAt(s.time);
+}
+
+static std::vector<LogSample> readAll(FlashLog& log, uint32_t from = 0, uint32_t to = 0xFFFFFFFF,
+                                      size_t limit = 1000000) {
+    std::vector<LogSample> samples;
+    log.query(from, to, limit, [&](const LogSample& s) { samples.push_back(s); });
+    return samples;
+}
+
+static void write(FlashLog& log, uint32_t start, uint32_t count, uint32_t step = 5) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t t = start + i * step;
+        log.record(tempAt(t), lightAt(t), ledAt(t), t);
+    }
+}
+
+static void lastSegmentPath(char* path, size_t size) {
+    File dir = LittleFS.open(FLASHLOG_DIR);
+    std::string last;
+    File entry;
+    while ((entry = dir.openNextFile())) {
+        if (last.empty() || strcmp(entry.name(), last.c_str()) > 0) last = entry.name();
+    }
+    snprintf(path, size, FLASHLOG_DIR "/%s", last.c_str());
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+
+    char root[] = "/tmp/ttgo_flashlog_XXXXXX";
+    if (!mkdtemp(root)) return 1;
+    hal::setFsRoot(root);
+    check(LittleFS.begin(true), "LittleFS monte");
+
+    // ========================================
+    // CRC ET ENCODAGE
+    // ========================================
+    check(FlashLog::crc32((const uint8_t*)"123456789", 9) == 0xCBF43926, "CRC32 IEEE de reference");
+
+    {
+        FlashLog log(&LittleFS);
+        check(log.begin(), "begin sur partition vide");
+
+        write(log, T0, 10);
+        check(log.getStats().flushes == 0 && log.getStats().pending == 10, "echantillons en page RAM");
+        std::vector<LogSample> pending = readAll(log);
+        check(pending.size() == 10 && matches(pending[9]), "page RAM visible en lecture");
+
+        hal::resetFsCounters();
+        write(log, T0 + 50, 990);
+        log.flush();
+        std::vector<LogSample> all = readAll(log);
+        bool ordered = true, exact = true;
+        for (size_t i = 0; i < all.size(); i++) {
+            if (all[i].time != T0 + i * 5) ordered = false;
+            if (!matches(all[i])) exact = false;
+        }
+        check(all.size() == 1000, "1000 echantillons relus");
+        check(ordered, "horodatages restitues dans l'ordre");
+        check(exact, "valeurs exactes en virgule fixe");
+
+        FlashLogStats stats = log.getStats();
+        float perSample = (float)stats.bytes / 1000;
+        printf("      %.2f octets/echantillon, %lu enregistrements\n", perSample, (unsigned long)stats.flushes);
+        check(perSample < 5.0f, "moins de 5 octets par echantillon");
+        check(stats.flushes < 1000 / 50, "une ecriture pour ~50 echantillons ou plus");
+        check(hal::fsBytesWritten() == stats.bytesWritten, "octets ecrits comptes");
+
+        std::vector<LogSample> range = readAll(log, T0 + 100, T0 + 199);
+        check(range.size() == 20 && range[0].time == T0 + 100, "intervalle [from, to] inclusif");
+        check(readAll(log, T0, 0xFFFFFFFF, 7).size() == 7, "limite respectee");
+        check(readAll(log, T0 + 5000).empty(), "rien apres le dernier");
+
+        // Trou > 18 h : nouvel enregistrement, deltas toujours courts
+        write(log, T0 + 200000, 3);
+        std::vector<LogSample> gap = readAll(log, T0 + 100000);
+        check(gap.size() == 3 && gap[0].time == T0 + 200000 && matches(gap[2]), "long trou encode");
+        log.flush();
+    }
+
+    // ========================================
+    // REDÉMARRAGE ET COUPURE
+    // ========================================
+    {
+        FlashLog log(&LittleFS);
+        check(log.begin(), "begin apres redemarrage");
+        check(readAll(log).size() == 1003, "donnees retrouvees apres redemarrage");
+
+        // Coupure pendant l'écriture d'un enregistrement : en-tête complet,
+        // données tronquées
+        char path[64];
+        lastSegmentPath(path, sizeof(path));
+        File file = LittleFS.open(path, FILE_APPEND);
+        uint8_t torn[40] = { 0xA5, 20, 100, 0 };
+        file.write(torn, sizeof(torn));
+        file.close();
+    }
+    {
+        FlashLog log(&LittleFS);
+        check(log.begin(), "begin apres coupure");
+        FlashLogStats stats = log.getStats();
+        check(stats.corrupt == 1, "queue invalide detectee");
+        check(readAll(log).size() == 1003, "enregistrements valides conserves");
+
+        write(log, T0 + 300000, 100);
+        log.flush();
+        std::vector<LogSample> after = readAll(log, T0 + 300000);
+        check(after.size() == 100 && matches(after[99]), "ecriture reprise sur un segment neuf");
+        check(readAll(log).size() == 1103, "total apres reprise");
+    }
+
+    // ========================================
+    // ROTATION
+    // ========================================
+    {
+        LittleFS.format();
+        FlashLog log(&LittleFS);
+        log.begin();
+        uint32_t count = 60000;
+        write(log, T0, count);
+        log.flush();
+
+        FlashLogStats stats = log.getStats();
+        check(stats.segments == FLASHLOG_MAX_SEGMENTS, "nombre de segments borne");
+        check(stats.bytes <= (uint32_t)FLASHLOG_MAX_SEGMENTS * FLASHLOG_SEGMENT_SIZE, "quota respecte");
+        std::vector<LogSample> kept = readAll(log);
+        check(!kept.empty() && kept.size() < count, "plus anciens supprimes");
+        check(kept.back().time == T0 + (count - 1) * 5, "dernier echantillon conserve");
+        printf("      %u echantillons conserves sur %u Ko\n",
+               (unsigned)kept.size(), (unsigned)(stats.bytes / 1024));
+
+        uint32_t from = kept[kept.size() / 2].time;
+        std::vector<LogSample> tail = readAll(log, from);
+        check(tail.size() == kept.size() - kept.size() / 2, "from au milieu des segments");
+    }
+
+    // ========================================
+    // GET /history/flash
+    // ========================================
+    WebServer server(80);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor, 10);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+    api.begin();
+
+    {
+        check(server.request(HTTP_GET, "/history/flash").code == 503, "sans journal -> 503");
+
+        LittleFS.format();
+        FlashLog log(&LittleFS);
+        log.begin();
+        write(log, T0, 500);
+        api.setFlashLog(&log);
+
+        char query[64];
+        snprintf(query, sizeof(query), "from=%lu&to=%lu", T0 + 100, T0 + 1095);
+        const HostHttpResponse& response = server.request(HTTP_GET, "/history/flash", query);
+        check(response.code == 200 && response.chunked, "GET /history/flash -> 200 chunked");
+
+        DynamicJsonDocument doc(32768);
+        check(!deserializeJson(doc, response.body.c_str(), response.body.size()), "JSON valide");
+        check(doc["count"].as<int>() == 200 && doc["data"].size() == 200, "200 lignes");
+        check(!doc["truncated"].as<bool>(), "non tronque");
+        JsonVariant row = doc["data"][0];
+        check(row[0].as<unsigned long>() == T0 + 100, "premiere ligne a from");
+        check(lroundf(row[1].as<float>() * 100) == SensorHistory::centiTemp(tempAt(T0 + 100)), "temperature");
+        check(lroundf(row[2].as<float>() * 100) == SensorHistory::centiLight(lightAt(T0 + 100)), "lumiere");
+        check(row[3].as<int>() == (ledAt(T0 + 100) ? 1 : 0), "LED");
+
+        const HostHttpResponse& limited = server.request(HTTP_GET, "/history/flash", "limit=10");
+        DynamicJsonDocument small(4096);
+        check(!deserializeJson(small, limited.body.c_str(), limited.body.size()) &&
+              small["count"].as<int>() == 10 && small["truncated"].as<bool>(), "limit=10 -> tronque");
+
+        check(server.request(HTTP_GET, "/history/flash", "from=10&to=5").code == 400, "from > to -> 400");
+        check(server.request(HTTP_GET, "/history/flash", "limit=0").code == 400, "limit=0 -> 400");
+        check(server.request(HTTP_GET, "/history/flash", "to=x").code == 400, "to non numerique -> 400");
+        check(server.request(HTTP_OPTIONS, "/history/flash").code == 204, "OPTIONS -> 204");
+        api.setFlashLog(NULL);
+    }
+
+    // ========================================
+    // ÉCRIVAIN ET LECTEUR CONCURRENTS
+    // ========================================
+    {
+        LittleFS.format();
+        FlashLog log(&LittleFS);
+        log.begin();
+        std::atomic<bool> running(true);
+        std::atomic<unsigned long> reads(0);
+        std::atomic<unsigned long> bad(0);
+
+        std::thread reader([&]() {
+            while (running) {
+                uint32_t previous = 0;
+                log.query(0, 0xFFFFFFFF, 1000000, [&](const LogSample& s) {
+                    if (!matches(s) || s.time <= previous) bad++;
+                    previous = s.time;
+                });
+                reads++;
+            }
+        });
+
+        write(log, T0, 40000, 1);
+        running = false;
+        reader.join();
+
+        printf("      %lu lectures concurrentes\n", (unsigned long)reads);
+        check(reads > 0, "lecteur actif pendant les ecritures");
+        check(bad == 0, "ni doublon ni echantillon incoherent");
+    }
+
+    LittleFS.format();
+    rmdir(root);
+    printf("%s\n", failures == 0 ? "OK" : "ECHEC");
+    return failures == 0 ? 0 : 1;
+}
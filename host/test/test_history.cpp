@@ -0,0 +1,206 @@
+// test_history.cpp
+// Historique circulaire : virgule fixe, agrégation par tranches, écrasement
+// à capacité, route /history en chunked et lecture concurrente
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "SensorHistory.h"
+#include "RestAPI.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+static HistoryBucket buckets[HISTORY_CAPACITY];
+static size_t bucketCount;
+
+static size_t collect(SensorHistory& history, uint32_t since, uint32_t step) {
+    bucketCount = 0;
+    return history.aggregate(since, step, [](const HistoryBucket& b) {
+        buckets[bucketCount++] = b;
+    });
+}
+
+// Une seule instance : ~11,7 Ko, hors pile
+static SensorHistory history;
+
+int main() {
+    hal::setSerialEnabled(false);
+
+    // ========================================
+    // VIRGULE FIXE ET AGRÉGATION
+    // ========================================
+    {
+        history.record(21.234f, 4095, true, 1000);
+        history.record(-5.006f, 0, false, 2000);
+        history.record(23.0f, 2048, true, 3000);
+        history.record(25.0f, 1024, false, 12000);
+        check(history.size() == 4 && history.total() == 4, "quatre echantillons");
+
+        check(collect(history, 0, 1) == 4, "step 1 : une tranche par echantillon");
+        check(buckets[0].tempMin == 2123, "21.234 -> 2123 centiemes");
+        check(buckets[1].tempMin == -501, "-5.006 -> -501 centiemes");
+        check(buckets[0].lightMax == 10000 && buckets[1].lightMin == 0, "lumiere 0..10000");
+        check(buckets[2].lightMin == 5001, "2048/4095 -> 50.01 %");
+
+        check(collect(history, 0, 10000) == 2, "step 10 s : deux tranches");
+        check(buckets[0].start == 0 && buckets[1].start == 10000, "debut de tranche aligne");
+        check(buckets[0].count == 3 && buckets[1].count == 1, "effectifs par tranche");
+        check(buckets[0].tempMin == -501 && buckets[0].tempMax == 2300, "min/max temperature");
+        check(buckets[0].tempSum == 2123 - 501 + 2300, "somme temperature");
+        check(buckets[0].ledOn == 2, "LED allumee 2 fois sur 3");
+
+        check(collect(history, 2000, 1000) == 2, "since exclut t <= since");
+        check(buckets[0].start == 3000, "premier echantillon apres since");
+        check(collect(history, 12000, 1000) == 0, "rien apres le dernier");
+
+        // Texte partagé par /history, /log et la file Firebase
+        char text[16];
+        SensorHistory::formatCenti(text, sizeof(text), -501);
+        check(strcmp(text, "-5.01") == 0, "-501 -> \"-5.01\"");
+        SensorHistory::formatCenti(text, sizeof(text), -7);
+        check(strcmp(text, "-0.07") == 0, "-7 -> \"-0.07\" (signe garde)");
+        SensorHistory::formatCenti(text, sizeof(text), 10000);
+        check(strcmp(text, "100.00") == 0, "10000 -> \"100.00\"");
+    }
+
+    // ========================================
+    // ÉCRASEMENT À CAPACITÉ
+    // ========================================
+    {
+        history.clear();
+        uint32_t extra = 100;
+        for (uint32_t i = 0; i < HISTORY_CAPACITY + extra; i++) {
+            history.record(20.0f, 0, i % 2 == 0, i * 1000);
+        }
+        check(history.size() == HISTORY_CAPACITY, "taille bornee a la capacite");
+        check(history.total() == HISTORY_CAPACITY + extra, "total depuis le demarrage");
+        check(collect(history, 0, 1000) == HISTORY_CAPACITY, "plus anciens ecrases");
+        check(buckets[0].start == extra * 1000, "premier conserve = plus ancien non ecrase");
+        check(buckets[bucketCount - 1].start == (HISTORY_CAPACITY + extra - 1) * 1000, "dernier conserve");
+        check(collect(history, (extra + 9) * 1000, 1000) == HISTORY_CAPACITY - 10, "since apres rotation");
+
+        size_t total = 0;
+        collect(history, 0, 60000);
+        for (size_t i = 0; i < bucketCount; i++) total += buckets[i].count;
+        check(total == HISTORY_CAPACITY, "tranches de 60 s : tous les echantillons comptes");
+        check(buckets[1].count == 60 && buckets[1].ledOn == 30, "tranche pleine : 30/60 LED");
+
+        // Reprise par lots : since = début de la dernière tranche + step - 1
+        size_t resumed = 0;
+        uint32_t since = 0;
+        bool ordered = true;
+        size_t batch;
+        do {
+            batch = history.aggregate(since, 1000, [&](const HistoryBucket& b) {
+                if (b.start != (extra + resumed) * 1000) ordered = false;
+                resumed++;
+                since = b.start + 1000 - 1;
+            }, 7);
+        } while (batch == 7);
+        check(resumed == HISTORY_CAPACITY && ordered, "lots de 7 tranches : meme suite qu'en une fois");
+        check(history.aggregate(0, 1000, [](const HistoryBucket&) {}, 0) == 0, "maxBuckets=0 -> rien");
+    }
+
+    // ========================================
+    // GET /history
+    // ========================================
+    WebServer server(80);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor, 10);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+    api.begin();
+
+    {
+        const HostHttpResponse& missing = server.request(HTTP_GET, "/history");
+        check(missing.code == 503, "sans historique -> 503");
+
+        api.setHistory(&history);
+        const HostHttpResponse& response = server.request(HTTP_GET, "/history", "since=0&step=60000");
+        check(response.code == 200 && response.chunked, "GET /history -> 200 chunked");
+
+        DynamicJsonDocument doc(16384);
+        check(!deserializeJson(doc, response.body.c_str(), response.body.size()), "JSON valide");
+        check(doc["step"].as<long>() == 60000, "step repris");
+        check(doc["fields"].size() == 9, "neuf colonnes");
+        check(doc["data"].size() == bucketCount, "une ligne par tranche");
+        JsonVariant row = doc["data"][1];
+        check(row[0].as<long>() == (long)buckets[1].start && row[1].as<int>() == 60, "debut et effectif");
+        check(row[2].as<float>() == 20.0f && row[4].as<float>() == 20.0f, "temperature min/avg");
+        check(row[8].as<int>() == 50, "LED allumee 50 %");
+
+        // Une tranche par échantillon : bien plus qu'un appel du producteur
+        const HostHttpResponse& fine = server.request(HTTP_GET, "/history", "since=0&step=1000");
+        DynamicJsonDocument fineDoc(1 << 20);
+        check(!deserializeJson(fineDoc, fine.body.c_str(), fine.body.size()), "step 1 s : JSON valide");
+        collect(history, 0, 1000);
+        JsonVariant rows = fineDoc["data"];
+        bool same = rows.size() == bucketCount;
+        for (size_t i = 0; same && i < bucketCount; i++) {
+            same = rows[i][0].as<long>() == (long)buckets[i].start && rows[i][1].as<int>() == 1;
+        }
+        check(same, "step 1 s : toutes les tranches, dans l'ordre, sans doublon");
+
+        char query[32];
+        snprintf(query, sizeof(query), "since=%lu", (unsigned long)(HISTORY_CAPACITY + 100) * 1000);
+        const HostHttpResponse& empty = server.request(HTTP_GET, "/history", query);
+        DynamicJsonDocument emptyDoc(1024);
+        check(empty.code == 200 && !deserializeJson(emptyDoc, empty.body.c_str(), empty.body.size()) &&
+              emptyDoc["data"].size() == 0, "aucune tranche : data vide");
+
+        check(server.request(HTTP_GET, "/history", "step=0").code == 400, "step=0 -> 400");
+        check(server.request(HTTP_GET, "/history", "since=abc").code == 400, "since non numerique -> 400");
+        check(server.request(HTTP_GET, "/history", "step=-5").code == 400, "step negatif -> 400");
+        check(server.request(HTTP_OPTIONS, "/history").code == 204, "OPTIONS /history -> 204");
+    }
+
+    // ========================================
+    // ÉCRIVAIN ET LECTEUR CONCURRENTS
+    // ========================================
+    // Chaque échantillon porte temp == horodatage % 1000 : une copie
+    // déchirée donnerait une tranche incohérente
+    {
+        history.clear();
+        std::atomic<bool> running(true);
+        std::atomic<unsigned long> reads(0);
+        std::atomic<unsigned long> torn(0);
+
+        std::thread reader([&]() {
+            while (running) {
+                history.aggregate(0, 1, [&](const HistoryBucket& b) {
+                    if (b.count != 1 || b.tempMin != (int16_t)(b.start % 1000) * 10) torn++;
+                });
+                reads++;
+            }
+        });
+
+        for (uint32_t t = 1; t < 200000; t++) {
+            history.record((t % 1000) / 10.0f, 0, false, t);
+        }
+        running = false;
+        reader.join();
+
+        printf("      %lu lectures concurrentes\n", (unsigned long)reads);
+        check(reads > 0, "lecteur actif pendant les ecritures");
+        check(torn == 0, "aucun echantillon incoherent");
+    }
+
+    printf("%s\n", failures == 0 ? "OK" : "ECHEC");
+    return failures == 0 ? 0 : 1;
+}
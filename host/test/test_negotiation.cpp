@@ -0,0 +1,243 @@
+// test_negotiation.cpp
+// Négociation Accept : CBOR et MessagePack octet pour octet, même document
+// que le JSON une fois décodé, JSON par défaut
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "BinaryJson.h"
+#include "RestAPI.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+// ========================================
+// DÉCODEUR DE RÉFÉRENCE (vers texte JSON)
+// ========================================
+static uint64_t readBigEndian(const uint8_t*& p, int bytes) {
+    uint64_t value = 0;
+    while (bytes--) value = (value << 8) | *p++;
+    return value;
+}
+
+static std::string number(const char* format, double value) {
+    char text[32];
+    snprintf(text, sizeof(text), format, value);
+    return text;
+}
+
+static bool decode(const uint8_t*& p, const uint8_t* end, bool cbor, std::string& out);
+
+static bool decodeItems(const uint8_t*& p, const uint8_t* end, bool cbor, std::string& out,
+                        uint64_t count, bool map) {
+    out += map ? "{" : "[";
+    for (uint64_t i = 0; i < count; i++) {
+        if (i) out += ",";
+        if (map) {
+            if (!decode(p, end, cbor, out)) return false;
+            out += ":";
+        }
+        if (!decode(p, end, cbor, out)) return false;
+    }
+    out += map ? "}" : "]";
+    return true;
+}
+
+static bool decodeText(const uint8_t*& p, const uint8_t* end, std::string& out, uint64_t len) {
+    if ((uint64_t)(end - p) < len) return false;
+    out += "\"" + std::string((const char*)p, len) + "\"";
+    p += len;
+    return true;
+}
+
+static float toFloat(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static bool decode(const uint8_t*& p, const uint8_t* end, bool cbor, std::string& out) {
+    if (p >= end) return false;
+    uint8_t b = *p++;
+    if (cbor) {
+        uint8_t major = b >> 5, info = b & 31;
+        uint64_t arg = info;
+        if (info >= 24 && info <= 27) arg = readBigEndian(p, 1 << (info - 24));
+        switch (major) {
+            case 0: out += std::to_string((unsigned long long)arg); return true;
+            case 1: out += std::to_string(-1 - (long long)arg); return true;
+            case 3: return decodeText(p, end, out, arg);
+            case 4: return decodeItems(p, end, cbor, out, arg, false);
+            case 5: return decodeItems(p, end, cbor, out, arg, true);
+            case 7:
+                if (info == 20 || info == 21) { out += info == 21 ? "true" : "false"; return true; }
+                if (info == 22) { out += "null"; return true; }
+                if (info == 26) { out += number("%.9g", toFloat((uint32_t)arg)); return true; }
+                return false;
+            default: return false;
+        }
+    }
+    if (b <= 0x7F) { out += std::to_string(b); return true; }
+    if (b >= 0xE0) { out += std::to_string((int8_t)b); return true; }
+    if ((b & 0xF0) == 0x80) return decodeItems(p, end, cbor, out, b & 0x0F, true);
+    if ((b & 0xF0) == 0x90) return decodeItems(p, end, cbor, out, b & 0x0F, false);
+    if ((b & 0xE0) == 0xA0) return decodeText(p, end, out, b & 0x1F);
+    switch (b) {
+        case 0xC0: out += "null"; return true;
+        case 0xC2: out += "false"; return true;
+        case 0xC3: out += "true"; return true;
+        case 0xCA: out += number("%.9g", toFloat((uint32_t)readBigEndian(p, 4))); return true;
+        case 0xCC: case 0xCD: case 0xCE: case 0xCF:
+            out += std::to_string((unsigned long long)readBigEndian(p, 1 << (b - 0xCC)));
+            return true;
+        case 0xD0: out += std::to_string((int8_t)readBigEndian(p, 1)); return true;
+        case 0xD1: out += std::to_string((int16_t)readBigEndian(p, 2)); return true;
+        case 0xD2: out += std::to_string((int32_t)readBigEndian(p, 4)); return true;
+        case 0xD3: out += std::to_string((long long)readBigEndian(p, 8)); return true;
+        case 0xD9: case 0xDA: case 0xDB: return decodeText(p, end, out, readBigEndian(p, 1 << (b - 0xD9)));
+        case 0xDC: return decodeItems(p, end, cbor, out, readBigEndian(p, 2), false);
+        case 0xDD: return decodeItems(p, end, cbor, out, readBigEndian(p, 4), false);
+        case 0xDE: return decodeItems(p, end, cbor, out, readBigEndian(p, 2), true);
+        case 0xDF: return decodeItems(p, end, cbor, out, readBigEndian(p, 4), true);
+        default: return false;
+    }
+}
+
+static bool decodeBody(const std::string& body, bool cbor, JsonDocument& doc) {
+    const uint8_t* p = (const uint8_t*)body.data();
+    const uint8_t* end = p + body.size();
+    std::string json;
+    return decode(p, end, cbor, json) && p == end && !deserializeJson(doc, json.c_str());
+}
+
+// Même structure, mêmes valeurs ; réels à la précision float32
+static bool sameValue(JsonVariant a, JsonVariant b) {
+    if (a.is<JsonObject>()) {
+        if (!b.is<JsonObject>() || a.size() != b.size()) return false;
+        for (JsonPair member : a.as<JsonObject>()) {
+            JsonVariant other = b[member.key().c_str()];
+            if (other.isNull() != member.value().isNull() || !sameValue(member.value(), other)) return false;
+        }
+        return true;
+    }
+    if (a.is<JsonArray>()) {
+        if (!b.is<JsonArray>() || a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (!sameValue(a[i], b[i])) return false;
+        }
+        return true;
+    }
+    if (a.is<const char*>()) return b.is<const char*>() && strcmp(a.as<const char*>(), b.as<const char*>()) == 0;
+    if (a.is<bool>()) return b.is<bool>() && a.as<bool>() == b.as<bool>();
+    if (a.is<long>() && b.is<long>()) return a.as<long>() == b.as<long>();
+    if (a.is<double>()) return b.is<double>() && fabs(a.as<double>() - b.as<double>()) <= 1e-4 * fmax(1, fabs(a.as<double>()));
+    return a.isNull() && b.isNull();
+}
+
+static bool sameBytes(const uint8_t* out, size_t len, const uint8_t* expected, size_t expectedLen) {
+    return len == expectedLen && memcmp(out, expected, len) == 0;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::setAnalogSource([](uint8_t pin) { return pin == TEMP_SENSOR_PIN ? 2200 : 1800; });
+
+    // ========================================
+    // EN-TÊTE ACCEPT
+    // ========================================
+    check(negotiateFormat("") == FORMAT_JSON, "sans Accept -> JSON");
+    check(negotiateFormat("*/*") == FORMAT_JSON, "*/* -> JSON");
+    check(negotiateFormat("application/cbor") == FORMAT_CBOR, "application/cbor");
+    check(negotiateFormat("Application/MsgPack") == FORMAT_MSGPACK, "casse ignoree");
+    check(negotiateFormat("application/x-msgpack") == FORMAT_MSGPACK &&
+          negotiateFormat("application/vnd.msgpack") == FORMAT_MSGPACK, "variantes MessagePack");
+    check(negotiateFormat("application/cbor, application/json") == FORMAT_CBOR, "premier cite a egalite");
+    check(negotiateFormat("application/json;q=0.5, application/msgpack") == FORMAT_MSGPACK, "meilleur q");
+    check(negotiateFormat("application/cbor;q=0") == FORMAT_JSON, "q=0 refuse");
+    check(negotiateFormat("text/html, application/cbor;q=0.9") == FORMAT_CBOR, "types inconnus ignores");
+
+    // ========================================
+    // ENCODAGE OCTET POUR OCTET
+    // ========================================
+    DynamicJsonDocument doc(1024);
+    deserializeJson(doc, "{\"a\":1,\"b\":[true,null],\"c\":-5,\"d\":\"x\",\"e\":1.5,\"f\":300,\"g\":-200}");
+    uint8_t out[64];
+    const uint8_t cbor[] = {
+        0xA7, 0x61, 'a', 0x01, 0x61, 'b', 0x82, 0xF5, 0xF6, 0x61, 'c', 0x24, 0x61, 'd', 0x61, 'x',
+        0x61, 'e', 0xFA, 0x3F, 0xC0, 0x00, 0x00, 0x61, 'f', 0x19, 0x01, 0x2C, 0x61, 'g', 0x38, 0xC7
+    };
+    const uint8_t msgpack[] = {
+        0x87, 0xA1, 'a', 0x01, 0xA1, 'b', 0x92, 0xC3, 0xC0, 0xA1, 'c', 0xFB, 0xA1, 'd', 0xA1, 'x',
+        0xA1, 'e', 0xCA, 0x3F, 0xC0, 0x00, 0x00, 0xA1, 'f', 0xCD, 0x01, 0x2C, 0xA1, 'g', 0xD1, 0xFF, 0x38
+    };
+    size_t len = serializeBinary(doc.as<JsonVariant>(), FORMAT_CBOR, out, sizeof(out));
+    check(sameBytes(out, len, cbor, sizeof(cbor)), "CBOR conforme (RFC 8949)");
+    len = serializeBinary(doc.as<JsonVariant>(), FORMAT_MSGPACK, out, sizeof(out));
+    check(sameBytes(out, len, msgpack, sizeof(msgpack)), "MessagePack conforme");
+    check(serializeBinary(doc.as<JsonVariant>(), FORMAT_CBOR, out, 10) == 0, "tampon trop petit -> 0");
+
+    // ========================================
+    // ROUTES
+    // ========================================
+    WebServer server(80);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+    tempSensor.begin();
+    lightSensor.begin();
+    led.begin();
+    sampler.sampleOnce();
+    api.begin();
+
+    const char* uris[] = { "/status", "/sensors", "/sensors/temperature", "/sensors/light", "/threshold" };
+    DynamicJsonDocument json(1024);
+    DynamicJsonDocument decoded(1024);
+    for (size_t i = 0; i < sizeof(uris) / sizeof(uris[0]); i++) {
+        server.clearRequestHeaders();
+        const HostHttpResponse& plain = server.request(HTTP_GET, uris[i]);
+        std::string jsonBody = plain.body;
+        bool ok = plain.contentType == "application/json" && strcmp(plain.header("Vary"), "Accept") == 0 &&
+                  !deserializeJson(json, jsonBody.c_str());
+
+        for (int f = 0; f < 2; f++) {
+            bool isCbor = f == 0;
+            server.clearRequestHeaders();
+            server.setRequestHeader("Accept", isCbor ? "application/cbor" : "application/msgpack");
+            const HostHttpResponse& binary = server.request(HTTP_GET, uris[i]);
+            char what[96];
+            snprintf(what, sizeof(what), "%s en %s : %zu octets au lieu de %zu", uris[i],
+                     isCbor ? "CBOR" : "MessagePack", binary.body.size(), jsonBody.size());
+            check(ok && binary.code == 200 && binary.contentType == (isCbor ? "application/cbor" : "application/msgpack") &&
+                  binary.body.size() < jsonBody.size() && decodeBody(binary.body, isCbor, decoded) &&
+                  sameValue(json.as<JsonVariant>(), decoded.as<JsonVariant>()), what);
+        }
+    }
+
+    server.clearRequestHeaders();
+    server.setRequestHeader("Accept", "application/cbor");
+    const HostHttpResponse& missing = server.request(HTTP_GET, "/inconnue");
+    check(missing.code == 404 && missing.contentType == "application/cbor" &&
+          decodeBody(missing.body, true, decoded) && decoded["code"].as<int>() == 404, "erreurs negociees aussi");
+    server.clearRequestHeaders();
+    server.setRequestHeader("Accept", "text/html");
+    check(server.request(HTTP_GET, "/status").contentType == "application/json", "type inconnu -> JSON");
+
+    printf(failures ? "ECHEC (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
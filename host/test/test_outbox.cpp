@@ -0,0 +1,189 @@
+// test_outbox.cpp
+// Envoi différé : arriéré accumulé hors ligne, vidage par lots du plus
+// ancien au plus récent, rythme borné, curseur persistant, /status
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <Firebase_ESP_Client.h>
+#include <LittleFS.h>
+#include <WebServer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "FlashLog.h"
+#include "FirebaseOutbox.h"
+#include "RestAPI.h"
+#include "RtdbServer.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+#define T0 1700000000UL
+
+static uint32_t nextTime = T0;
+
+static void record(FlashLog& log, FirebaseOutbox& outbox, int count) {
+    for (int i = 0; i < count; i++) {
+        log.record(21.5f, 2048, i % 2 == 0, nextTime);
+        outbox.recorded();
+        nextTime += 5;
+    }
+}
+
+// Corps JSON du dernier PATCH reçu par le RTDB local
+static bool lastBody(RtdbServer& rtdb, JsonDocument& doc, std::string* line) {
+    std::string request = rtdb.lastRequest();
+    size_t bodyStart = request.find("\r\n\r\n");
+    if (line) *line = request.substr(0, request.find("\r\n"));
+    return bodyStart != std::string::npos && !deserializeJson(doc, request.c_str() + bodyStart + 4);
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::useSimulatedClock(true);
+
+    char root[] = "/tmp/ttgo_outbox_XXXXXX";
+    if (!mkdtemp(root)) return 1;
+    hal::setFsRoot(root);
+    LittleFS.begin(true);
+
+    RtdbServer rtdb;
+    Firebase.setEndpoint("127.0.0.1", rtdb.start(0));
+    FirebaseData fbdo;
+
+    // ========================================
+    // HORS LIGNE PUIS RECONNEXION
+    // ========================================
+    {
+        FlashLog log(&LittleFS);
+        log.begin();
+        FirebaseOutbox outbox(&log, &LittleFS);
+        outbox.begin();
+        check(outbox.getStats().depth == 0, "file vide au premier demarrage");
+
+        Firebase.setReady(false);
+        record(log, outbox, 120);
+        check(outbox.getStats().depth == 120, "120 echantillons en attente hors ligne");
+        check(!outbox.drain(&fbdo) && rtdb.requests() == 0, "aucun envoi sans lien");
+
+        Firebase.setReady(true);
+        check(outbox.drain(&fbdo), "lot envoye a la reconnexion");
+        check(rtdb.requests() == 1, "un seul aller-retour par lot");
+
+        DynamicJsonDocument doc(16384);
+        std::string line;
+        check(lastBody(rtdb, doc, &line), "corps JSON valide");
+        check(line.find("PATCH " OUTBOX_PATH ".json?") == 0, "PATCH sur " OUTBOX_PATH);
+        check(doc.size() == OUTBOX_BATCH, "lot de OUTBOX_BATCH echantillons");
+        char key[16];
+        snprintf(key, sizeof(key), "%lu", T0);
+        check(doc.containsKey(key), "plus ancien en premier");
+        check(doc[key]["temp"].as<float>() == 21.5f && doc[key]["led"].as<bool>(), "valeurs du lot");
+        check(outbox.getStats().depth == 120 - OUTBOX_BATCH, "arriere decremente");
+
+        // Rythme : rien avant OUTBOX_DRAIN_INTERVAL
+        check(!outbox.drain(&fbdo) && rtdb.requests() == 1, "lot suivant retenu par le rythme");
+        hal::advanceMillis(OUTBOX_DRAIN_INTERVAL);
+        check(outbox.drain(&fbdo) && rtdb.requests() == 2, "lot suivant apres l'intervalle");
+        hal::advanceMillis(OUTBOX_DRAIN_INTERVAL);
+        check(outbox.drain(&fbdo) && rtdb.requests() == 3, "dernier lot partiel");
+        check(lastBody(rtdb, doc, NULL) && doc.size() == 120 - 2 * OUTBOX_BATCH, "reste de l'arriere");
+        check(outbox.getStats().depth == 0 && outbox.getStats().delivered == 120, "arriere vide");
+        check(outbox.cursor() == T0 + 119 * 5, "curseur au dernier livre");
+        check(LittleFS.exists(OUTBOX_CURSOR_FILE), "curseur sauvegarde a la fin de l'arriere");
+
+        // Régime établi : un lot partiel au plus tard après OUTBOX_MAX_DELAY
+        record(log, outbox, 3);
+        hal::advanceMillis(OUTBOX_DRAIN_INTERVAL);
+        check(!outbox.drain(&fbdo), "lot partiel retenu");
+        hal::advanceMillis(OUTBOX_MAX_DELAY);
+        check(outbox.drain(&fbdo) && outbox.getStats().depth == 0, "lot partiel apres le delai max");
+
+        // Lien refusé : rien de perdu, nouvel essai plus tard
+        record(log, outbox, OUTBOX_BATCH);
+        rtdb.stop();
+        hal::advanceMillis(OUTBOX_DRAIN_INTERVAL);
+        check(outbox.drain(&fbdo), "envoi tente sans serveur");
+        check(outbox.getStats().failed == 1 && outbox.getStats().depth == OUTBOX_BATCH, "echec compte, rien perdu");
+        Firebase.setEndpoint("127.0.0.1", rtdb.start(0));
+        hal::advanceMillis(OUTBOX_DRAIN_INTERVAL);
+        check(outbox.drain(&fbdo) && outbox.getStats().depth == 0, "renvoi apres retour du lien");
+        log.flush();
+    }
+
+    // ========================================
+    // REDÉMARRAGE
+    // ========================================
+    {
+        FlashLog log(&LittleFS);
+        log.begin();
+        FirebaseOutbox outbox(&log, &LittleFS);
+        outbox.begin();
+        check(outbox.getStats().depth == 0, "rien a renvoyer apres redemarrage");
+
+        // Coupure de courant avec arriéré : le curseur en flash le retrouve
+        Firebase.setReady(false);
+        record(log, outbox, 2 * OUTBOX_BATCH);
+        log.flush();
+    }
+    {
+        FlashLog log(&LittleFS);
+        log.begin();
+        FirebaseOutbox outbox(&log, &LittleFS);
+        outbox.begin();
+        check(outbox.getStats().depth == 2 * OUTBOX_BATCH, "arriere retrouve apres coupure");
+
+        Firebase.setReady(true);
+        unsigned long before = rtdb.requests();
+        hal::advanceMillis(OUTBOX_DRAIN_INTERVAL);
+        outbox.drain(&fbdo);
+        hal::advanceMillis(OUTBOX_DRAIN_INTERVAL);
+        outbox.drain(&fbdo);
+        check(rtdb.requests() - before == 2 && outbox.getStats().depth == 0, "arriere vide en deux lots");
+        check(outbox.getStats().drainRate >= 0.0f, "debit mesure");
+
+        // ========================================
+        // /status
+        // ========================================
+        WebServer server(80);
+        TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+        PhotocellControl lightSensor(LDR_PIN);
+        LedControl led(LED_PIN);
+        SensorSampler sampler(&tempSensor, &lightSensor, 10);
+        RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+        api.begin();
+
+        const HostHttpResponse& without = server.request(HTTP_GET, "/status");
+        DynamicJsonDocument doc(2048);
+        check(!deserializeJson(doc, without.body.c_str(), without.body.size()) &&
+              !doc.containsKey("outbox"), "pas d'outbox sans file");
+
+        api.setOutbox(&outbox);
+        Firebase.setReady(false);
+        record(log, outbox, 7);
+        const HostHttpResponse& response = server.request(HTTP_GET, "/status");
+        check(response.code == 200 && !deserializeJson(doc, response.body.c_str(), response.body.size()),
+              "GET /status -> 200");
+        check(doc["outbox"]["depth"].as<int>() == 7, "profondeur dans /status");
+        check(doc["outbox"]["delivered"].as<int>() == 2 * OUTBOX_BATCH, "livres dans /status");
+        check(doc["outbox"].containsKey("drain_rate"), "debit dans /status");
+        Firebase.setReady(true);
+    }
+
+    rtdb.stop();
+    LittleFS.format();
+    rmdir(root);
+    printf("%s\n", failures == 0 ? "OK" : "ECHEC");
+    return failures == 0 ? 0 : 1;
+}
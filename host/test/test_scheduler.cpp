@@ -0,0 +1,116 @@
+// test_scheduler.cpp
+// Ordonnanceur coopératif sur horloge simulée : cadence des tâches et écart
+// maximal entre deux appels de handleClient()
+
+#include <Arduino.h>
+#include <stdio.h>
+
+#include "Scheduler.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+// Durées simulées (µs) : handleClient vide, capteurs, écran, Firebase
+static const unsigned long SERVICE_US = 150;
+static unsigned long services = 0;
+static unsigned long slowUs = 30000;
+
+static void service() { services++; hal::advanceMicros(SERVICE_US); }
+static void sensors() { hal::advanceMicros(40); }
+static void display() { hal::advanceMicros(8000); }
+static void firebase() { hal::advanceMicros(300); }
+static void slow() { hal::advanceMicros(slowUs); }
+
+static void runUntil(Scheduler& scheduler, unsigned long ms) {
+    while (millis() < ms) scheduler.runOnce();
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::useSimulatedClock(true);
+
+    // ========================================
+    // CADENCE
+    // ========================================
+    {
+        Scheduler scheduler(service);
+        int s = scheduler.add("capteurs", 100, sensors);
+        int d = scheduler.add("ecran", 500, display, 20);
+        int f = scheduler.add("firebase", 5000, firebase, 40);
+        runUntil(scheduler, 10000);
+
+        // Échéances en 0, 100, ... : une exécution de plus si la dernière
+        // itération déborde sur t = 10 s
+        unsigned long sensorRuns = scheduler.task(s)->runs;
+        check(sensorRuns >= 100 && sensorRuns <= 101, "capteurs : 100 executions en 10 s");
+        check(scheduler.task(d)->runs == 20, "ecran : 20 executions en 10 s");
+        check(scheduler.task(f)->runs == 2, "firebase : 2 executions en 10 s");
+        check(scheduler.task(s)->skipped == 0 && scheduler.task(d)->skipped == 0, "aucune periode sautee");
+
+        // Écart max = tâche la plus longue + un service
+        unsigned long gap = scheduler.maxServiceGap();
+        printf("      ecart max entre handleClient : %lu us\n", gap);
+        check(gap <= 8000 + SERVICE_US, "ecart borne par la tache la plus longue");
+        check(scheduler.task(d)->maxDuration == 8000, "duree max mesuree");
+    }
+
+    // ========================================
+    // SURCHARGE : pas de rafale de rattrapage
+    // ========================================
+    {
+        hal::useSimulatedClock(true);
+        Scheduler scheduler(service);
+        int id = scheduler.add("lente", 10, slow);
+        runUntil(scheduler, 3000);
+
+        const ScheduledTask* task = scheduler.task(id);
+        printf("      tache 30 ms / periode 10 ms : %lu executions, %lu periodes sautees\n",
+               task->runs, task->skipped);
+        check(task->runs <= 3000 / 30 + 1, "pas d'execution en rafale");
+        check(task->skipped > 0, "retard compte en periodes sautees");
+        check(scheduler.maxServiceGap() <= slowUs + SERVICE_US, "service maintenu entre executions");
+    }
+
+    // ========================================
+    // ACTIVATION / PÉRIODE
+    // ========================================
+    {
+        hal::useSimulatedClock(true);
+        Scheduler scheduler(service);
+        int id = scheduler.add("capteurs", 100, sensors);
+        scheduler.setEnabled(id, false);
+        runUntil(scheduler, 1000);
+        check(scheduler.task(id)->runs == 0, "tache desactivee jamais executee");
+
+        scheduler.setEnabled(id, true);
+        scheduler.setPeriod(id, 250);
+        runUntil(scheduler, 2000);
+        check(scheduler.task(id)->runs == 4, "nouvelle periode appliquee");
+    }
+
+    // ========================================
+    // ATTENTE DE DÉMARRAGE
+    // ========================================
+    {
+        hal::useSimulatedClock(true);
+        Scheduler scheduler(service);
+        services = 0;
+        scheduler.serviceFor(1500);
+        check(millis() >= 1500, "serviceFor attend la duree demandee");
+        check(services >= 1500000 / SERVICE_US, "handleClient servi pendant l'attente");
+    }
+
+    // Table pleine
+    {
+        Scheduler scheduler(service);
+        for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) scheduler.add("t", 10, sensors);
+        check(scheduler.add("de trop", 10, sensors) == -1, "table pleine refusee");
+    }
+
+    printf(failures ? "ECHEC (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
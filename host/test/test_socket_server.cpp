@@ -0,0 +1,260 @@
+// test_socket_server.cpp
+// RestAPI sur SocketHttpServer, par de vraies sockets TCP : keep-alive,
+// connexions simultanées, pipelining, chunked, client lent
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+#include <thread>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "SocketHttpServer.h"
+#include "RestAPI.h"
+#include "test_client.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::setAnalogSource([](uint8_t pin) { return pin == TEMP_SENSOR_PIN ? 2200 : 1800; });
+
+    SocketHttpServer server(0);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+
+    tempSensor.begin();
+    lightSensor.begin();
+    led.begin();
+    sampler.sampleOnce();
+    api.begin();
+    check(server.port() != 0, "port ephemere attribue");
+
+    // Tâche HTTP dédiée, comme sur le cœur réseau
+    std::atomic<bool> running(true);
+    server.setPollTimeout(5);
+    std::thread loop([&]() { while (running) server.handleClient(); });
+
+    Response response;
+
+    // ========================================
+    // KEEP-ALIVE
+    // ========================================
+    {
+        Client client;
+        check(connectClient(client, server.port()), "connexion");
+        check(request(client, get("/status"), response) && response.code == 200, "GET /status -> 200");
+        check(strstr(response.headers.c_str(), "Connection: keep-alive") != NULL, "keep-alive annonce");
+
+        DynamicJsonDocument doc(1024);
+        check(!deserializeJson(doc, response.body.c_str(), response.body.size()), "JSON valide");
+        check(doc["settings"]["current_mode"] == "MANUEL", "contenu /status");
+
+        bool all = true;
+        for (int i = 0; i < 50; i++) {
+            all = all && request(client, get("/sensors/temperature"), response) && response.code == 200;
+        }
+        check(all, "50 requetes sur la meme connexion");
+        check(strstr(response.headers.c_str(), "Access-Control-Allow-Origin: *") != NULL, "en-tetes CORS");
+        close(client.fd);
+    }
+
+    // ========================================
+    // CONNEXIONS SIMULTANÉES
+    // ========================================
+    {
+        Client clients[HTTP_MAX_CLIENTS];
+        bool connected = true;
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) connected = connected && connectClient(clients[i], server.port());
+        check(connected, "connexions ouvertes en parallele");
+
+        // Requêtes entrelacées : toutes envoyées avant de lire les réponses
+        bool all = true;
+        for (int round = 0; round < 20; round++) {
+            for (int i = 0; i < HTTP_MAX_CLIENTS; i++) sendRaw(clients[i], get("/status"));
+            for (int i = 0; i < HTTP_MAX_CLIENTS; i++) {
+                all = all && readResponse(clients[i], response) && response.code == 200;
+            }
+        }
+        check(all, "requetes entrelacees sur toutes les connexions");
+        for (int i = 0; i < HTTP_MAX_CLIENTS; i++) close(clients[i].fd);
+    }
+
+    // ========================================
+    // PIPELINING, ARGUMENTS, CORPS
+    // ========================================
+    {
+        Client client;
+        connectClient(client, server.port());
+        sendRaw(client, get("/sensors") + get("/threshold") + get("/inconnue"));
+        Response a, b, c;
+        check(readResponse(client, a) && a.code == 200 && strstr(a.body.c_str(), "NTC 10k"), "pipeline 1 : /sensors");
+        check(readResponse(client, b) && b.code == 200 && strstr(b.body.c_str(), "temp_threshold"), "pipeline 2 : /threshold");
+        check(readResponse(client, c) && c.code == 404, "pipeline 3 : 404");
+
+        request(client, "POST /threshold/set?temp=28.5&light=40 HTTP/1.1\r\nContent-Length: 0\r\n\r\n", response);
+        check(response.code == 200 && strstr(response.body.c_str(), "\"temp_threshold\":28.5"), "arguments de la query");
+
+        const char* form = "mode=auto-temp";
+        char raw[256];
+        snprintf(raw, sizeof(raw), "POST /mode/set HTTP/1.1\r\nContent-Type: application/x-www-form-urlencoded\r\n"
+                 "Content-Length: %zu\r\n\r\n%s", strlen(form), form);
+        request(client, raw, response);
+        check(response.code == 200 && api.getCurrentMode() == "AUTO-TEMP", "arguments du corps (formulaire)");
+
+        request(client, "OPTIONS /status HTTP/1.1\r\n\r\n", response);
+        check(response.code == 204 && response.body.empty(), "OPTIONS -> 204 sans corps");
+        close(client.fd);
+    }
+
+    // ========================================
+    // TABLE DES ROUTES
+    // ========================================
+    {
+        Client client;
+        connectClient(client, server.port());
+        request(client, "OPTIONS /api-docs HTTP/1.1\r\n\r\n", response);
+        check(response.code == 204 && strstr(response.headers.c_str(), "Access-Control-Allow-Methods: ") != NULL,
+              "pre-vol generique sur une route de la table");
+        request(client, "OPTIONS /inconnue HTTP/1.1\r\n\r\n", response);
+        check(response.code == 404, "pre-vol chemin inconnu -> 404");
+
+        request(client, get("/led/on"), response);
+        check(response.code == 405 && strcasestr(response.headers.c_str(), "Allow: POST, OPTIONS\r\n") != NULL,
+              "mauvaise methode -> 405 + Allow");
+        const char* first = strstr(response.headers.c_str(), "Access-Control-Allow-Origin");
+        check(first && !strstr(first + 1, "Access-Control-Allow-Origin"), "bloc CORS emis une fois");
+        check(request(client, get("/sensors/light"), response) && response.code == 200, "connexion gardee apres 405");
+        close(client.fd);
+    }
+
+    // ========================================
+    // CHUNKED ET EN-TÊTES COLLECTÉS
+    // ========================================
+    {
+        Client client;
+        connectClient(client, server.port());
+        check(request(client, get("/api-docs"), response) && response.chunked, "/api-docs en chunked");
+        DynamicJsonDocument doc(16384);
+        check(!deserializeJson(doc, response.body.c_str(), response.body.size()), "spec reassemblee valide");
+
+        const char* etag = strcasestr(response.headers.c_str(), "ETag: ");
+        std::string tag = etag ? std::string(etag + 6, strcspn(etag + 6, "\r")) : "";
+        request(client, get("/api-docs", ("If-None-Match: " + tag + "\r\n").c_str()), response);
+        check(response.code == 304, "If-None-Match collecte -> 304");
+
+        request(client, get("/api-docs", "Accept-Encoding: gzip\r\n"), response);
+        check(response.code == 200 && !response.chunked &&
+              (unsigned char)response.body[0] == 0x1f, "variante gzip");
+        close(client.fd);
+    }
+
+    // ========================================
+    // FERMETURE ET ERREURS
+    // ========================================
+    {
+        Client client;
+        connectClient(client, server.port());
+        check(request(client, get("/sensors", "Connection: close\r\n"), response) && response.code == 200,
+              "Connection: close -> reponse");
+        check(closedByPeer(client), "connexion fermee par le serveur");
+        close(client.fd);
+
+        connectClient(client, server.port());
+        std::string huge = "GET /status HTTP/1.1\r\nX-Long: " + std::string(HTTP_RX_BUFFER, 'a') + "\r\n\r\n";
+        check(request(client, huge, response) && response.code == 413, "requete trop longue -> 413");
+        close(client.fd);
+
+        // strtoul lirait -1 comme ULONG_MAX : la somme avec headerLen bouclerait
+        const char* const badLengths[] = { "-1", "+5", "0x10", "12abc", "", "99999999999999999999999" };
+        const int badCodes[] = { 400, 400, 400, 400, 400, 413 };
+        for (size_t i = 0; i < sizeof(badLengths) / sizeof(badLengths[0]); i++) {
+            connectClient(client, server.port());
+            std::string raw = std::string("POST /batch HTTP/1.1\r\nContent-Length: ") + badLengths[i] + "\r\n\r\n[]";
+            char what[80];
+            snprintf(what, sizeof(what), "Content-Length: \"%s\" -> %d", badLengths[i], badCodes[i]);
+            check(request(client, raw, response) && response.code == badCodes[i], what);
+            close(client.fd);
+        }
+
+        connectClient(client, server.port());
+        check(request(client, "BREW /status HTTP/1.1\r\n\r\n", response) && response.code == 400, "methode inconnue -> 400");
+        close(client.fd);
+    }
+
+    // ========================================
+    // CLIENT LENT
+    // ========================================
+    // Une requête à moitié reçue ne bloque pas les autres connexions
+    {
+        Client slow;
+        Client fast;
+        connectClient(slow, server.port());
+        connectClient(fast, server.port());
+        sendRaw(slow, "GET /status HTTP/1.1\r\nHo");
+
+        unsigned long start = millis();
+        check(request(fast, get("/status"), response) && response.code == 200, "client rapide servi");
+        check(millis() - start < 100, "sans attendre le client lent");
+
+        sendRaw(slow, "st: test\r\n\r\n");
+        check(readResponse(slow, response) && response.code == 200, "client lent servi a la fin");
+        close(slow.fd);
+        close(fast.fd);
+    }
+
+    // Lecteur lent de gros corps : /api-docs (plus grand que HTTP_TX_BUFFER)
+    // en rafale, jamais lu ; le corps est produit à mesure que la socket se
+    // vide, la boucle ne l'attend pas
+    {
+        const ClientOptions smallWindow = { 2000, 2048, false };
+        Client reader;
+        Client fast;
+        connectClient(reader, server.port(), smallWindow);
+        connectClient(fast, server.port());
+        const int burst = 700;   // ~5,8 Mo : au-delà des tampons du noyau (4 Mo en boucle locale)
+        std::string requests;
+        for (int i = 0; i < burst; i++) requests += get("/api-docs");
+        sendRaw(reader, requests);
+        delay(100);
+
+        unsigned long start = millis();
+        bool served = true;
+        for (int i = 0; i < 5; i++) served = served && request(fast, get("/status"), response) && response.code == 200;
+        unsigned long elapsed = millis() - start;
+        printf("      5 requetes en %lu ms pendant le lecteur bloque\n", elapsed);
+        check(served && elapsed < 200, "lecteur lent de gros corps : autres clients servis");
+
+        bool complete = true;
+        for (int i = 0; i < burst && complete; i++) {
+            DynamicJsonDocument doc(16384);
+            complete = readResponse(reader, response) && response.code == 200 &&
+                       !deserializeJson(doc, response.body.c_str(), response.body.size());
+        }
+        check(complete, "corps complets une fois lus");
+        close(reader.fd);
+        close(fast.fd);
+    }
+
+    running = false;
+    loop.join();
+    printf("      %lu connexions, %lu requetes\n", server.acceptedCount(), server.requestCount());
+    server.stop();
+
+    printf("%s\n", failures == 0 ? "OK" : "ECHEC");
+    return failures == 0 ? 0 : 1;
+}
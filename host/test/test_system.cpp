@@ -0,0 +1,140 @@
+// test_system.cpp
+// Suivi des tâches (part de CPU, /system) et réglages partagés entre le
+// cœur réseau et le cœur contrôle
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "TaskMonitor.h"
+#include "RestAPI.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+
+    // ========================================
+    // PART DE CPU SUR HORLOGE SIMULÉE
+    // ========================================
+    {
+        hal::useSimulatedClock(true);
+        TaskMonitor monitor;
+        int a = monitor.registerCurrentTask("a", CORE_NETWORK);
+        int b = monitor.registerCurrentTask("b", CORE_CONTROL);
+        check(a == 0 && b == 1 && monitor.taskCount() == 2, "enregistrement dans l'ordre");
+
+        monitor.addBusy(a, 250000);
+        monitor.addBusy(b, 50000);
+        hal::advanceMillis(1000);
+        monitor.sample();
+
+        TaskInfo info;
+        check(monitor.getTask(a, info) && info.cpuPercent == 25.0f, "25 % sur la fenetre");
+        check(monitor.getTask(b, info) && info.cpuPercent == 5.0f, "5 % sur la fenetre");
+        check(info.core == CORE_CONTROL, "coeur conserve");
+        check(info.stackFree == -1, "pile inconnue hors FreeRTOS");
+
+        // Nouvelle fenêtre sans activité
+        hal::advanceMillis(1000);
+        monitor.sample();
+        check(monitor.getTask(a, info) && info.cpuPercent == 0.0f, "fenetre suivante a 0 %");
+
+        for (int i = 2; i < TASK_MONITOR_MAX_TASKS; i++) monitor.registerCurrentTask("x", 0);
+        check(monitor.registerCurrentTask("trop", 0) == -1, "table pleine : -1");
+        check(!monitor.getTask(TASK_MONITOR_MAX_TASKS, info), "identifiant hors table refuse");
+        hal::useSimulatedClock(false);
+    }
+
+    WebServer server(80);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor, 10);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+    TaskMonitor monitor;
+
+    // ========================================
+    // GET /system
+    // ========================================
+    {
+        sampler.setMonitor(&monitor);
+        api.setMonitor(&monitor);
+        api.begin();
+        sampler.begin();
+        delay(200);
+        monitor.sample();
+
+        const HostHttpResponse& response = server.request(HTTP_GET, "/system");
+        check(response.code == 200, "GET /system -> 200");
+
+        DynamicJsonDocument doc(2048);
+        check(!deserializeJson(doc, response.body.c_str(), response.body.size()), "JSON valide");
+        JsonVariant task = doc["tasks"][0];
+        check(doc["tasks"].size() == 1, "une tache enregistree");
+        check(task["name"] == "sampler", "tache sampler");
+        check(task["core"].as<int>() == CORE_CONTROL, "sampler sur le coeur controle");
+        check(task["stack_free"].isNull(), "stack_free null sur host");
+        float cpu = task["cpu_percent"].as<float>();
+        check(cpu >= 0.0f && cpu <= 100.0f, "cpu_percent dans [0, 100]");
+
+        const HostHttpResponse& options = server.request(HTTP_OPTIONS, "/system");
+        check(options.code == 204, "OPTIONS /system -> 204");
+        check(options.header("Access-Control-Max-Age") && strcmp(options.header("Access-Control-Max-Age"), "86400") == 0 &&
+              options.header("Access-Control-Allow-Origin"), "bloc CORS decoupe pour WebServer");
+        check(server.request(HTTP_POST, "/system").code == 405, "POST /system -> 405");
+        sampler.stop();
+    }
+
+    // ========================================
+    // RÉGLAGES PARTAGÉS ENTRE DEUX TÂCHES
+    // ========================================
+    // Le handler /mode/set (cœur réseau) écrit mode + auto_mode pendant que
+    // l'autre cœur lit : chaque copie doit être cohérente
+    {
+        std::atomic<bool> running(true);
+        std::atomic<unsigned long> reads(0);
+        std::atomic<unsigned long> torn(0);
+
+        std::thread reader([&]() {
+            while (running) {
+                ControlSettings settings = api.getSettings();
+                bool manual = strcmp(settings.mode, "MANUEL") == 0;
+                bool known = manual || strcmp(settings.mode, "AUTO-TEMP") == 0 ||
+                             strcmp(settings.mode, "AUTO-LIGHT") == 0;
+                if (!known || settings.autoMode == manual) torn++;
+                reads++;
+            }
+        });
+
+        const char* modes[] = { "AUTO-TEMP", "MANUEL", "AUTO-LIGHT" };
+        char query[32];
+        for (int i = 0; i < 20000; i++) {
+            snprintf(query, sizeof(query), "mode=%s", modes[i % 3]);
+            server.request(HTTP_POST, "/mode/set", query);
+        }
+        running = false;
+        reader.join();
+
+        printf("      %lu lectures concurrentes\n", (unsigned long)reads);
+        check(reads > 0, "lecteur actif pendant les ecritures");
+        check(torn == 0, "aucune copie incoherente");
+    }
+
+    printf("%s\n", failures == 0 ? "OK" : "ECHEC");
+    return failures == 0 ? 0 : 1;
+}
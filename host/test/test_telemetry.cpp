@@ -0,0 +1,176 @@
+// test_telemetry.cpp
+// Télémétrie par exception : seuls les champs sortis de leur bande morte
+// partent, heartbeat, renvoi après échec, réglage par /telemetry/set
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <Firebase_ESP_Client.h>
+#include <WebServer.h>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "FirebaseUploader.h"
+#include "TelemetryPolicy.h"
+#include "RestAPI.h"
+#include "RtdbServer.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+static TelemetryRecord state;
+
+static void reset() {
+    state.temperature = 22.0f;
+    state.lightRaw = 1800;
+    state.lightPercent = 44;
+    state.led = false;
+    state.autoMode = false;
+    snprintf(state.mode, sizeof(state.mode), "MANUEL");
+}
+
+// Une évaluation : dépôt puis envoi éventuel, comme taskFirebase + uploader
+static bool evaluate(FirebaseUploader& uploader) {
+    state.timestamp = millis();
+    uploader.submit(state);
+    return uploader.uploadPending();
+}
+
+// Chemins du dernier PATCH, horodatage serveur exclu
+static std::string lastPaths(RtdbServer& rtdb) {
+    std::string request = rtdb.lastRequest();
+    size_t bodyStart = request.find("\r\n\r\n");
+    StaticJsonDocument<512> doc;
+    if (bodyStart == std::string::npos || deserializeJson(doc, request.c_str() + bodyStart + 4)) return "?";
+    std::string paths;
+    for (JsonPair pair : doc.as<JsonObject>()) {
+        if (strcmp(pair.key().c_str(), "sensors/lastUpdate") == 0) continue;
+        if (!paths.empty()) paths += ",";
+        paths += pair.key().c_str();
+    }
+    return paths;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::useSimulatedClock(true);
+
+    RtdbServer rtdb;
+    Firebase.setEndpoint("127.0.0.1", rtdb.start(0));
+    FirebaseData fbdo;
+    FirebaseUploader uploader(&fbdo);
+    TelemetryPolicy policy;
+    uploader.setPolicy(&policy);
+    reset();
+
+    // ========================================
+    // BANDES MORTES
+    // ========================================
+    check(evaluate(uploader) && rtdb.requests() == 1, "premier rapport");
+    check(lastPaths(rtdb) == "sensors/temperature,sensors/lightRaw,sensors/lightPercent,"
+                             "actuators/led,settings/mode,settings/autoMode", "tous les champs au depart");
+
+    hal::advanceMillis(FIREBASE_UPDATE_INTERVAL);
+    check(!evaluate(uploader) && rtdb.requests() == 1, "rien d'envoye sans changement");
+
+    state.temperature += 0.1f;
+    state.lightRaw += 40;
+    state.lightPercent += 1;
+    check(!evaluate(uploader) && rtdb.requests() == 1, "bruit sous la bande morte ignore");
+
+    // Dérive lente : comparée à la valeur envoyée, pas à la mesure précédente
+    state.temperature += 0.15f;
+    check(evaluate(uploader) && rtdb.requests() == 2, "derive cumulee envoyee");
+    check(lastPaths(rtdb) == "sensors/temperature", "seul le champ modifie");
+
+    state.led = true;
+    evaluate(uploader);
+    check(lastPaths(rtdb) == "actuators/led", "LED : tout changement");
+
+    snprintf(state.mode, sizeof(state.mode), "AUTO-TEMP");
+    state.autoMode = true;
+    evaluate(uploader);
+    check(lastPaths(rtdb) == "settings/mode,settings/autoMode", "mode : tout changement");
+
+    // ========================================
+    // HEARTBEAT
+    // ========================================
+    hal::advanceMillis(TELEMETRY_HEARTBEAT - 1);
+    check(evaluate(uploader) && lastPaths(rtdb) == "sensors/lightRaw,sensors/lightPercent",
+          "silence max atteint pour la lumiere seule");
+    unsigned long before = rtdb.requests();
+    check(!evaluate(uploader) && rtdb.requests() == before, "heartbeat rearme");
+    hal::advanceMillis(TELEMETRY_HEARTBEAT);
+    check(evaluate(uploader) && lastPaths(rtdb).find("sensors/temperature") == 0, "heartbeat general");
+
+    // ========================================
+    // ÉCHEC D'ENVOI
+    // ========================================
+    rtdb.stop();
+    state.temperature += 1.0f;
+    check(evaluate(uploader) && uploader.getFailed() == 1, "envoi refuse");
+    Firebase.setEndpoint("127.0.0.1", rtdb.start(0));
+    before = rtdb.requests();
+    check(evaluate(uploader) && rtdb.requests() == before + 1, "champ renvoye apres echec");
+    check(lastPaths(rtdb) == "sensors/temperature", "seul le champ non acquitte");
+
+    TelemetryStats stats = policy.getStats();
+    printf("      %lu evaluations, %lu rapports, %lu champs ecrits, %lu evites\n",
+           stats.evaluations, stats.updates, stats.fieldsSent, stats.fieldsSuppressed);
+    check(stats.fieldsSuppressed > stats.fieldsSent, "plus de champs evites qu'ecrits");
+
+    // ========================================
+    // /telemetry
+    // ========================================
+    WebServer server(80);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor, 10);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+    api.begin();
+
+    check(server.request(HTTP_GET, "/telemetry").code == 503, "sans politique -> 503");
+    api.setTelemetryPolicy(&policy);
+
+    const HostHttpResponse& response = server.request(HTTP_GET, "/telemetry");
+    DynamicJsonDocument doc(2048);
+    check(response.code == 200 && !deserializeJson(doc, response.body.c_str(), response.body.size()),
+          "GET /telemetry -> 200");
+    check(doc["fields"]["temperature"]["deadband"].as<float>() == TELEMETRY_TEMP_DEADBAND, "bande morte temperature");
+    check(doc["fields"]["led"]["heartbeat_ms"].as<unsigned long>() == TELEMETRY_HEARTBEAT, "heartbeat LED");
+    check(!doc["fields"]["led"].containsKey("deadband"), "pas de bande morte pour la LED");
+    check(doc["updates"].as<unsigned long>() == stats.updates, "compteurs exposes");
+
+    const HostHttpResponse& set = server.request(HTTP_POST, "/telemetry/set", "field=temperature&deadband=1.5");
+    check(set.code == 200 && !deserializeJson(doc, set.body.c_str(), set.body.size()) &&
+          doc["deadband"].as<float>() == 1.5f &&
+          doc["heartbeat_ms"].as<unsigned long>() == TELEMETRY_HEARTBEAT, "POST /telemetry/set -> 200");
+    before = rtdb.requests();
+    state.temperature += 1.0f;
+    check(!evaluate(uploader) && rtdb.requests() == before, "nouvelle bande morte appliquee");
+
+    check(server.request(HTTP_POST, "/telemetry/set", "field=led&heartbeat=0").code == 200, "heartbeat nul");
+    evaluate(uploader);
+    check(rtdb.requests() == before + 1 && lastPaths(rtdb) == "actuators/led", "LED a chaque evaluation");
+
+    check(server.request(HTTP_POST, "/telemetry/set", "field=humidity&deadband=1").code == 400, "champ inconnu -> 400");
+    check(server.request(HTTP_POST, "/telemetry/set", "field=temperature").code == 400, "aucun reglage -> 400");
+    check(server.request(HTTP_POST, "/telemetry/set", "field=temperature&deadband=-1").code == 400, "bande negative -> 400");
+    check(server.request(HTTP_POST, "/telemetry/set", "field=led&deadband=1").code == 400, "bande morte LED -> 400");
+    check(server.request(HTTP_POST, "/telemetry/set", "field=mode&heartbeat=x").code == 400, "heartbeat invalide -> 400");
+    check(server.request(HTTP_OPTIONS, "/telemetry/set").code == 204, "OPTIONS -> 204");
+
+    rtdb.stop();
+    printf(failures ? "ECHEC (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
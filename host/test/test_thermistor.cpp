@@ -0,0 +1,53 @@
+// test_thermistor.cpp
+// La table ADC → °C doit suivre l'ancienne formule à 0.05°C près sur 0-4095
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "config.h"
+#include "TemperatureControl.h"
+
+// Ancien calcul de readTemperature(), recopié tel quel (sans les logs)
+static float legacyTemperature(int adcValue) {
+    if (adcValue == 0) return 25.0;
+
+    float voltage = (adcValue / (float)ADC_MAX) * (float)ESP32_VMAX;
+    if (voltage >= (float)VREF - 0.01) voltage = (float)VREF - 0.01;
+    if (voltage < 0.1) return 25.0;
+
+    float Rth = (float)R0 * (((float)VREF - voltage) / voltage);
+    if(Rth < 100 || Rth > 200000) return 25.0;
+
+    float TempK = 1.0 / ((1.0 / (float)T0_KELVIN) + (1.0 / (float)B_COEFFICIENT) * log(Rth / (float)R_AT_25C));
+    float tempC = TempK - 273.15;
+
+    if(tempC < -10.0) tempC = 20.0;
+    if(tempC > 80.0) tempC = 40.0;
+    return tempC;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+
+    TemperatureControl sensor(TEMP_SENSOR_PIN);
+    sensor.begin();
+
+    float maxError = 0;
+    int worstAdc = 0;
+    for (int adc = 0; adc <= 4095; adc++) {
+        float error = fabs(sensor.adcToCelsius(adc) - legacyTemperature(adc));
+        if (error > maxError) {
+            maxError = error;
+            worstAdc = adc;
+        }
+    }
+
+    printf("Ecart max table/formule: %.4f C (ADC %d)\n", maxError, worstAdc);
+    if (maxError > 0.05) {
+        printf("ECHEC: ecart > 0.05 C\n");
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
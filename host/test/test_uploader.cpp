@@ -0,0 +1,104 @@
+// test_uploader.cpp
+// FirebaseUploader : fusion en un seul PATCH multi-chemins, file bornée
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <Firebase_ESP_Client.h>
+#include <stdio.h>
+#include <string>
+
+#include "config.h"
+#include "FirebaseUploader.h"
+#include "RtdbServer.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+static TelemetryRecord record(float temperature, int lightPercent) {
+    TelemetryRecord r;
+    r.temperature = temperature;
+    r.lightRaw = 1800;
+    r.lightPercent = lightPercent;
+    r.led = true;
+    r.autoMode = true;
+    snprintf(r.mode, sizeof(r.mode), "AUTO-TEMP");
+    r.timestamp = millis();
+    return r;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+
+    RtdbServer rtdb;
+    uint16_t port = rtdb.start(0);
+    check(port != 0, "point d'acces RTDB local");
+    Firebase.setEndpoint("127.0.0.1", port);
+
+    FirebaseData fbdo;
+    FirebaseUploader uploader(&fbdo);
+
+    // Tâche non démarrée : uploadPending() pilotée à la main
+    check(!uploader.uploadPending(), "rien a envoyer");
+    check(uploader.submit(record(21.0, 10)), "depot 1");
+    check(uploader.submit(record(22.0, 20)), "depot 2");
+    check(uploader.submit(record(23.5, 30)), "depot 3");
+    check(uploader.pending() == 3, "3 en attente");
+
+    check(uploader.uploadPending(), "envoi");
+    check(rtdb.requests() == 1, "un seul aller-retour");
+    check(uploader.getSent() == 1 && uploader.getCoalesced() == 2, "3 fusionnes en 1");
+    check(uploader.pending() == 0, "file videe");
+
+    std::string request = rtdb.lastRequest();
+    check(request.compare(0, 12, "PATCH /.json") == 0, "PATCH a la racine");
+    size_t bodyStart = request.find("\r\n\r\n");
+    StaticJsonDocument<512> doc;
+    bool parsed = bodyStart != std::string::npos &&
+                  !deserializeJson(doc, request.c_str() + bodyStart + 4);
+    check(parsed, "corps JSON valide");
+    check(doc["sensors/temperature"].as<float>() == 23.5f, "valeur la plus recente");
+    check(doc["sensors/lightPercent"].as<int>() == 30, "7 chemins : lightPercent");
+    check(doc["settings/mode"] == "AUTO-TEMP", "7 chemins : mode");
+    check(doc["sensors/lastUpdate"][".sv"] == "timestamp", "horodatage serveur");
+
+    // File bornée
+    for (int i = 0; i < UPLOAD_QUEUE_SIZE; i++) uploader.submit(record(20.0, i));
+    check(!uploader.submit(record(20.0, 99)), "file pleine refuse");
+    check(uploader.getRejected() == 1, "refus compte");
+
+    // Lien coupé : échec compté, la file ne bloque pas
+    rtdb.stop();
+    uploader.uploadPending();
+    check(uploader.getFailed() == 1, "echec compte sans lien");
+    check(uploader.submit(record(20.0, 1)), "depot apres echec");
+
+    // Tâche de fond
+    uint16_t again = rtdb.start(0);
+    Firebase.setEndpoint("127.0.0.1", again);
+    uploader.begin();
+    unsigned long start = millis();
+    while (uploader.getSent() < 2 && millis() - start < 2000) delay(5);
+    uploader.stop();
+    check(uploader.getSent() == 2, "envoi par la tache de fond");
+    check(uploader.isReady(), "lien pret vu par la tache");
+
+    // État du lien suivi par la tâche seule, même sans rien à envoyer
+    uploader.begin();
+    Firebase.setReady(false);
+    start = millis();
+    while (uploader.isReady() && millis() - start < 1000) delay(5);
+    check(!uploader.isReady(), "lien perdu vu sans envoi");
+    Firebase.setReady(true);
+    start = millis();
+    while (!uploader.isReady() && millis() - start < 1000) delay(5);
+    check(uploader.isReady(), "lien retrouve");
+    uploader.stop();
+
+    rtdb.stop();
+    printf(failures ? "ECHEC (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+// test_waveforms.cpp
+// Formes d'onde du HAL simulé, entrées numériques scriptées, horloge
+// accélérée, et capteurs du firmware pilotés par ces signaux
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "config.h"
+#include "Waveform.h"
+#include "PhotocellControl.h"
+#include "TemperatureControl.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+static bool near(float a, float b) { return fabsf(a - b) < 0.01f; }
+
+int main() {
+    hal::setSerialEnabled(false);
+
+    // ========================================
+    // FORMES
+    // ========================================
+    {
+        using hal::Waveform;
+        check(near(Waveform::constant(1234).at(99999), 1234), "constante");
+
+        Waveform sine = Waveform::sine(2000, 500, 1000);
+        check(near(sine.at(0), 2000) && near(sine.at(250), 2500) && near(sine.at(750), 1500),
+              "sinus : moyenne, crete, creux");
+        check(near(sine.at(1250), sine.at(250)), "sinus periodique");
+
+        Waveform ramp = Waveform::ramp(0, 1000, 100);
+        check(near(ramp.at(50), 500) && near(ramp.at(500), 1000), "rampe puis palier");
+        check(near(Waveform::ramp(0, 1000, 100).loop(100).at(150), 500), "rampe repetee");
+
+        Waveform square = Waveform::square(100, 3000, 200);
+        check(near(square.at(10), 100) && near(square.at(150), 3000), "creneau");
+
+        std::vector<Waveform::Point> points;
+        points.push_back(Waveform::Point(100, 10));
+        points.push_back(Waveform::Point(300, 30));
+        Waveform steps = Waveform::points(points);
+        check(near(steps.at(0), 10) && near(steps.at(200), 20) && near(steps.at(1000), 30),
+              "points interpoles");
+
+        Waveform noisy = Waveform::constant(2000).noise(50, 7);
+        bool bounded = true;
+        bool varies = false;
+        for (unsigned long ms = 0; ms < 1000; ms++) {
+            float v = noisy.at(ms);
+            bounded = bounded && v >= 1950 && v <= 2050;
+            varies = varies || !near(v, noisy.at(0));
+        }
+        check(bounded && varies, "bruit borne et variable");
+        check(near(noisy.at(123), Waveform::constant(2000).noise(50, 7).at(123)), "bruit deterministe");
+
+        const char* path = "waveform_test.csv";
+        FILE* file = fopen(path, "w");
+        fprintf(file, "# ms,adc\n0,100\n1000,2100\n");
+        fclose(file);
+        bool ok = false;
+        Waveform csv = Waveform::parse("csv:waveform_test.csv", &ok);
+        check(ok && near(csv.at(500), 1100), "CSV interpole");
+        remove(path);
+
+        Waveform::parse("ramp:1:2:3", &ok);
+        check(ok, "spec ramp");
+        Waveform::parse("triangle:1", &ok);
+        check(!ok, "spec inconnue refusee");
+    }
+
+    // ========================================
+    // BROCHES SCRIPTÉES SUR HORLOGE SIMULÉE
+    // ========================================
+    {
+        hal::useSimulatedClock(true);
+        hal::setAnalogWaveform(LDR_PIN, hal::Waveform::ramp(0, 4000, 1000));
+        int first = analogRead(LDR_PIN);
+        delay(500);
+        int middle = analogRead(LDR_PIN);
+        check(first == 0 && middle == 2000, "analogRead suit la rampe");
+
+        hal::setAnalogWaveform(LDR_PIN, hal::Waveform::constant(9000));
+        check(analogRead(LDR_PIN) == 4095, "valeur bornee a 12 bits");
+
+        hal::setDigitalInput(BUTTON_LEFT, HIGH);
+        std::vector<std::pair<unsigned long, int> > press;
+        press.push_back(std::make_pair(100UL, (int)LOW));
+        press.push_back(std::make_pair(250UL, (int)HIGH));
+        hal::scriptDigitalInput(BUTTON_LEFT, press);
+        bool before = digitalRead(BUTTON_LEFT) == HIGH;
+        delay(150);
+        bool during = digitalRead(BUTTON_LEFT) == LOW;
+        delay(200);
+        bool after = digitalRead(BUTTON_LEFT) == HIGH;
+        check(before && during && after, "appui scripte 100..250 ms");
+
+        // Capteurs du firmware : lumière croissante, température qui varie
+        hal::setAnalogWaveform(LDR_PIN, hal::Waveform::ramp(200, 3800, 10000));
+        hal::setAnalogWaveform(TEMP_SENSOR_PIN, hal::Waveform::ramp(1500, 2500, 10000));
+        PhotocellControl light(LDR_PIN);
+        TemperatureControl temp(TEMP_SENSOR_PIN);
+        light.begin();
+        temp.begin();
+        int lightStart = light.read().percent;
+        float tempStart = temp.read().celsius;
+        delay(10000);
+        // Moyenne glissante : FILTER_SIZE lectures pour oublier le début
+        int lightEnd = 0;
+        float tempEnd = 0;
+        for (int i = 0; i < FILTER_SIZE; i++) {
+            lightEnd = light.read().percent;
+            tempEnd = temp.read().celsius;
+        }
+        check(lightEnd > lightStart, "PhotocellControl suit la forme");
+        check(fabsf(tempEnd - tempStart) > 1.0f, "TemperatureControl suit la forme");
+
+        hal::clearScripts();
+        hal::useSimulatedClock(false);
+    }
+
+    // ========================================
+    // HORLOGE ACCÉLÉRÉE
+    // ========================================
+    {
+        unsigned long before = millis();
+        hal::setTimeScale(50.0);
+        unsigned long realStart = before;
+        delay(1000);   // ~20 ms réelles
+        unsigned long elapsed = millis() - realStart;
+        hal::setTimeScale(1.0);
+        unsigned long after = millis();
+        check(elapsed >= 1000 && elapsed < 3000, "delay(1000) a x50");
+        check(after >= before + elapsed - 1, "temps continu au changement d'echelle");
+    }
+
+    printf("%s\n", failures == 0 ? "OK" : "ECHEC");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,347 @@
+// test_websocket.cpp
+// Canal de commande /ws sur SocketHttpServer : poignée de main RFC 6455,
+// commandes texte et binaires acquittées, état poussé comme sur /events,
+// ping/close, trame non masquée refusée, latence comparée à HTTP
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+#include <strings.h>
+#include <thread>
+
+#include "config.h"
+#include "TemperatureControl.h"
+#include "PhotocellControl.h"
+#include "LedControl.h"
+#include "SensorSampler.h"
+#include "SocketHttpServer.h"
+#include "RestAPI.h"
+#include "test_client.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    printf("%s %s\n", condition ? "ok   " : "ECHEC", what);
+    if (!condition) failures++;
+}
+
+// ========================================
+// CLIENT WEBSOCKET MINIMAL
+// ========================================
+struct Frame {
+    uint8_t opcode;
+    std::string payload;
+};
+
+// Commandes de quelques octets : envoyées sans attendre Nagle
+static const ClientOptions WS_OPTIONS = { 2000, 0, true };
+
+static bool upgrade(Client& c, uint16_t port, const char* key = "dGhlIHNhbXBsZSBub25jZQ==") {
+    char raw[256];
+    snprintf(raw, sizeof(raw),
+             "GET /ws HTTP/1.1\r\nHost: test\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+             "Sec-WebSocket-Key: %s\r\nSec-WebSocket-Version: 13\r\n\r\n", key);
+    return openStream(c, port, raw, WS_OPTIONS);
+}
+
+// Trame client : toujours masquée et finale, sauf pour tester le refus
+static void sendFrame(Client& c, uint8_t opcode, const void* data, size_t len, bool masked = true,
+                      bool fin = true) {
+    std::string frame;
+    frame += (char)((fin ? 0x80 : 0) | opcode);
+    if (len < 126) {
+        frame += (char)((masked ? 0x80 : 0) | len);
+    } else {
+        frame += (char)((masked ? 0x80 : 0) | 126);
+        frame += (char)(len >> 8);
+        frame += (char)(len & 0xFF);
+    }
+    const uint8_t mask[4] = { 0x12, 0x34, 0x56, 0x78 };
+    if (masked) frame.append((const char*)mask, 4);
+    for (size_t i = 0; i < len; i++) {
+        uint8_t byte = ((const uint8_t*)data)[i];
+        frame += (char)(masked ? byte ^ mask[i & 3] : byte);
+    }
+    ::send(c.fd, frame.data(), frame.size(), 0);
+}
+
+static void sendText(Client& c, const char* text) {
+    sendFrame(c, 0x1, text, strlen(text));
+}
+
+static bool nextFrame(Client& c, Frame& frame) {
+    while (true) {
+        if (c.pending.size() >= 2) {
+            const uint8_t* p = (const uint8_t*)c.pending.data();
+            size_t len = p[1] & 0x7F;
+            size_t head = 2;
+            if (len == 126 && c.pending.size() >= 4) {
+                len = (size_t)p[2] << 8 | p[3];
+                head = 4;
+            }
+            if (len != 126 && c.pending.size() >= head + len) {
+                frame.opcode = p[0] & 0x0F;
+                frame.payload = c.pending.substr(head, len);
+                c.pending.erase(0, head + len);
+                return true;
+            }
+        }
+        if (!fill(c)) return false;
+    }
+}
+
+static bool textFrame(Client& c, JsonDocument& doc) {
+    Frame frame;
+    return nextFrame(c, frame) && frame.opcode == 0x1 &&
+           !deserializeJson(doc, frame.payload.c_str(), frame.payload.size());
+}
+
+static bool binaryAck(Client& c, uint8_t command, uint16_t seq, uint8_t status) {
+    Frame frame;
+    if (!nextFrame(c, frame) || frame.opcode != 0x2 || frame.payload.size() != 4) return false;
+    const uint8_t* p = (const uint8_t*)frame.payload.data();
+    return p[0] == (0x80 | command) && (p[1] | p[2] << 8) == seq && p[3] == status;
+}
+
+int main() {
+    hal::setSerialEnabled(false);
+    hal::setAnalogSource([](uint8_t pin) { return pin == TEMP_SENSOR_PIN ? 2200 : 1800; });
+
+    SocketHttpServer server(0);
+    TemperatureControl tempSensor(TEMP_SENSOR_PIN);
+    PhotocellControl lightSensor(LDR_PIN);
+    LedControl led(LED_PIN);
+    SensorSampler sampler(&tempSensor, &lightSensor);
+    RestAPI api(&server, &tempSensor, &lightSensor, &led, &sampler);
+
+    tempSensor.begin();
+    lightSensor.begin();
+    led.begin();
+    sampler.sampleOnce();
+    api.begin();
+
+    std::atomic<bool> running(true);
+    server.setPollTimeout(5);
+    std::thread loop([&]() { while (running) api.handleClient(); });
+    uint16_t port = server.port();
+
+    // ========================================
+    // POIGNÉE DE MAIN
+    // ========================================
+    Client ws;
+    check(upgrade(ws, port), "mise a niveau");
+    check(ws.headers.compare(0, 12, "HTTP/1.1 101") == 0, "101 Switching Protocols");
+    check(strcasestr(ws.headers.c_str(), "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=") != NULL,
+          "cle d'acceptation RFC 6455");
+    check(strcasestr(ws.headers.c_str(), "Upgrade: websocket") != NULL, "Upgrade: websocket");
+
+    DynamicJsonDocument doc(512);
+    check(textFrame(ws, doc) && !doc["led"].as<bool>() && doc["mode"] == "MANUEL" &&
+          doc.containsKey("id") && doc.containsKey("temperature"), "etat courant a l'ouverture");
+    check(silent(ws, 3 * EVENTS_MIN_INTERVAL), "rien sans changement");
+
+    Client sse;
+    check(openStream(sse, port, "GET /events HTTP/1.1\r\nAccept: text/event-stream\r\n\r\n", WS_OPTIONS),
+          "abonne SSE a cote");
+    check(server.streamCount() == 2, "deux flux ouverts");
+    sse.pending.clear();
+
+    // ========================================
+    // COMMANDES TEXTE
+    // ========================================
+    sendText(ws, "{\"seq\":1,\"cmd\":\"led\",\"state\":\"on\"}");
+    check(textFrame(ws, doc) && doc["ack"].as<unsigned long>() == 1 && doc["ok"].as<bool>(), "LED -> acquittement");
+    check(textFrame(ws, doc) && doc["led"].as<bool>(), "nouvel etat pousse");
+    unsigned long id = doc["id"].as<unsigned long>();
+    check(led.getState(), "LED allumee");
+    {
+        size_t end;
+        while ((end = sse.pending.find("\n\n")) == std::string::npos && fill(sse)) {}
+        char expected[32];
+        snprintf(expected, sizeof(expected), "id: %lu\n", id);
+        check(sse.pending.find(expected) == 0 && sse.pending.find("\"led\":true") != std::string::npos,
+              "meme evenement sur /events");
+    }
+
+    sendText(ws, "{\"seq\":2,\"cmd\":\"mode\",\"mode\":\"auto-light\"}");
+    check(textFrame(ws, doc) && doc["ack"].as<unsigned long>() == 2 && doc["ok"].as<bool>(), "mode -> acquittement");
+    check(textFrame(ws, doc) && doc["mode"] == "AUTO-LIGHT" && doc["auto_mode"].as<bool>() &&
+          doc["id"].as<unsigned long>() == id + 1, "mode pousse");
+
+    sendText(ws, "{\"seq\":3,\"cmd\":\"threshold\",\"temp\":27.5,\"light\":40}");
+    check(textFrame(ws, doc) && doc["ok"].as<bool>(), "seuils -> acquittement");
+    ControlSettings settings = api.getSettings();
+    check(settings.tempThreshold == 27.5f && settings.lightThreshold == 40, "seuils appliques");
+
+    sendText(ws, "{\"seq\":4,\"cmd\":\"state\"}");
+    check(textFrame(ws, doc) && doc["ack"].as<unsigned long>() == 4, "etat -> acquittement");
+    check(textFrame(ws, doc) && doc["id"].as<unsigned long>() == id + 1 && doc["led"].as<bool>(), "etat renvoye");
+
+    sendText(ws, "{\"seq\":5,\"cmd\":\"fly\"}");
+    check(textFrame(ws, doc) && doc["ack"].as<unsigned long>() == 5 && !doc["ok"].as<bool>() &&
+          doc["error"] == "commande inconnue", "commande inconnue");
+    sendText(ws, "{\"seq\":6,\"cmd\":\"led\",\"state\":\"blink\"}");
+    check(textFrame(ws, doc) && !doc["ok"].as<bool>() && doc["error"] == "arguments invalides", "arguments invalides");
+    sendText(ws, "{\"seq\":7,\"cmd\":\"threshold\",\"temp\":25}");
+    check(textFrame(ws, doc) && !doc["ok"].as<bool>(), "seuil lumiere manquant");
+    sendText(ws, "pas du json");
+    check(textFrame(ws, doc) && doc["ack"].as<unsigned long>() == 0 && !doc["ok"].as<bool>(), "JSON invalide");
+
+    // ========================================
+    // COMMANDES BINAIRES
+    // ========================================
+    {
+        const uint8_t off[] = { WS_CMD_LED, 0x02, 0x01, 0 };
+        sendFrame(ws, 0x2, off, sizeof(off));
+        check(binaryAck(ws, WS_CMD_LED, 0x0102, WS_STATUS_OK), "LED binaire -> acquittement");
+        check(textFrame(ws, doc) && !doc["led"].as<bool>(), "LED eteinte poussee");
+
+        const int16_t centi = -250;
+        const uint8_t threshold[] = { WS_CMD_THRESHOLD, 9, 0, (uint8_t)(centi & 0xFF), (uint8_t)(centi >> 8), 75 };
+        sendFrame(ws, 0x2, threshold, sizeof(threshold));
+        check(binaryAck(ws, WS_CMD_THRESHOLD, 9, WS_STATUS_OK), "seuils binaires -> acquittement");
+        settings = api.getSettings();
+        check(settings.tempThreshold == -2.5f && settings.lightThreshold == 75, "seuils binaires appliques");
+
+        const uint8_t mode[] = { WS_CMD_MODE, 10, 0, 0 };
+        sendFrame(ws, 0x2, mode, sizeof(mode));
+        check(binaryAck(ws, WS_CMD_MODE, 10, WS_STATUS_OK), "mode binaire -> acquittement");
+        check(textFrame(ws, doc) && doc["mode"] == "MANUEL", "mode MANUEL pousse");
+
+        const uint8_t unknown[] = { 42, 11, 0 };
+        sendFrame(ws, 0x2, unknown, sizeof(unknown));
+        check(binaryAck(ws, 42, 11, WS_STATUS_BAD_COMMAND), "commande binaire inconnue");
+        const uint8_t shortLed[] = { WS_CMD_LED, 12, 0 };
+        sendFrame(ws, 0x2, shortLed, sizeof(shortLed));
+        check(binaryAck(ws, WS_CMD_LED, 12, WS_STATUS_BAD_ARGS), "argument manquant");
+    }
+
+    // ========================================
+    // PING, GRANDE TRAME
+    // ========================================
+    Frame frame;
+    sendFrame(ws, 0x9, "abc", 3);
+    check(nextFrame(ws, frame) && frame.opcode == 0xA && frame.payload == "abc", "ping -> pong");
+
+    std::string big = "{\"seq\":13,\"cmd\":\"state\",\"pad\":\"" + std::string(300, 'x') + "\"}";
+    sendText(ws, big.c_str());
+    check(textFrame(ws, doc) && doc["ack"].as<unsigned long>() == 13 && doc["ok"].as<bool>(),
+          "longueur sur 16 bits");
+    check(textFrame(ws, doc), "etat apres grande trame");
+
+    // ========================================
+    // LATENCE : WebSocket contre HTTP keep-alive, même commande sans état
+    // poussé (seuils) pour mesurer un seul aller-retour de chaque côté
+    // ========================================
+    close(sse.fd);
+    {
+        const int rounds = 200;
+        size_t wsBytes = 0;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        bool wsOk = true;
+        for (int i = 0; i < rounds && wsOk; i++) {
+            const uint8_t set[] = { WS_CMD_THRESHOLD, (uint8_t)i, 0, 0xF6, 0x09, 50 };
+            sendFrame(ws, 0x2, set, sizeof(set));
+            wsOk = binaryAck(ws, WS_CMD_THRESHOLD, (uint8_t)i, WS_STATUS_OK);
+            wsBytes += 2 + 4 + sizeof(set) + 2 + 4;
+        }
+        double wsUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / rounds;
+
+        Client http;
+        connectClient(http, port, WS_OPTIONS);
+        const char* raw = "POST /threshold/set?temp=25.5&light=50 HTTP/1.1\r\nContent-Length: 0\r\n\r\n";
+        size_t httpBytes = 0;
+        t0 = std::chrono::steady_clock::now();
+        bool httpOk = true;
+        for (int i = 0; i < rounds && httpOk; i++) {
+            ::send(http.fd, raw, strlen(raw), 0);
+            while (http.pending.find("}") == std::string::npos && (httpOk = fill(http))) {}
+            httpBytes += strlen(raw) + http.pending.size();
+            http.pending.clear();
+        }
+        double httpUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / rounds;
+        close(http.fd);
+
+        printf("      aller-retour commande : WebSocket %.0f us / %zu octets, HTTP %.0f us / %zu octets\n",
+               wsUs, wsBytes / rounds, httpUs, httpBytes / rounds);
+        check(wsOk && httpOk, "commandes servies sur les deux canaux");
+        check(wsBytes < httpBytes / 10, "dix fois moins d'octets par commande");
+        check(silent(ws, EVENTS_MIN_INTERVAL), "seuils : rien de pousse");
+    }
+
+    // ========================================
+    // FERMETURE
+    // ========================================
+    const uint8_t normal[] = { 0x03, 0xE8 };
+    sendFrame(ws, 0x8, normal, sizeof(normal));
+    check(nextFrame(ws, frame) && frame.opcode == 0x8 && frame.payload == std::string("\x03\xE8", 2),
+          "close renvoye");
+    check(closedByPeer(ws), "connexion fermee apres close");
+    close(ws.fd);
+
+    Client raw;
+    check(upgrade(raw, port, "x3JJHMbDL1EzLkh9GBhXDw==") && nextFrame(raw, frame), "deuxieme client");
+    sendFrame(raw, 0x1, "{}", 2, false);
+    check(nextFrame(raw, frame) && frame.opcode == 0x8 && frame.payload == std::string("\x03\xEA", 2),
+          "trame non masquee -> close 1002");
+    check(closedByPeer(raw), "client fautif deconnecte");
+    close(raw.fd);
+
+    // Trames de contrôle hors RFC 6455 §5.5 : refusées avant d'être traitées
+    {
+        struct ControlCase {
+            uint8_t opcode;
+            size_t len;
+            bool fin;
+            const char* what;
+        };
+        const ControlCase cases[] = {
+            { 0x9, 4, false, "ping fragmente -> close 1002" },
+            { 0x9, 126, true, "ping de 126 octets -> close 1002" },
+            { 0x8, 1, true, "close d'un octet -> close 1002" },
+        };
+        std::string payload(126, 'p');
+        for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+            Client bad;
+            bool ok = upgrade(bad, port, "x3JJHMbDL1EzLkh9GBhXDw==") && nextFrame(bad, frame);
+            sendFrame(bad, cases[i].opcode, payload.data(), cases[i].len, true, cases[i].fin);
+            // Aucun pong : la première trame reçue est le close
+            ok = ok && nextFrame(bad, frame) && frame.opcode == 0x8 &&
+                 frame.payload == std::string("\x03\xEA", 2) && closedByPeer(bad);
+            check(ok, cases[i].what);
+            close(bad.fd);
+        }
+    }
+
+    Client plain;
+    check(openStream(plain, port, "GET /ws HTTP/1.1\r\nHost: test\r\n\r\n", WS_OPTIONS) &&
+          plain.headers.find(" 400 ") != std::string::npos, "sans Sec-WebSocket-Key -> 400");
+    close(plain.fd);
+
+    unsigned long start = millis();
+    while (server.streamCount() > 0 && millis() - start < 2000) delay(5);
+    check(server.streamCount() == 0, "flux liberes");
+
+    running = false;
+    loop.join();
+
+    // ========================================
+    // MOTEUR WebServer
+    // ========================================
+    {
+        WebServer webServer(80);
+        RestAPI sync(&webServer, &tempSensor, &lightSensor, &led, &sampler);
+        sync.begin();
+        check(webServer.request(HTTP_GET, "/ws").code == 400, "WebServer sans WebSocket -> 400");
+        check(webServer.request(HTTP_OPTIONS, "/ws").code == 204, "OPTIONS -> 204");
+    }
+
+    server.stop();
+    printf(failures ? "ECHEC (%d)\n" : "OK\n", failures);
+    return failures ? 1 : 0;
+}